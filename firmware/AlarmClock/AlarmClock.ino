@@ -10,20 +10,38 @@
 #include "AlarmController.h"
 #include "FeatureFlags.h"
 #include "AudioSwitch.h"
+#include "TaskManager.h"
+#include "Profiler.h"
+#include "Metrics.h"
+#include "AppLock.h"
+#include "StationTable.h"
+#include "MediaIndex.h"
 
 // Module instances (managed by HardwareSetup)
 HardwareSetup* hardware = nullptr;
 MenuSystem* menu = nullptr;
 AlarmController* alarmController = nullptr;
 AudioSwitch* audioSwitch = nullptr;
+TaskManager* taskManager = nullptr;
 
 // State
 AlarmState alarmState;
 UIState uiState;
 
-// Internet radio stations - dynamically loaded from storage
-InternetRadioStation* stationList = nullptr;
-int stationCount = 0;
+// Built-in stations, used when nothing has been saved yet
+struct DefaultStation {
+  const char* name;
+  const char* url;
+};
+
+static const DefaultStation DEFAULT_STATIONS[] = {
+  { "BBC World Service", "http://stream.live.vc.bbcmedia.co.uk/bbc_world_service" },
+  { "Radio Paradise", "http://stream.radioparadise.com/aac-128" },
+  { "LBC", "https://ice-sov.musicradio.com/LBC973" },
+  { "Veronica", "https://playerservices.streamtheworld.com/api/livestream-redirect/VERONICAAAC.aac" },
+  { "NPO Radio 1", "https://icecast.omroep.nl/radio1-bb-mp3" },
+};
+static const int DEFAULT_STATION_COUNT = sizeof(DEFAULT_STATIONS) / sizeof(DEFAULT_STATIONS[0]);
 
 // Constants
 const unsigned long DEBOUNCE_DELAY = 200;
@@ -33,6 +51,7 @@ const unsigned long RDS_UPDATE_INTERVAL = 500;
 // RDS monitoring
 unsigned long lastRdsCheck = 0;
 
+// Publishes the station table that the menu, audio, web and alarm code read
 void loadStationsFromStorage() {
   if (!hardware || !hardware->getStorage()) return;
   
@@ -44,55 +63,32 @@ void loadStationsFromStorage() {
     Serial.printf("Loading %d stations from storage\n", savedCount);
   }
   
-  // Free old station list if it exists
-  if (stationList != nullptr) {
-    delete[] stationList;
-    stationList = nullptr;
+  if (savedCount > 0) {
+    storage->publishInternetStations();
+    return;
   }
   
-  // If no stations saved, create default stations
-  if (savedCount == 0) {
-    Serial.println("No stations in storage, using defaults");
-    stationCount = 5;
-    stationList = new InternetRadioStation[stationCount];
-    
-    stationList[0].name = "BBC World Service";
-    stationList[0].url = "http://stream.live.vc.bbcmedia.co.uk/bbc_world_service";
-
-    stationList[1].name = "Radio Paradise";
-    stationList[1].url = "http://stream.radioparadise.com/aac-128";
-
-    stationList[2].name = "LBC";
-    stationList[2].url = "https://ice-sov.musicradio.com/LBC973";
-    
-    stationList[3].name = "Veronica";
-    stationList[3].url = "https://playerservices.streamtheworld.com/api/livestream-redirect/VERONICAAAC.aac";
-    
-    stationList[4].name = "NPO Radio 1";
-    stationList[4].url = "https://icecast.omroep.nl/radio1-bb-mp3";
-    
-    // Save defaults to storage
-    for (int i = 0; i < stationCount; i++) {
-      storage->saveInternetStation(i, stationList[i].name.c_str(), stationList[i].url.c_str());
-    }
-    storage->setInternetStationCount(stationCount);
-  } else {
-    // Load stations from storage
-    stationCount = savedCount;
-    stationList = new InternetRadioStation[stationCount];
-    
-    for (int i = 0; i < stationCount; i++) {
-      String name, url;
-      if (storage->loadInternetStation(i, name, url)) {
-        stationList[i].name = name;
-        stationList[i].url = url;
-        Serial.printf("Loaded station %d: %s\n", i, name.c_str());
-      }
-    }
+  // If no stations saved, use and save the defaults
+  Serial.println("No stations in storage, using defaults");
+  size_t textBytes = 0;
+  for (int i = 0; i < DEFAULT_STATION_COUNT; i++) {
+    textBytes += strlen(DEFAULT_STATIONS[i].name) + strlen(DEFAULT_STATIONS[i].url);
+  }
+  
+  StationTable* table = StationTable::build(DEFAULT_STATION_COUNT, textBytes);
+  for (int i = 0; i < DEFAULT_STATION_COUNT; i++) {
+    if (table) table->add(DEFAULT_STATIONS[i].name, DEFAULT_STATIONS[i].url);
+    storage->saveInternetStation(i, DEFAULT_STATIONS[i].name, DEFAULT_STATIONS[i].url);
   }
+  if (table) StationTable::publish(table);
 }
 
 void setup() {
+  // The web server answers as soon as WiFi is up, long before setup() is
+  // done: its handlers wait on this lock until the modules are ready
+  AppLock::begin();
+  AppLock::take();
+
   Serial.begin(115200);
   delay(1000);
   
@@ -100,6 +96,10 @@ void setup() {
   Serial.println("   ESP32 Alarm Clock Radio");
   Serial.println("   with Audio Source Switching");
   Serial.println("====================================\n");
+
+#if ENABLE_PROFILER
+  Profiler::begin();
+#endif
   
   // Initialize all hardware
   Serial.println("Initializing hardware...");
@@ -143,6 +143,11 @@ void setup() {
   // Load stations from storage
   loadStationsFromStorage();
 
+  // MP3 listing for the alarm page; changes are picked up by networkTick()
+  if (hardware->getStorage()) {
+    MediaIndex::begin();
+  }
+
   // Initialize menu system
   menu = new MenuSystem(
     hardware->getDisplay(),
@@ -206,12 +211,29 @@ void setup() {
     menu->setAlarmState(&alarmState);
   }
   menu->setUIState(&uiState);
-  menu->setStationList(stationList, stationCount);
   
-  // Pass station list to web server
+  // Redraw on the second boundary instead of up to a second after it
+  if (hardware->getTimeModule()) {
+    hardware->getTimeModule()->onSecond([](const TimeSnapshot& now) {
+      uiState.needsRedraw = true;
+    });
+  }
+  
+  // WiFi reconnects in the background; the UI and NTP just hear about it
+  if (hardware->getWiFi()) {
+    menu->setWiFiStatus(hardware->getWiFi()->isConnected());
+    hardware->getWiFi()->onStatus([](bool connected) {
+      menu->setWiFiStatus(connected);
+      uiState.needsRedraw = true;
+      if (connected && hardware->getTimeModule()) {
+        hardware->getTimeModule()->syncTime();
+      }
+    });
+  }
+  
+  // Stations reach the menu, audio and web code through the published StationTable
   if (hardware->getWebServer()) {
-    Serial.println("Configuring web server with station list...");
-    hardware->getWebServer()->setStationList(stationList, stationCount);
+    Serial.println("Configuring web server...");
     hardware->getWebServer()->setAlarmController(alarmController);
     
     hardware->getWebServer()->setPlayCallback([](const char* name, const char* url) {
@@ -220,12 +242,7 @@ void setup() {
       }
     });
     
-    Serial.printf("Web server ready with %d stations\n", stationCount);
-  }
-  
-  // Pass station list to audio module
-  if (hardware->getAudio()) {
-    hardware->getAudio()->setStationList(stationList, stationCount);
+    Serial.println("Web server ready");
   }
 
   if (hardware->getDisplay()) {
@@ -237,7 +254,7 @@ void setup() {
   }
   
   Serial.println("Setup complete!\n");
-  Serial.printf("Loaded %d internet radio stations\n", stationCount);
+  Serial.printf("Loaded %d internet radio stations\n", StationTableRef().count());
   Serial.println("Web interface available at:");
   if (hardware->getWiFi()) {
     Serial.printf("  http://%s\n", hardware->getWiFi()->getLocalIP().c_str());
@@ -247,6 +264,11 @@ void setup() {
   
   Serial.println("\n*** System Ready - Audio Source: " + 
                 String(audioSwitch->isFMRadioActive() ? "FM RADIO" : "INTERNET RADIO") + " ***\n");
+  
+  AppLock::give();
+  if (ENABLE_TASKS) {
+    startTasks();
+  }
 }
 
 void updateRDS() {
@@ -266,32 +288,54 @@ void updateRDS() {
   }
 }
 
-void loop() {
+// Serial diagnostics: 'p' prints the loop profile, 'r' resets it
+void serialCommands() {
+  while (Serial.available()) {
+    char c = Serial.read();
+    if (c == 'p') {
+      Profiler::dump();
+    } else if (c == 'r') {
+      Profiler::reset();
+      Serial.println("Profiler reset");
+    }
+  }
+}
+
+// Touch, buttons and display refresh
+void uiTick() {
   static unsigned long lastUpdate = 0;
   unsigned long now = millis();
-  
-  yield();
 
-  // Update all hardware
-  hardware->loop();
+  Metrics::countLoop();
+  serialCommands();
   
   // Update ezTime events
   if (hardware->getTimeModule()) {
+    PROFILE_SCOPE(PROF_TIME);
     hardware->getTimeModule()->loop();
   }
   
   // Update RDS if in FM mode
   if (audioSwitch && audioSwitch->isFMRadioActive()) {
+    PROFILE_SCOPE(PROF_RDS);
     updateRDS();
   }
   
   // Handle touchscreen input
   if (hardware->getTouchScreen()) {
+    PROFILE_SCOPE(PROF_TOUCH);
     menu->handleTouch();
   }
   
+  // Volume pot, brightness and next-station buttons
+  {
+    PROFILE_SCOPE(PROF_CONTROLS);
+    hardware->controlsLoop();
+  }
+  
   // Read buttons
   if (hardware->getActiveFlags().enableButtons) {
+    PROFILE_SCOPE(PROF_BUTTONS);
     bool btnUp = !digitalRead(BTN_UP);
     bool btnDown = !digitalRead(BTN_DOWN);
     bool btnSelect = !digitalRead(BTN_SELECT);
@@ -308,17 +352,81 @@ void loop() {
 
   // Update display
   if (now - lastUpdate >= DISPLAY_UPDATE_INTERVAL || uiState.needsRedraw) {
+    PROFILE_SCOPE(PROF_DISPLAY);
     menu->updateDisplay();
-    menu->setWiFiStatus(hardware->getWiFi() && hardware->getWiFi()->isConnected());
     
     lastUpdate = now;
     uiState.needsRedraw = false;
   }
-  
-  // Check alarms
+}
+
+// WiFi maintenance and web requests
+void networkTick() {
+  PROFILE_SCOPE(PROF_NETWORK);
+  hardware->networkLoop();
+  MediaIndex::loop();
+  if (hardware->getStorage()) {
+    hardware->getStorage()->loop();
+  }
+}
+
+// Audio streaming (runs alone on the audio core)
+void audioTick() {
+  PROFILE_SCOPE(PROF_AUDIO);
+  hardware->getAudio()->loop();
+}
+
+// Alarm trigger checks; sleeps until the next deadline (capped)
+uint32_t alarmTick() {
   if (hardware->getActiveFlags().enableAlarms && alarmController) {
-    alarmController->checkAlarms(hardware->getTimeModule());
+    PROFILE_SCOPE(PROF_ALARMS);
+    Metrics::countAlarmCheck();
+    return alarmController->checkAlarms(hardware->getTimeModule());
+  }
+  return 0;
+}
+
+void startTasks() {
+  taskManager = new TaskManager();
+  
+  if (hardware->getAudio()) {
+    hardware->getAudio()->enableCommandQueue();
+    taskManager->addTask("audio", audioTick, AUDIO_TASK_PERIOD_MS, AUDIO_TASK_CORE,
+                         AUDIO_TASK_PRIORITY, AUDIO_TASK_STACK, false);
   }
+  taskManager->addTask("network", networkTick, NET_TASK_PERIOD_MS, APP_TASK_CORE,
+                       APP_TASK_PRIORITY, APP_TASK_STACK, true);
+  taskManager->addTask("ui", uiTick, UI_TASK_PERIOD_MS, APP_TASK_CORE,
+                       APP_TASK_PRIORITY, APP_TASK_STACK, true);
+  taskManager->addTask("alarm", alarmTick, ALARM_TASK_PERIOD_MS, APP_TASK_CORE,
+                       APP_TASK_PRIORITY, APP_TASK_STACK, true);
+  
+  if (!taskManager->start()) {
+    Serial.println("Task start failed, falling back to loop()");
+  }
+}
+
+void loop() {
+  // The tasks own all the work; the Arduino loop task is no longer needed
+  if (taskManager && taskManager->isStarted()) {
+    vTaskDelete(NULL);
+  }
+  
+  yield();
+
+  // Same locking as the tasks: web handlers may run between any two ticks
+  AppLock::take();
+  networkTick();
+  AppLock::give();
+  
+  if (hardware->getAudio()) {
+    audioTick();
+  }
+  
+  AppLock::take();
+  uiTick();
+  alarmTick();
+  AppLock::give();
   
   delay(1);
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 
 AlarmController::AlarmController(AudioModule* aud, FMRadioModule* fm, DisplayILI9341* disp, StorageModule* stor)
     : audio(aud), fmRadio(fm), display(disp), storage(stor),
-      triggeredAlarmIndex(-1), alarmIsTriggered(false), alarmIsSnoozed(false), snoozeTime(0) {
+      lastChecked(0), scheduleOffset(0),
+      triggeredAlarmIndex(-1), alarmIsTriggered(false), alarmIsSnoozed(false), snoozeUntil(0) {
+    for (int i = 0; i < MAX_ALARMS; i++) {
+        nextFire[i] = 0;
+    }
 }
 
 void AlarmController::begin() {
@@ -36,16 +40,41 @@ void AlarmController::reloadAlarms() {
     } else {
         Serial.println("ERROR: Storage module not available");
     }
+    
+    // Recomputed on the next check
+    for (int i = 0; i < MAX_ALARMS; i++) {
+        nextFire[i] = 0;
+    }
 }
 
-void AlarmController::checkAlarms(TimeModule* time) {
+// ===== SCHEDULER =====
+
+uint32_t AlarmController::checkAlarms(TimeModule* time) {
     if (!time) {
         Serial.println("ERROR: TimeModule is NULL in checkAlarms");
-        return;
+        return ALARM_MAX_SLEEP_MS;
+    }
+    
+    time_t now = time->getEpoch();
+    if (now == 0) return ALARM_MAX_SLEEP_MS;  // Clock not set yet
+    
+    // First check after boot also looks back, so a restart around the
+    // alarm time does not swallow it
+    if (lastChecked == 0 || now < lastChecked) {
+        lastChecked = now - ALARM_CATCHUP_SEC - 1;
+    }
+    
+    // A timezone change moves every local deadline
+    time_t offset = time->toLocal(now) - now;
+    if (offset != scheduleOffset) {
+        scheduleOffset = offset;
+        for (int i = 0; i < MAX_ALARMS; i++) {
+            nextFire[i] = 0;
+        }
     }
     
     // Check if snoozed alarm should trigger
-    if (alarmIsSnoozed && millis() >= snoozeTime) {
+    if (alarmIsSnoozed && now >= snoozeUntil) {
         Serial.println("Snooze time expired, re-triggering alarm");
         alarmIsTriggered = true;
         alarmIsSnoozed = false;
@@ -56,166 +85,114 @@ void AlarmController::checkAlarms(TimeModule* time) {
             display->drawText(60, 100, "WAKE UP!", ILI9341_RED, 4);
             display->drawText(40, 150, "Press SNOOZE", ILI9341_WHITE, 2);
         }
-        return;
     }
     
-    // Don't check for new alarms if one is already triggered
-    if (alarmIsTriggered) return;
-    
-    // Get current time
-    uint8_t currentHour = time->getHour();
-    uint8_t currentMin = time->getMinute();
-    uint8_t currentSec = time->getSecond();
+    time_t nextDeadline = alarmIsSnoozed ? snoozeUntil : 0;
     
-    // Debug: Print current time every minute at 0 seconds
-    static uint8_t lastDebugMin = 255;
-    if (currentSec == 0 && currentMin != lastDebugMin) {
-        lastDebugMin = currentMin;
-        Serial.printf("=== Current time: %02d:%02d:%02d ===\n", 
-                     currentHour, currentMin, currentSec);
-        
-        // Show status of all alarms
-        for (int i = 0; i < MAX_ALARMS; i++) {
-            Serial.printf("  Alarm %d: %02d:%02d %s (Repeat:%d, Sound:%d, LastTrig:%04d-%02d-%02d)\n", 
-                         i, 
-                         alarms[i].hour, 
-                         alarms[i].minute,
-                         alarms[i].enabled ? "ENABLED" : "disabled",
-                         alarms[i].repeatMode,
-                         alarms[i].soundType,
-                         alarms[i].lastYear,
-                         alarms[i].lastMonth,
-                         alarms[i].lastDay);
-        }
-        Serial.println("=================================");
-    }
-    
-    // Check each alarm
     for (int i = 0; i < MAX_ALARMS; i++) {
-        if (shouldAlarmTrigger(i, time)) {
-            Serial.printf(">>> ALARM %d TRIGGERED! <<<\n", i);
-            
-            triggeredAlarmIndex = i;
-            alarmIsTriggered = true;
-            
-            // Play the alarm sound
-            playAlarmSound(i);
-            
-            // Update last triggered date
-            updateLastTriggeredDate(i, time);
+        if (!alarms[i].enabled) {
+            nextFire[i] = 0;
+            continue;
+        }
+        if (nextFire[i] == 0) {
+            scheduleAlarm(i, lastChecked + 1, time);
+        }
+        
+        if (nextFire[i] != 0 && now >= nextFire[i]) {
+            time_t deadline = nextFire[i];
+            time_t late = now - deadline;
             
-            // If it's "once" mode, disable the alarm
-            if (alarms[i].repeatMode == ALARM_ONCE) {
-                alarms[i].enabled = false;
-                if (storage) {
-                    storage->saveAlarm(i, alarms[i]);
-                }
-                Serial.printf("Alarm %d disabled (once mode)\n", i);
+            if (late > ALARM_CATCHUP_SEC) {
+                Serial.printf("Alarm %d missed by %ld s, skipping\n", i, (long)late);
+            } else if (alarmIsTriggered || alarmIsSnoozed) {
+                // Only one alarm rings at a time
+                Serial.printf("Alarm %d due while another is active, skipping\n", i);
+            } else {
+                triggerAlarm(i, deadline, time);
             }
             
-            // Show alarm screen
-            if (display) {
-                display->clear();
-                display->drawText(60, 100, "WAKE UP!", ILI9341_RED, 4);
-                display->drawText(20, 150, ("Alarm " + String(i + 1)).c_str(), ILI9341_WHITE, 3);
-                display->drawText(40, 190, "Press SNOOZE", ILI9341_WHITE, 2);
+            nextFire[i] = 0;
+            if (alarms[i].enabled) {
+                scheduleAlarm(i, deadline + 1, time);
             }
-            
-            // Only trigger one alarm at a time
-            break;
         }
-    }
-}
-
-bool AlarmController::shouldAlarmTrigger(int index, TimeModule* time) {
-    if (index < 0 || index >= MAX_ALARMS) return false;
-    
-    AlarmConfig& alarm = alarms[index];
-    
-    // Check if alarm is enabled
-    if (!alarm.enabled) {
-        return false;
-    }
-    
-    // Get current time
-    uint8_t currentHour = time->getHour();
-    uint8_t currentMin = time->getMinute();
-    uint8_t currentSec = time->getSecond();
-    uint8_t dayOfWeek = time->getDayOfWeek();
-    
-    // Check if it's the right time (trigger only at 0 seconds)
-    if (currentHour != alarm.hour || currentMin != alarm.minute || currentSec != 0) {
-        return false;
+        
+        if (nextFire[i] != 0 && (nextDeadline == 0 || nextFire[i] < nextDeadline)) {
+            nextDeadline = nextFire[i];
+        }
     }
     
-    Serial.printf("Time match for Alarm %d! Checking day of week...\n", index);
+    lastChecked = now;
     
-    // Check if it's the right day of week
-    if (!isCorrectDayOfWeek(alarm.repeatMode, dayOfWeek)) {
-        Serial.printf("  Day of week mismatch (current: %d, mode: %d)\n", dayOfWeek, alarm.repeatMode);
-        return false;
+    if (nextDeadline == 0 || nextDeadline - now >= ALARM_MAX_SLEEP_MS / 1000) {
+        return ALARM_MAX_SLEEP_MS;
     }
-    
-    Serial.printf("  Day of week OK. Checking if already triggered today...\n");
-    
-    // Check if already triggered today (prevents multiple triggers)
-    if (hasAlreadyTriggeredToday(index, time)) {
-        Serial.printf("  Already triggered today\n");
-        return false;
+    return nextDeadline > now ? (uint32_t)(nextDeadline - now) * 1000 : 1;
+}
+
+void AlarmController::scheduleAlarm(int index, time_t from, TimeModule* time) {
+    nextFire[index] = findNextFire(index, from, time);
+    
+    if (nextFire[index] != 0) {
+        time_t local = time->toLocal(nextFire[index]);
+        uint16_t y;
+        uint8_t mo, d;
+        civilFromDays((long)(local / SECONDS_PER_DAY), y, mo, d);
+        Serial.printf("Alarm %d scheduled for %04d-%02d-%02d %02d:%02d\n",
+                      index, y, mo, d, alarms[index].hour, alarms[index].minute);
     }
-    
-    Serial.printf("  All checks passed - TRIGGER!\n");
-    return true;
 }
 
-bool AlarmController::isCorrectDayOfWeek(AlarmRepeat mode, uint8_t dayOfWeek) {
-    switch (mode) {
-        case ALARM_ONCE:
-            return true;  // Can trigger any day (but only once)
-            
-        case ALARM_DAILY:
-            return true;  // Every day
-            
-        case ALARM_WEEKDAYS:
-            // Monday = 1, Friday = 5
-            return (dayOfWeek >= 1 && dayOfWeek <= 5);
-            
-        case ALARM_WEEKENDS:
-            // Saturday = 6, Sunday = 0
-            return (dayOfWeek == 0 || dayOfWeek == 6);
-            
-        default:
-            return false;
+// Next deadline for an alarm, skipping the local day it last rang
+time_t AlarmController::findNextFire(int index, time_t from, TimeModule* time) {
+    const AlarmConfig& alarm = alarms[index];
+    
+    long lastDay = -1;
+    if (alarm.lastYear != 0) {
+        lastDay = daysFromCivil(alarm.lastYear, alarm.lastMonth, alarm.lastDay);
     }
+    return alarmNextFire(alarm.hour, alarm.minute, alarm.repeatMode, lastDay, from, *time);
 }
 
-bool AlarmController::hasAlreadyTriggeredToday(int index, TimeModule* time) {
-    if (index < 0 || index >= MAX_ALARMS) return false;
+void AlarmController::triggerAlarm(int index, time_t deadline, TimeModule* time) {
+    Serial.printf(">>> ALARM %d TRIGGERED! <<<\n", index);
     
-    AlarmConfig& alarm = alarms[index];
+    triggeredAlarmIndex = index;
+    alarmIsTriggered = true;
     
-    uint16_t currentYear = time->getYear();
-    uint8_t currentMonth = time->getMonth();
-    uint8_t currentDay = time->getDay();
+    // Play the alarm sound
+    playAlarmSound(index);
     
-    // Check if last triggered date matches today
-    if (alarm.lastYear == currentYear && 
-        alarm.lastMonth == currentMonth && 
-        alarm.lastDay == currentDay) {
-        return true;
+    // If it's "once" mode, disable the alarm (saved together with the date)
+    if (alarms[index].repeatMode == ALARM_ONCE) {
+        alarms[index].enabled = false;
+        Serial.printf("Alarm %d disabled (once mode)\n", index);
     }
     
-    return false;
+    // Record the local day of the deadline, even when caught up after midnight
+    updateLastTriggeredDate(index, time->toLocal(deadline));
+    
+    showAlarmScreen(index);
 }
 
-void AlarmController::updateLastTriggeredDate(int index, TimeModule* time) {
-    if (index < 0 || index >= MAX_ALARMS || !time || !storage) return;
+void AlarmController::showAlarmScreen(int index) {
+    if (display) {
+        display->clear();
+        display->drawText(60, 100, "WAKE UP!", ILI9341_RED, 4);
+        display->drawText(20, 150, ("Alarm " + String(index + 1)).c_str(), ILI9341_WHITE, 3);
+        display->drawText(40, 190, "Press SNOOZE", ILI9341_WHITE, 2);
+    }
+}
+
+void AlarmController::updateLastTriggeredDate(int index, time_t localTime) {
+    if (index < 0 || index >= MAX_ALARMS) return;
     
-    alarms[index].lastYear = time->getYear();
-    alarms[index].lastMonth = time->getMonth();
-    alarms[index].lastDay = time->getDay();
+    civilFromDays((long)(localTime / SECONDS_PER_DAY),
+                  alarms[index].lastYear, alarms[index].lastMonth, alarms[index].lastDay);
     
-    storage->saveAlarm(index, alarms[index]);
+    if (storage) {
+        storage->saveAlarm(index, alarms[index]);
+    }
     
     Serial.printf("Updated last triggered date for Alarm %d: %04d-%02d-%02d\n",
                   index, alarms[index].lastYear, alarms[index].lastMonth, alarms[index].lastDay);
@@ -272,7 +249,7 @@ void AlarmController::snoozeAlarm() {
     
     alarmIsTriggered = false;
     alarmIsSnoozed = true;
-    snoozeTime = millis() + SNOOZE_DURATION;
+    snoozeUntil = lastChecked + SNOOZE_DURATION_SEC;
     
     // Stop audio
     if (audio) {
@@ -10,7 +10,9 @@
 #include "AlarmData.h"
 
 #define MAX_ALARMS 3
-#define SNOOZE_DURATION (5 * 60 * 1000)  // 5 minutes in milliseconds
+#define SNOOZE_DURATION_SEC (5 * 60)     // 5 minutes
+#define ALARM_CATCHUP_SEC   120          // Still fire a deadline missed by up to this much
+#define ALARM_MAX_SLEEP_MS  1000         // Longest wait between checks (picks up clock steps)
 
 class AlarmController {
 private:
@@ -21,23 +23,30 @@ private:
     
     AlarmConfig alarms[MAX_ALARMS];
     
+    // Next deadline per alarm as a UTC epoch (0 = none scheduled)
+    time_t nextFire[MAX_ALARMS];
+    time_t lastChecked;       // Epoch of the previous check
+    time_t scheduleOffset;    // Local-UTC offset the schedule was computed with
+    
     int triggeredAlarmIndex;
     bool alarmIsTriggered;
     bool alarmIsSnoozed;
-    unsigned long snoozeTime;
+    time_t snoozeUntil;
     
-    bool shouldAlarmTrigger(int index, TimeModule* time);
-    bool isCorrectDayOfWeek(AlarmRepeat mode, uint8_t dayOfWeek);
-    bool hasAlreadyTriggeredToday(int index, TimeModule* time);
-    void updateLastTriggeredDate(int index, TimeModule* time);
+    void scheduleAlarm(int index, time_t from, TimeModule* time);
+    time_t findNextFire(int index, time_t from, TimeModule* time);
+    void triggerAlarm(int index, time_t deadline, TimeModule* time);
+    void updateLastTriggeredDate(int index, time_t localTime);
     void playAlarmSound(int index);
+    void showAlarmScreen(int index);
 
 public:
     AlarmController(AudioModule* aud, FMRadioModule* fm, DisplayILI9341* disp, StorageModule* stor);
     
     void begin();
     void reloadAlarms();  // NEW: Reload alarms from storage
-    void checkAlarms(TimeModule* time);
+    // Fires due alarms; returns ms until the next check is needed
+    uint32_t checkAlarms(TimeModule* time);
     void snoozeAlarm();
     void stopAlarm();
     
@@ -2,14 +2,7 @@
 #define ALARM_DATA_H
 
 #include <Arduino.h>
-
-// Alarm repeat modes
-enum AlarmRepeat {
-    ALARM_ONCE = 0,
-    ALARM_DAILY = 1,
-    ALARM_WEEKDAYS = 2,
-    ALARM_WEEKENDS = 3
-};
+#include "AlarmSchedule.h"   // AlarmRepeat
 
 // Alarm sound types
 enum AlarmSoundType {
@@ -0,0 +1,65 @@
+#include "AlarmSchedule.h"
+
+long daysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const long era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (long)doe - 719468;
+}
+
+void civilFromDays(long z, uint16_t& year, uint8_t& month, uint8_t& day) {
+    z += 719468;
+    const long era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    month = (uint8_t)(mp < 10 ? mp + 3 : mp - 9);
+    year = (uint16_t)((long)yoe + era * 400 + (month <= 2));
+}
+
+uint8_t dayOfWeekFromDays(long days) {
+    // 1970-01-01 was a Thursday
+    long dow = (days + 4) % 7;
+    return (uint8_t)(dow < 0 ? dow + 7 : dow);
+}
+
+bool alarmRunsOnDay(AlarmRepeat mode, uint8_t dayOfWeek) {
+    switch (mode) {
+        case ALARM_ONCE:
+            return true;  // Can trigger any day (but only once)
+            
+        case ALARM_DAILY:
+            return true;  // Every day
+            
+        case ALARM_WEEKDAYS:
+            // Monday = 1, Friday = 5
+            return (dayOfWeek >= 1 && dayOfWeek <= 5);
+            
+        case ALARM_WEEKENDS:
+            // Saturday = 6, Sunday = 0
+            return (dayOfWeek == 0 || dayOfWeek == 6);
+            
+        default:
+            return false;
+    }
+}
+
+// Local times are mapped through the timezone rules for that day, so a DST
+// change between 'from' and the deadline is honoured
+time_t alarmNextFire(uint8_t hour, uint8_t minute, AlarmRepeat mode, long skipDay,
+                     time_t from, LocalTimeMapping& tz) {
+    long firstDay = (long)(tz.toLocal(from) / SECONDS_PER_DAY);
+    for (long day = firstDay; day <= firstDay + 7; day++) {
+        if (day == skipDay) continue;
+        if (!alarmRunsOnDay(mode, dayOfWeekFromDays(day))) continue;
+        
+        time_t local = (time_t)day * SECONDS_PER_DAY + hour * 3600 + minute * 60;
+        time_t epoch = tz.localToEpoch(local);
+        if (epoch >= from) return epoch;
+    }
+    return 0;
+}
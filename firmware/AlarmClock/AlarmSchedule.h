@@ -0,0 +1,44 @@
+#ifndef ALARM_SCHEDULE_H
+#define ALARM_SCHEDULE_H
+
+// Alarm scheduling math with no Arduino, ezTime or FreeRTOS dependencies,
+// so it compiles unchanged on a host for testing against a fake clock
+
+#include <stdint.h>
+#include <time.h>
+
+#define SECONDS_PER_DAY 86400L
+
+// Alarm repeat modes
+enum AlarmRepeat {
+    ALARM_ONCE = 0,
+    ALARM_DAILY = 1,
+    ALARM_WEEKDAYS = 2,
+    ALARM_WEEKENDS = 3
+};
+
+// Maps between UTC epochs and local wall-clock seconds (implemented by
+// TimeModule on the device; a fixed-offset or table stand-in on a host)
+class LocalTimeMapping {
+public:
+    virtual ~LocalTimeMapping() {}
+    virtual time_t toLocal(time_t utc) = 0;
+    virtual time_t localToEpoch(time_t local) = 0;
+};
+
+// Days since 1970-01-01 for a civil date (proleptic Gregorian) and back
+long daysFromCivil(int year, unsigned month, unsigned day);
+void civilFromDays(long days, uint16_t& year, uint8_t& month, uint8_t& day);
+
+// 0 = Sunday ... 6 = Saturday
+uint8_t dayOfWeekFromDays(long days);
+
+bool alarmRunsOnDay(AlarmRepeat mode, uint8_t dayOfWeek);
+
+// Earliest UTC epoch >= from at which hour:minute local time falls on a
+// day allowed by mode, skipping local day skipDay (-1 = none).
+// Returns 0 if there is none within a week.
+time_t alarmNextFire(uint8_t hour, uint8_t minute, AlarmRepeat mode, long skipDay,
+                     time_t from, LocalTimeMapping& tz);
+
+#endif
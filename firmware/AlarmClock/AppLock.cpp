@@ -0,0 +1,23 @@
+#include "AppLock.h"
+
+SemaphoreHandle_t AppLock::mutex = nullptr;
+
+bool AppLock::begin() {
+    if (mutex) return true;
+    mutex = xSemaphoreCreateRecursiveMutex();
+    if (!mutex) {
+        Serial.println("AppLock: Failed to create the app lock");
+        return false;
+    }
+    return true;
+}
+
+bool AppLock::take(uint32_t timeoutMs) {
+    if (!mutex) return false;
+    TickType_t ticks = (timeoutMs == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+    return xSemaphoreTakeRecursive(mutex, ticks) == pdTRUE;
+}
+
+void AppLock::give() {
+    if (mutex) xSemaphoreGiveRecursive(mutex);
+}
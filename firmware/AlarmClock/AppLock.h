@@ -0,0 +1,25 @@
+#ifndef APP_LOCK_H
+#define APP_LOCK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// The lock around modules that are not thread-safe (display, storage,
+// alarms, media index). setup(), loop(), the app tasks and the web
+// handlers all take it, so it is created first thing in setup() and works
+// whether or not the TaskManager ever starts. Recursive: a handler that
+// calls into a module which locks again does not deadlock.
+class AppLock {
+private:
+    static SemaphoreHandle_t mutex;
+
+public:
+    // Creates the lock; later calls do nothing. Call before anything can take it.
+    static bool begin();
+
+    static bool take(uint32_t timeoutMs = portMAX_DELAY);
+    static void give();
+};
+
+#endif
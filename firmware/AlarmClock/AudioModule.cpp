@@ -1,23 +1,66 @@
 #include "AudioModule.h"
 #include <LittleFS.h>
 #include <SD.h>
+#include <lwip/tcpip.h>
 
 AudioModule::AudioModule(int bclkPin, int lrcPin, int doutPin, int maxVol, int lastVolume)
-    : stations(nullptr), stationCount(0), currentStation(-1), 
-      currentVolume(lastVolume), maxVolume(maxVol), currentStationName("Unknown"), 
-      isPlaying(false), isPlayingMP3(false), shouldLoopMP3(false), currentMP3File("") {
-    
+    : currentStation(-1),
+      currentVolume(lastVolume), maxVolume(maxVol),
+      isPlaying(false), isPlayingMP3(false), shouldLoopMP3(false),
+      cmdQueue(nullptr), streamState(STREAM_IDLE), streamError(""), stateSince(0), switchStart(0),
+      dnsRequest(0), dnsAnswered(0), dnsResult(0), prebufferPercent(0), outputMuted(false), lastWarm(0),
+      rebufferStart(0) {
+
+    stateMux = portMUX_INITIALIZER_UNLOCKED;
+    strlcpy(currentStationName, "Unknown", sizeof(currentStationName));
+    currentMP3File[0] = '\0';
+    pendingUrl[0] = '\0';
+    pendingHost[0] = '\0';
+    memset(&bufferStats, 0, sizeof(bufferStats));
+    bufferStats.targetBytes = STREAM_PREBUFFER_BYTES;
     audio.setPinout(bclkPin, lrcPin, doutPin);
 }
 
+AudioModule::~AudioModule() {
+    if (cmdQueue) {
+        vQueueDelete(cmdQueue);
+    }
+}
+
 void AudioModule::begin() {
+    // A multi-second input buffer in PSRAM rides out WiFi stalls; the
+    // library falls back to its small internal-RAM buffer without PSRAM
+    if (ENABLE_PRAM && psramFound()) {
+        uint32_t size = STREAM_BUFFER_SECONDS * STREAM_BYTES_PER_SEC;
+        if (audio.setBufsize(-1, size)) {
+            bufferStats.inPsram = true;
+            Serial.printf("AudioModule: %u byte stream buffer in PSRAM\n", size);
+        } else {
+            Serial.println("AudioModule: PSRAM stream buffer allocation failed");
+        }
+    }
+
     audio.setVolume(currentVolume);
     Serial.println("AudioModule initialized");
 }
 
+bool AudioModule::enableCommandQueue(int length) {
+    if (cmdQueue) return true;
+
+    cmdQueue = xQueueCreate(length, sizeof(AudioCommand));
+    if (!cmdQueue) {
+        Serial.println("AudioModule: Failed to create command queue");
+        return false;
+    }
+    Serial.printf("AudioModule: Command queue enabled (%d slots)\n", length);
+    return true;
+}
+
 void AudioModule::loop() {
+    processCommands();
+    updateStream();
     audio.loop();
-    
+
     // Check if MP3 has finished and should loop
     if (isPlayingMP3 && shouldLoopMP3) {
         // The Audio library will automatically loop if we don't stop it
@@ -25,99 +68,251 @@ void AudioModule::loop() {
     }
 }
 
-void AudioModule::setStationList(InternetRadioStation* stationList, int count) {
-    stations = stationList;
-    stationCount = count;
-    Serial.printf("AudioModule: Loaded %d stations\n", stationCount);
+// ===== COMMAND QUEUE =====
+
+// False when the queue is full; callers only post once the queue exists
+bool AudioModule::postCommand(AudioCommand& cmd) {
+    if (!cmdQueue) return false;
+
+    if (xQueueSend(cmdQueue, &cmd, 0) != pdTRUE) {
+        Serial.printf("AudioModule: Command queue full, dropped command %d\n", cmd.type);
+        return false;
+    }
+    return true;
+}
+
+void AudioModule::processCommands() {
+    if (!cmdQueue) return;
+
+    AudioCommand cmd;
+    while (xQueueReceive(cmdQueue, &cmd, 0) == pdTRUE) {
+        switch (cmd.type) {
+            case AUDIO_CMD_PLAY_STATION:
+                doPlayStation(cmd.value);
+                break;
+            case AUDIO_CMD_NEXT_STATION: {
+                int count = StationTableRef().count();
+                if (count > 0) {
+                    doPlayStation((currentStation + 1) % count);
+                }
+                break;
+            }
+            case AUDIO_CMD_PREV_STATION: {
+                int count = StationTableRef().count();
+                if (count > 0) {
+                    doPlayStation((currentStation - 1 + count) % count);
+                }
+                break;
+            }
+            case AUDIO_CMD_PLAY_URL:
+                doPlayCustom(cmd.name, cmd.url);
+                break;
+            case AUDIO_CMD_PLAY_MP3:
+                doPlayMP3File(cmd.url, cmd.loop);
+                break;
+            case AUDIO_CMD_STOP:
+                doStop();
+                break;
+            case AUDIO_CMD_STOP_MP3:
+                doStopMP3();
+                break;
+            case AUDIO_CMD_SET_VOLUME:
+                if (!outputMuted) audio.setVolume(cmd.value);
+                break;
+        }
+    }
 }
 
+void AudioModule::setStationName(const char* name) {
+    portENTER_CRITICAL(&stateMux);
+    strlcpy(currentStationName, name, sizeof(currentStationName));
+    portEXIT_CRITICAL(&stateMux);
+}
+
+void AudioModule::setMP3Name(const char* name) {
+    portENTER_CRITICAL(&stateMux);
+    strlcpy(currentMP3File, name, sizeof(currentMP3File));
+    portEXIT_CRITICAL(&stateMux);
+}
+
+// ===== PUBLIC CONTROL (safe to call from any task) =====
+
 void AudioModule::playStation(int index) {
-    if (!stations || index < 0 || index >= stationCount) {
-        Serial.println("AudioModule: Invalid station index");
+    if (!cmdQueue) {
+        doPlayStation(index);
         return;
     }
-    
-    currentStation = index;
-    currentStationName = stations[index].name;
-    isPlayingMP3 = false;
-    shouldLoopMP3 = false;
-    currentMP3File = "";
-    
-    Serial.printf("AudioModule: Playing: %s (%s)\n", 
-        stations[index].name.c_str(), 
-        stations[index].url.c_str());
-    
-    audio.stopSong();
-    delay(100);
-    
-    if (audio.connecttohost(stations[index].url.c_str())) {
-        isPlaying = true;
-        Serial.println("AudioModule: Stream connected successfully");
-    } else {
-        isPlaying = false;
-        Serial.println("AudioModule: Failed to connect to stream");
-    }
+
+    AudioCommand cmd = {};
+    cmd.type = AUDIO_CMD_PLAY_STATION;
+    cmd.value = index;
+    postCommand(cmd);
 }
 
 void AudioModule::nextStation() {
-    if (!stations || stationCount == 0) return;
-    
-    currentStation = (currentStation + 1) % stationCount;
-    playStation(currentStation);
+    int count = StationTableRef().count();
+    if (count == 0) return;
+
+    if (!cmdQueue) {
+        doPlayStation((currentStation + 1) % count);
+        return;
+    }
+
+    AudioCommand cmd = {};
+    cmd.type = AUDIO_CMD_NEXT_STATION;
+    postCommand(cmd);
 }
 
 void AudioModule::previousStation() {
-    if (!stations || stationCount == 0) return;
-    
-    currentStation = (currentStation - 1 + stationCount) % stationCount;
-    playStation(currentStation);
+    int count = StationTableRef().count();
+    if (count == 0) return;
+
+    if (!cmdQueue) {
+        doPlayStation((currentStation - 1 + count) % count);
+        return;
+    }
+
+    AudioCommand cmd = {};
+    cmd.type = AUDIO_CMD_PREV_STATION;
+    postCommand(cmd);
 }
 
 void AudioModule::playCustom(const char* name, const char* url) {
-    currentStationName = String(name);
+    if (!cmdQueue) {
+        doPlayCustom(name, url);
+        return;
+    }
+
+    AudioCommand cmd = {};
+    if (strlen(url) >= sizeof(cmd.url)) {
+        Serial.println("AudioModule: URL too long for command queue");
+        return;
+    }
+    cmd.type = AUDIO_CMD_PLAY_URL;
+    strlcpy(cmd.name, name, sizeof(cmd.name));
+    strlcpy(cmd.url, url, sizeof(cmd.url));
+    postCommand(cmd);
+}
+
+bool AudioModule::playMP3File(const char* filename, bool loop) {
+    if (!filename || strlen(filename) == 0) {
+        Serial.println("AudioModule: Invalid MP3 filename");
+        return false;
+    }
+    if (!cmdQueue) return doPlayMP3File(filename, loop);
+
+    // Report missing files to the caller before handing over to the audio task
+    String fullPath = String("/mp3/") + filename;
+    if (!LittleFS.exists(fullPath.c_str()) && !SD.exists(fullPath.c_str())) {
+        Serial.println("AudioModule: File not found on LittleFS or SD");
+        return false;
+    }
+
+    AudioCommand cmd = {};
+    cmd.type = AUDIO_CMD_PLAY_MP3;
+    cmd.loop = loop;
+    strlcpy(cmd.url, filename, sizeof(cmd.url));
+    return postCommand(cmd);
+}
+
+void AudioModule::stopMP3() {
+    if (!cmdQueue) {
+        doStopMP3();
+        return;
+    }
+
+    AudioCommand cmd = {};
+    cmd.type = AUDIO_CMD_STOP_MP3;
+    postCommand(cmd);
+}
+
+void AudioModule::stop() {
+    if (!cmdQueue) {
+        doStop();
+        return;
+    }
+
+    AudioCommand cmd = {};
+    cmd.type = AUDIO_CMD_STOP;
+    postCommand(cmd);
+}
+
+void AudioModule::setVolume(int volume) {
+    if (volume < 0) volume = 0;
+    if (volume > maxVolume) volume = maxVolume;
+
+    currentVolume = volume;
+
+    if (!cmdQueue) {
+        if (!outputMuted) audio.setVolume(volume);
+        return;
+    }
+
+    AudioCommand cmd = {};
+    cmd.type = AUDIO_CMD_SET_VOLUME;
+    cmd.value = volume;
+    postCommand(cmd);
+}
+
+// ===== AUDIO TASK SIDE =====
+
+void AudioModule::doPlayStation(int index) {
+    // Held only while the name and URL are copied out
+    StationTableRef stations;
+    const StationEntry* station = stations.get(index);
+    if (!station) {
+        Serial.println("AudioModule: Invalid station index");
+        return;
+    }
+
+    currentStation = index;
+    setStationName(station->name.data);
+    isPlayingMP3 = false;
+    shouldLoopMP3 = false;
+    setMP3Name("");
+
+    Serial.printf("AudioModule: Playing: %s (%s)\n", station->name.data, station->url.data);
+
+    beginStream(station->url.data);
+}
+
+void AudioModule::doPlayCustom(const char* name, const char* url) {
+    setStationName(name);
     currentStation = -1; // Custom station
     isPlayingMP3 = false;
     shouldLoopMP3 = false;
-    currentMP3File = "";
-    
+    setMP3Name("");
+
     Serial.printf("AudioModule: Playing custom: %s (%s)\n", name, url);
-    
-    audio.stopSong();
-    delay(100);
-    
-    if (audio.connecttohost(url)) {
-        isPlaying = true;
-        Serial.println("AudioModule: Custom stream connected successfully");
-    } else {
-        isPlaying = false;
-        Serial.println("AudioModule: Failed to connect to custom stream");
-    }
+
+    beginStream(url);
 }
 
-bool AudioModule::playMP3File(const char* filename, bool loop) {
+bool AudioModule::doPlayMP3File(const char* filename, bool loop) {
     if (!filename || strlen(filename) == 0) {
         Serial.println("AudioModule: Invalid MP3 filename");
         return false;
     }
-    
-    // Stop any current playback
+
+    // Stop any current playback (including a station switch in progress)
     audio.stopSong();
-    delay(100);
-    
+    setStreamState(STREAM_IDLE);
+    setMuted(false);
+
     // Construct full path (assuming files are in /mp3/ directory)
     String fullPath = String("/mp3/") + filename;
-    
-    Serial.printf("AudioModule: Playing MP3: %s (loop: %s)\n", 
+
+    Serial.printf("AudioModule: Playing MP3: %s (loop: %s)\n",
                   fullPath.c_str(), loop ? "yes" : "no");
-    
-    currentMP3File = String(filename);
+
+    setMP3Name(filename);
     shouldLoopMP3 = loop;
-    currentStationName = "MP3: " + String(filename);
+    setStationName(("MP3: " + String(filename)).c_str());
     currentStation = -1;
-    
+
     // Try LittleFS first, then SD card
     bool success = false;
-    
+
     // Try LittleFS
     if (LittleFS.exists(fullPath.c_str())) {
         Serial.println("AudioModule: Found on LittleFS");
@@ -131,7 +326,7 @@ bool AudioModule::playMP3File(const char* filename, bool loop) {
     else {
         Serial.println("AudioModule: File not found on LittleFS or SD");
     }
-    
+
     if (success) {
         isPlaying = true;
         isPlayingMP3 = true;
@@ -141,47 +336,347 @@ bool AudioModule::playMP3File(const char* filename, bool loop) {
         isPlaying = false;
         isPlayingMP3 = false;
         shouldLoopMP3 = false;
-        currentMP3File = "";
+        setMP3Name("");
         Serial.println("AudioModule: Failed to play MP3 file");
         return false;
     }
 }
 
-void AudioModule::stopMP3() {
+void AudioModule::doStopMP3() {
     if (isPlayingMP3) {
         audio.stopSong();
         isPlayingMP3 = false;
         shouldLoopMP3 = false;
-        currentMP3File = "";
+        setMP3Name("");
         isPlaying = false;
         Serial.println("AudioModule: MP3 playback stopped");
     }
 }
 
-bool AudioModule::isMP3Playing() {
-    return isPlayingMP3;
-}
-
-String AudioModule::getCurrentMP3File() {
-    return currentMP3File;
-}
-
-void AudioModule::stop() {
+void AudioModule::doStop() {
     audio.stopSong();
+    setStreamState(STREAM_IDLE);
+    setMuted(false);
     isPlaying = false;
     isPlayingMP3 = false;
     shouldLoopMP3 = false;
-    currentMP3File = "";
-    currentStationName = "Stopped";
+    setMP3Name("");
+    setStationName("Stopped");
     Serial.println("AudioModule: Audio stopped");
 }
 
-void AudioModule::setVolume(int volume) {
-    if (volume < 0) volume = 0;
-    if (volume > maxVolume) volume = maxVolume;
-    
-    currentVolume = volume;
-    audio.setVolume(volume);
+// ===== STREAM SWITCH PIPELINE =====
+// beginStream() only stops the old stream and starts an async DNS lookup.
+// updateStream() advances one step per loop(), so queued commands (e.g. the
+// next station button pressed again) are still handled while resolving.
+
+void AudioModule::beginStream(const char* url) {
+    audio.stopSong();
+    isPlaying = false;
+    switchStart = millis();
+    strlcpy(pendingUrl, url, sizeof(pendingUrl));
+
+    // The lwIP thread may be reading pendingHost for an earlier lookup
+    char host[sizeof(pendingHost)];
+    if (!extractHost(url, host, sizeof(host))) {
+        failStream("Invalid stream URL");
+        return;
+    }
+    portENTER_CRITICAL(&stateMux);
+    strlcpy(pendingHost, host, sizeof(pendingHost));
+    dnsRequest++;
+    portEXIT_CRITICAL(&stateMux);
+
+    // Stay silent until the prebuffer watermark is reached
+    setMuted(true);
+    prebufferPercent = 0;
+    setStreamState(STREAM_RESOLVING);
+
+    err_t err = startDnsLookup(host, dnsFoundCallback, this);
+    if (err == ERR_OK) {
+        answerDns(1);       // IP literal or cached
+    } else if (err != ERR_INPROGRESS) {
+        answerDns(-1);
+    }
+}
+
+// Host part of a URL: skip the scheme, stop at port, path or query
+bool AudioModule::extractHost(const char* url, char* host, size_t size) {
+    const char* start = strstr(url, "://");
+    start = start ? start + 3 : url;
+    size_t len = strcspn(start, ":/?");
+    if (len == 0 || len >= size) return false;
+    memcpy(host, start, len);
+    host[len] = '\0';
+    return true;
+}
+
+err_t AudioModule::startDnsLookup(const char* host, dns_found_callback callback, void* arg) {
+    ip_addr_t addr;
+#if CONFIG_LWIP_TCPIP_CORE_LOCKING
+    LOCK_TCPIP_CORE();
+#endif
+    err_t err = dns_gethostbyname(host, &addr, callback, arg);
+#if CONFIG_LWIP_TCPIP_CORE_LOCKING
+    UNLOCK_TCPIP_CORE();
+#endif
+    return err;
+}
+
+// Runs on the lwIP thread. Answers for a host we have since switched away
+// from are ignored; one for the current host answers the latest request.
+void AudioModule::dnsFoundCallback(const char* name, const ip_addr_t* ip, void* arg) {
+    AudioModule* self = static_cast<AudioModule*>(arg);
+    portENTER_CRITICAL(&self->stateMux);
+    if (strcmp(name, self->pendingHost) == 0) {
+        self->dnsAnswered = self->dnsRequest;
+        self->dnsResult = ip ? 1 : -1;
+    }
+    portEXIT_CRITICAL(&self->stateMux);
+}
+
+void AudioModule::answerDns(int result) {
+    portENTER_CRITICAL(&stateMux);
+    dnsAnswered = dnsRequest;
+    dnsResult = result;
+    portEXIT_CRITICAL(&stateMux);
+}
+
+// 0 until the lookup this switch started has been answered
+int AudioModule::takeDnsResult() {
+    portENTER_CRITICAL(&stateMux);
+    int result = dnsAnswered == dnsRequest ? dnsResult : 0;
+    portEXIT_CRITICAL(&stateMux);
+    return result;
+}
+
+void AudioModule::warmDnsCallback(const char* name, const ip_addr_t* ip, void* arg) {
+    // Only the lwIP cache entry matters
+    (void)name;
+    (void)ip;
+    (void)arg;
+}
+
+// Pre-resolve the stations either side of the current one so the next and
+// previous buttons skip the DNS step. The Audio library opens its own
+// socket, so only the name lookup can be done ahead of time; the lwIP
+// cache holds a handful of entries, which is what bounds this.
+void AudioModule::warmNeighbours() {
+    lastWarm = millis();
+    StationTableRef stations;
+    int count = stations.count();
+    if (!WARM_NEXT_STATIONS || count < 2 || currentStation < 0) return;
+
+    int neighbours[2] = {
+        (currentStation + 1) % count,
+        (currentStation - 1 + count) % count
+    };
+    for (int i = 0; i < 2; i++) {
+        if (i == 1 && neighbours[1] == neighbours[0]) break;
+
+        char host[sizeof(pendingHost)];
+        if (extractHost(stations.getUrl(neighbours[i]), host, sizeof(host))) {
+            startDnsLookup(host, warmDnsCallback, nullptr);
+        }
+    }
+}
+
+void AudioModule::updateStream() {
+    unsigned long elapsed = millis() - stateSince;
+
+    switch (streamState) {
+        case STREAM_RESOLVING: {
+            int dns = takeDnsResult();
+            if (dns > 0) {
+                setStreamState(STREAM_CONNECTING);
+            } else if (dns < 0 || elapsed > STREAM_DNS_TIMEOUT_MS) {
+                Serial.printf("AudioModule: Could not resolve %s\n", pendingHost);
+                failStream("Host not found");
+            }
+            break;
+        }
+
+        case STREAM_CONNECTING:
+            // The host is in the lwIP DNS cache now, so this only covers
+            // the TCP/TLS connect and the ICY request
+            if (audio.connecttohost(pendingUrl)) {
+                isPlaying = true;
+                setStreamState(STREAM_PREBUFFERING);
+                Serial.println("AudioModule: Stream connected successfully");
+            } else {
+                failStream("Could not connect");
+            }
+            break;
+
+        case STREAM_PREBUFFERING: {
+            uint32_t filled = audio.inBufferFilled();
+            uint32_t target = prebufferTarget();
+            int percent = (int)((uint64_t)filled * 100 / target);
+            prebufferPercent = percent > 100 ? 100 : percent;
+
+            if (filled >= target || elapsed > STREAM_PREBUFFER_TIMEOUT_MS) {
+                setMuted(false);
+                setStreamState(STREAM_PLAYING);
+                Serial.printf("AudioModule: Audio after %lu ms (%u bytes buffered)\n",
+                              millis() - switchStart, filled);
+                warmNeighbours();
+            } else if (!audio.isRunning()) {
+                failStream("Closed while buffering");
+            }
+            break;
+        }
+
+        case STREAM_PLAYING:
+            // The station closed the connection, or stopped sending
+            if (!audio.isRunning()) {
+                failStream("Connection lost");
+                break;
+            }
+            updateBufferStats();
+            if (rebufferStart != 0 && millis() - rebufferStart > STREAM_STALL_TIMEOUT_MS) {
+                audio.stopSong();
+                failStream("No data from station");
+                break;
+            }
+
+            // Cache entries expire with their TTL, so keep refreshing
+            if (millis() - lastWarm > WARM_DNS_REFRESH_MS) {
+                warmNeighbours();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+// reason must be a string literal: other tasks read it without a lock
+void AudioModule::failStream(const char* reason) {
+    Serial.printf("AudioModule: Stream failed: %s\n", reason);
+    isPlaying = false;
+    streamError = reason;
+    setStreamState(STREAM_FAILED);
+    setMuted(false);
+}
+
+void AudioModule::setStreamState(StreamState state) {
+    if (state != STREAM_FAILED) streamError = "";
+    streamState = state;
+    stateSince = millis();
+    rebufferStart = 0;
+
+    if (state != STREAM_PLAYING) {
+        portENTER_CRITICAL(&stateMux);
+        bufferStats.bitRate = 0;
+        portEXIT_CRITICAL(&stateMux);
+    }
+}
+
+// ===== BUFFER TELEMETRY =====
+
+void AudioModule::updateBufferStats() {
+    uint32_t filled = audio.inBufferFilled();
+    uint32_t size = audio.inBufferSize();
+    uint32_t bitRate = audio.getBitRate();
+
+    if (rebufferStart == 0 && filled < STREAM_UNDERRUN_BYTES && !isPlayingMP3) {
+        rebufferStart = millis();
+        portENTER_CRITICAL(&stateMux);
+        bufferStats.underruns++;
+        portEXIT_CRITICAL(&stateMux);
+        Serial.printf("AudioModule: Buffer underrun (%u bytes left)\n", filled);
+    } else if (rebufferStart != 0 && filled >= prebufferTarget()) {
+        uint32_t stallMs = millis() - rebufferStart;
+        rebufferStart = 0;
+        adaptPrebufferTarget(stallMs);
+        Serial.printf("AudioModule: Rebuffered in %u ms\n", stallMs);
+    }
+
+    portENTER_CRITICAL(&stateMux);
+    bufferStats.filledBytes = filled;
+    bufferStats.sizeBytes = size;
+    bufferStats.bitRate = bitRate;
+    portEXIT_CRITICAL(&stateMux);
+}
+
+// Track a decaying peak of stall lengths and size the prebuffer to cover
+// it, so a jittery network gets a deeper cushion on the next connect
+void AudioModule::adaptPrebufferTarget(uint32_t stallMs) {
+    portENTER_CRITICAL(&stateMux);
+    bufferStats.lastRebufferMs = stallMs;
+    bufferStats.totalRebufferMs += stallMs;
+    uint32_t decayed = bufferStats.jitterMs - bufferStats.jitterMs / 8;
+    bufferStats.jitterMs = stallMs > decayed ? stallMs : decayed;
+
+    uint32_t target = STREAM_PREBUFFER_BYTES +
+                      (uint32_t)((uint64_t)STREAM_BYTES_PER_SEC * bufferStats.jitterMs / 1000);
+    bufferStats.targetBytes = target;
+    portEXIT_CRITICAL(&stateMux);
+}
+
+// Watermark actually used: never more than 3/4 of the real input buffer,
+// which is small when PSRAM is unavailable
+uint32_t AudioModule::prebufferTarget() {
+    uint32_t target = bufferStats.targetBytes;
+    uint32_t limit = audio.inBufferSize() * 3 / 4;
+    return (limit > 0 && target > limit) ? limit : target;
+}
+
+void AudioModule::getBufferStats(AudioBufferStats& stats) {
+    portENTER_CRITICAL(&stateMux);
+    stats = bufferStats;
+    portEXIT_CRITICAL(&stateMux);
+}
+
+void AudioModule::setMuted(bool muted) {
+    if (muted == outputMuted) return;
+    outputMuted = muted;
+    audio.setVolume(muted ? 0 : currentVolume);
+}
+
+const char* AudioModule::getStreamStateName() {
+    switch (streamState) {
+        case STREAM_RESOLVING:    return "Resolving";
+        case STREAM_CONNECTING:   return "Connecting";
+        case STREAM_PREBUFFERING: return "Buffering";
+        case STREAM_PLAYING:      return "Playing";
+        case STREAM_FAILED:       return "Failed";
+        default:                  return "Idle";
+    }
+}
+
+void AudioModule::getStatusText(char* out, size_t size) {
+    if (!out || size == 0) return;
+
+    StreamState state = streamState;
+    if (state == STREAM_PREBUFFERING) {
+        snprintf(out, size, "Buffering %d%%", (int)prebufferPercent);
+    } else if (state != STREAM_IDLE && state != STREAM_PLAYING) {
+        strlcpy(out, getStreamStateName(), size);
+    } else {
+        strlcpy(out, isPlaying ? "Playing" : "Stopped", size);
+    }
+}
+
+// ===== STATUS =====
+
+bool AudioModule::isMP3Playing() {
+    return isPlayingMP3;
+}
+
+String AudioModule::getCurrentMP3File() {
+    char name[sizeof(currentMP3File)];
+    portENTER_CRITICAL(&stateMux);
+    memcpy(name, currentMP3File, sizeof(name));
+    portEXIT_CRITICAL(&stateMux);
+    return String(name);
+}
+
+void AudioModule::getCurrentStationName(char* out, size_t size) {
+    if (!out || size == 0) return;
+    portENTER_CRITICAL(&stateMux);
+    strlcpy(out, currentStationName, size);
+    portEXIT_CRITICAL(&stateMux);
 }
 
 int AudioModule::getCurrentVolume() {
@@ -193,7 +688,11 @@ int AudioModule::getMaxVolume() {
 }
 
 String AudioModule::getCurrentStationName() {
-    return currentStationName;
+    char name[sizeof(currentStationName)];
+    portENTER_CRITICAL(&stateMux);
+    memcpy(name, currentStationName, sizeof(name));
+    portEXIT_CRITICAL(&stateMux);
+    return String(name);
 }
 
 int AudioModule::getCurrentStationIndex() {
@@ -201,9 +700,9 @@ int AudioModule::getCurrentStationIndex() {
 }
 
 int AudioModule::getStationCount() {
-    return stationCount;
+    return StationTableRef().count();
 }
 
 bool AudioModule::getIsPlaying() {
     return isPlaying;
-}
\ No newline at end of file
+}
@@ -3,50 +3,162 @@
 
 #include <Arduino.h>
 #include <Audio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <lwip/ip_addr.h>
+#include <lwip/dns.h>
+#include "Config.h"
 #include "CommonTypes.h"
+#include "StationTable.h"
 
+// Requests posted to the audio task when the command queue is enabled
+enum AudioCommandType {
+    AUDIO_CMD_PLAY_STATION,
+    AUDIO_CMD_NEXT_STATION,
+    AUDIO_CMD_PREV_STATION,
+    AUDIO_CMD_PLAY_URL,
+    AUDIO_CMD_PLAY_MP3,
+    AUDIO_CMD_STOP,
+    AUDIO_CMD_STOP_MP3,
+    AUDIO_CMD_SET_VOLUME
+};
+
+// Station-switch pipeline, driven from loop() on the audio task
+enum StreamState {
+    STREAM_IDLE,
+    STREAM_RESOLVING,      // Waiting for DNS (async, other commands still processed)
+    STREAM_CONNECTING,     // HTTP/ICY handshake
+    STREAM_PREBUFFERING,   // Connected, muted until the watermark is reached
+    STREAM_PLAYING,
+    STREAM_FAILED
+};
+
+// Input buffer health, for /control and diagnostics
+struct AudioBufferStats {
+    uint32_t sizeBytes;         // Allocated input buffer
+    uint32_t filledBytes;
+    uint32_t targetBytes;       // Current (adaptive) prebuffer watermark
+    uint32_t underruns;         // Times the buffer ran dry while playing
+    uint32_t lastRebufferMs;    // Duration of the most recent stall
+    uint32_t totalRebufferMs;
+    uint32_t jitterMs;          // Decaying peak of recent stall durations
+    uint32_t bitRate;           // Stream bitrate reported by the decoder (bps, 0 when idle)
+    bool inPsram;
+};
+
+struct AudioCommand {
+    AudioCommandType type;
+    int value;          // Station index or volume
+    bool loop;          // MP3 looping
+    char name[64];
+    char url[256];      // Stream URL or MP3 filename
+};
 
 class AudioModule {
 private:
     Audio audio;
-    InternetRadioStation* stations;
-    int stationCount;
-    int currentStation;
-    int currentVolume;
+    volatile int currentStation;
+    volatile int currentVolume;
     int maxVolume;
-    String currentStationName;
-    bool isPlaying;
-    bool isPlayingMP3;
+    char currentStationName[64];
+    volatile bool isPlaying;
+    volatile bool isPlayingMP3;
     bool shouldLoopMP3;
-    String currentMP3File;
+    char currentMP3File[64];
+
+    // Cross-task access: other tasks post commands, only loop() touches audio
+    QueueHandle_t cmdQueue;
+    portMUX_TYPE stateMux;
+
+    // Stream switch state (written by the audio task; the DNS callback
+    // answers through dnsResult, and both sides hold stateMux for the
+    // host, request and result fields)
+    volatile StreamState streamState;
+    const char* volatile streamError;   // Why the stream failed ("" otherwise)
+    unsigned long stateSince;
+    unsigned long switchStart;    // For time-to-first-audio logging
+    char pendingUrl[256];
+    char pendingHost[128];
+    uint32_t dnsRequest;          // Bumped for every lookup a switch starts
+    uint32_t dnsAnswered;         // The request dnsResult belongs to
+    int dnsResult;                // 1 = resolved, -1 = failed
+    volatile int prebufferPercent;
+    bool outputMuted;
+
+    unsigned long lastWarm;       // When neighbour stations were last pre-resolved
+
+    // Buffer telemetry (written by the audio task, copied out under stateMux)
+    AudioBufferStats bufferStats;
+    unsigned long rebufferStart;  // 0 when not stalled
+    void updateBufferStats();
+    void adaptPrebufferTarget(uint32_t stallMs);
+    uint32_t prebufferTarget();
+
+    static void dnsFoundCallback(const char* name, const ip_addr_t* ip, void* arg);
+    static void warmDnsCallback(const char* name, const ip_addr_t* ip, void* arg);
+    static bool extractHost(const char* url, char* host, size_t size);
+    static err_t startDnsLookup(const char* host, dns_found_callback callback, void* arg);
+    void warmNeighbours();
+    void beginStream(const char* url);
+    void updateStream();
+    void setStreamState(StreamState state);
+    void answerDns(int result);
+    int takeDnsResult();
+    void failStream(const char* reason);
+    void setMuted(bool muted);
+
+    bool postCommand(AudioCommand& cmd);
+    void processCommands();
+    void setStationName(const char* name);
+    void setMP3Name(const char* name);
+
+    void doPlayStation(int index);
+    void doPlayCustom(const char* name, const char* url);
+    bool doPlayMP3File(const char* filename, bool loop);
+    void doStopMP3();
+    void doStop();
 
 public:
     AudioModule(int bclkPin, int lrcPin, int doutPin, int maxVol = 21, int defaultVolume=0);
-    
+    ~AudioModule();
+
     void begin();
     void loop();
-    
-    void setStationList(InternetRadioStation* stationList, int count);
+
+    // Route all control calls through a queue drained by loop().
+    // Call once before loop() starts running in its own task.
+    bool enableCommandQueue(int length = AUDIO_CMD_QUEUE_LEN);
+
     void playStation(int index);
     void nextStation();
     void previousStation();
     void playCustom(const char* name, const char* url);
     void stop();
-    
+
     // MP3 file playback
     bool playMP3File(const char* filename, bool loop = false);
     void stopMP3();
     bool isMP3Playing();
     String getCurrentMP3File();
-    
+
     void setVolume(int volume);
     int getCurrentVolume();
     int getMaxVolume();
-    
+
     String getCurrentStationName();
+    void getCurrentStationName(char* out, size_t size);
     int getCurrentStationIndex();
     int getStationCount();
-    
+
     bool getIsPlaying();
+
+    // Station-switch progress for the menu and web UI
+    StreamState getStreamState() { return streamState; }
+    const char* getStreamStateName();
+    const char* getStreamError() { return streamError; }  // "" unless STREAM_FAILED
+    // "Playing", "Stopped", "Buffering 40%", ... as shown on /control
+    void getStatusText(char* out, size_t size);
+    int getPrebufferPercent() { return prebufferPercent; }
+    void getBufferStats(AudioBufferStats& stats);
 };
 #endif
@@ -3,12 +3,6 @@
 
 #include <Arduino.h>
 
-// Internet Radio Station (for streaming)
-struct InternetRadioStation {
-    String name;
-    String url;
-};
-
 // FM Radio Preset (for RDA5807 presets)
 struct FMRadioPreset {
     float frequency;
@@ -48,6 +48,8 @@
 #define ENABLE_FM_RADIO     true  // Set to true now that we're using FM
 #define ENABLE_PRAM         true
 #define ENABLE_I2C_SCAN     true
+#define ENABLE_COMPOSITOR   true  // Off-screen menu rendering (needs ~300 KB PSRAM)
+#define ENABLE_PROFILER     true  // Per-stage loop latency histograms (/metrics, serial 'p')
 
 // ===== Pin Definitions for ESP32-S3-DevKitC-1 =====
 // *** LOCKED - DO NOT CHANGE THESE PINS ***
@@ -130,9 +132,56 @@ Pin 3 - DCLK - White
 #define WIFI_SSID        "DEBEER"
 #define WIFI_PASSWORD    "B@C&86j@gqW73g"
 #define MDNS_NAME        "alarmclock"
+// Fallback networks, tried in order when the one above can't be joined
+// #define WIFI_SSID_2      "phone-hotspot"
+// #define WIFI_PASSWORD_2  "..."
+// #define WIFI_SSID_3      "..."
+// #define WIFI_PASSWORD_3  "..."
+
+// Connection manager (event driven; nothing in the work loop waits for WiFi)
+#define WIFI_CONNECT_TIMEOUT_MS  10000   // Join with a scan (scan + auth + DHCP)
+#define WIFI_FAST_TIMEOUT_MS     3000    // Join to the cached BSSID/channel
+#define WIFI_BACKOFF_MIN_MS      2000    // Wait after every network failed, doubling...
+#define WIFI_BACKOFF_MAX_MS      120000  // ...up to 2 minutes
+#define WIFI_BOOT_WAIT_MS        3000    // Boot waits this long at most for a link
+#define WIFI_EVENT_QUEUE_LEN     8
 
 // ===== Audio Settings =====
 #define MAX_VOLUME       25
+#define STREAM_DNS_TIMEOUT_MS        5000   // Give up resolving a station host
+#define STREAM_PREBUFFER_BYTES       16000  // Stay muted until this much is buffered
+#define STREAM_PREBUFFER_TIMEOUT_MS  4000   // Unmute anyway after this long
+#define STREAM_BUFFER_SECONDS        10     // PSRAM input buffer length
+#define STREAM_BYTES_PER_SEC         16000  // Assumed stream rate (128 kbps)
+#define STREAM_UNDERRUN_BYTES        2048   // Below this while playing counts as an underrun
+#define STREAM_STALL_TIMEOUT_MS      10000  // Underrun this long while playing = station gone
+#define WARM_NEXT_STATIONS           true   // Keep next/previous station hosts in the DNS cache
+#define WARM_DNS_REFRESH_MS          60000  // Re-resolve them this often while playing
+
+// ===== Task Runtime =====
+// When enabled, loop() is replaced by pinned FreeRTOS tasks (see TaskManager)
+#define ENABLE_TASKS          true
+#define AUDIO_TASK_CORE       0     // Audio decoding gets a core of its own
+#define APP_TASK_CORE         1     // UI, network and alarm tasks
+#define AUDIO_TASK_PRIORITY   5
+#define APP_TASK_PRIORITY     2
+#define AUDIO_TASK_STACK      8192
+#define APP_TASK_STACK        8192
+#define AUDIO_TASK_PERIOD_MS  1
+#define UI_TASK_PERIOD_MS     20
+#define NET_TASK_PERIOD_MS    5
+#define ALARM_TASK_PERIOD_MS  1000  // Fallback; the scheduler picks its own wake-up
+#define AUDIO_CMD_QUEUE_LEN   8     // Pending play/stop/volume requests
+#define METRICS_BUFFER_SIZE   6144  // Preallocated /metrics response (profiler + gauges)
+#define EVENTS_MAX_CLIENTS    3     // Concurrent /events (SSE) listeners
+#define EVENTS_POLL_MS        250   // How often live status is compared for changes
+#define EVENTS_KEEPALIVE_MS   15000 // Idle ping so proxies keep the stream open
+#define EVENTS_MESSAGE_SIZE   384   // One JSON status event
+#define WEB_MAX_REQUESTS      4     // Open HTTP requests before answering 503
+#define WEB_MIN_FREE_BLOCK    16384 // Refuse new requests below this largest free block
+#define WEB_LOCK_TIMEOUT_MS   5     // Handler wait for the app lock before a 503 (blocks AsyncTCP)
+#define WEB_PAGE_WAIT_MS      250   // Page GET wait for the app lock before a reload page (blocks AsyncTCP)
+#define API_MAX_BODY          4096  // Largest JSON body accepted by PUT /api/v1/*
 
 // ===== Time Settings =====
 // NOTE: These are DEFAULT values only
@@ -145,6 +194,19 @@ Pin 3 - DCLK - White
 #define GMT_OFFSET_SEC       DEFAULT_GMT_OFFSET_SEC
 #define DAYLIGHT_OFFSET_SEC  DEFAULT_DAYLIGHT_OFFSET_SEC
 
+// Background NTP sync (never blocks boot; the clock runs from the RTC or
+// the last saved epoch until the first reply)
+#define NTP_SERVER            "pool.ntp.org"
+#define NTP_PORT              123
+#define NTP_LOCAL_PORT        2390
+#define NTP_SYNC_INTERVAL_MS  3600000   // Re-sync hourly once synced
+#define NTP_TIMEOUT_MS        1500      // Reply wait before counting a failure
+#define NTP_BACKOFF_MIN_MS    2000      // Retry delay after the first failure, doubling...
+#define NTP_BACKOFF_MAX_MS    600000    // ...up to 10 minutes
+#define NTP_EPOCH_SAVE_MS     21600000  // Save the synced epoch to NVS at most every 6 h
+#define NTP_MIN_VALID_EPOCH   1704067200 // 2024-01-01; RTC values below this are unset
+#define TZ_RESOLVE_RETRY_MS   600000    // Zone lookup retry when nothing is cached
+
 // ===== LED Settings =====
 #define BRIGHT_FULL      250
 #define BRIGHT_DIM       5
@@ -153,6 +215,13 @@ Pin 3 - DCLK - White
 #define MAX_STATIONS     50
 #define MAX_ALARMS       10
 
+// ===== Media Index =====
+#define MEDIA_INDEX_FILE    "/mp3index.bin"  // Cached /mp3/ listing on LittleFS
+#define MEDIA_MAX_FILES     64      // Files kept in the index (RAM: ~140 bytes each)
+#define MEDIA_NAME_MAX      64      // File name buffer including terminator
+#define MEDIA_TITLE_MAX     48      // ID3 title buffer, truncated to fit
+#define MEDIA_RESCAN_MS     300000  // Background check of /mp3/ for added/changed files
+
 // Add these definitions to your existing Config.h file
 // Place them in the appropriate sections
 
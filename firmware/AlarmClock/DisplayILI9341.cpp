@@ -1,9 +1,33 @@
 #include "DisplayILI9341.h"
+#include "TimeFormat.h"
 #include "Config.h"
-#include <math.h>
+
+// sin(i * 6 degrees) * 1024 for the 60 clock positions, clockwise from 12;
+// cos(i) is sin(i + 15)
+static const int16_t CLOCK_SIN[60] = {
+        0,   107,   213,   316,   416,   512,   602,   685,   761,   828,
+      887,   935,   974,  1002,  1018,  1024,  1018,  1002,   974,   935,
+      887,   828,   761,   685,   602,   512,   416,   316,   213,   107,
+        0,  -107,  -213,  -316,  -416,  -512,  -602,  -685,  -761,  -828,
+     -887,  -935,  -974, -1002, -1018, -1024, -1018, -1002,  -974,  -935,
+     -887,  -828,  -761,  -685,  -602,  -512,  -416,  -316,  -213,  -107,
+};
+
+// length * sin/cos(position), rounded
+static inline int16_t clockX(uint8_t position, int16_t length) {
+    int32_t v = (int32_t)length * CLOCK_SIN[position % 60];
+    return (int16_t)((v + (v >= 0 ? 512 : -512)) / 1024);
+}
+
+static inline int16_t clockY(uint8_t position, int16_t length) {
+    return -clockX((position + 15) % 60, length);
+}
 
 DisplayILI9341::DisplayILI9341(int8_t cs, int8_t dc, int8_t rst, int8_t mosi, int8_t sck, int8_t miso, int8_t bl)
-    : backlightPin(bl), brightness(255) {
+    : backlightPin(bl), brightness(255),
+      frame(nullptr), frontBuffer(nullptr), inFrame(false), frontValid(false),
+      damageCount(0), inkCount(0), lastFramePixels(0), lastFrameScanned(0),
+      clockSprite(nullptr) {
     
     // Note: TFT_eSPI uses User_Setup.h for pin configuration
     // The constructor parameters are kept for compatibility but not used
@@ -20,8 +44,8 @@ DisplayILI9341::DisplayILI9341(int8_t cs, int8_t dc, int8_t rst, int8_t mosi, in
     lastAlarmMin = 255;
     lastFMFreq = -1.0;
     lastWiFiStatus = false;
-    lastDateStr = "";
-    lastTimeStr = "";
+    lastTextDays = -1;
+    lastTextMinutes = -1;
     
     // Analog clock settings (right side of screen)
     // Moved up and right to avoid digital clock
@@ -47,13 +71,199 @@ void DisplayILI9341::begin() {
     }
     
     clear();
+    
+    if (ENABLE_COMPOSITOR && psramFound()) {
+        int16_t w = tft.width();
+        int16_t h = tft.height();
+        frame = new TFT_eSprite(&tft);
+        frame->setColorDepth(16);
+        frontBuffer = (uint16_t*)ps_malloc((size_t)w * h * sizeof(uint16_t));
+        if (!frontBuffer || !frame->createSprite(w, h)) {
+            Serial.println("Display: Not enough PSRAM for compositor, drawing directly");
+            free(frontBuffer);
+            frontBuffer = nullptr;
+            delete frame;
+            frame = nullptr;
+        } else {
+            Serial.printf("Display: Compositor enabled (%dx%d)\n", w, h);
+        }
+    }
+    
+    // Small sprite for the analog clock (PSRAM when available)
+    int16_t size = clockRadius * 2 + 1;
+    clockSprite = new TFT_eSprite(&tft);
+    clockSprite->setColorDepth(16);
+    if (!clockSprite->createSprite(size, size)) {
+        Serial.println("Display: Not enough memory for clock sprite, drawing the clock directly");
+        delete clockSprite;
+        clockSprite = nullptr;
+    }
 }
 
 void DisplayILI9341::clear() {
-    tft.fillScreen(TFT_BLACK);
+    if (inFrame) {
+        // Only what was drawn since the last clear needs blacking out, so a
+        // frame that redraws the same screen diffs just those areas
+        for (int i = 0; i < inkCount; i++) {
+            frame->fillRect(ink[i].x, ink[i].y, ink[i].w, ink[i].h, TFT_BLACK);
+            mergeRect(damage, damageCount, ink[i]);
+        }
+        inkCount = 0;
+    } else {
+        tft.fillScreen(TFT_BLACK);
+        frontValid = false;
+    }
     resetCache();
 }
 
+// ===== COMPOSITOR =====
+
+// Target for the direct draw functions
+TFT_eSPI* DisplayILI9341::gfx() {
+    if (inFrame) return frame;
+    frontValid = false;  // Panel no longer matches the front buffer
+    return &tft;
+}
+
+// Main-screen widgets always draw straight to the panel
+TFT_eSPI& DisplayILI9341::panel() {
+    frontValid = false;
+    return tft;
+}
+
+void DisplayILI9341::beginFrame() {
+    if (!frame || inFrame) return;
+    inFrame = true;
+    damageCount = 0;
+}
+
+// Record a changed area, both for this frame and until the next clear()
+void DisplayILI9341::addDamage(int16_t x, int16_t y, int16_t w, int16_t h) {
+    int16_t screenW = frame->width();
+    int16_t screenH = frame->height();
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > screenW) w = screenW - x;
+    if (y + h > screenH) h = screenH - y;
+    if (w <= 0 || h <= 0) return;
+
+    DamageRect r = { x, y, w, h };
+    mergeRect(damage, damageCount, r);
+    mergeRect(ink, inkCount, r);
+}
+
+// Add r to a rectangle list, merging it with any rectangle it overlaps or
+// touches; when the list is full everything collapses into one bounding box
+void DisplayILI9341::mergeRect(DamageRect* rects, int& count, DamageRect r) {
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < count; i++) {
+            DamageRect& d = rects[i];
+            if (r.x <= d.x + d.w && d.x <= r.x + r.w && r.y <= d.y + d.h && d.y <= r.y + r.h) {
+                int16_t x2 = max(r.x + r.w, d.x + d.w);
+                int16_t y2 = max(r.y + r.h, d.y + d.h);
+                r.x = min(r.x, d.x);
+                r.y = min(r.y, d.y);
+                r.w = x2 - r.x;
+                r.h = y2 - r.y;
+                rects[i] = rects[--count];
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    if (count == MAX_DAMAGE_RECTS) {
+        for (int i = 0; i < count; i++) {
+            int16_t x2 = max(r.x + r.w, rects[i].x + rects[i].w);
+            int16_t y2 = max(r.y + r.h, rects[i].y + rects[i].h);
+            r.x = min(r.x, rects[i].x);
+            r.y = min(r.y, rects[i].y);
+            r.w = x2 - r.x;
+            r.h = y2 - r.y;
+        }
+        count = 0;
+    }
+    rects[count++] = r;
+}
+
+// Diff each damaged rectangle against the front buffer and push runs of
+// changed rows, each trimmed to the changed columns
+void DisplayILI9341::endFrame() {
+    if (!inFrame) return;
+    inFrame = false;
+
+    int16_t screenW = frame->width();
+    uint16_t* back = (uint16_t*)frame->getPointer();
+    lastFramePixels = 0;
+    lastFrameScanned = 0;
+
+    if (!frontValid) {
+        damageCount = 0;
+        DamageRect all = { 0, 0, screenW, frame->height() };
+        mergeRect(damage, damageCount, all);
+    }
+
+    for (int i = 0; i < damageCount; i++) {
+        const DamageRect& r = damage[i];
+        lastFrameScanned += (uint32_t)r.w * r.h;
+        int16_t runTop = -1;
+        int16_t runLeft = screenW;
+        int16_t runRight = -1;
+
+        // One extra iteration flushes the final run
+        for (int16_t y = r.y; y <= r.y + r.h; y++) {
+            int16_t left = -1;
+            int16_t right = -1;
+
+            if (y < r.y + r.h) {
+                const uint16_t* b = back + (int32_t)y * screenW;
+                const uint16_t* f = frontBuffer + (int32_t)y * screenW;
+                if (!frontValid) {
+                    left = r.x;
+                    right = r.x + r.w - 1;
+                } else {
+                    for (int16_t x = r.x; x < r.x + r.w; x++) {
+                        if (b[x] != f[x]) { left = x; break; }
+                    }
+                    if (left >= 0) {
+                        for (int16_t x = r.x + r.w - 1; x >= left; x--) {
+                            if (b[x] != f[x]) { right = x; break; }
+                        }
+                    }
+                }
+            }
+
+            if (left >= 0) {
+                if (runTop < 0) runTop = y;
+                if (left < runLeft) runLeft = left;
+                if (right > runRight) runRight = right;
+            } else if (runTop >= 0) {
+                pushRegion(runLeft, runTop, runRight - runLeft + 1, y - runTop);
+                runTop = -1;
+                runLeft = screenW;
+                runRight = -1;
+            }
+        }
+    }
+
+    damageCount = 0;
+    frontValid = true;
+}
+
+void DisplayILI9341::pushRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+    frame->pushSprite(x, y, x, y, w, h);
+
+    int16_t screenW = frame->width();
+    const uint16_t* back = (const uint16_t*)frame->getPointer();
+    for (int16_t row = y; row < y + h; row++) {
+        memcpy(frontBuffer + (int32_t)row * screenW + x,
+               back + (int32_t)row * screenW + x, w * sizeof(uint16_t));
+    }
+    lastFramePixels += (uint32_t)w * h;
+}
+
 void DisplayILI9341::resetCache() {
     lastHour = 255;
     lastMinute = 255;
@@ -66,8 +276,8 @@ void DisplayILI9341::resetCache() {
     lastAlarmMin = 255;
     lastFMFreq = -1.0;
     lastWiFiStatus = false;
-    lastDateStr = "";
-    lastTimeStr = "";
+    lastTextDays = -1;
+    lastTextMinutes = -1;
 }
 
 void DisplayILI9341::setBrightness(uint8_t level) {
@@ -86,76 +296,61 @@ void DisplayILI9341::drawClockFace() {
     if (!ENABLE_DRAW) {
         return;
     }
-
-    // Draw outer circle
-    tft.drawCircle(clockCenterX, clockCenterY, clockRadius, TFT_WHITE);
-    tft.drawCircle(clockCenterX, clockCenterY, clockRadius - 1, TFT_WHITE);
-    
-    // Draw hour markers
-    for (int i = 0; i < 12; i++) {
-        float angle = i * 30 - 90;
-        float rad = angle * PI / 180.0;
-        
-        int x1 = clockCenterX + (clockRadius - 10) * cos(rad);
-        int y1 = clockCenterY + (clockRadius - 10) * sin(rad);
-        int x2 = clockCenterX + (clockRadius - 5) * cos(rad);
-        int y2 = clockCenterY + (clockRadius - 5) * sin(rad);
-        
-        tft.drawLine(x1, y1, x2, y2, TFT_WHITE);
-    }
-    
-    // Draw center dot
-    tft.fillCircle(clockCenterX, clockCenterY, 3, TFT_WHITE);
+    renderClock(0, 0, 0, false);
 }
 
-void DisplayILI9341::drawHourHand(uint8_t hour, uint8_t minute, bool erase) {
-    if (!ENABLE_DRAW) {
-        return;
+// Draw the whole clock (face, hands, centre dot) into the sprite and push
+// its bounding box once; nothing on the panel is erased piecemeal. Without
+// the sprite (no memory) the same drawing goes straight to the panel.
+void DisplayILI9341::renderClock(uint8_t hour, uint8_t minute, uint8_t second, bool drawHands) {
+    TFT_eSPI* g = clockSprite;
+    int16_t cx = clockRadius;  // Centre in sprite coordinates
+    int16_t cy = clockRadius;
+    if (clockSprite) {
+        clockSprite->fillSprite(TFT_BLACK);
+    } else {
+        g = &panel();
+        cx = clockCenterX;
+        cy = clockCenterY;
+        g->fillCircle(cx, cy, clockRadius, TFT_BLACK);
     }
-
-    float angle = ((hour % 12) * 30 + minute * 0.5) - 90;
-    float rad = angle * PI / 180.0;
-    int length = clockRadius - 25;
     
-    int x = clockCenterX + length * cos(rad);
-    int y = clockCenterY + length * sin(rad);
+    // Outer circle
+    g->drawCircle(cx, cy, clockRadius, TFT_WHITE);
+    g->drawCircle(cx, cy, clockRadius - 1, TFT_WHITE);
     
-    uint16_t color = erase ? TFT_BLACK : TFT_WHITE;
-    tft.drawLine(clockCenterX, clockCenterY, x, y, color);
-    tft.drawLine(clockCenterX + 1, clockCenterY, x + 1, y, color);
-    tft.drawLine(clockCenterX, clockCenterY + 1, x, y + 1, color);
-}
-
-void DisplayILI9341::drawMinuteHand(uint8_t minute, bool erase) {
-    if (!ENABLE_DRAW) {
-        return;
+    // Hour markers
+    for (uint8_t pos = 0; pos < 60; pos += 5) {
+        g->drawLine(cx + clockX(pos, clockRadius - 10), cy + clockY(pos, clockRadius - 10),
+                    cx + clockX(pos, clockRadius - 5), cy + clockY(pos, clockRadius - 5),
+                    TFT_WHITE);
     }
-
-    float angle = (minute * 6) - 90;
-    float rad = angle * PI / 180.0;
-    int length = clockRadius - 15;
     
-    int x = clockCenterX + length * cos(rad);
-    int y = clockCenterY + length * sin(rad);
+    if (drawHands) {
+        drawHand(g, cx, cy, (hour % 12) * 5 + minute / 12, clockRadius - 25, TFT_WHITE, true);
+        drawHand(g, cx, cy, minute, clockRadius - 15, TFT_CYAN, false);
+        drawHand(g, cx, cy, second, clockRadius - 10, TFT_RED, false);
+    }
     
-    uint16_t color = erase ? TFT_BLACK : TFT_CYAN;
-    tft.drawLine(clockCenterX, clockCenterY, x, y, color);
-}
-
-void DisplayILI9341::drawSecondHand(uint8_t second, bool erase) {
-    if (!ENABLE_DRAW) {
-        return;
+    // Centre dot
+    g->fillCircle(cx, cy, 3, TFT_WHITE);
+    
+    if (clockSprite) {
+        frontValid = false;  // Panel changes outside the compositor
+        clockSprite->pushSprite(clockCenterX - clockRadius, clockCenterY - clockRadius);
     }
+}
 
-    float angle = (second * 6) - 90;
-    float rad = angle * PI / 180.0;
-    int length = clockRadius - 10;
+void DisplayILI9341::drawHand(TFT_eSPI* g, int16_t cx, int16_t cy, uint8_t position,
+                              int16_t length, uint16_t color, bool thick) {
+    int16_t x = cx + clockX(position, length);
+    int16_t y = cy + clockY(position, length);
     
-    int x = clockCenterX + length * cos(rad);
-    int y = clockCenterY + length * sin(rad);
-    
-    uint16_t color = erase ? TFT_BLACK : TFT_RED;
-    tft.drawLine(clockCenterX, clockCenterY, x, y, color);
+    g->drawLine(cx, cy, x, y, color);
+    if (thick) {
+        g->drawLine(cx + 1, cy, x + 1, y, color);
+        g->drawLine(cx, cy + 1, x, y + 1, color);
+    }
 }
 
 // ===== SMART UPDATE FUNCTIONS =====
@@ -180,25 +375,13 @@ void DisplayILI9341::updateTime(uint8_t hour, uint8_t minute, uint8_t second) {
     }
     
     // Update analog clock
-    if (lastSecond != 255) {
-        drawSecondHand(lastSecond, true);
-    }
-    if (lastMinute != 255 && lastMinute != minute) {
-        drawMinuteHand(lastMinute, true);
-    }
-    if (lastHour != 255 && (lastHour != hour || lastMinute != minute)) {
-        drawHourHand(lastHour, lastMinute, true);
+    if (hour != lastHour || minute != lastMinute || second != lastSecond) {
+        renderClock(hour, minute, second, true);
     }
 
     lastHour = hour;
     lastMinute = minute;
     lastSecond = second;
-    
-    drawHourHand(hour, minute, false);
-    drawMinuteHand(minute, false);
-    drawSecondHand(second, false);
-    
-    tft.fillCircle(clockCenterX, clockCenterY, 3, TFT_WHITE);
 }
 
 void DisplayILI9341::updateDate(uint16_t year, uint8_t month, uint8_t day) {
@@ -223,35 +406,42 @@ void DisplayILI9341::updateDate(uint16_t year, uint8_t month, uint8_t day) {
     }
 }
 
-void DisplayILI9341::updateDateFormatted(const String& dateStr, const String& timeStr) {
-    if (!ENABLE_DRAW) {
+// Compares the integer fields from the time snapshot and formats text only
+// when something visible changed (once a minute for HH:MM, once a day for
+// the date), into stack buffers
+void DisplayILI9341::updateClockText(const TimeSnapshot& now) {
+    if (!ENABLE_DRAW || !now.valid) {
         return;
     }
     // Check if date changed - MOVED to bottom, above SETUP button
-    if (dateStr != lastDateStr) {
+    if (now.days != lastTextDays) {
+        char dateText[DATE_TEXT_SIZE];
+        formatShortDate(now, dateText);
+        
         // FULLY clear the date area (bottom of screen, Y: dateStrRow)
-        tft.fillRect(startColumn, dateStrRow, dateWidth,dateHeight, TFT_BLACK);
-        tft.setCursor(startColumn, dateStrRow);
-        tft.setTextColor(TFT_CYAN, TFT_BLACK);
-        tft.setTextSize(2);
-        tft.print(dateStr);
+        panel().fillRect(startColumn, dateStrRow, dateWidth,dateHeight, TFT_BLACK);
+        panel().setCursor(startColumn, dateStrRow);
+        panel().setTextColor(TFT_CYAN, TFT_BLACK);
+        panel().setTextSize(2);
+        panel().print(dateText);
         
-        lastDateStr = dateStr;
+        lastTextDays = now.days;
     }
     
     // Check if time changed (HH:MM only, ignore seconds) - SMALLER and HIGHER
-    String shortTime = timeStr.substring(0, 5);  // Get "HH:MM"
-    String lastShortTime = lastTimeStr.substring(0, 5);
-    
-    if (shortTime != lastShortTime || lastTimeStr.length() == 0) {
+    int16_t minutes = now.hour * 60 + now.minute;
+    if (minutes != lastTextMinutes) {
+        char timeText[HOUR_MINUTE_SIZE];
+        formatHourMinute(now, timeText);
+        
         // FULLY clear the time area (top left, smaller size 4)
-        tft.fillRect(startColumn, clockRow, clockWidth, clockHeight, TFT_BLACK);
-        tft.setCursor(startColumn, clockRow);
-        tft.setTextColor(TFT_WHITE, TFT_BLACK);
-        tft.setTextSize(4);  // Reduced from 5 to 4
-        tft.print(shortTime);
+        panel().fillRect(startColumn, clockRow, clockWidth, clockHeight, TFT_BLACK);
+        panel().setCursor(startColumn, clockRow);
+        panel().setTextColor(TFT_WHITE, TFT_BLACK);
+        panel().setTextSize(4);  // Reduced from 5 to 4
+        panel().print(timeText);
         
-        lastTimeStr = timeStr;
+        lastTextMinutes = minutes;
     }
 }
 
@@ -266,16 +456,16 @@ void DisplayILI9341::updateAlarmStatus(bool enabled, uint8_t hour, uint8_t minut
 
         This messes up the clock display
 */        
-        tft.fillRect(startColumn, clockRow + clockHeight, alarmWidth, alarmHeight, TFT_BLACK);
+        panel().fillRect(startColumn, clockRow + clockHeight, alarmWidth, alarmHeight, TFT_BLACK);
 
         // Only show alarm if enabled
         if (enabled) {
             char alarmStr[20];
             sprintf(alarmStr, "ALARM: %02d:%02d", hour, minute);
-            tft.setTextColor(TFT_GREEN, TFT_BLACK);
-            tft.setCursor(10, 80);
-            tft.setTextSize(2);
-            tft.print(alarmStr);
+            panel().setTextColor(TFT_GREEN, TFT_BLACK);
+            panel().setCursor(10, 80);
+            panel().setTextSize(2);
+            panel().print(alarmStr);
         }
         
         lastAlarmEnabled = enabled;
@@ -291,14 +481,14 @@ void DisplayILI9341::updateFMFrequency(float frequency) {
 
     if (abs(frequency - lastFMFreq) > 0.05) {
         // FULLY clear the FM area (below alarm)
-        tft.fillRect(10, 110, 150, 20, TFT_BLACK);
+        panel().fillRect(10, 110, 150, 20, TFT_BLACK);
         
         char freqStr[15];
         sprintf(freqStr, "FM: %.1f MHz", frequency);
-        tft.setCursor(10, 110);
-        tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-        tft.setTextSize(2);
-        tft.print(freqStr);
+        panel().setCursor(10, 110);
+        panel().setTextColor(TFT_YELLOW, TFT_BLACK);
+        panel().setTextSize(2);
+        panel().print(freqStr);
         
         lastFMFreq = frequency;
     }
@@ -311,16 +501,16 @@ void DisplayILI9341::updateWiFiStatus(bool connected) {
 
     if (connected != lastWiFiStatus) {
         // FULLY clear the WiFi area
-        tft.fillRect(5, 5, 70, 15, TFT_BLACK);
+        panel().fillRect(5, 5, 70, 15, TFT_BLACK);
         
-        tft.setCursor(5, 5);
-        tft.setTextSize(1);
+        panel().setCursor(5, 5);
+        panel().setTextSize(1);
         if (connected) {
-            tft.setTextColor(TFT_GREEN, TFT_BLACK);
-            tft.print("WiFi OK");
+            panel().setTextColor(TFT_GREEN, TFT_BLACK);
+            panel().print("WiFi OK");
         } else {
-            tft.setTextColor(TFT_RED, TFT_BLACK);
-            tft.print("WiFi OFF");
+            panel().setTextColor(TFT_RED, TFT_BLACK);
+            panel().print("WiFi OFF");
         }
         
         lastWiFiStatus = connected;
@@ -328,25 +518,42 @@ void DisplayILI9341::updateWiFiStatus(bool connected) {
 }
 
 // ===== DIRECT DRAW FUNCTIONS =====
+// These go through the compositor when called inside beginFrame()/endFrame()
+
 void DisplayILI9341::drawText(int16_t x, int16_t y, const char* text, uint16_t color, uint8_t size) {
-    tft.setCursor(x, y, 2);
-    tft.setTextColor(color, TFT_BLACK);
-    tft.setTextSize(size);
-    tft.println(text);
+    TFT_eSPI* g = gfx();
+    g->setCursor(x, y, 2);
+    g->setTextColor(color, TFT_BLACK);
+    g->setTextSize(size);
+    if (inFrame) {
+        int16_t w = g->textWidth(text);
+        // Long text wraps, so damage everything below it
+        if (x + w > g->width()) {
+            addDamage(0, y, g->width(), g->height() - y);
+        } else {
+            addDamage(x, y, w, g->fontHeight());
+        }
+    }
+    g->println(text);
 }
 
 void DisplayILI9341::drawTextWithBackground(int16_t x, int16_t y, const char* text, uint16_t fgColor, uint16_t bgColor, uint8_t size) {
-    tft.setCursor(x, y);
-    tft.setTextColor(fgColor, bgColor);
-    tft.setTextSize(size);
-    tft.print(text);
+    TFT_eSPI* g = gfx();
+    g->setCursor(x, y);
+    g->setTextColor(fgColor, bgColor);
+    g->setTextSize(size);
+    if (inFrame) {
+        addDamage(0, y, g->width(), g->height() - y);
+    }
+    g->print(text);
 }
 
 void DisplayILI9341::drawBitmap(int16_t x, int16_t y, const uint16_t* bitmap, int16_t w, int16_t h) {
     if (!ENABLE_DRAW) {
         return;
     }
-    tft.pushImage(x, y, w, h, bitmap);
+    if (inFrame) addDamage(x, y, w, h);
+    gfx()->pushImage(x, y, w, h, bitmap);
 }
 
 /*
@@ -359,35 +566,40 @@ void DisplayILI9341::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16
     if (!ENABLE_DRAW) {
         return;
     }
-    tft.fillRect(x, y, w, h, color);
+    if (inFrame) addDamage(x, y, w, h);
+    gfx()->fillRect(x, y, w, h, color);
 }
 
 void DisplayILI9341::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
     if (!ENABLE_DRAW) {
         return;
     }
-    tft.drawRect(x, y, w, h, color);
+    if (inFrame) addDamage(x, y, w, h);
+    gfx()->drawRect(x, y, w, h, color);
 }
 
 void DisplayILI9341::drawCircle(int16_t x, int16_t y, int16_t r, uint16_t color) {
     if (!ENABLE_DRAW) {
         return;
     }
-    tft.drawCircle(x, y, r, color);
+    if (inFrame) addDamage(x - r, y - r, 2 * r + 1, 2 * r + 1);
+    gfx()->drawCircle(x, y, r, color);
 }
 
 void DisplayILI9341::fillCircle(int16_t x, int16_t y, int16_t r, uint16_t color) {
     if (!ENABLE_DRAW) {
         return;
     }
-    tft.fillCircle(x, y, r, color);
+    if (inFrame) addDamage(x - r, y - r, 2 * r + 1, 2 * r + 1);
+    gfx()->fillCircle(x, y, r, color);
 }
 
 void DisplayILI9341::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
     if (!ENABLE_DRAW) {
         return;
     }
-    tft.drawLine(x0, y0, x1, y1, color);
+    if (inFrame) addDamage(min(x0, x1), min(y0, y1), abs(x1 - x0) + 1, abs(y1 - y0) + 1);
+    gfx()->drawLine(x0, y0, x1, y1, color);
 }
 
 int16_t DisplayILI9341::getWidth() {
@@ -2,6 +2,7 @@
 #define DISPLAY_ILI9341_H
 
 #include <TFT_eSPI.h>
+#include "TimeSnapshot.h"
 
 // Color compatibility - map ILI9341_ colors to TFT_ colors
 #define ILI9341_BLACK       TFT_BLACK
@@ -24,8 +25,14 @@
 #define ILI9341_GREENYELLOW TFT_GREENYELLOW
 #define ILI9341_PINK        TFT_PINK
 
+#define MAX_DAMAGE_RECTS 8
+
 class DisplayILI9341 {
 private:
+    struct DamageRect {
+        int16_t x, y, w, h;
+    };
+
     TFT_eSPI tft;
     int8_t backlightPin;
     uint8_t brightness;
@@ -42,8 +49,8 @@ private:
     uint8_t lastAlarmMin;
     float lastFMFreq;
     bool lastWiFiStatus;
-    String lastDateStr;  // NEW: Cache for formatted date
-    String lastTimeStr;  // NEW: Cache for formatted time
+    long lastTextDays;          // Digital clock text cache (local day number,
+    int16_t lastTextMinutes;    // minutes since midnight); -1 = redraw
 
     uint8_t startColumn = 10;
     uint8_t dateStrRow  = 130;
@@ -62,9 +69,32 @@ private:
     int16_t clockCenterY;
     int16_t clockRadius;
     
-    void drawHourHand(uint8_t hour, uint8_t minute, bool erase);
-    void drawMinuteHand(uint8_t minute, bool erase);
-    void drawSecondHand(uint8_t second, bool erase);
+    // Compositor: frames render into a full-screen PSRAM sprite, and only
+    // pixels that differ from what the panel already shows are pushed
+    TFT_eSprite* frame;
+    uint16_t* frontBuffer;        // Copy of the panel contents
+    bool inFrame;
+    bool frontValid;              // False after any direct draw to the panel
+    DamageRect damage[MAX_DAMAGE_RECTS];
+    int damageCount;
+    DamageRect ink[MAX_DAMAGE_RECTS];    // Drawn on since the last clear();
+    int inkCount;                         // everything else is still black
+    uint32_t lastFramePixels;
+    uint32_t lastFrameScanned;
+
+    TFT_eSPI* gfx();
+    TFT_eSPI& panel();
+    void addDamage(int16_t x, int16_t y, int16_t w, int16_t h);
+    static void mergeRect(DamageRect* rects, int& count, DamageRect r);
+    void pushRegion(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    // Analog clock is composed off-screen and pushed as one block
+    // (nullptr when there was no memory for it: drawn on the panel instead)
+    TFT_eSprite* clockSprite;
+    
+    void renderClock(uint8_t hour, uint8_t minute, uint8_t second, bool drawHands);
+    void drawHand(TFT_eSPI* g, int16_t cx, int16_t cy, uint8_t position,
+                  int16_t length, uint16_t color, bool thick);
 
 public:
     DisplayILI9341(int8_t cs, int8_t dc, int8_t rst, int8_t mosi, int8_t sck, int8_t miso, int8_t bl);
@@ -74,13 +104,22 @@ public:
     void setBrightness(uint8_t level);
     uint8_t getBrightness();
     
+    // Compositing: draw calls between beginFrame() and endFrame() go to an
+    // off-screen buffer; endFrame() pushes only the changed pixels.
+    // Falls back to direct drawing when PSRAM is not available.
+    void beginFrame();
+    void endFrame();
+    bool hasCompositor() { return frame != nullptr; }
+    uint32_t getLastFramePixels() { return lastFramePixels; }
+    uint32_t getLastFrameScanned() { return lastFrameScanned; }  // Pixels diffed
+    
     // Get the underlying TFT_eSPI object (needed for touch)
     TFT_eSPI* getTFT() { return &tft; }
     
     // Smart update functions (only redraw if changed)
     void updateTime(uint8_t hour, uint8_t minute, uint8_t second);
     void updateDate(uint16_t year, uint8_t month, uint8_t day);
-    void updateDateFormatted(const String& dateStr, const String& timeStr);  // NEW: Better formatted display
+    void updateClockText(const TimeSnapshot& now);  // Digital HH:MM + date, redrawn only on change
     void updateAlarmStatus(bool enabled, uint8_t hour, uint8_t minute);
     void updateFMFrequency(float frequency);
     void updateWiFiStatus(bool connected);
@@ -0,0 +1,172 @@
+#include "EventStream.h"
+#include "AudioModule.h"
+#include "AlarmController.h"
+#include "FMRadioModule.h"
+#include "TimeModule.h"
+
+// ===== JSON HELPERS =====
+
+static size_t appendRaw(char* out, size_t size, size_t len, const char* text) {
+    while (*text && len + 1 < size) {
+        out[len++] = *text++;
+    }
+    out[len] = '\0';
+    return len;
+}
+
+static size_t appendJsonString(char* out, size_t size, size_t len, const char* text) {
+    len = appendRaw(out, size, len, "\"");
+    for (; *text && len + 7 < size; text++) {
+        unsigned char c = *text;
+        if (c == '"' || c == '\\') {
+            out[len++] = '\\';
+            out[len++] = c;
+        } else if (c < 0x20) {
+            len += snprintf(out + len, size - len, "\\u%04x", c);
+        } else {
+            out[len++] = c;
+        }
+    }
+    return appendRaw(out, size, len, "\"");
+}
+
+static size_t appendKey(char* out, size_t size, size_t len, const char* key, bool& first) {
+    len = appendRaw(out, size, len, first ? "{\"" : ",\"");
+    len = appendRaw(out, size, len, key);
+    first = false;
+    return appendRaw(out, size, len, "\":");
+}
+
+// ===== EVENT STREAM =====
+
+EventStream::EventStream()
+    : source("/events"), audioModule(nullptr), alarmController(nullptr), fmRadioModule(nullptr),
+      timeModule(nullptr), haveLatest(false), lastPoll(0), lastKeepAlive(0) {
+    memset(&sent, 0, sizeof(sent));
+    memset(&latest, 0, sizeof(latest));
+    latestMux = portMUX_INITIALIZER_UNLOCKED;
+    message[0] = '\0';
+}
+
+void EventStream::begin(AsyncWebServer* server) {
+    source.onConnect([this](AsyncEventSourceClient* client) { onConnect(client); });
+    server->addHandler(&source);
+}
+
+int EventStream::getClientCount() {
+    return source.count();
+}
+
+// Runs on the AsyncTCP task, so it formats into its own buffer
+void EventStream::onConnect(AsyncEventSourceClient* client) {
+    if (source.count() > EVENTS_MAX_CLIENTS) {
+        Serial.println("EventStream: Too many listeners, closing");
+        client->close();
+        return;
+    }
+
+    // New listeners start from a full snapshot; others keep getting deltas.
+    // Before loop() has sampled once, its first delta carries every field.
+    portENTER_CRITICAL(&latestMux);
+    LiveStatus now = latest;
+    bool ready = haveLatest;
+    portEXIT_CRITICAL(&latestMux);
+
+    char snapshot[EVENTS_MESSAGE_SIZE];
+    if (ready && buildEvent(now, nullptr, snapshot, sizeof(snapshot)) > 0) {
+        client->send(snapshot, nullptr, millis(), 5000);
+    }
+    Serial.printf("EventStream: Client connected (%d active)\n", (int)source.count());
+}
+
+// Samples even with no listeners, so the next one to connect starts current
+void EventStream::loop() {
+    unsigned long now = millis();
+    if (haveLatest && now - lastPoll < EVENTS_POLL_MS) return;
+    lastPoll = now;
+
+    LiveStatus current;
+    sample(current);
+    portENTER_CRITICAL(&latestMux);
+    latest = current;
+    haveLatest = true;
+    portEXIT_CRITICAL(&latestMux);
+
+    if (source.count() == 0) {
+        // A listener connecting now is sent this sample; deltas follow on from it
+        sent = current;
+        return;
+    }
+
+    if (buildEvent(current, &sent, message, sizeof(message)) > 0) {
+        source.send(message, nullptr, now);
+        sent = current;
+        lastKeepAlive = now;
+    } else if (now - lastKeepAlive >= EVENTS_KEEPALIVE_MS) {
+        // Named event the page ignores; keeps proxies from closing an idle stream
+        source.send("", "ping", now);
+        lastKeepAlive = now;
+    }
+}
+
+void EventStream::sample(LiveStatus& status) {
+    memset(&status, 0, sizeof(status));
+
+    if (audioModule) {
+        audioModule->getCurrentStationName(status.station, sizeof(status.station));
+        audioModule->getStatusText(status.status, sizeof(status.status));
+        status.volume = audioModule->getCurrentVolume();
+    }
+
+    const char* alarm = "Off";
+    if (alarmController) {
+        if (alarmController->isAlarmTriggered()) alarm = "Ringing";
+        else if (alarmController->isAlarmSnoozed()) alarm = "Snoozed";
+    }
+    strlcpy(status.alarm, alarm, sizeof(status.alarm));
+
+    if (fmRadioModule) {
+        strlcpy(status.rds, fmRadioModule->getLastRdsText(), sizeof(status.rds));
+    }
+
+    if (timeModule) {
+        const TimeSnapshot& t = timeModule->getSnapshot();
+        snprintf(status.time, sizeof(status.time), "%02u:%02u:%02u", t.hour, t.minute, t.second);
+    }
+}
+
+size_t EventStream::buildEvent(const LiveStatus& now, const LiveStatus* prev,
+                               char* out, size_t size) {
+    size_t len = 0;
+    bool first = true;
+
+    if (!prev || strcmp(now.station, prev->station) != 0) {
+        len = appendKey(out, size, len, "station", first);
+        len = appendJsonString(out, size, len, now.station);
+    }
+    if (!prev || strcmp(now.status, prev->status) != 0) {
+        len = appendKey(out, size, len, "status", first);
+        len = appendJsonString(out, size, len, now.status);
+    }
+    if (!prev || now.volume != prev->volume) {
+        char number[12];
+        snprintf(number, sizeof(number), "%d", now.volume);
+        len = appendKey(out, size, len, "volume", first);
+        len = appendRaw(out, size, len, number);
+    }
+    if (!prev || strcmp(now.alarm, prev->alarm) != 0) {
+        len = appendKey(out, size, len, "alarm", first);
+        len = appendJsonString(out, size, len, now.alarm);
+    }
+    if (!prev || strcmp(now.rds, prev->rds) != 0) {
+        len = appendKey(out, size, len, "rds", first);
+        len = appendJsonString(out, size, len, now.rds);
+    }
+    if (!prev || strcmp(now.time, prev->time) != 0) {
+        len = appendKey(out, size, len, "time", first);
+        len = appendJsonString(out, size, len, now.time);
+    }
+
+    if (first) return 0;  // No field changed
+    return appendRaw(out, size, len, "}");
+}
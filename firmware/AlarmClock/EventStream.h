@@ -0,0 +1,66 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "Config.h"
+
+class AudioModule;
+class AlarmController;
+class FMRadioModule;
+class TimeModule;
+
+// Snapshot of everything the live status view shows
+struct LiveStatus {
+    char station[64];
+    char status[32];
+    int volume;
+    char alarm[16];
+    char rds[65];
+    char time[12];
+};
+
+// Server-Sent Events channel (/events). Clients get the full status when
+// they connect, then only the fields that changed, as one JSON object per
+// event. Sampling happens from the network task's loop(), which holds the
+// app lock; a connecting client is sent the last sample loop() took, so
+// the AsyncTCP task never reads the modules itself.
+class EventStream {
+private:
+    AsyncEventSource source;
+    AudioModule* audioModule;
+    AlarmController* alarmController;
+    FMRadioModule* fmRadioModule;
+    TimeModule* timeModule;
+
+    LiveStatus sent;          // Last state pushed to all clients
+    LiveStatus latest;        // Last sample, for clients that connect (under latestMux)
+    bool haveLatest;
+    portMUX_TYPE latestMux;
+    unsigned long lastPoll;
+    unsigned long lastKeepAlive;
+    char message[EVENTS_MESSAGE_SIZE];  // Used by loop() only
+
+    // prev == nullptr builds the full object; returns 0 if nothing changed
+    static size_t buildEvent(const LiveStatus& now, const LiveStatus* prev,
+                             char* out, size_t size);
+    void onConnect(AsyncEventSourceClient* client);
+
+public:
+    EventStream();
+
+    void setAudioModule(AudioModule* aud) { audioModule = aud; }
+    void setAlarmController(AlarmController* ctrl) { alarmController = ctrl; }
+    void setFMRadioModule(FMRadioModule* fm) { fmRadioModule = fm; }
+    void setTimeModule(TimeModule* time) { timeModule = time; }
+
+    // Registers /events on the server
+    void begin(AsyncWebServer* server);
+    void loop();
+    int getClientCount();
+
+    // Current values (also served by /api/v1/status)
+    void sample(LiveStatus& status);
+};
+
+#endif
@@ -1,7 +1,9 @@
 #include "FMRadioModule.h"
 
 FMRadioModule::FMRadioModule() 
-    : isInitialized(false), currentFrequency(98.0), currentVolume(45) {}
+    : isInitialized(false), currentFrequency(98.0), currentVolume(45) {
+    rdsText[0] = '\0';
+}
 
 bool FMRadioModule::begin() {
     Serial.println("FMRadioModule: Initializing Si4735...");
@@ -59,6 +61,7 @@ void FMRadioModule::setupDigitalAudio() {
 void FMRadioModule::setFrequency(float freq) {
     if (isInitialized && freq >= 87.5 && freq <= 108.0) {
         currentFrequency = freq;
+        rdsText[0] = '\0';  // Text belongs to the previous station
         uint16_t freqInt = (uint16_t)(freq * 100);  // Convert to 10kHz units
         radio.setFrequency(freqInt);
         Serial.printf("FMRadioModule: Tuned to %.1f MHz\n", freq);
@@ -82,6 +85,7 @@ void FMRadioModule::setVolume(uint8_t vol) {
 void FMRadioModule::seekUp() {
     if (isInitialized) {
         radio.frequencyUp();
+        rdsText[0] = '\0';
         currentFrequency = radio.getFrequency() / 100.0;
         Serial.printf("FMRadioModule: Seek up to %.1f MHz\n", currentFrequency);
     }
@@ -90,6 +94,7 @@ void FMRadioModule::seekUp() {
 void FMRadioModule::seekDown() {
     if (isInitialized) {
         radio.frequencyDown();
+        rdsText[0] = '\0';
         currentFrequency = radio.getFrequency() / 100.0;
         Serial.printf("FMRadioModule: Seek down to %.1f MHz\n", currentFrequency);
     }
@@ -122,7 +127,11 @@ bool FMRadioModule::getRdsReceived() {
 
 char* FMRadioModule::getRdsText() {
     if (isInitialized) {
-        return radio.getRdsText();
+        char* text = radio.getRdsText();
+        if (text && text[0]) {
+            strlcpy(rdsText, text, sizeof(rdsText));
+        }
+        return text;
     }
     return nullptr;
 }
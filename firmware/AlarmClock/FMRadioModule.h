@@ -10,6 +10,7 @@ private:
     bool isInitialized;
     float currentFrequency;
     uint8_t currentVolume;
+    char rdsText[65];       // Last non-empty radio text, readable without I2C
 
 public:
     FMRadioModule();
@@ -27,6 +28,7 @@ public:
     int getRSSI();
     bool getRdsReceived();
     char* getRdsText();
+    const char* getLastRdsText() { return rdsText; }
     void getRdsStatus();
 };
 
@@ -27,12 +27,12 @@ bool HardwareSetup::begin() {
     Serial.println("HW - Init Display");
     initDisplay();
     
-    Serial.println("HW - Init WiFi");
-    initWiFi();
-
     Serial.println("HW - Init Storage");
     initStorage();
     
+    Serial.println("HW - Init WiFi");
+    initWiFi();  // After storage: it keeps the cached BSSID/channel there
+    
     // Load saved settings after storage is initialized
     loadSavedSettings();
 /**/    
@@ -142,15 +142,23 @@ void HardwareSetup::loadSavedSettings() {
 }
 
 void HardwareSetup::loop() {
-    // WiFi maintenance
-    if (wifi) wifi->checkConnection();
-    
-    // Web server
-    if (webServer) webServer->handleClient();
+    networkLoop();
     
     // Audio streaming
     if (audio) audio->loop();
     
+    controlsLoop();
+}
+
+void HardwareSetup::networkLoop() {
+    // WiFi events, join timeouts and backoff (never waits)
+    if (wifi) wifi->loop();
+    
+    // Web server
+    if (webServer) webServer->handleClient();
+}
+
+void HardwareSetup::controlsLoop() {
     // Hardware controls
     handleVolumeControl();
     handleBrightnessButton();
@@ -193,7 +201,15 @@ void HardwareSetup::initWiFi() {
     Serial.println("Initializing WiFi...");
     if (display) display->drawText(10, lastRow, "Connecting WiFi:", ILI9341_WHITE, 1);    
     wifi = new WiFiModule(WIFI_SSID, WIFI_PASSWORD);
-    if (wifi->connect()) {
+#ifdef WIFI_SSID_2
+    wifi->addNetwork(WIFI_SSID_2, WIFI_PASSWORD_2);
+#endif
+#ifdef WIFI_SSID_3
+    wifi->addNetwork(WIFI_SSID_3, WIFI_PASSWORD_3);
+#endif
+    wifi->setStorage(storage);
+    
+    if (wifi->begin() && wifi->waitForConnection(WIFI_BOOT_WAIT_MS)) {
         Serial.println("WiFi Connected!");
         if (display) {
             display->drawText(120, lastRow, "OK - ", ILI9341_WHITE, 1);
@@ -203,8 +219,8 @@ void HardwareSetup::initWiFi() {
         Serial.println("Set LED to Green");
         if (led) led->setColor(LEDModule::COLOR_GREEN, BRIGHT_DIM);
     } else {
-        Serial.println("WiFi Connection Failed!");
-        if (display) display->drawText(80, lastRow, "FAIL", ILI9341_RED, 1);
+        Serial.println("WiFi not connected yet, retrying in the background");
+        if (display) display->drawText(120, lastRow, "RETRYING", ILI9341_RED, 1);
         Serial.println("Set LED to Red");
         if (led) led->setColor(LEDModule::COLOR_RED, BRIGHT_FULL);
     }
@@ -225,6 +241,8 @@ void HardwareSetup::initTime() {
     // timeModule = new TimeModule("Europe/London");  // UK
     // timeModule = new TimeModule("America/New_York");  // US East Coast
     
+    timeModule->setStorage(storage);
+    
     if (timeModule->begin(WIFI_SSID, WIFI_PASSWORD)) {
         if (display) display->drawText(10, lastRow, "Time: OK", ILI9341_WHITE, 1);
         Serial.println("Timezone: " + timeModule->getTimezoneName());
@@ -236,7 +254,8 @@ void HardwareSetup::initTime() {
 }
 
 void HardwareSetup::initWebServer() {
-    if (activeFlags.enableWeb && wifi && wifi->isConnected()) {
+    // Started even before the link is up; it serves once WiFi connects
+    if (activeFlags.enableWeb && wifi) {
         webServer = new WebServerModule();
         
         // CRITICAL: Set ALL modules BEFORE calling begin()
@@ -248,6 +267,7 @@ void HardwareSetup::initWebServer() {
             webServer->setTimeModule(timeModule);
             Serial.println("WebServer: Time module set");
         }
+        webServer->setWiFiModule(wifi);
         if (audio) {
             webServer->setAudioModule(audio);
             Serial.println("WebServer: Audio module set");
@@ -269,7 +289,7 @@ void HardwareSetup::initWebServer() {
                      MDNS_NAME, wifi->getLocalIP().c_str());
     }
     else {
-        if (display) display->drawText(10, lastRow, "Web: Disabled or no WiFi", ILI9341_WHITE, 1);
+        if (display) display->drawText(10, lastRow, "Web: Disabled", ILI9341_WHITE, 1);
     }
     lastRow += fontHeight;
 }
@@ -383,11 +403,9 @@ void HardwareSetup::handleVolumeControl() {
         int newVolume = map(potValue, 0, 4095, 0, audio->getMaxVolume());
         audio->setVolume(newVolume);
         
-        // Save to storage periodically (not on every change to avoid wear)
-        static unsigned long lastSave = 0;
-        if (millis() - lastSave > 5000 && storage) {  // Save every 5 seconds max
+        // The settings journal holds this in RAM until the pot stops moving
+        if (storage) {
             storage->saveVolume(newVolume);
-            lastSave = millis();
         }
     }
 }
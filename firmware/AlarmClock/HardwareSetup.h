@@ -39,7 +39,9 @@ public:
     ~HardwareSetup();
     
     bool begin();
-    void loop();
+    void loop();          // Everything below, for single-threaded operation
+    void networkLoop();   // WiFi maintenance and web server
+    void controlsLoop();  // Volume pot, brightness and next-station buttons
     
     // Getters
     DisplayILI9341* getDisplay() { return display; }
@@ -0,0 +1,303 @@
+#include "HtmlStream.h"
+#include <stdarg.h>
+#include <new>
+
+#define HTML_ROW_BUFFER_SIZE (HTML_CHUNK_SIZE + HTML_ROW_MAX)
+
+// ===== PAGE BODY =====
+
+size_t HtmlStream::heldBytes = 0;
+size_t HtmlStream::peakBytes = 0;
+
+HtmlStream::Body::~Body() {
+    while (head) freeHead();
+    freeRowBuffer();
+}
+
+// capacity 0: a header only, for text in flash or rows not yet written
+HtmlStream::Segment* HtmlStream::Body::addSegment(size_t capacity) {
+    size_t size = sizeof(Segment) + capacity;
+    Segment* segment = (Segment*)(psramFound() ? ps_malloc(size) : malloc(size));
+    if (!segment) return nullptr;
+
+    segment->next = nullptr;
+    segment->data = capacity ? (const uint8_t*)(segment + 1) : nullptr;
+    segment->length = 0;
+    segment->capacity = capacity;
+    segment->rows = nullptr;
+    if (tail) tail->next = segment;
+    else head = segment;
+    tail = segment;
+
+    heldBytes += size;
+    if (heldBytes > peakBytes) peakBytes = heldBytes;
+    return segment;
+}
+
+void HtmlStream::Body::freeHead() {
+    Segment* next = head->next;
+    heldBytes -= sizeof(Segment) + head->capacity;
+    if (head->rows) {
+        heldBytes -= sizeof(RowSource);
+        delete head->rows;
+    }
+    free(head);
+    head = next;
+    if (!head) tail = nullptr;
+    sent = 0;
+}
+
+void HtmlStream::Body::freeRowBuffer() {
+    if (!rowBuffer) return;
+    free(rowBuffer);
+    rowBuffer = nullptr;
+    heldBytes -= HTML_ROW_BUFFER_SIZE;
+}
+
+size_t HtmlStream::Body::append(const uint8_t* data, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        if (total >= HTML_PAGE_MAX) {
+            truncated = true;
+            break;
+        }
+        if (!tail || tail->length >= tail->capacity) {  // Full, or a header-only segment
+            if (!addSegment(HTML_CHUNK_SIZE)) {
+                truncated = true;
+                break;
+            }
+        }
+        size_t n = min(size - written, tail->capacity - tail->length);
+        n = min(n, (size_t)HTML_PAGE_MAX - total);
+        memcpy((uint8_t*)tail->data + tail->length, data + written, n);
+        tail->length += n;
+        total += n;
+        written += n;
+    }
+    return written;
+}
+
+void HtmlStream::Body::appendStatic(const uint8_t* data, size_t size) {
+    if (size == 0) return;
+    if (total + size > HTML_PAGE_MAX) {
+        truncated = true;
+        return;
+    }
+    Segment* segment = addSegment(0);
+    if (!segment) {
+        truncated = true;
+        return;
+    }
+    segment->data = data;
+    segment->length = size;
+    total += size;
+}
+
+// Rows are not counted against HTML_PAGE_MAX: until sent they are a
+// header, and then they share one buffer
+void HtmlStream::Body::appendRows(int count, const HtmlRowWriter& writer) {
+    if (count <= 0 || !writer) return;
+    RowSource* rows = new (std::nothrow) RowSource();
+    Segment* segment = rows ? addSegment(0) : nullptr;
+    if (!segment) {
+        delete rows;
+        truncated = true;
+        return;
+    }
+    rows->writer = writer;
+    rows->count = count;
+    rows->next = 0;
+    segment->rows = rows;
+    heldBytes += sizeof(RowSource);
+    if (heldBytes > peakBytes) peakBytes = heldBytes;
+}
+
+// Refill a rows segment with the next rows, about a block's worth;
+// false once they have all been written
+bool HtmlStream::Body::writeRows(Segment* segment) {
+    if (!rowBuffer) {
+        rowBuffer = (uint8_t*)(psramFound() ? ps_malloc(HTML_ROW_BUFFER_SIZE) : malloc(HTML_ROW_BUFFER_SIZE));
+        if (!rowBuffer) return false;   // Headers are out: end the page early
+        heldBytes += HTML_ROW_BUFFER_SIZE;
+        if (heldBytes > peakBytes) peakBytes = heldBytes;
+    }
+
+    RowSource* rows = segment->rows;
+    size_t length = 0;
+    while (rows->next < rows->count && length < HTML_CHUNK_SIZE) {
+        HtmlRowOut out(rowBuffer + length, HTML_ROW_MAX);
+        rows->writer(out, rows->next++);
+        length += out.getLength();
+    }
+    segment->data = rowBuffer;
+    segment->length = length;
+    return length > 0;
+}
+
+// Copy the next bytes into the response buffer, freeing segments as they empty
+size_t HtmlStream::Body::fill(uint8_t* buffer, size_t maxLen) {
+    size_t copied = 0;
+    while (head && copied < maxLen) {
+        if (sent == head->length) {
+            if (!head->rows || !writeRows(head)) {
+                freeHead();
+                continue;
+            }
+            sent = 0;
+        }
+        size_t n = min(maxLen - copied, head->length - sent);
+        memcpy(buffer + copied, head->data + sent, n);
+        copied += n;
+        sent += n;
+        if (sent == head->length && !head->rows) freeHead();
+    }
+    if (!head) freeRowBuffer();
+    return copied;
+}
+
+// ===== ROWS =====
+
+size_t HtmlRowOut::printf(const char* format, ...) {
+    size_t room = capacity - length;
+    if (room == 0) return 0;
+
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf((char*)buffer + length, room, format, args);
+    va_end(args);
+    if (n < 0) return 0;
+
+    // Cut short, vsnprintf() still spends the last byte on a terminator
+    size_t written = (size_t)n < room ? (size_t)n : room - 1;
+    length += written;
+    return written;
+}
+
+size_t HtmlRowOut::write(uint8_t c) {
+    if (length >= capacity) return 0;
+    buffer[length++] = c;
+    return 1;
+}
+
+size_t HtmlRowOut::write(const uint8_t* data, size_t size) {
+    size_t n = min(size, capacity - length);
+    memcpy(buffer + length, data, n);
+    length += n;
+    return n;
+}
+
+// ===== ESCAPING =====
+
+size_t htmlEscape(Print& out, const char* text) {
+    if (!text) return 0;
+
+    // Write unescaped runs in one call, entities individually
+    size_t written = 0;
+    const char* run = text;
+    for (const char* p = text; *p; p++) {
+        const char* entity;
+        switch (*p) {
+            case '&':  entity = "&amp;"; break;
+            case '<':  entity = "&lt;"; break;
+            case '>':  entity = "&gt;"; break;
+            case '"':  entity = "&quot;"; break;
+            case '\'': entity = "&#39;"; break;
+            default: continue;
+        }
+        if (p > run) written += out.write((const uint8_t*)run, p - run);
+        written += out.print(entity);
+        run = p + 1;
+    }
+    return written + out.print(run);
+}
+
+// ===== STREAM =====
+
+HtmlStream::HtmlStream(AsyncWebServerRequest* req) 
+    : request(req), contentType("text/html"), code(200) {
+}
+
+HtmlStream::~HtmlStream() {
+    end();
+}
+
+void HtmlStream::begin(int code, const char* contentType) {
+    if (!request || body) return;
+    
+    body = std::make_shared<Body>();
+    this->code = code;
+    this->contentType = contentType;
+}
+
+void HtmlStream::end() {
+    if (!body) return;
+    
+    if (body->truncated) {
+        // A cut-off page would render as broken HTML with a 200
+        Serial.printf("HtmlStream: %s over %u bytes, sending 500\n", request->url().c_str(), (unsigned)HTML_PAGE_MAX);
+        body.reset();
+        request->send(500, "text/plain", "Page too large");
+        return;
+    }
+    
+    // The filler owns the body now; it is freed with the response
+    std::shared_ptr<Body> pending = body;
+    AsyncWebServerResponse* response = request->beginChunkedResponse(contentType,
+        [pending](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            (void)index;  // Always called in order
+            return pending->fill(buffer, maxLen);
+        });
+    response->setCode(code);
+    request->send(response);
+    body.reset();
+}
+
+void HtmlStream::sendStatic(PGM_P text) {
+    if (!body || !text) return;
+    
+    // Flash is memory-mapped on the ESP32: the filler reads it in place
+    body->appendStatic((const uint8_t*)text, strlen_P(text));
+}
+
+void HtmlStream::sendRows(int count, HtmlRowWriter writer) {
+    if (!body) return;
+    body->appendRows(count, writer);
+}
+
+size_t HtmlStream::printf(const char* format, ...) {
+    if (!body) return 0;
+    
+    char buffer[HTML_FORMAT_SIZE];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (n < 0) return 0;
+    
+    if ((size_t)n < sizeof(buffer)) {
+        return body->append((const uint8_t*)buffer, n);
+    }
+    
+    // Larger than the stack buffer (rare): format into a temporary buffer
+    char* temp = (char*)malloc(n + 1);
+    if (!temp) {
+        body->truncated = true;
+        return 0;
+    }
+    va_start(args, format);
+    vsnprintf(temp, n + 1, format, args);
+    va_end(args);
+    size_t written = body->append((const uint8_t*)temp, n);
+    free(temp);
+    return written;
+}
+
+size_t HtmlStream::write(uint8_t c) {
+    if (!body) return 0;
+    return body->append(&c, 1);
+}
+
+size_t HtmlStream::write(const uint8_t* data, size_t size) {
+    if (!body) return 0;
+    return body->append(data, size);
+}
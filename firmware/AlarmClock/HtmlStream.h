@@ -0,0 +1,126 @@
+#ifndef HTML_STREAM_H
+#define HTML_STREAM_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <functional>
+#include <memory>
+
+#define HTML_CHUNK_SIZE      1024   // Formatted text is held in blocks of this size until sent
+#define HTML_PAGE_MAX        65536  // Buffered text past this turns the page into a 500
+#define HTML_FORMAT_SIZE     256    // printf() fragments up to this size avoid the heap
+#define HTML_ROW_MAX         1024   // Longest row a sendRows() writer may print
+
+// Prints text with & < > " ' written as entities, for names that come
+// from files or forms, in element text and quoted attributes alike
+size_t htmlEscape(Print& out, const char* text);
+
+// Where a sendRows() writer prints its row: straight into the response
+// buffer, from the response filler. Text past HTML_ROW_MAX is dropped.
+class HtmlRowOut : public Print {
+private:
+    uint8_t* buffer;
+    size_t length;
+    size_t capacity;
+
+public:
+    HtmlRowOut(uint8_t* buffer, size_t capacity) : buffer(buffer), length(0), capacity(capacity) {}
+    size_t getLength() const { return length; }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+};
+
+// Writes row `index` of a sendRows() list. Runs on the AsyncTCP task after
+// the handler has returned, so it may only use what it captured by value
+// and data that is safe to read from any task.
+typedef std::function<void(HtmlRowOut& out, int index)> HtmlRowWriter;
+
+// Builds a page response for an async request without assembling a String.
+// Static page sections passed to sendStatic() are not copied: the page
+// keeps a pointer to them in flash and the response reads them from there.
+// Long lists go through sendRows(), which writes each row as the response
+// is sent, so a page of 250 stations holds no more than a block of them.
+// Everything else is buffered, in a list of small blocks (PSRAM when
+// present), and end() hands the list to a chunked response that frees
+// each block once it has been sent. The handler (and the app lock) is
+// released before any network I/O. A page that would buffer more than
+// HTML_PAGE_MAX bytes is answered with a 500 rather than cut off.
+class HtmlStream : public Print {
+private:
+    // Rows still to be written for a sendRows() segment
+    struct RowSource {
+        HtmlRowWriter writer;
+        int count;
+        int next;
+    };
+
+    // A run of page text: in flash (capacity 0), in the buffer that follows
+    // this header, or rows written into the body's row buffer when sent
+    struct Segment {
+        Segment* next;
+        const uint8_t* data;
+        size_t length;
+        size_t capacity;
+        RowSource* rows;
+    };
+
+    // Written by the handler, then drained by the response's filler
+    struct Body {
+        Segment* head;
+        Segment* tail;
+        size_t sent;          // Bytes of head already sent
+        size_t total;
+        bool truncated;
+        uint8_t* rowBuffer;   // Shared by all rows segments, only the head is written
+
+        Body() : head(nullptr), tail(nullptr), sent(0), total(0), truncated(false), rowBuffer(nullptr) {}
+        ~Body();
+        Segment* addSegment(size_t capacity);
+        void freeHead();
+        void freeRowBuffer();
+        size_t append(const uint8_t* data, size_t size);
+        void appendStatic(const uint8_t* data, size_t size);
+        void appendRows(int count, const HtmlRowWriter& writer);
+        bool writeRows(Segment* segment);
+        size_t fill(uint8_t* buffer, size_t maxLen);
+    };
+
+    // Page buffers allocated across all open responses (AsyncTCP task only)
+    static size_t heldBytes;
+    static size_t peakBytes;
+
+    AsyncWebServerRequest* request;
+    std::shared_ptr<Body> body;
+    const char* contentType;
+    int code;
+
+public:
+    HtmlStream(AsyncWebServerRequest* req);
+    ~HtmlStream();
+
+    void begin(int code = 200, const char* contentType = "text/html");
+    void end();
+
+    // Queue a flash-resident string by reference; it must outlive the response
+    void sendStatic(PGM_P text);
+
+    // Queue count rows, written by writer(out, 0..count-1) as they are sent
+    void sendRows(int count, HtmlRowWriter writer);
+
+    // Formats without Print::printf's heap allocation past 64 bytes
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    // Print
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+
+    static size_t getHeldBytes() { return heldBytes; }
+    static size_t getPeakBytes() { return peakBytes; }
+    static void resetPeakBytes() { peakBytes = heldBytes; }
+};
+
+#endif
@@ -0,0 +1,237 @@
+#include "JsonReader.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define JSON_READER_MAX_DEPTH 16
+
+JsonReader::JsonReader(const char* text, size_t length)
+    : pos(text), end(text + length), failed(text == nullptr), hasItems(0), depth(0) {
+}
+
+void JsonReader::skipSpace() {
+    while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) {
+        pos++;
+    }
+}
+
+bool JsonReader::peek(char c) {
+    skipSpace();
+    return !failed && pos < end && *pos == c;
+}
+
+bool JsonReader::expect(char c) {
+    if (!peek(c)) return fail();
+    pos++;
+    return true;
+}
+
+bool JsonReader::atEnd() {
+    skipSpace();
+    return !failed && pos == end;
+}
+
+// ===== CONTAINERS =====
+
+bool JsonReader::enter(char open) {
+    if (depth >= JSON_READER_MAX_DEPTH - 1 || !expect(open)) return fail();
+    depth++;
+    hasItems &= ~(1UL << depth);
+    return true;
+}
+
+bool JsonReader::nextItem(char close) {
+    if (failed) return false;
+
+    if (peek(close)) {
+        pos++;
+        depth--;
+        return false;
+    }
+
+    uint32_t bit = 1UL << depth;
+    if (hasItems & bit) {
+        if (!expect(',')) return false;
+    }
+    hasItems |= bit;
+    return true;
+}
+
+bool JsonReader::beginObject() {
+    return enter('{');
+}
+
+bool JsonReader::nextKey(char* key, size_t size) {
+    if (!nextItem('}')) return false;
+    return readString(key, size) && expect(':');
+}
+
+bool JsonReader::beginArray() {
+    return enter('[');
+}
+
+bool JsonReader::nextElement() {
+    return nextItem(']');
+}
+
+// ===== SCALARS =====
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool JsonReader::readString(char* out, size_t size) {
+    if (!expect('"')) return false;
+    if (out && size == 0) return fail();
+
+    size_t len = 0;
+    while (pos < end && *pos != '"') {
+        char c = *pos++;
+        uint32_t code = (unsigned char)c;
+
+        if (c == '\\') {
+            if (pos >= end) return fail();
+            char e = *pos++;
+            switch (e) {
+                case '"': case '\\': case '/': code = e; break;
+                case 'b': code = '\b'; break;
+                case 'f': code = '\f'; break;
+                case 'n': code = '\n'; break;
+                case 'r': code = '\r'; break;
+                case 't': code = '\t'; break;
+                case 'u': {
+                    if (end - pos < 4) return fail();
+                    code = 0;
+                    for (int i = 0; i < 4; i++) {
+                        int h = hexValue(*pos++);
+                        if (h < 0) return fail();
+                        code = (code << 4) | h;
+                    }
+                    break;
+                }
+                default:
+                    return fail();
+            }
+        } else if (code < 0x20) {
+            return fail();
+        }
+
+        // Encode as UTF-8 (surrogate pairs are kept as two 3-byte sequences)
+        char utf8[3];
+        size_t n;
+        if (code < 0x80) {
+            utf8[0] = (char)code;
+            n = 1;
+        } else if (code < 0x800) {
+            utf8[0] = (char)(0xC0 | (code >> 6));
+            utf8[1] = (char)(0x80 | (code & 0x3F));
+            n = 2;
+        } else {
+            utf8[0] = (char)(0xE0 | (code >> 12));
+            utf8[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+            utf8[2] = (char)(0x80 | (code & 0x3F));
+            n = 3;
+        }
+        // Raw multi-byte UTF-8 in the input passes through one byte at a time
+        if (c != '\\' && code >= 0x80) {
+            utf8[0] = c;
+            n = 1;
+        }
+
+        if (out) {
+            if (len + n >= size) return fail();
+            memcpy(out + len, utf8, n);
+            len += n;
+        }
+    }
+
+    if (pos >= end) return fail();
+    pos++;  // Closing quote
+    if (out) out[len] = '\0';
+    return true;
+}
+
+bool JsonReader::readNumber(double& value) {
+    skipSpace();
+    if (failed || pos >= end) return fail();
+
+    // Copy the token so strtod can't run past the body
+    char token[32];
+    size_t len = 0;
+    while (pos + len < end && len < sizeof(token) - 1 &&
+           strchr("+-0123456789.eE", pos[len])) {
+        len++;
+    }
+    if (len == 0) return fail();
+    memcpy(token, pos, len);
+    token[len] = '\0';
+
+    char* parsed;
+    value = strtod(token, &parsed);
+    if (parsed != token + len) return fail();
+    pos += len;
+    return true;
+}
+
+bool JsonReader::readInt(long& value) {
+    double number;
+    if (!readNumber(number)) return false;
+    value = (long)number;
+    return true;
+}
+
+bool JsonReader::readBool(bool& value) {
+    skipSpace();
+    if (end - pos >= 4 && strncmp(pos, "true", 4) == 0) {
+        value = true;
+        pos += 4;
+        return true;
+    }
+    if (end - pos >= 5 && strncmp(pos, "false", 5) == 0) {
+        value = false;
+        pos += 5;
+        return true;
+    }
+    return fail();
+}
+
+bool JsonReader::isNull() {
+    skipSpace();
+    if (!failed && end - pos >= 4 && strncmp(pos, "null", 4) == 0) {
+        pos += 4;
+        return true;
+    }
+    return false;
+}
+
+bool JsonReader::skipValue() {
+    skipSpace();
+    if (failed || pos >= end) return fail();
+
+    char c = *pos;
+    if (c == '"') return readString(nullptr, 0);
+    if (c == '{') {
+        if (!beginObject()) return false;
+        while (nextKey(nullptr, 0)) {
+            if (!skipValue()) return false;
+        }
+        return ok();
+    }
+    if (c == '[') {
+        if (!beginArray()) return false;
+        while (nextElement()) {
+            if (!skipValue()) return false;
+        }
+        return ok();
+    }
+    if (c == 't' || c == 'f') {
+        bool flag;
+        return readBool(flag);
+    }
+    if (isNull()) return true;
+
+    double number;
+    return readNumber(number);
+}
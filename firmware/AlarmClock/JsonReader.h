@@ -0,0 +1,60 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Pull parser for small JSON request bodies. Walks the text in place;
+// strings are copied into caller buffers, nothing is allocated. Standard
+// C/C++ only (host-testable like AlarmSchedule).
+//
+//   JsonReader in(body, length);
+//   char key[16];
+//   if (in.beginObject()) {
+//       while (in.nextKey(key, sizeof(key))) {
+//           if (strcmp(key, "volume") == 0) in.readInt(volume);
+//           else in.skipValue();
+//       }
+//   }
+//   if (!in.ok()) ... reject
+class JsonReader {
+private:
+    const char* pos;
+    const char* end;
+    bool failed;
+    uint32_t hasItems;   // Bit per nesting level: next item must be preceded by ','
+    uint8_t depth;
+
+    void skipSpace();
+    bool expect(char c);
+    bool peek(char c);
+    bool enter(char open);
+    bool nextItem(char close);
+    bool fail() { failed = true; return false; }
+
+public:
+    JsonReader(const char* text, size_t length);
+
+    // Containers: begin*() consumes the opening bracket. nextKey()/nextElement()
+    // return false (consuming the closing bracket) once the container ends.
+    bool beginObject();
+    bool nextKey(char* key, size_t size);
+    bool beginArray();
+    bool nextElement();
+
+    // Scalars. A string that doesn't fit the buffer is an error, not truncated
+    // (out == nullptr discards it).
+    bool readString(char* out, size_t size);
+    bool readNumber(double& value);
+    bool readInt(long& value);
+    bool readBool(bool& value);
+    bool isNull();           // Consumes a null if one is next
+    bool skipValue();
+
+    // False after any syntax error; all later calls fail too
+    bool ok() const { return !failed; }
+    // True when only whitespace is left (call after the top-level value)
+    bool atEnd();
+};
+
+#endif
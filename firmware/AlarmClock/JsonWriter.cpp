@@ -0,0 +1,105 @@
+#include "JsonWriter.h"
+#include <math.h>
+
+JsonWriter::JsonWriter(Print& output)
+    : out(output), hasItems(0), depth(0), afterKey(false) {
+}
+
+void JsonWriter::separator() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    uint32_t bit = 1UL << depth;
+    if (hasItems & bit) out.write(',');
+    hasItems |= bit;
+}
+
+void JsonWriter::push(char open) {
+    separator();
+    out.write(open);
+    if (depth < JSON_MAX_DEPTH - 1) depth++;
+    hasItems &= ~(1UL << depth);
+}
+
+void JsonWriter::pop(char close) {
+    out.write(close);
+    if (depth > 0) depth--;
+    afterKey = false;
+}
+
+void JsonWriter::key(const char* name) {
+    separator();
+    writeString(name);
+    out.write(':');
+    afterKey = true;
+}
+
+void JsonWriter::value(const char* text) {
+    separator();
+    writeString(text);
+}
+
+void JsonWriter::writeString(const char* text) {
+    out.write('"');
+    if (text) {
+        // Write unescaped runs in one call, escapes individually
+        const char* run = text;
+        for (const char* p = text; *p; p++) {
+            unsigned char c = *p;
+            if (c != '"' && c != '\\' && c >= 0x20) continue;
+
+            if (p > run) out.write((const uint8_t*)run, p - run);
+            switch (c) {
+                case '"':  out.print("\\\""); break;
+                case '\\': out.print("\\\\"); break;
+                case '\n': out.print("\\n"); break;
+                case '\r': out.print("\\r"); break;
+                case '\t': out.print("\\t"); break;
+                default: {
+                    char escape[8];
+                    snprintf(escape, sizeof(escape), "\\u%04x", c);
+                    out.print(escape);
+                }
+            }
+            run = p + 1;
+        }
+        out.print(run);
+    }
+    out.write('"');
+}
+
+void JsonWriter::value(long number) {
+    separator();
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%ld", number);
+    out.print(buffer);
+}
+
+void JsonWriter::value(unsigned long number) {
+    separator();
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%lu", number);
+    out.print(buffer);
+}
+
+void JsonWriter::value(double number, int decimals) {
+    separator();
+    if (isnan(number) || isinf(number)) {
+        out.print("null");
+        return;
+    }
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, number);
+    out.print(buffer);
+}
+
+void JsonWriter::value(bool flag) {
+    separator();
+    out.print(flag ? "true" : "false");
+}
+
+void JsonWriter::nullValue() {
+    separator();
+    out.print("null");
+}
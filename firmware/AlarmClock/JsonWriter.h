@@ -0,0 +1,54 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+#define JSON_MAX_DEPTH 16
+
+// Streaming JSON serializer. Values are written straight to the Print
+// (usually an HtmlStream response), so no document or String is built.
+// Commas are inserted automatically:
+//
+//   JsonWriter json(out);
+//   json.beginObject();
+//   json.field("volume", 5);
+//   json.key("alarms"); json.beginArray(); ... json.endArray();
+//   json.endObject();
+class JsonWriter {
+private:
+    Print& out;
+    uint32_t hasItems;   // Bit per nesting level: a comma is needed before the next item
+    uint8_t depth;
+    bool afterKey;
+
+    void separator();
+    void writeString(const char* text);
+    void push(char open);
+    void pop(char close);
+
+public:
+    JsonWriter(Print& output);
+
+    void beginObject() { push('{'); }
+    void endObject() { pop('}'); }
+    void beginArray() { push('['); }
+    void endArray() { pop(']'); }
+
+    void key(const char* name);
+
+    void value(const char* text);
+    void value(const String& text) { value(text.c_str()); }
+    void value(long number);
+    void value(unsigned long number);
+    void value(int number) { value((long)number); }
+    void value(unsigned int number) { value((unsigned long)number); }
+    void value(double number, int decimals = 2);
+    void value(bool flag);
+    void nullValue();
+
+    template <typename T>
+    void field(const char* name, T v) { key(name); value(v); }
+    void field(const char* name, double v, int decimals) { key(name); value(v, decimals); }
+};
+
+#endif
@@ -0,0 +1,278 @@
+#include "MediaIndex.h"
+#include <LittleFS.h>
+
+#define MEDIA_INDEX_MAGIC   0x3158444DUL  // "MDX1"
+#define MEDIA_INDEX_VERSION 1
+
+struct MediaIndexHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint16_t entrySize;   // Catches a changed MEDIA_NAME_MAX/MEDIA_TITLE_MAX
+    uint16_t reserved;
+};
+
+MediaEntry* MediaIndex::entries = nullptr;
+int MediaIndex::entryCount = 0;
+MediaIndex::ScanState MediaIndex::state = MediaIndex::SCAN_IDLE;
+File MediaIndex::scanDir;
+unsigned long MediaIndex::lastScan = 0;
+bool MediaIndex::scanRequested = false;
+bool MediaIndex::dirty = false;
+uint8_t MediaIndex::probeBuffer[MP3_PROBE_BYTES];
+
+bool MediaIndex::begin() {
+    if (!entries) entries = (MediaEntry*)malloc(MEDIA_MAX_FILES * sizeof(MediaEntry));
+    if (!entries) {
+        Serial.println("MediaIndex: Out of memory");
+        return false;
+    }
+
+    if (load()) {
+        Serial.printf("MediaIndex: Loaded %d files from %s\n", entryCount, MEDIA_INDEX_FILE);
+    } else {
+        entryCount = 0;
+    }
+
+    // Pick up anything copied onto the filesystem since the last save
+    scanRequested = true;
+    return true;
+}
+
+// ===== PERSISTENCE =====
+
+bool MediaIndex::load() {
+    File file = LittleFS.open(MEDIA_INDEX_FILE, "r");
+    if (!file) return false;
+
+    MediaIndexHeader header;
+    if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != MEDIA_INDEX_MAGIC || header.version != MEDIA_INDEX_VERSION ||
+        header.entrySize != sizeof(MediaEntry) || header.count > MEDIA_MAX_FILES) {
+        Serial.println("MediaIndex: Index file is stale, rebuilding");
+        file.close();
+        return false;
+    }
+
+    size_t bytes = header.count * sizeof(MediaEntry);
+    bool ok = file.read((uint8_t*)entries, bytes) == bytes;
+    file.close();
+    if (!ok) return false;
+
+    entryCount = header.count;
+    for (int i = 0; i < entryCount; i++) {
+        entries[i].name[MEDIA_NAME_MAX - 1] = '\0';
+        entries[i].title[MEDIA_TITLE_MAX - 1] = '\0';
+    }
+    return true;
+}
+
+bool MediaIndex::save() {
+    File file = LittleFS.open(MEDIA_INDEX_FILE, "w");
+    if (!file) {
+        Serial.println("MediaIndex: Failed to open index file for writing");
+        return false;
+    }
+
+    MediaIndexHeader header = { MEDIA_INDEX_MAGIC, MEDIA_INDEX_VERSION,
+                                (uint16_t)entryCount, sizeof(MediaEntry), 0 };
+    size_t bytes = entryCount * sizeof(MediaEntry);
+    bool ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              file.write((const uint8_t*)entries, bytes) == bytes;
+    file.close();
+
+    if (!ok) LittleFS.remove(MEDIA_INDEX_FILE);  // Rebuilt on next boot
+    return ok;
+}
+
+// ===== BACKGROUND SCAN =====
+
+void MediaIndex::loop() {
+    if (!entries) return;
+
+    if (state == SCAN_IDLE) {
+        if (scanRequested || millis() - lastScan >= MEDIA_RESCAN_MS) {
+            startScan();
+        }
+        return;
+    }
+
+    scanStep();
+}
+
+void MediaIndex::startScan() {
+    scanRequested = false;
+    lastScan = millis();
+
+    scanDir = LittleFS.open("/mp3");
+    if (!scanDir || !scanDir.isDirectory()) {
+        // No /mp3/ at all: everything that was indexed is gone
+        scanDir = File();
+        if (entryCount > 0) {
+            entryCount = 0;
+            save();
+        }
+        return;
+    }
+
+    for (int i = 0; i < entryCount; i++) {
+        entries[i].seen = 0;
+    }
+    dirty = false;
+    state = SCAN_LISTING;
+}
+
+// One directory entry per call, so a big folder never stalls the network task
+void MediaIndex::scanStep() {
+    File file = scanDir.openNextFile();
+    if (!file) {
+        finishScan();
+        return;
+    }
+    if (file.isDirectory()) return;
+
+    const char* name = file.name();
+    // Remove the /mp3/ prefix if present
+    if (strncmp(name, "/mp3/", 5) == 0) {
+        name += 5;
+    }
+    size_t len = strlen(name);
+    if (len <= 4 || len >= MEDIA_NAME_MAX || strcasecmp(name + len - 4, ".mp3") != 0) return;
+
+    uint32_t size = file.size();
+    uint32_t modified = (uint32_t)file.getLastWrite();
+
+    MediaEntry* entry = (MediaEntry*)find(name);
+    if (entry && entry->size == size && entry->modified == modified) {
+        entry->seen = 1;
+        return;
+    }
+
+    if (!entry) {
+        int index = insertEntry(name);
+        if (index < 0) return;
+        entry = &entries[index];
+    }
+
+    unsigned long start = millis();
+    entry->size = size;
+    entry->modified = modified;
+    entry->seen = 1;
+    if (!probe(file, *entry)) {
+        Serial.printf("MediaIndex: %s is not a readable MP3\n", name);
+    }
+    Serial.printf("MediaIndex: Indexed %s (%lu ms)\n", name, millis() - start);
+    dirty = true;
+}
+
+void MediaIndex::finishScan() {
+    scanDir.close();
+    scanDir = File();
+    state = SCAN_IDLE;
+
+    // Drop files that have been deleted
+    int kept = 0;
+    for (int i = 0; i < entryCount; i++) {
+        if (entries[i].seen) {
+            if (kept != i) entries[kept] = entries[i];
+            kept++;
+        }
+    }
+    if (kept != entryCount) {
+        entryCount = kept;
+        dirty = true;
+    }
+
+    if (dirty) {
+        save();
+        Serial.printf("MediaIndex: %d files, index saved\n", entryCount);
+    }
+}
+
+// Keeps the list sorted by name so the dropdown order is stable
+int MediaIndex::insertEntry(const char* name) {
+    if (entryCount >= MEDIA_MAX_FILES) {
+        Serial.printf("MediaIndex: Full, skipping %s\n", name);
+        return -1;
+    }
+
+    int index = 0;
+    while (index < entryCount && strcasecmp(entries[index].name, name) < 0) {
+        index++;
+    }
+    memmove(&entries[index + 1], &entries[index], (entryCount - index) * sizeof(MediaEntry));
+    entryCount++;
+
+    MediaEntry& entry = entries[index];
+    memset(&entry, 0, sizeof(entry));
+    strncpy(entry.name, name, MEDIA_NAME_MAX - 1);
+    return index;
+}
+
+// Reads the ID3 tags and the first audio frame; the rest of the file is never touched
+bool MediaIndex::probe(File& file, MediaEntry& entry) {
+    entry.title[0] = '\0';
+    entry.durationMs = 0;
+    entry.bitrateKbps = 0;
+
+    uint32_t size = entry.size;
+    size_t n = file.read(probeBuffer, 10);
+    uint32_t tagSize = mp3Id3v2Size(probeBuffer, n);
+    if (tagSize >= size) return false;
+
+    if (tagSize > 0) {
+        size_t want = tagSize < sizeof(probeBuffer) ? tagSize : sizeof(probeBuffer);
+        if (file.seek(0)) {
+            n = file.read(probeBuffer, want);
+            mp3Id3v2Title(probeBuffer, n, entry.title, sizeof(entry.title));
+        }
+    }
+
+    // ID3v1 sits in the last 128 bytes and isn't audio
+    uint32_t audioBytes = size - tagSize;
+    if (size - tagSize >= MP3_ID3V1_BYTES && file.seek(size - MP3_ID3V1_BYTES)) {
+        n = file.read(probeBuffer, MP3_ID3V1_BYTES);
+        if (n == MP3_ID3V1_BYTES && memcmp(probeBuffer, "TAG", 3) == 0) {
+            audioBytes -= MP3_ID3V1_BYTES;
+            if (entry.title[0] == '\0') {
+                mp3Id3v1Title(probeBuffer, n, entry.title, sizeof(entry.title));
+            }
+        }
+    }
+
+    if (!file.seek(tagSize)) return false;
+    n = file.read(probeBuffer, sizeof(probeBuffer));
+
+    Mp3Info info;
+    if (!mp3AudioInfo(probeBuffer, n, audioBytes, info)) return false;
+    entry.durationMs = info.durationMs;
+    entry.bitrateKbps = info.bitrateKbps;
+    return true;
+}
+
+// ===== LOOKUP =====
+
+const MediaEntry* MediaIndex::get(int index) {
+    if (index < 0 || index >= entryCount) return nullptr;
+    return &entries[index];
+}
+
+const MediaEntry* MediaIndex::find(const char* name) {
+    for (int i = 0; i < entryCount; i++) {
+        if (strcmp(entries[i].name, name) == 0) return &entries[i];
+    }
+    return nullptr;
+}
+
+void MediaIndex::formatDuration(uint32_t ms, char* buffer, size_t size) {
+    uint32_t seconds = (ms + 500) / 1000;
+    if (ms == 0) {
+        buffer[0] = '\0';
+    } else if (seconds >= 3600) {
+        snprintf(buffer, size, "%lu:%02lu:%02lu", (unsigned long)(seconds / 3600),
+                 (unsigned long)(seconds / 60 % 60), (unsigned long)(seconds % 60));
+    } else {
+        snprintf(buffer, size, "%lu:%02lu", (unsigned long)(seconds / 60),
+                 (unsigned long)(seconds % 60));
+    }
+}
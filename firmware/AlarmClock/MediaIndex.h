@@ -0,0 +1,62 @@
+#ifndef MEDIA_INDEX_H
+#define MEDIA_INDEX_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "Config.h"
+#include "Mp3Probe.h"
+
+// One file in /mp3/, with what the probe found out about it
+struct MediaEntry {
+    char name[MEDIA_NAME_MAX];     // File name without the /mp3/ prefix
+    char title[MEDIA_TITLE_MAX];   // ID3 title, empty if none
+    uint32_t size;
+    uint32_t modified;             // getLastWrite(), to spot replaced files
+    uint32_t durationMs;
+    uint16_t bitrateKbps;
+    uint8_t seen;                  // Found by the scan in progress
+    uint8_t reserved;
+};
+
+// Cached listing of the MP3 files on LittleFS. The index is loaded from
+// MEDIA_INDEX_FILE at boot and kept in RAM, so the alarm page and
+// /list_mp3 no longer walk the directory on every request. loop() rescans
+// in the background, one directory entry per call; only files that are
+// new or whose size/date changed get opened and probed. Readers run under
+// the app lock, as loop() does, so entries never change under them.
+class MediaIndex {
+private:
+    enum ScanState { SCAN_IDLE, SCAN_LISTING };
+
+    static MediaEntry* entries;
+    static int entryCount;
+    static ScanState state;
+    static File scanDir;
+    static unsigned long lastScan;
+    static bool scanRequested;
+    static bool dirty;
+    static uint8_t probeBuffer[MP3_PROBE_BYTES];
+
+    static bool load();
+    static bool save();
+    static void startScan();
+    static void scanStep();
+    static void finishScan();
+    static int insertEntry(const char* name);
+    static bool probe(File& file, MediaEntry& entry);
+
+public:
+    static bool begin();
+    static void loop();
+    static void requestRescan() { scanRequested = true; }
+    static bool isScanning() { return state != SCAN_IDLE; }
+
+    static int count() { return entryCount; }
+    static const MediaEntry* get(int index);
+    static const MediaEntry* find(const char* name);
+
+    // "3:25" or "1:02:03"; empty when the duration is unknown
+    static void formatDuration(uint32_t ms, char* buffer, size_t size);
+};
+
+#endif
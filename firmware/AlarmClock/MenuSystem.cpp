@@ -5,7 +5,7 @@ MenuSystem::MenuSystem(DisplayILI9341* disp, TimeModule* time, FMRadioModule* fm
     : display(disp), timeModule(time), fmRadio(fm), 
       audio(aud), storage(stor), touchScreen(touch),
       alarmState(nullptr), uiState(nullptr),
-      stationList(nullptr), stationCount(0), wifiConnected(false) {
+      wifiConnected(false) {
 }
 
 void MenuSystem::setAlarmState(AlarmState* alarm) {
@@ -16,14 +16,6 @@ void MenuSystem::setUIState(UIState* ui) {
     uiState = ui;
 }
 
-void MenuSystem::setStationList(InternetRadioStation* stations, int count) {
-    stationList = stations;
-    stationCount = count;
-    if (audio) {
-        audio->setStationList(stations, count);
-    }
-}
-
 void MenuSystem::setWiFiStatus(bool connected) {
     wifiConnected = connected;
 }
@@ -50,12 +42,9 @@ void MenuSystem::handleTouch() {
                 delay(100);
             }
             
-            // Go to setup screen
+            // Go to setup screen (drawn over the old one by the compositor)
             uiState->currentMenu = MENU_SETUP;
             uiState->selectedItem = 0;
-            if (display) {
-                display->clear();
-            }
             uiState->needsRedraw = true;
         }
         return;
@@ -114,9 +103,6 @@ void MenuSystem::handleButtons(bool up, bool down, bool select, bool snooze, boo
         if (uiState->currentMenu == MENU_MAIN) {
             uiState->currentMenu = MENU_SETUP;
             uiState->selectedItem = 0;
-            if (display) {
-                display->clear();
-            }
         } else if (uiState->currentMenu == MENU_SETUP) {
             uiState->currentMenu = MENU_MAIN;
             uiState->selectedItem = 0;
@@ -159,35 +145,38 @@ void MenuSystem::handleButtons(bool up, bool down, bool select, bool snooze, boo
 void MenuSystem::updateDisplay() {
     if (!display || !uiState) return;
     
+    if (uiState->currentMenu == MENU_MAIN) {
+        drawMainScreen();
+        return;
+    }
+    
+    // Other screens are redrawn from scratch; the compositor sends only
+    // what actually changed, so there is no visible clear
+    display->beginFrame();
+    display->clear();
     switch (uiState->currentMenu) {
-        case MENU_MAIN:
-            drawMainScreen();
-            break;
         case MENU_SET_TIME:
-            display->clear();
             drawSetTimeScreen();
             break;
         case MENU_SET_ALARM:
-            display->clear();
             drawSetAlarmScreen();
             break;
         case MENU_FM_RADIO:
-            display->clear();
             drawFMRadioScreen();
             break;
         case MENU_STATIONS:
-            display->clear();
             drawStationsScreen();
             break;
         case MENU_SETTINGS:
-            display->clear();
             drawSettingsScreen();
             break;
         case MENU_SETUP:
-            display->clear();
             drawSetupScreen();
             break;
+        default:
+            break;
     }
+    display->endFrame();
 }
 
 void MenuSystem::saveConfig() {
@@ -348,6 +337,9 @@ void MenuSystem::handleFMRadioMenu(bool up, bool down, bool select) {
 void MenuSystem::handleStationsMenu(bool up, bool down, bool select) {
     if (!uiState) return;
     
+    int stationCount = StationTableRef().count();
+    if (stationCount == 0 && (up || down)) return;
+    
     if (up) {
         uiState->selectedItem = (uiState->selectedItem - 1 + stationCount) % stationCount;
         uiState->needsRedraw = true;
@@ -414,18 +406,13 @@ void MenuSystem::handleSetupMenu(bool up, bool down, bool select) {
 void MenuSystem::drawMainScreen() {
     if (!display || !timeModule) return;
     
-    // DON'T use the old updateTime/updateDate methods!
-    // Only use the new updateDateFormatted method
-    
-    // Get formatted strings from ezTime
-    String dateStr = timeModule->getDateString();  // "Sun, 21 Dec 2025"
-    String timeStr = timeModule->getTimeString();  // "17:06:00"
-    
-    // Update with new formatted method
-    display->updateDateFormatted(dateStr, timeStr);
+    // Everything below reads the once-per-second snapshot; text is only
+    // formatted when the display cache sees a changed field
+    const TimeSnapshot& now = timeModule->getSnapshot();
+    display->updateClockText(now);
     
     // Update analog clock
-    display->updateTime(timeModule->getHour(), timeModule->getMinute(), timeModule->getSecond());
+    display->updateTime(now.hour, now.minute, now.second);
     
     // Update alarm status (only if alarms enabled)
     if (alarmState) {
@@ -440,14 +427,27 @@ void MenuSystem::drawMainScreen() {
     // Update WiFi status
     display->updateWiFiStatus(wifiConnected);
     
-    // Display current station if playing
-    if (audio && audio->getIsPlaying()) {
-        static String lastStation = "";
-        String currentStation = audio->getCurrentStationName();
-        if (currentStation != lastStation) {
+    // Display current station, or switch progress while connecting
+    if (audio) {
+        static char lastStation[64] = "";
+        char currentStation[64] = "";
+        StreamState state = audio->getStreamState();
+        if (state == STREAM_PREBUFFERING) {
+            snprintf(currentStation, sizeof(currentStation), "Buffering %d%%",
+                     audio->getPrebufferPercent());
+        } else if (state == STREAM_RESOLVING || state == STREAM_CONNECTING) {
+            strlcpy(currentStation, "Connecting...", sizeof(currentStation));
+        } else if (state == STREAM_FAILED) {
+            // The reason alone: "Station unavailable: ..." overruns the 200px field
+            strlcpy(currentStation, audio->getStreamError(), sizeof(currentStation));
+        } else if (audio->getIsPlaying()) {
+            audio->getCurrentStationName(currentStation, sizeof(currentStation));
+        }
+        if (currentStation[0] && strcmp(currentStation, lastStation) != 0) {
             display->fillRect(10, 195, 200, 20, ILI9341_BLACK);
-            display->drawText(10, 195, currentStation.c_str(), ILI9341_YELLOW, 1);
-            lastStation = currentStation;
+            display->drawText(10, 195, currentStation,
+                              state == STREAM_FAILED ? ILI9341_RED : ILI9341_YELLOW, 1);
+            strlcpy(lastStation, currentStation, sizeof(lastStation));
         }
     }
     
@@ -540,6 +540,8 @@ void MenuSystem::drawStationsScreen() {
     
     display->drawText(60, 20, "STATIONS", ILI9341_YELLOW, 3);
     
+    StationTableRef stations;
+    int stationCount = stations.count();
     if (stationCount == 0) {
         display->drawText(40, 100, "No Stations", ILI9341_RED, 2);
         display->drawText(10, 200, "SEL: Back", ILI9341_CYAN, 1);
@@ -553,12 +555,16 @@ void MenuSystem::drawStationsScreen() {
             color = ILI9341_GREEN;
         }
         
-        String name = stationList[startIdx + i].name;
-        if (name.length() > 20) {
-            name = name.substring(0, 17) + "...";
+        // Long names are cut to 17 characters plus "..."
+        char name[21];
+        const char* full = stations.getName(startIdx + i);
+        if (strlen(full) > 20) {
+            snprintf(name, sizeof(name), "%.17s...", full);
+        } else {
+            strlcpy(name, full, sizeof(name));
         }
         
-        display->drawText(10, 60 + i * 25, name.c_str(), color, 2);
+        display->drawText(10, 60 + i * 25, name, color, 2);
     }
     
     display->drawText(10, 200, "UP/DN:Select SEL:Play", ILI9341_CYAN, 1);
@@ -583,7 +589,11 @@ void MenuSystem::drawSettingsScreen() {
     
     if (audio) {
         display->drawText(30, 150, "Audio Status:", ILI9341_WHITE, 2);
-        if (audio->getIsPlaying()) {
+        StreamState state = audio->getStreamState();
+        if (state != STREAM_IDLE && state != STREAM_PLAYING) {
+            display->drawText(30, 170, audio->getStreamStateName(),
+                              state == STREAM_FAILED ? ILI9341_RED : ILI9341_CYAN, 1);
+        } else if (audio->getIsPlaying()) {
             display->drawText(30, 170, "Playing", ILI9341_GREEN, 1);
         } else {
             display->drawText(30, 170, "Stopped", ILI9341_YELLOW, 1);
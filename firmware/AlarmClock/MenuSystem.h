@@ -9,6 +9,7 @@
 #include "StorageModule.h"
 #include "TouchScreenModule.h"
 #include "CommonTypes.h"
+#include "StationTable.h"
 
 enum MenuState {
     MENU_MAIN,
@@ -48,8 +49,6 @@ private:
     AlarmState* alarmState;
     UIState* uiState;
     
-    InternetRadioStation* stationList;
-    int stationCount;
     bool wifiConnected;
 
 public:
@@ -58,7 +57,6 @@ public:
     
     void setAlarmState(AlarmState* alarm);
     void setUIState(UIState* ui);
-    void setStationList(InternetRadioStation* stations, int count);
     void setWiFiStatus(bool connected);
     
     void handleButtons(bool up, bool down, bool select, bool snooze, bool setup);
@@ -0,0 +1,81 @@
+#include "Metrics.h"
+#include <stdarg.h>
+
+volatile uint32_t Metrics::loopCount = 0;
+volatile uint32_t Metrics::loopRate = 0;
+volatile uint32_t Metrics::alarmChecks = 0;
+unsigned long Metrics::windowStart = 0;
+
+// ===== LOOP COUNTERS =====
+
+void Metrics::countLoop() {
+    unsigned long now = millis();
+    loopCount++;
+
+    unsigned long elapsed = now - windowStart;
+    if (elapsed >= 1000) {
+        loopRate = (uint32_t)((uint64_t)loopCount * 1000 / elapsed);
+        loopCount = 0;
+        windowStart = now;
+    }
+}
+
+// ===== METRICS BUFFER =====
+
+MetricsBuffer::MetricsBuffer(char* buffer, size_t size)
+    : data(buffer), capacity(size), length(0), overflowed(false) {
+    clear();
+}
+
+void MetricsBuffer::clear() {
+    length = 0;
+    overflowed = false;
+    if (capacity > 0) data[0] = '\0';
+}
+
+size_t MetricsBuffer::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t MetricsBuffer::write(const uint8_t* buffer, size_t size) {
+    // Keep room for the terminator
+    size_t room = capacity - length - 1;
+    if (size > room) {
+        size = room;
+        overflowed = true;
+    }
+    memcpy(data + length, buffer, size);
+    length += size;
+    data[length] = '\0';
+    return size;
+}
+
+void MetricsBuffer::appendf(const char* format, ...) {
+    size_t room = capacity - length;
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(data + length, room, format, args);
+    va_end(args);
+
+    if (written < 0) return;
+    if ((size_t)written >= room) {
+        // vsnprintf truncated; keep what fit
+        length = capacity - 1;
+        overflowed = true;
+    } else {
+        length += written;
+    }
+}
+
+void MetricsBuffer::gauge(const char* name, int32_t value) {
+    appendf("# TYPE %s gauge\n%s %d\n", name, name, (int)value);
+}
+
+void MetricsBuffer::gauge(const char* name, uint32_t value) {
+    appendf("# TYPE %s gauge\n%s %u\n", name, name, (unsigned)value);
+}
+
+void MetricsBuffer::counter(const char* name, uint32_t value) {
+    appendf("# TYPE %s counter\n%s %u\n", name, name, (unsigned)value);
+}
@@ -0,0 +1,55 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// Fixed-size text sink for the /metrics response. Output past the end is
+// dropped (and flagged) rather than growing a String on the heap.
+class MetricsBuffer : public Print {
+private:
+    char* data;
+    size_t capacity;
+    size_t length;
+    bool overflowed;
+
+public:
+    MetricsBuffer(char* buffer, size_t size);
+
+    void clear();
+    const char* c_str() const { return data; }
+    size_t size() const { return length; }
+    bool hasOverflowed() const { return overflowed; }
+
+    // "# TYPE name kind" followed by "name value"
+    void gauge(const char* name, int32_t value);
+    void gauge(const char* name, uint32_t value);
+    void counter(const char* name, uint32_t value);
+
+    // Print
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+private:
+    void appendf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+// Counters bumped from the work loop and read by the metrics page
+class Metrics {
+private:
+    static volatile uint32_t loopCount;
+    static volatile uint32_t loopRate;
+    static volatile uint32_t alarmChecks;
+    static unsigned long windowStart;
+
+public:
+    // Call once per UI loop iteration; loop rate is measured over 1 s windows
+    static void countLoop();
+    static void countAlarmCheck() { alarmChecks++; }
+
+    static uint32_t getLoopRate() { return loopRate; }
+    static uint32_t getAlarmChecks() { return alarmChecks; }
+};
+
+#endif
@@ -0,0 +1,237 @@
+#include "Mp3Probe.h"
+#include <string.h>
+
+static const uint16_t BITRATES_V1_L3[16] = {
+    0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0
+};
+static const uint16_t BITRATES_V2_L3[16] = {
+    0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0
+};
+static const uint32_t SAMPLE_RATES_V1[3] = { 44100, 48000, 32000 };
+
+static uint32_t readBE32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint32_t readSyncsafe(const uint8_t* p) {
+    return ((uint32_t)(p[0] & 0x7F) << 21) | ((uint32_t)(p[1] & 0x7F) << 14) |
+           ((uint32_t)(p[2] & 0x7F) << 7) | (p[3] & 0x7F);
+}
+
+// ===== ID3 =====
+
+uint32_t mp3Id3v2Size(const uint8_t* data, size_t len) {
+    if (len < 10 || memcmp(data, "ID3", 3) != 0) return 0;
+    if (data[3] < 2 || data[3] > 4) return 0;
+
+    uint32_t size = 10 + readSyncsafe(data + 6);
+    if (data[5] & 0x10) size += 10;  // Footer (v2.4)
+    return size;
+}
+
+// Appends a code point as UTF-8; returns false when the buffer is full
+static bool appendUtf8(char* out, size_t size, size_t& pos, uint32_t code) {
+    char bytes[3];
+    size_t n;
+    if (code < 0x80) {
+        bytes[0] = (char)code;
+        n = 1;
+    } else if (code < 0x800) {
+        bytes[0] = (char)(0xC0 | (code >> 6));
+        bytes[1] = (char)(0x80 | (code & 0x3F));
+        n = 2;
+    } else {
+        bytes[0] = (char)(0xE0 | (code >> 12));
+        bytes[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        bytes[2] = (char)(0x80 | (code & 0x3F));
+        n = 3;
+    }
+    if (pos + n >= size) return false;
+    memcpy(out + pos, bytes, n);
+    pos += n;
+    return true;
+}
+
+// ID3 text frame body: encoding byte, then the string
+static bool decodeText(const uint8_t* body, size_t len, char* out, size_t size) {
+    if (len < 2 || size == 0) return false;
+
+    uint8_t encoding = body[0];
+    const uint8_t* p = body + 1;
+    const uint8_t* end = body + len;
+    size_t pos = 0;
+
+    if (encoding == 1 || encoding == 2) {
+        // UTF-16 with BOM (1) or big-endian (2); surrogate pairs are dropped
+        bool bigEndian = (encoding == 2);
+        if (encoding == 1 && end - p >= 2) {
+            bigEndian = (p[0] == 0xFE && p[1] == 0xFF);
+            if ((p[0] == 0xFF && p[1] == 0xFE) || bigEndian) p += 2;
+        }
+        for (; end - p >= 2; p += 2) {
+            uint32_t code = bigEndian ? ((p[0] << 8) | p[1]) : ((p[1] << 8) | p[0]);
+            if (code == 0) break;
+            if (code >= 0xD800 && code <= 0xDFFF) continue;
+            if (!appendUtf8(out, size, pos, code)) break;
+        }
+    } else {
+        // ISO-8859-1 (0) or UTF-8 (3)
+        for (; p < end && *p; p++) {
+            if (encoding == 3 || *p < 0x80) {
+                if (pos + 1 >= size) break;
+                out[pos++] = (char)*p;
+            } else if (!appendUtf8(out, size, pos, *p)) {
+                break;
+            }
+        }
+    }
+
+    out[pos] = '\0';
+    return pos > 0;
+}
+
+bool mp3Id3v2Title(const uint8_t* tag, size_t len, char* title, size_t size) {
+    if (mp3Id3v2Size(tag, len) == 0) return false;
+
+    uint8_t version = tag[3];
+    uint8_t flags = tag[5];
+    size_t tagEnd = mp3Id3v2Size(tag, len);
+    if (tagEnd > len) tagEnd = len;
+
+    size_t pos = 10;
+    if ((flags & 0x40) && version >= 3 && len >= 14) {
+        // Extended header: v2.4 size includes itself, v2.3 doesn't
+        pos += (version == 4) ? readSyncsafe(tag + 10) : readBE32(tag + 10) + 4;
+    }
+
+    size_t headerSize = (version == 2) ? 6 : 10;
+    while (pos + headerSize <= tagEnd) {
+        const uint8_t* frame = tag + pos;
+        if (frame[0] == 0) break;  // Padding
+
+        uint32_t frameSize;
+        bool isTitle;
+        if (version == 2) {
+            frameSize = ((uint32_t)frame[3] << 16) | (frame[4] << 8) | frame[5];
+            isTitle = memcmp(frame, "TT2", 3) == 0;
+        } else {
+            frameSize = (version == 4) ? readSyncsafe(frame + 4) : readBE32(frame + 4);
+            isTitle = memcmp(frame, "TIT2", 4) == 0;
+        }
+
+        if (isTitle) {
+            size_t available = tagEnd - (pos + headerSize);
+            return decodeText(frame + headerSize, frameSize < available ? frameSize : available,
+                              title, size);
+        }
+        pos += headerSize + frameSize;
+    }
+    return false;
+}
+
+bool mp3Id3v1Title(const uint8_t* tail, size_t len, char* title, size_t size) {
+    if (len < MP3_ID3V1_BYTES || size == 0) return false;
+    const uint8_t* tag = tail + len - MP3_ID3V1_BYTES;
+    if (memcmp(tag, "TAG", 3) != 0) return false;
+
+    // 30 bytes, ISO-8859-1, padded with spaces or zeros
+    uint8_t body[31];
+    body[0] = 0;
+    memcpy(body + 1, tag + 3, 30);
+    size_t n = 31;
+    while (n > 1 && (body[n - 1] == ' ' || body[n - 1] == 0)) n--;
+    return decodeText(body, n, title, size);
+}
+
+// ===== MPEG AUDIO =====
+
+struct FrameHeader {
+    bool mpeg1;
+    bool mono;
+    uint16_t bitrateKbps;
+    uint32_t sampleRate;
+    uint32_t samplesPerFrame;
+    uint32_t length;
+};
+
+// Layer III headers only (this is an MP3 index)
+static bool parseFrameHeader(const uint8_t* p, FrameHeader& h) {
+    if (p[0] != 0xFF || (p[1] & 0xE0) != 0xE0) return false;
+
+    uint8_t version = (p[1] >> 3) & 3;   // 3 = MPEG1, 2 = MPEG2, 0 = MPEG2.5
+    uint8_t layer = (p[1] >> 1) & 3;     // 1 = Layer III
+    uint8_t bitrateIndex = p[2] >> 4;
+    uint8_t rateIndex = (p[2] >> 2) & 3;
+    if (version == 1 || layer != 1 || bitrateIndex == 0 || bitrateIndex == 15 || rateIndex == 3) {
+        return false;
+    }
+
+    h.mpeg1 = (version == 3);
+    h.mono = ((p[3] >> 6) == 3);
+    h.bitrateKbps = h.mpeg1 ? BITRATES_V1_L3[bitrateIndex] : BITRATES_V2_L3[bitrateIndex];
+    h.sampleRate = SAMPLE_RATES_V1[rateIndex] >> (version == 3 ? 0 : version == 2 ? 1 : 2);
+    h.samplesPerFrame = h.mpeg1 ? 1152 : 576;
+
+    uint32_t padding = (p[2] >> 1) & 1;
+    h.length = (h.samplesPerFrame / 8) * h.bitrateKbps * 1000 / h.sampleRate + padding;
+    return true;
+}
+
+bool mp3AudioInfo(const uint8_t* data, size_t len, uint32_t audioBytes, Mp3Info& info) {
+    memset(&info, 0, sizeof(info));
+
+    // Find a frame whose successor (if it's in the buffer) is also a frame
+    FrameHeader h;
+    size_t pos = 0;
+    for (; pos + 4 <= len; pos++) {
+        if (!parseFrameHeader(data + pos, h)) continue;
+
+        size_t next = pos + h.length;
+        FrameHeader n;
+        if (next + 4 > len || parseFrameHeader(data + next, n)) break;
+    }
+    if (pos + 4 > len) return false;
+
+    info.sampleRate = h.sampleRate;
+    info.bitrateKbps = h.bitrateKbps;
+    const uint8_t* frame = data + pos;
+
+    // Xing/Info header sits after the side information of the first frame
+    size_t sideInfo = h.mpeg1 ? (h.mono ? 17 : 32) : (h.mono ? 9 : 17);
+    uint32_t frames = 0;
+    uint32_t bytes = 0;
+    const uint8_t* xing = frame + 4 + sideInfo;
+    const uint8_t* vbri = frame + 4 + 32;
+
+    if (xing + 16 <= data + len &&
+        (memcmp(xing, "Xing", 4) == 0 || memcmp(xing, "Info", 4) == 0)) {
+        uint32_t flags = readBE32(xing + 4);
+        const uint8_t* field = xing + 8;
+        if (flags & 1) {
+            frames = readBE32(field);
+            field += 4;
+        }
+        if ((flags & 2) && field + 4 <= data + len) {
+            bytes = readBE32(field);
+        }
+        info.vbr = (memcmp(xing, "Xing", 4) == 0);
+    } else if (vbri + 18 <= data + len && memcmp(vbri, "VBRI", 4) == 0) {
+        bytes = readBE32(vbri + 10);
+        frames = readBE32(vbri + 14);
+        info.vbr = true;
+    }
+
+    if (frames > 0) {
+        uint64_t samples = (uint64_t)frames * h.samplesPerFrame;
+        info.durationMs = (uint32_t)(samples * 1000 / h.sampleRate);
+        if (bytes == 0) bytes = audioBytes;
+        if (info.durationMs > 0) {
+            info.bitrateKbps = (uint16_t)((uint64_t)bytes * 8 / info.durationMs);
+        }
+    } else {
+        // Constant bitrate: size over rate
+        uint32_t audio = audioBytes > pos ? audioBytes - pos : 0;
+        info.durationMs = (uint32_t)((uint64_t)audio * 8 / h.bitrateKbps);
+    }
+    return true;
+}
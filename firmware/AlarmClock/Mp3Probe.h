@@ -0,0 +1,37 @@
+#ifndef MP3_PROBE_H
+#define MP3_PROBE_H
+
+// MP3 header parsing (ID3 title, bitrate, duration) with no Arduino
+// dependencies. Callers read the relevant bytes of the file and pass
+// them in, so this compiles unchanged on a host.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MP3_PROBE_BYTES 2048   // Enough after the ID3v2 tag to find a frame and its Xing/VBRI header
+#define MP3_ID3V1_BYTES 128    // Trailing ID3v1 tag
+
+struct Mp3Info {
+    uint32_t durationMs;
+    uint16_t bitrateKbps;      // Average for VBR files
+    uint32_t sampleRate;
+    bool vbr;
+};
+
+// Total size of a leading ID3v2 tag (header, body and footer), 0 if none.
+// Needs the first 10 bytes of the file.
+uint32_t mp3Id3v2Size(const uint8_t* data, size_t len);
+
+// Title (TIT2/TT2) from a leading ID3v2 tag, as UTF-8. len may cover only
+// the start of the tag; the title is usually the first frame.
+bool mp3Id3v2Title(const uint8_t* tag, size_t len, char* title, size_t size);
+
+// Title from the 128-byte ID3v1 tag at the end of the file
+bool mp3Id3v1Title(const uint8_t* tail, size_t len, char* title, size_t size);
+
+// Finds the first MPEG audio frame in data (which starts where the ID3v2
+// tag ends) and works out bitrate and duration. audioBytes is the file
+// size minus both tags, used for constant-bitrate files.
+bool mp3AudioInfo(const uint8_t* data, size_t len, uint32_t audioBytes, Mp3Info& info);
+
+#endif
@@ -0,0 +1,145 @@
+#include "NtpSync.h"
+#include <string.h>
+
+static uint32_t readBE32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void writeBE32(uint8_t* p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+// ===== PACKETS =====
+
+void ntpBuildRequest(uint8_t* packet, uint32_t cookieSeconds, uint32_t cookieFraction) {
+    memset(packet, 0, NTP_PACKET_SIZE);
+    packet[0] = (0 << 6) | (4 << 3) | 3;  // LI 0, version 4, mode 3 (client)
+    // The transmit timestamp is echoed back as the origin timestamp; it
+    // need not be the real time, so it doubles as a request cookie
+    writeBE32(packet + 40, cookieSeconds);
+    writeBE32(packet + 44, cookieFraction);
+}
+
+bool ntpParseReply(const uint8_t* packet, size_t len, uint32_t cookieSeconds,
+                   uint32_t cookieFraction, uint32_t& ntpSeconds, uint32_t& ntpFraction,
+                   uint8_t& stratum) {
+    stratum = NTP_NOT_OURS;
+    if (len < NTP_PACKET_SIZE) return false;
+
+    uint8_t leap = packet[0] >> 6;
+    uint8_t mode = packet[0] & 7;
+    if (mode != 4) return false;  // Not a server reply
+
+    // Stale or spoofed replies don't echo the request we have outstanding
+    if (readBE32(packet + 24) != cookieSeconds || readBE32(packet + 28) != cookieFraction) {
+        return false;
+    }
+
+    stratum = packet[1];
+    if (stratum == 0 || stratum > 15 || leap == 3) return false;  // Refused or unsynchronized
+
+    ntpSeconds = readBE32(packet + 40);
+    ntpFraction = readBE32(packet + 44);
+    return ntpSeconds != 0;
+}
+
+// ===== STATE MACHINE =====
+
+NtpSync::NtpSync()
+    : transport(nullptr), state(NTP_IDLE), nextAttempt(0), sentAt(0),
+      intervalMs(3600000UL), timeoutMs(1500), backoffMinMs(5000), backoffMaxMs(600000UL),
+      failures(0), requests(0), synced(false) {
+    cookie[0] = cookie[1] = 0;
+}
+
+void NtpSync::configure(uint32_t interval, uint32_t timeout, uint32_t backoffMin, uint32_t backoffMax) {
+    intervalMs = interval;
+    timeoutMs = timeout;
+    backoffMinMs = backoffMin;
+    backoffMaxMs = backoffMax;
+}
+
+void NtpSync::begin(NtpTransport& udp, uint32_t nowMs) {
+    transport = &udp;
+    requestSync(nowMs);
+}
+
+void NtpSync::requestSync(uint32_t nowMs) {
+    if (state == NTP_WAITING) return;
+    state = NTP_IDLE;
+    nextAttempt = nowMs;
+}
+
+uint32_t NtpSync::msUntilNextAttempt(uint32_t nowMs) const {
+    if (state == NTP_WAITING) return 0;
+    int32_t left = (int32_t)(nextAttempt - nowMs);
+    return left > 0 ? (uint32_t)left : 0;
+}
+
+void NtpSync::fail(uint32_t nowMs, bool serverRefused) {
+    failures++;
+
+    // 1x, 2x, 4x ... the minimum, capped; a kiss-o'-death goes straight to the cap
+    uint32_t backoff = backoffMaxMs;
+    if (!serverRefused && failures <= 16) {
+        uint64_t scaled = (uint64_t)backoffMinMs << (failures - 1);
+        if (scaled < backoffMaxMs) backoff = (uint32_t)scaled;
+    }
+
+    state = NTP_BACKOFF;
+    nextAttempt = nowMs + backoff;
+}
+
+bool NtpSync::poll(uint32_t nowMs, NtpResult& result) {
+    if (!transport) return false;
+
+    if (state != NTP_WAITING) {
+        if ((int32_t)(nowMs - nextAttempt) < 0) return false;
+
+        uint8_t packet[NTP_PACKET_SIZE];
+        cookie[0] = nowMs ^ 0x5A5A5A5AUL;
+        cookie[1] = ++requests;
+        ntpBuildRequest(packet, cookie[0], cookie[1]);
+
+        if (!transport->send(packet, sizeof(packet))) {
+            fail(nowMs, false);
+            return false;
+        }
+        state = NTP_WAITING;
+        sentAt = nowMs;
+        return false;
+    }
+
+    uint8_t packet[NTP_PACKET_SIZE + 16];  // Room for optional extension bytes we ignore
+    size_t len;
+    while ((len = transport->receive(packet, sizeof(packet))) > 0) {
+        uint32_t seconds, fraction;
+        uint8_t stratum;
+        if (ntpParseReply(packet, len, cookie[0], cookie[1], seconds, fraction, stratum)) {
+            uint32_t rtt = nowMs - sentAt;
+            uint64_t ms = ((uint64_t)fraction * 1000 >> 32) + rtt / 2;
+
+            result.unixSeconds = seconds - NTP_UNIX_OFFSET + (uint32_t)(ms / 1000);
+            result.millis = (uint16_t)(ms % 1000);
+            result.roundTripMs = rtt;
+
+            state = NTP_IDLE;
+            nextAttempt = nowMs + intervalMs;
+            failures = 0;
+            synced = true;
+            return true;
+        }
+        if (stratum == 0) {
+            fail(nowMs, true);  // Kiss-o'-death (RATE, DENY...): back off fully
+            return false;
+        }
+    }
+
+    if (nowMs - sentAt >= timeoutMs) {
+        fail(nowMs, false);
+    }
+    return false;
+}
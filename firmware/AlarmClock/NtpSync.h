@@ -0,0 +1,83 @@
+#ifndef NTP_SYNC_H
+#define NTP_SYNC_H
+
+// SNTP client as a poll()-driven state machine with no Arduino or
+// network-stack dependencies. The caller supplies the UDP socket through
+// NtpTransport and the millisecond clock through poll(), so a request
+// never blocks: poll() sends, later polls look for the answer, and a
+// timeout schedules the next attempt with exponential backoff.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define NTP_PACKET_SIZE      48
+#define NTP_UNIX_OFFSET      2208988800UL  // Seconds from 1900 to 1970
+#define NTP_NOT_OURS         0xFF          // ntpParseReply stratum for foreign packets
+
+enum NtpState {
+    NTP_IDLE,       // Waiting for the next scheduled attempt
+    NTP_WAITING,    // Request sent, waiting for the reply
+    NTP_BACKOFF     // Last attempt failed; waiting longer than usual
+};
+
+// The UDP socket (WiFiUDP on the device, a local socket on a host)
+class NtpTransport {
+public:
+    virtual ~NtpTransport() {}
+    virtual bool send(const uint8_t* packet, size_t len) = 0;
+    // Bytes of one received datagram, 0 if none is waiting
+    virtual size_t receive(uint8_t* packet, size_t size) = 0;
+};
+
+struct NtpResult {
+    uint32_t unixSeconds;   // Server time, corrected by half the round trip
+    uint16_t millis;
+    uint32_t roundTripMs;
+};
+
+class NtpSync {
+private:
+    NtpTransport* transport;
+    NtpState state;
+    uint32_t nextAttempt;
+    uint32_t sentAt;
+    uint32_t cookie[2];      // Our transmit timestamp, echoed back as origin
+    uint32_t intervalMs;
+    uint32_t timeoutMs;
+    uint32_t backoffMinMs;
+    uint32_t backoffMaxMs;
+    uint32_t failures;
+    uint32_t requests;
+    bool synced;
+
+    void fail(uint32_t nowMs, bool serverRefused);
+
+public:
+    NtpSync();
+
+    void configure(uint32_t interval, uint32_t timeout, uint32_t backoffMin, uint32_t backoffMax);
+    // First request goes out on the next poll()
+    void begin(NtpTransport& udp, uint32_t nowMs);
+    void requestSync(uint32_t nowMs);
+
+    // True when a valid reply arrived during this call
+    bool poll(uint32_t nowMs, NtpResult& result);
+
+    NtpState getState() const { return state; }
+    bool hasSynced() const { return synced; }
+    uint32_t getFailures() const { return failures; }
+    uint32_t getRequests() const { return requests; }
+    // Until the next request (0 while waiting for a reply)
+    uint32_t msUntilNextAttempt(uint32_t nowMs) const;
+};
+
+// Packet helpers, also usable by a stand-in server in host tests
+void ntpBuildRequest(uint8_t* packet, uint32_t cookieSeconds, uint32_t cookieFraction);
+// Checks mode, stratum, leap indicator and that the origin timestamp
+// echoes our cookie. stratum is set whenever the packet answers our
+// request, even if it is refused (0 = kiss-o'-death), else NTP_NOT_OURS.
+bool ntpParseReply(const uint8_t* packet, size_t len, uint32_t cookieSeconds,
+                   uint32_t cookieFraction, uint32_t& ntpSeconds, uint32_t& ntpFraction,
+                   uint8_t& stratum);
+
+#endif
@@ -0,0 +1,388 @@
+#include "PosixTz.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TZ_DEFAULT_RULE_TIME  7200   // 02:00 when a rule gives no time
+
+// ===== PARSING =====
+
+// Abbreviation: 3+ letters, or anything but '>' inside <...>
+static const char* parseName(const char* p, char* out) {
+    size_t n = 0;
+    if (*p == '<') {
+        for (p++; *p && *p != '>'; p++) {
+            if (n < TZ_NAME_MAX - 1) out[n++] = *p;
+        }
+        if (*p != '>' || n == 0) return nullptr;
+        p++;
+    } else {
+        for (; (*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'); p++) {
+            if (n < TZ_NAME_MAX - 1) out[n++] = *p;
+        }
+        if (n < 3) return nullptr;
+    }
+    out[n] = '\0';
+    return p;
+}
+
+static const char* parseNumber(const char* p, int& value, int maxValue) {
+    if (*p < '0' || *p > '9') return nullptr;
+    value = 0;
+    while (*p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
+        if (value > maxValue) return nullptr;
+    }
+    return p;
+}
+
+// [+|-]hh[:mm[:ss]] in seconds
+static const char* parseTime(const char* p, int32_t& seconds, int maxHours) {
+    int sign = 1;
+    if (*p == '+' || *p == '-') {
+        if (*p == '-') sign = -1;
+        p++;
+    }
+
+    int hours, minutes = 0, secs = 0;
+    p = parseNumber(p, hours, maxHours);
+    if (p && *p == ':') {
+        p = parseNumber(p + 1, minutes, 59);
+        if (p && *p == ':') p = parseNumber(p + 1, secs, 59);
+    }
+    if (!p) return nullptr;
+
+    seconds = sign * (int32_t)(hours * 3600 + minutes * 60 + secs);
+    return p;
+}
+
+static const char* parseRule(const char* p, TzRule& rule) {
+    int value;
+    memset(&rule, 0, sizeof(rule));
+
+    if (*p == 'J') {
+        rule.kind = TZ_RULE_JULIAN;
+        p = parseNumber(p + 1, value, 365);
+        if (!p || value < 1) return nullptr;
+        rule.day = value;
+    } else if (*p == 'M') {
+        int month, week, weekday;
+        rule.kind = TZ_RULE_MONTH;
+        p = parseNumber(p + 1, month, 12);
+        if (!p || month < 1 || *p != '.') return nullptr;
+        p = parseNumber(p + 1, week, 5);
+        if (!p || week < 1 || *p != '.') return nullptr;
+        p = parseNumber(p + 1, weekday, 6);
+        if (!p) return nullptr;
+        rule.month = month;
+        rule.week = week;
+        rule.weekday = weekday;
+    } else {
+        rule.kind = TZ_RULE_ZERO_BASED;
+        p = parseNumber(p, value, 365);
+        if (!p) return nullptr;
+        rule.day = value;
+    }
+
+    rule.time = TZ_DEFAULT_RULE_TIME;
+    if (*p == '/') p = parseTime(p + 1, rule.time, 167);  // POSIX.1-2024 allows -167..167 h
+    return p;
+}
+
+// Everything set() needs, so a bad string leaves the zone untouched
+struct TzParsed {
+    char stdName[TZ_NAME_MAX];
+    char dstName[TZ_NAME_MAX];
+    int32_t stdOffset;
+    int32_t dstOffset;
+    bool hasDst;
+    TzRule startRule;
+    TzRule endRule;
+};
+
+static bool parseSpec(const char* posix, TzParsed& out) {
+    if (!posix || strlen(posix) >= TZ_POSIX_MAX) return false;
+    memset(&out, 0, sizeof(out));
+
+    int32_t offset;
+    const char* p = parseName(posix, out.stdName);
+    if (p) p = parseTime(p, offset, 24);
+    if (!p) return false;
+    out.stdOffset = -offset;  // POSIX offsets are west of UTC
+
+    if (*p == '\0') return true;
+
+    p = parseName(p, out.dstName);
+    if (!p) return false;
+    out.hasDst = true;
+    out.dstOffset = out.stdOffset + 3600;
+    if (*p && *p != ',') {
+        p = parseTime(p, offset, 24);
+        if (!p) return false;
+        out.dstOffset = -offset;
+    }
+
+    if (*p == ',') {
+        p = parseRule(p + 1, out.startRule);
+        if (!p || *p != ',') return false;
+        p = parseRule(p + 1, out.endRule);
+        if (!p) return false;
+    } else {
+        // No rule: same default as glibc (US rules since 2007)
+        parseRule("M3.2.0", out.startRule);
+        parseRule("M11.1.0", out.endRule);
+    }
+    return *p == '\0';
+}
+
+bool posixTzValid(const char* posix) {
+    TzParsed parsed;
+    return parseSpec(posix, parsed);
+}
+
+// ===== RULE EVALUATION =====
+
+static bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+// Local days since 1970 of the day a rule picks in a year
+static long ruleDay(const TzRule& rule, int year) {
+    long jan1 = daysFromCivil(year, 1, 1);
+
+    switch (rule.kind) {
+        case TZ_RULE_JULIAN:
+            return jan1 + rule.day - 1 + (isLeapYear(year) && rule.day >= 60 ? 1 : 0);
+
+        case TZ_RULE_ZERO_BASED:
+            return jan1 + rule.day;
+
+        default: {
+            long first = daysFromCivil(year, rule.month, 1);
+            long next = rule.month == 12 ? daysFromCivil(year + 1, 1, 1)
+                                         : daysFromCivil(year, rule.month + 1, 1);
+            long day = first + (rule.weekday - dayOfWeekFromDays(first) + 7) % 7 + (rule.week - 1) * 7L;
+            while (day >= next) day -= 7;  // Week 5 = last, which may be the 4th
+            return day;
+        }
+    }
+}
+
+// Start is given in standard time, end in daylight time
+void PosixTz::yearTransitions(int year, TzTransition& start, TzTransition& end) const {
+    start.at = (time_t)ruleDay(startRule, year) * SECONDS_PER_DAY + startRule.time - stdOffset;
+    start.offset = dstOffset;
+    start.isDst = 1;
+
+    end.at = (time_t)ruleDay(endRule, year) * SECONDS_PER_DAY + endRule.time - dstOffset;
+    end.offset = stdOffset;
+    end.isDst = 0;
+}
+
+void PosixTz::buildTable() {
+    tableCount = 0;
+    tableStart = 0;
+    tableEnd = 0;
+    if (!hasDst) return;
+
+    // A 32-bit time_t ends in January 2038, before that year's first change
+    int years = TZ_TABLE_YEARS;
+    if (sizeof(time_t) < 8 && TZ_TABLE_FIRST_YEAR + years > 2038) years = 2038 - TZ_TABLE_FIRST_YEAR;
+
+    for (int i = 0; i < years; i++) {
+        TzTransition start, end;
+        yearTransitions(TZ_TABLE_FIRST_YEAR + i, start, end);
+
+        // Southern-hemisphere zones end DST before they start it
+        bool startFirst = start.at <= end.at;
+        table[tableCount++] = startFirst ? start : end;
+        table[tableCount++] = startFirst ? end : start;
+    }
+
+    tableStart = table[0].at;
+    if (sizeof(time_t) < 8) {
+        tableEnd = (time_t)0x7FFFFFFF;
+        return;
+    }
+
+    // The last entry holds until the first change of the following year
+    TzTransition start, end;
+    yearTransitions(TZ_TABLE_FIRST_YEAR + years, start, end);
+    tableEnd = start.at < end.at ? start.at : end.at;
+}
+
+// The transition in effect at utc (the last one at or before it)
+const TzTransition* PosixTz::lookup(time_t utc, TzTransition& scratch) const {
+    if (tableCount > 0 && utc >= tableStart && utc < tableEnd) {
+        int low = 0, high = tableCount - 1;
+        while (low < high) {
+            int mid = (low + high + 1) / 2;
+            if (table[mid].at <= utc) low = mid;
+            else high = mid - 1;
+        }
+        return &table[low];
+    }
+
+    // Outside the table: evaluate the rules around that year
+    time_t local = utc + stdOffset;
+    long days = (long)(local / SECONDS_PER_DAY);
+    if (local % SECONDS_PER_DAY < 0) days--;
+
+    uint16_t year;
+    uint8_t month, day;
+    civilFromDays(days, year, month, day);
+
+    // On a tie the later one wins, as in the table: a DST period that ends
+    // the moment next year's starts (all-year DST) never shows standard time
+    bool found = false;
+    for (int y = year - 1; y <= year + 1; y++) {
+        TzTransition pair[2];
+        yearTransitions(y, pair[0], pair[1]);
+        for (int i = 0; i < 2; i++) {
+            if (pair[i].at <= utc && (!found || pair[i].at >= scratch.at)) {
+                scratch = pair[i];
+                found = true;
+            }
+        }
+    }
+    return &scratch;
+}
+
+// ===== PUBLIC =====
+
+PosixTz::PosixTz() {
+    setUTC();
+}
+
+void PosixTz::setUTC() {
+    set("UTC0");
+}
+
+bool PosixTz::set(const char* posix) {
+    TzParsed parsed;
+    if (!parseSpec(posix, parsed)) return false;
+
+    strcpy(spec, posix);
+    memcpy(stdName, parsed.stdName, sizeof(stdName));
+    memcpy(dstName, parsed.dstName, sizeof(dstName));
+    stdOffset = parsed.stdOffset;
+    dstOffset = parsed.dstOffset;
+    hasDst = parsed.hasDst;
+    startRule = parsed.startRule;
+    endRule = parsed.endRule;
+
+    buildTable();
+    return true;
+}
+
+int32_t PosixTz::offsetAt(time_t utc) const {
+    if (!hasDst) return stdOffset;
+    TzTransition scratch;
+    return lookup(utc, scratch)->offset;
+}
+
+bool PosixTz::isDstAt(time_t utc) const {
+    if (!hasDst) return false;
+    TzTransition scratch;
+    return lookup(utc, scratch)->isDst != 0;
+}
+
+const char* PosixTz::nameAt(time_t utc) const {
+    return isDstAt(utc) ? dstName : stdName;
+}
+
+time_t PosixTz::toLocal(time_t utc) {
+    return utc + offsetAt(utc);
+}
+
+// Tries the offsets in force a day either side; transitions are months
+// apart, so at most one lies in between
+time_t PosixTz::localToEpoch(time_t local) {
+    int32_t before = offsetAt(local - SECONDS_PER_DAY);
+    int32_t after = offsetAt(local + SECONDS_PER_DAY);
+
+    time_t early = local - before;
+    time_t late = local - after;
+    bool earlyFits = offsetAt(early) == before;
+    bool lateFits = offsetAt(late) == after;
+
+    if (earlyFits && lateFits) return early < late ? early : late;  // Overlap: first one
+    if (lateFits) return late;
+    return early;  // Fits, or a gap: the old offset lands past the jump
+}
+
+// ===== NAMED ZONES =====
+
+struct TzNamedRule {
+    const char* name;
+    const char* posix;
+};
+
+// Current rules from tzdata for zones people are likely to configure
+static const TzNamedRule NAMED_ZONES[] = {
+    { "UTC",                 "UTC0" },
+    { "Etc/UTC",             "UTC0" },
+    { "Europe/London",       "GMT0BST,M3.5.0/1,M10.5.0" },
+    { "Europe/Dublin",       "IST-1GMT0,M10.5.0,M3.5.0/1" },
+    { "Europe/Lisbon",       "WET0WEST,M3.5.0/1,M10.5.0" },
+    { "Europe/Amsterdam",    "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Berlin",       "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Brussels",     "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Madrid",       "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Paris",        "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Rome",         "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Stockholm",    "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Athens",       "EET-2EEST,M3.5.0/3,M10.5.0/4" },
+    { "Europe/Helsinki",     "EET-2EEST,M3.5.0/3,M10.5.0/4" },
+    { "Europe/Moscow",       "MSK-3" },
+    { "America/New_York",    "EST5EDT,M3.2.0,M11.1.0" },
+    { "America/Chicago",     "CST6CDT,M3.2.0,M11.1.0" },
+    { "America/Denver",      "MST7MDT,M3.2.0,M11.1.0" },
+    { "America/Phoenix",     "MST7" },
+    { "America/Los_Angeles", "PST8PDT,M3.2.0,M11.1.0" },
+    { "America/Anchorage",   "AKST9AKDT,M3.2.0,M11.1.0" },
+    { "America/Nuuk",        "<-02>2<-01>,M3.5.0/-1,M10.5.0/0" },
+    { "America/Sao_Paulo",   "<-03>3" },
+    { "Pacific/Honolulu",    "HST10" },
+    { "Asia/Kolkata",        "IST-5:30" },
+    { "Asia/Shanghai",       "CST-8" },
+    { "Asia/Singapore",      "<+08>-8" },
+    { "Asia/Tokyo",          "JST-9" },
+    { "Australia/Adelaide",  "ACST-9:30ACDT,M10.1.0,M4.1.0/3" },
+    { "Australia/Brisbane",  "AEST-10" },
+    { "Australia/Sydney",    "AEST-10AEDT,M10.1.0,M4.1.0/3" },
+    { "Pacific/Auckland",    "NZST-12NZDT,M9.5.0,M4.1.0/3" },
+};
+
+const char* posixTzForName(const char* zoneName) {
+    if (!zoneName) return nullptr;
+    for (size_t i = 0; i < sizeof(NAMED_ZONES) / sizeof(NAMED_ZONES[0]); i++) {
+        if (strcmp(NAMED_ZONES[i].name, zoneName) == 0) return NAMED_ZONES[i].posix;
+    }
+    return nullptr;
+}
+
+const char* posixTzNamedZone(size_t index, const char** posix) {
+    if (index >= sizeof(NAMED_ZONES) / sizeof(NAMED_ZONES[0])) return nullptr;
+    if (posix) *posix = NAMED_ZONES[index].posix;
+    return NAMED_ZONES[index].name;
+}
+
+void posixTzFixed(int32_t offsetSeconds, char* out, size_t size) {
+    if (size == 0) return;
+    if (offsetSeconds == 0) {
+        snprintf(out, size, "UTC0");
+        return;
+    }
+
+    int32_t a = offsetSeconds < 0 ? -offsetSeconds : offsetSeconds;
+    int hours = a / 3600;
+    int minutes = (a % 3600) / 60;
+    char sign = offsetSeconds < 0 ? '-' : '+';
+    const char* posixSign = offsetSeconds < 0 ? "" : "-";  // POSIX counts west
+
+    if (minutes) {
+        snprintf(out, size, "<%c%02d%02d>%s%d:%02d", sign, hours, minutes, posixSign, hours, minutes);
+    } else {
+        snprintf(out, size, "<%c%02d>%s%d", sign, hours, posixSign, hours);
+    }
+}
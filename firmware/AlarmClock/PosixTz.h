@@ -0,0 +1,97 @@
+#ifndef POSIX_TZ_H
+#define POSIX_TZ_H
+
+// Timezone rules from a POSIX TZ string ("GMT0BST,M3.5.0/1,M10.5.0"), with
+// no Arduino, ezTime or network dependencies. The DST transitions for
+// TZ_TABLE_YEARS years are computed once into a sorted table, so a
+// conversion is a binary search plus an add. Times outside the table fall
+// back to evaluating the rules for that year.
+//
+// Local wall-clock times that don't exist or happen twice resolve the same
+// way every time:
+//   gap (clocks go forward)  -> shifted forward by the jump (02:30 -> 03:30)
+//   overlap (clocks go back) -> the first occurrence (still in DST)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include "AlarmSchedule.h"
+
+#define TZ_POSIX_MAX         64     // Rule string buffer, including the terminator
+#define TZ_NAME_MAX          8      // Abbreviation buffer ("BST", "+0530")
+#define TZ_TABLE_FIRST_YEAR  2024
+#define TZ_TABLE_YEARS       32     // 2024-2055: two transitions per DST year
+
+struct TzTransition {
+    time_t at;          // UTC second the new offset starts
+    int32_t offset;     // Local minus UTC, in seconds
+    uint8_t isDst;
+};
+
+enum TzRuleKind {
+    TZ_RULE_JULIAN,     // Jn: day 1-365, February 29 never counted
+    TZ_RULE_ZERO_BASED, // n: day 0-365, counting February 29
+    TZ_RULE_MONTH       // Mm.w.d: weekday d of week w of month m
+};
+
+// One end of the DST period: a day rule plus a local time of day
+struct TzRule {
+    uint8_t kind;       // TzRuleKind
+    uint8_t month;      // 1-12        (TZ_RULE_MONTH)
+    uint8_t week;       // 1-5, 5=last (TZ_RULE_MONTH)
+    uint8_t weekday;    // 0=Sunday    (TZ_RULE_MONTH)
+    uint16_t day;       // Jn 1-365 or n 0-365
+    int32_t time;       // Seconds after local midnight, may be negative or > 24h
+};
+
+class PosixTz : public LocalTimeMapping {
+private:
+    char spec[TZ_POSIX_MAX];
+    char stdName[TZ_NAME_MAX];
+    char dstName[TZ_NAME_MAX];
+    int32_t stdOffset;  // Local minus UTC, in seconds (POSIX signs are the other way)
+    int32_t dstOffset;
+    bool hasDst;
+    TzRule startRule;
+    TzRule endRule;
+    TzTransition table[TZ_TABLE_YEARS * 2];
+    int tableCount;
+    time_t tableStart;  // UTC range the table answers for
+    time_t tableEnd;
+
+    void yearTransitions(int year, TzTransition& start, TzTransition& end) const;
+    void buildTable();
+    const TzTransition* lookup(time_t utc, TzTransition& scratch) const;
+
+public:
+    PosixTz();
+
+    // Parses the rules and rebuilds the table; on failure the zone is unchanged
+    bool set(const char* posix);
+    void setUTC();
+    const char* getSpec() const { return spec; }
+
+    int32_t offsetAt(time_t utc) const;
+    bool isDstAt(time_t utc) const;
+    const char* nameAt(time_t utc) const;  // "GMT" / "BST"
+
+    time_t toLocal(time_t utc) override;
+    time_t localToEpoch(time_t local) override;
+
+    int getTransitionCount() const { return tableCount; }
+    const TzTransition& getTransition(int index) const { return table[index]; }
+};
+
+// Parses without applying (for validating input)
+bool posixTzValid(const char* posix);
+
+// Rules for a few common zone names, so they work offline; nullptr if unknown
+const char* posixTzForName(const char* zoneName);
+
+// The same table by index, for listing; nullptr past the end
+const char* posixTzNamedZone(size_t index, const char** posix);
+
+// Fixed-offset rules, e.g. 3600 -> "<+0100>-1"
+void posixTzFixed(int32_t offsetSeconds, char* out, size_t size);
+
+#endif
@@ -0,0 +1,106 @@
+#include "Profiler.h"
+
+Profiler::StageData Profiler::stages[PROF_STAGE_COUNT];
+uint32_t Profiler::cyclesPerUs = 240;
+
+static const char* const STAGE_NAMES[PROF_STAGE_COUNT] = {
+    "audio", "network", "time", "rds", "touch", "controls", "buttons", "display", "alarms"
+};
+
+void Profiler::begin() {
+    cyclesPerUs = getCpuFrequencyMhz();
+    if (cyclesPerUs == 0) cyclesPerUs = 240;
+    reset();
+}
+
+void Profiler::reset() {
+    memset(stages, 0, sizeof(stages));
+}
+
+const char* Profiler::stageName(ProfileStage stage) {
+    return (stage >= 0 && stage < PROF_STAGE_COUNT) ? STAGE_NAMES[stage] : "unknown";
+}
+
+int Profiler::bucketFor(uint32_t us) {
+    if (us < 2 * PROF_SUB_BUCKETS) return us;
+
+    int exponent = 31 - __builtin_clz(us);  // us >= 16, so exponent >= 4
+    int bucket = (exponent - 2) * PROF_SUB_BUCKETS + ((us >> (exponent - 3)) & (PROF_SUB_BUCKETS - 1));
+    return bucket < PROF_BUCKETS ? bucket : PROF_BUCKETS - 1;
+}
+
+// Lower bound of a bucket in microseconds
+uint32_t Profiler::bucketValue(int bucket) {
+    if (bucket < 2 * PROF_SUB_BUCKETS) return bucket;
+
+    int exponent = bucket / PROF_SUB_BUCKETS + 2;
+    uint32_t sub = bucket % PROF_SUB_BUCKETS;
+    return (PROF_SUB_BUCKETS + sub) << (exponent - 3);
+}
+
+void Profiler::record(ProfileStage stage, uint32_t cycles) {
+    if (stage < 0 || stage >= PROF_STAGE_COUNT) return;
+
+    uint32_t us = cycles / cyclesPerUs;
+    StageData& data = stages[stage];
+    data.buckets[bucketFor(us)]++;
+    data.count++;
+    data.totalUs += us;
+    if (us > data.maxUs) data.maxUs = us;
+}
+
+uint32_t Profiler::percentile(const StageData& data, uint32_t permille) {
+    if (data.count == 0) return 0;
+
+    uint32_t rank = (uint32_t)(((uint64_t)data.count * permille + 999) / 1000);
+    uint32_t seen = 0;
+    for (int i = 0; i < PROF_BUCKETS; i++) {
+        seen += data.buckets[i];
+        if (seen >= rank) return bucketValue(i);
+    }
+    return data.maxUs;
+}
+
+void Profiler::getStats(ProfileStage stage, ProfileStats& stats) {
+    const StageData& data = stages[stage];
+    stats.count = data.count;
+    stats.p50Us = percentile(data, 500);
+    stats.p99Us = percentile(data, 990);
+    stats.maxUs = data.maxUs;
+    stats.totalUs = data.totalUs;
+}
+
+void Profiler::writeMetrics(Print& out) {
+    // Formatted locally: Print::printf is not virtual and heap-allocates long lines
+    char line[112];
+
+    out.print("# TYPE loop_stage_latency_us summary\n");
+    for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+        ProfileStats stats;
+        getStats((ProfileStage)i, stats);
+        const char* name = STAGE_NAMES[i];
+
+        snprintf(line, sizeof(line), "loop_stage_latency_us{stage=\"%s\",quantile=\"0.5\"} %u\n", name, stats.p50Us);
+        out.print(line);
+        snprintf(line, sizeof(line), "loop_stage_latency_us{stage=\"%s\",quantile=\"0.99\"} %u\n", name, stats.p99Us);
+        out.print(line);
+        snprintf(line, sizeof(line), "loop_stage_latency_us{stage=\"%s\",quantile=\"1\"} %u\n", name, stats.maxUs);
+        out.print(line);
+        snprintf(line, sizeof(line), "loop_stage_latency_us_sum{stage=\"%s\"} %llu\n", name, (unsigned long long)stats.totalUs);
+        out.print(line);
+        snprintf(line, sizeof(line), "loop_stage_latency_us_count{stage=\"%s\"} %u\n", name, stats.count);
+        out.print(line);
+    }
+}
+
+void Profiler::dump() {
+    Serial.println("=== Loop Stage Latency (us) ===");
+    Serial.println("stage        count      p50      p99      max");
+    for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+        ProfileStats stats;
+        getStats((ProfileStage)i, stats);
+        Serial.printf("%-10s %8u %8u %8u %8u\n",
+                      STAGE_NAMES[i], stats.count, stats.p50Us, stats.p99Us, stats.maxUs);
+    }
+    Serial.println("===============================");
+}
@@ -0,0 +1,84 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// Stages of the main work loop that are timed
+enum ProfileStage {
+    PROF_AUDIO,
+    PROF_NETWORK,
+    PROF_TIME,
+    PROF_RDS,
+    PROF_TOUCH,
+    PROF_CONTROLS,
+    PROF_BUTTONS,
+    PROF_DISPLAY,
+    PROF_ALARMS,
+    PROF_STAGE_COUNT
+};
+
+// Log-linear histogram buckets: values below 16 us are exact, above that
+// each power of two is split into 8 sub-buckets (~12% resolution) up to ~16 s
+#define PROF_SUB_BUCKETS  8
+#define PROF_BUCKETS      176
+
+struct ProfileStats {
+    uint32_t count;
+    uint32_t p50Us;
+    uint32_t p99Us;
+    uint32_t maxUs;
+    uint64_t totalUs;
+};
+
+// Per-stage latency histograms fed by PROFILE_SCOPE(). Each stage is only
+// recorded from one task, so recording takes no lock; readers may see a
+// sample in flight, which is fine for diagnostics.
+class Profiler {
+private:
+    struct StageData {
+        uint32_t buckets[PROF_BUCKETS];
+        uint32_t count;
+        uint32_t maxUs;
+        uint64_t totalUs;
+    };
+
+    static StageData stages[PROF_STAGE_COUNT];
+    static uint32_t cyclesPerUs;
+
+    static int bucketFor(uint32_t us);
+    static uint32_t bucketValue(int bucket);
+    static uint32_t percentile(const StageData& data, uint32_t permille);
+
+public:
+    static void begin();
+    static void record(ProfileStage stage, uint32_t cycles);
+    static void reset();
+
+    static const char* stageName(ProfileStage stage);
+    static void getStats(ProfileStage stage, ProfileStats& stats);
+
+    // Prometheus text format, e.g. for /metrics
+    static void writeMetrics(Print& out);
+    // Human-readable table on Serial
+    static void dump();
+};
+
+// Times the enclosing block in CPU cycles
+class ProfileScope {
+private:
+    ProfileStage stage;
+    uint32_t start;
+
+public:
+    ProfileScope(ProfileStage s) : stage(s), start(ESP.getCycleCount()) {}
+    ~ProfileScope() { Profiler::record(stage, ESP.getCycleCount() - start); }
+};
+
+#if ENABLE_PROFILER
+#define PROFILE_SCOPE(stage) ProfileScope _profileScope(stage)
+#else
+#define PROFILE_SCOPE(stage) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+#include "SettingsJournal.h"
+#include <string.h>
+
+uint32_t settingsCRC(const SettingsRecord& record) {
+    const uint8_t* p = (const uint8_t*)&record;
+    size_t len = offsetof(SettingsRecord, crc);
+
+    uint32_t crc = 0xFFFFFFFFUL;
+    while (len--) {
+        crc ^= *p++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static bool recordValid(const SettingsRecord& record) {
+    return record.magic == SETTINGS_MAGIC && record.version == SETTINGS_VERSION &&
+           record.size == sizeof(SettingsData) && record.crc == settingsCRC(record);
+}
+
+SettingsJournal::SettingsJournal()
+    : store(nullptr), sequence(0), nextSlot(0), dirty(false), changedAt(0),
+      committedAt(0), committedOnce(false), quietMs(0), minIntervalMs(0), writeCount(0) {
+    memset(&current, 0, sizeof(current));
+}
+
+void SettingsJournal::setTiming(uint32_t quiet, uint32_t minInterval) {
+    quietMs = quiet;
+    minIntervalMs = minInterval;
+}
+
+bool SettingsJournal::load(SettingsSlotStore& slotStore) {
+    store = &slotStore;
+
+    SettingsRecord slots[2];
+    bool valid[2];
+    for (int i = 0; i < 2; i++) {
+        valid[i] = store->readSlot(i, slots[i]) && recordValid(slots[i]);
+    }
+
+    int newest = -1;
+    if (valid[0] && valid[1]) {
+        // Signed difference survives the sequence wrapping
+        newest = (int32_t)(slots[1].sequence - slots[0].sequence) > 0 ? 1 : 0;
+    } else if (valid[0]) {
+        newest = 0;
+    } else if (valid[1]) {
+        newest = 1;
+    }
+
+    dirty = false;
+    if (newest < 0) {
+        memset(&current, 0, sizeof(current));
+        sequence = 0;
+        nextSlot = 0;
+        return false;
+    }
+
+    current = slots[newest].data;
+    sequence = slots[newest].sequence;
+    nextSlot = 1 - newest;
+    return true;
+}
+
+void SettingsJournal::update(const SettingsData& data, uint32_t nowMs) {
+    if (memcmp(&data, &current, sizeof(current)) == 0) return;
+    current = data;
+    dirty = true;
+    changedAt = nowMs;
+}
+
+bool SettingsJournal::poll(uint32_t nowMs) {
+    if (!dirty) return false;
+    if (nowMs - changedAt < quietMs) return false;
+    if (committedOnce && nowMs - committedAt < minIntervalMs) return false;
+    return flush(nowMs);
+}
+
+bool SettingsJournal::flush(uint32_t nowMs) {
+    if (!dirty) return true;
+    if (!store) return false;
+
+    SettingsRecord record;
+    memset(&record, 0, sizeof(record));
+    record.magic = SETTINGS_MAGIC;
+    record.version = SETTINGS_VERSION;
+    record.size = sizeof(SettingsData);
+    record.sequence = sequence + 1;
+    record.data = current;
+    record.crc = settingsCRC(record);
+
+    // Counted even on failure: a failed write still costs an erase cycle
+    writeCount++;
+    committedAt = nowMs;
+    committedOnce = true;
+    if (!store->writeSlot(nextSlot, record)) return false;
+
+    sequence = record.sequence;
+    nextSlot = 1 - nextSlot;
+    dirty = false;
+    return true;
+}
@@ -0,0 +1,103 @@
+#ifndef SETTINGS_JOURNAL_H
+#define SETTINGS_JOURNAL_H
+
+// Write-coalescing store for the small settings (volume, brightness, audio
+// mode, time zone, menu config, feature flags) with no Arduino dependencies.
+//
+// Changes only touch the RAM copy. poll() commits them as one record once
+// the values have been quiet for quietMs, and never more often than once
+// per minIntervalMs, so dragging the volume pot costs one flash write
+// instead of one every few seconds. flush() commits immediately (explicit
+// saves, shutdown).
+//
+// Records alternate between two slots, each with a sequence number and a
+// CRC. A commit overwrites the older slot, so losing power mid-write still
+// leaves the previous commit intact, and load() picks the newest valid one.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SETTINGS_MAGIC   0x31474653UL  // "SFG1"
+#define SETTINGS_VERSION 1
+
+// Bits in SettingsData::savedMask: which values were ever saved, so the
+// load functions can still hand back their caller's default
+enum SettingsField {
+    SETTING_VOLUME      = 1 << 0,
+    SETTING_BRIGHTNESS  = 1 << 1,
+    SETTING_AUDIO_MODE  = 1 << 2,
+    SETTING_TIMEZONE    = 1 << 3,
+    SETTING_CONFIG      = 1 << 4,
+    SETTING_FEATURES    = 1 << 5
+};
+
+struct SettingsData {
+    uint16_t savedMask;
+    uint8_t volume;
+    uint8_t brightness;
+    uint8_t useFMRadio;
+    uint8_t alarmHour;
+    uint8_t alarmMinute;
+    uint8_t alarmEnabled;
+    int32_t gmtOffset;
+    int32_t dstOffset;
+    float fmFrequency;
+    uint16_t featureBits;   // FeatureFlags packed by StorageModule
+    uint16_t reserved;
+};
+
+struct SettingsRecord {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;          // sizeof(SettingsData) when written
+    uint32_t sequence;      // Higher = newer
+    SettingsData data;
+    uint32_t crc;           // CRC32 of everything above
+};
+
+// Where the two slots live (NVS blobs on the device, memory on a host)
+class SettingsSlotStore {
+public:
+    virtual ~SettingsSlotStore() {}
+    virtual bool readSlot(int slot, SettingsRecord& record) = 0;
+    virtual bool writeSlot(int slot, const SettingsRecord& record) = 0;
+};
+
+class SettingsJournal {
+private:
+    SettingsSlotStore* store;
+    SettingsData current;
+    uint32_t sequence;
+    int nextSlot;
+    bool dirty;
+    uint32_t changedAt;
+    uint32_t committedAt;
+    bool committedOnce;
+    uint32_t quietMs;
+    uint32_t minIntervalMs;
+    uint32_t writeCount;
+
+public:
+    SettingsJournal();
+
+    void setTiming(uint32_t quiet, uint32_t minInterval);
+
+    // Reads both slots; false if neither holds a valid record (first boot)
+    bool load(SettingsSlotStore& slotStore);
+
+    const SettingsData& get() const { return current; }
+    // Takes a changed copy of get(); no-op when nothing differs
+    void update(const SettingsData& data, uint32_t nowMs);
+
+    // Commits if the quiet period and rate limit allow; true if it wrote
+    bool poll(uint32_t nowMs);
+    bool flush(uint32_t nowMs);
+
+    bool isDirty() const { return dirty; }
+    uint32_t getWriteCount() const { return writeCount; }
+    uint32_t getSequence() const { return sequence; }
+};
+
+uint32_t settingsCRC(const SettingsRecord& record);
+
+#endif
@@ -0,0 +1,327 @@
+#include "StationCatalog.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef ESP_PLATFORM
+#include <unistd.h>   // fsync: LittleFS only commits to flash on sync/close
+#endif
+
+#define CATALOG_COPY_CHUNK 16   // Entries read per fread() when loading
+
+static uint32_t dataStart(uint16_t capacity) {
+    return sizeof(CatalogHeader) + (uint32_t)capacity * sizeof(CatalogEntry);
+}
+
+StationCatalog::StationCatalog() : file(nullptr), slots(nullptr), live(0) {
+    path[0] = '\0';
+    memset(&header, 0, sizeof(header));
+}
+
+StationCatalog::~StationCatalog() {
+    close();
+}
+
+bool StationCatalog::open(const char* filePath) {
+    close();
+    strncpy(path, filePath, sizeof(path) - 1);
+    path[sizeof(path) - 1] = '\0';
+
+    file = fopen(path, "r+b");
+    if (file && load()) return true;
+
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+    return create(CATALOG_DEFAULT_CAPACITY);
+}
+
+void StationCatalog::close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+    free(slots);
+    slots = nullptr;
+    live = 0;
+}
+
+void StationCatalog::commit() {
+    fflush(file);
+#ifdef ESP_PLATFORM
+    fsync(fileno(file));
+#endif
+}
+
+// ===== FILE LAYOUT =====
+
+bool StationCatalog::create(uint16_t capacity) {
+    close();
+    file = fopen(path, "w+b");
+    if (!file) return false;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = CATALOG_MAGIC;
+    header.version = CATALOG_VERSION;
+    header.capacity = capacity;
+    header.poolEnd = dataStart(capacity);
+
+    slots = (uint16_t*)malloc(capacity * sizeof(uint16_t));
+    if (!slots || !writeHeader()) {
+        close();
+        return false;
+    }
+
+    // Unused slots are never read, but write them so the pool starts on real bytes
+    CatalogEntry empty = { CATALOG_TOMBSTONE, 0, 0 };
+    for (int i = 0; i < capacity; i++) {
+        if (!writeEntry(i, empty)) {
+            close();
+            return false;
+        }
+    }
+
+    commit();
+    return true;
+}
+
+bool StationCatalog::load() {
+    if (fseek(file, 0, SEEK_SET) != 0 ||
+        fread(&header, sizeof(header), 1, file) != 1) return false;
+
+    if (header.magic != CATALOG_MAGIC || header.version != CATALOG_VERSION ||
+        header.capacity == 0 || header.capacity > CATALOG_MAX_CAPACITY ||
+        header.used > header.capacity || header.poolEnd < dataStart(header.capacity)) {
+        return false;
+    }
+
+    slots = (uint16_t*)malloc(header.capacity * sizeof(uint16_t));
+    if (!slots) return false;
+
+    // The live count is rebuilt from the index rather than trusted from the
+    // header, so an interrupted delete can't leave the two disagreeing
+    live = 0;
+    CatalogEntry chunk[CATALOG_COPY_CHUNK];
+    for (int base = 0; base < header.used; base += CATALOG_COPY_CHUNK) {
+        int n = header.used - base;
+        if (n > CATALOG_COPY_CHUNK) n = CATALOG_COPY_CHUNK;
+        if (fread(chunk, sizeof(CatalogEntry), n, file) != (size_t)n) return false;
+
+        for (int i = 0; i < n; i++) {
+            const CatalogEntry& e = chunk[i];
+            if (e.offset == CATALOG_TOMBSTONE) continue;
+            if (e.offset < dataStart(header.capacity) ||
+                e.offset + e.nameLen + e.urlLen > header.poolEnd) continue;  // Torn write
+            slots[live++] = base + i;
+        }
+    }
+    return true;
+}
+
+bool StationCatalog::readEntry(int slot, CatalogEntry& entry) {
+    long pos = sizeof(CatalogHeader) + (long)slot * sizeof(CatalogEntry);
+    return fseek(file, pos, SEEK_SET) == 0 && fread(&entry, sizeof(entry), 1, file) == 1;
+}
+
+bool StationCatalog::writeEntry(int slot, const CatalogEntry& entry) {
+    long pos = sizeof(CatalogHeader) + (long)slot * sizeof(CatalogEntry);
+    return fseek(file, pos, SEEK_SET) == 0 && fwrite(&entry, sizeof(entry), 1, file) == 1;
+}
+
+bool StationCatalog::writeHeader() {
+    return fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+bool StationCatalog::appendStrings(const char* name, const char* url, CatalogEntry& entry) {
+    size_t nameLen = strlen(name);
+    size_t urlLen = strlen(url);
+    if (nameLen == 0 || nameLen >= CATALOG_NAME_MAX || urlLen >= CATALOG_URL_MAX) return false;
+
+    if (fseek(file, header.poolEnd, SEEK_SET) != 0 ||
+        fwrite(name, 1, nameLen, file) != nameLen ||
+        fwrite(url, 1, urlLen, file) != urlLen) return false;
+
+    entry.offset = header.poolEnd;
+    entry.nameLen = nameLen;
+    entry.urlLen = urlLen;
+    header.poolEnd += nameLen + urlLen;
+    return true;
+}
+
+// ===== ACCESS =====
+
+bool StationCatalog::get(int index, char* name, size_t nameSize, char* url, size_t urlSize) {
+    if (!file || index < 0 || index >= live || nameSize == 0 || urlSize == 0) return false;
+
+    CatalogEntry entry;
+    if (!readEntry(slots[index], entry)) return false;
+
+    size_t n = entry.nameLen < nameSize - 1 ? entry.nameLen : nameSize - 1;
+    size_t u = entry.urlLen < urlSize - 1 ? entry.urlLen : urlSize - 1;
+
+    if (fseek(file, entry.offset, SEEK_SET) != 0 || fread(name, 1, n, file) != n) return false;
+    if (n < entry.nameLen && fseek(file, entry.offset + entry.nameLen, SEEK_SET) != 0) return false;
+    if (fread(url, 1, u, file) != u) return false;
+
+    name[n] = '\0';
+    url[u] = '\0';
+    return true;
+}
+
+bool StationCatalog::getLengths(int index, size_t& nameLen, size_t& urlLen) {
+    if (!file || index < 0 || index >= live) return false;
+
+    CatalogEntry entry;
+    if (!readEntry(slots[index], entry)) return false;
+    nameLen = entry.nameLen;
+    urlLen = entry.urlLen;
+    return true;
+}
+
+// ===== CHANGES =====
+
+bool StationCatalog::add(const char* name, const char* url) {
+    if (!file) return false;
+
+    if (header.used >= header.capacity) {
+        // Reclaim tombstones first; grow only if the index is really full
+        uint16_t capacity = header.capacity;
+        if (live >= capacity / 2) capacity = capacity * 2;
+        if (capacity > CATALOG_MAX_CAPACITY) capacity = CATALOG_MAX_CAPACITY;
+        if (live >= capacity || !rewrite(capacity)) return false;
+    }
+
+    // Strings first, then the slot, then the header that makes it count
+    CatalogEntry entry;
+    int slot = header.used;
+    if (!appendStrings(name, url, entry) || !writeEntry(slot, entry)) return false;
+
+    header.used++;
+    if (!writeHeader()) return false;
+    slots[live++] = slot;
+
+    commit();
+    return true;
+}
+
+bool StationCatalog::update(int index, const char* name, const char* url) {
+    if (!file || index < 0 || index >= live) return false;
+
+    CatalogEntry old, entry;
+    if (!readEntry(slots[index], old) ||
+        !appendStrings(name, url, entry) ||
+        !writeEntry(slots[index], entry)) return false;
+
+    header.garbage += old.nameLen + old.urlLen;
+    writeHeader();
+    commit();
+
+    compactIfWasteful();
+    return true;
+}
+
+bool StationCatalog::remove(int index) {
+    if (!file || index < 0 || index >= live) return false;
+
+    CatalogEntry entry;
+    if (!readEntry(slots[index], entry)) return false;
+    header.garbage += entry.nameLen + entry.urlLen;
+
+    entry.offset = CATALOG_TOMBSTONE;
+    if (!writeEntry(slots[index], entry)) return false;
+    writeHeader();
+    commit();
+
+    memmove(&slots[index], &slots[index + 1], (live - index - 1) * sizeof(uint16_t));
+    live--;
+
+    compactIfWasteful();
+    return true;
+}
+
+bool StationCatalog::clear() {
+    return create(CATALOG_DEFAULT_CAPACITY);
+}
+
+// ===== COMPACTION =====
+
+void StationCatalog::compactIfWasteful() {
+    uint32_t pool = header.poolEnd - dataStart(header.capacity);
+    int tombstones = header.used - live;
+
+    if ((header.garbage > 1024 && header.garbage * 2 > pool) ||
+        tombstones > header.capacity / 2) {
+        compact();
+    }
+}
+
+bool StationCatalog::compact() {
+    if (!file) return false;
+    return rewrite(header.capacity);
+}
+
+// Copies the live stations, in order, into a fresh file and swaps it in
+bool StationCatalog::rewrite(uint16_t capacity) {
+    if (capacity < live) return false;
+
+    char tmpPath[sizeof(path) + 4];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+    FILE* out = fopen(tmpPath, "w+b");
+    if (!out) return false;
+
+    CatalogHeader fresh;
+    memset(&fresh, 0, sizeof(fresh));
+    fresh.magic = CATALOG_MAGIC;
+    fresh.version = CATALOG_VERSION;
+    fresh.capacity = capacity;
+    fresh.used = live;
+    fresh.poolEnd = dataStart(capacity);
+
+    // Index first: offsets follow from the string lengths
+    bool ok = fwrite(&fresh, sizeof(fresh), 1, out) == 1;
+    for (int i = 0; ok && i < capacity; i++) {
+        CatalogEntry entry = { CATALOG_TOMBSTONE, 0, 0 };
+        if (i < live) {
+            ok = readEntry(slots[i], entry);
+            entry.offset = fresh.poolEnd;
+            fresh.poolEnd += entry.nameLen + entry.urlLen;
+        }
+        ok = ok && fwrite(&entry, sizeof(entry), 1, out) == 1;
+    }
+
+    // Then the strings, in the same order
+    char buffer[CATALOG_NAME_MAX + CATALOG_URL_MAX];
+    for (int i = 0; ok && i < live; i++) {
+        CatalogEntry entry;
+        ok = readEntry(slots[i], entry);
+        size_t len = entry.nameLen + entry.urlLen;
+        ok = ok && len <= sizeof(buffer) &&
+             fseek(file, entry.offset, SEEK_SET) == 0 &&
+             fread(buffer, 1, len, file) == len &&
+             fwrite(buffer, 1, len, out) == len;
+    }
+
+    // Header again, now that poolEnd is known
+    ok = ok && fseek(out, 0, SEEK_SET) == 0 &&
+         fwrite(&fresh, sizeof(fresh), 1, out) == 1 &&
+         fflush(out) == 0;
+    fclose(out);
+    if (!ok) {
+        ::remove(tmpPath);
+        return false;
+    }
+
+    fclose(file);
+    file = nullptr;
+    if (rename(tmpPath, path) != 0) {
+        // Some filesystems won't rename over an existing file
+        ::remove(path);
+        rename(tmpPath, path);
+    }
+
+    free(slots);
+    slots = nullptr;
+    live = 0;
+    file = fopen(path, "r+b");
+    return file && load();
+}
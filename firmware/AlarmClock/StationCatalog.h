@@ -0,0 +1,94 @@
+#ifndef STATION_CATALOG_H
+#define STATION_CATALOG_H
+
+// Internet station list kept in one LittleFS file, read through stdio
+// (LittleFS is mounted into the ESP-IDF VFS), so this file has no Arduino
+// dependencies and runs unchanged on a host against a temp file.
+//
+// File layout (little-endian, as both the ESP32 and a PC are):
+//   CatalogHeader
+//   CatalogEntry[capacity]     fixed-size index, one slot per station
+//   string pool                name bytes followed by url bytes, no terminators
+//
+// Adding appends to the pool and fills the next free slot. Deleting writes
+// a tombstone into the slot (O(1), nothing moves on flash). Updating
+// appends the new strings and repoints the slot. Dead pool bytes and
+// tombstones are squeezed out by compact(), which runs automatically when
+// they make up most of the file or the index is full.
+//
+// Stations are addressed by position among the live entries, so deleting
+// station 2 makes the old station 3 the new station 2 (as before).
+// Only the slot map (2 bytes per station) lives in RAM; names and URLs are
+// read from the file on demand.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define CATALOG_MAGIC            0x31435453UL  // "STC1"
+#define CATALOG_VERSION          1
+#define CATALOG_DEFAULT_CAPACITY 32            // Index slots in a new file; doubles when full
+#define CATALOG_MAX_CAPACITY     1024
+#define CATALOG_NAME_MAX         64            // Buffer sizes including the terminator
+#define CATALOG_URL_MAX          256
+#define CATALOG_TOMBSTONE        0xFFFFFFFFUL  // Entry offset of a deleted slot
+
+struct CatalogHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t capacity;   // Index slots
+    uint16_t used;       // Slots filled so far (live + tombstones)
+    uint16_t reserved;
+    uint32_t poolEnd;    // File offset where the next strings go
+    uint32_t garbage;    // Pool bytes no longer referenced
+};
+
+struct CatalogEntry {
+    uint32_t offset;     // File offset of the name, or CATALOG_TOMBSTONE
+    uint16_t nameLen;
+    uint16_t urlLen;
+};
+
+class StationCatalog {
+private:
+    FILE* file;
+    char path[64];
+    CatalogHeader header;
+    uint16_t* slots;     // Live index -> slot
+    int live;
+
+    bool create(uint16_t capacity);
+    bool load();
+    bool readEntry(int slot, CatalogEntry& entry);
+    bool writeEntry(int slot, const CatalogEntry& entry);
+    bool writeHeader();
+    bool appendStrings(const char* name, const char* url, CatalogEntry& entry);
+    bool rewrite(uint16_t capacity);
+    void compactIfWasteful();
+    void commit();
+
+public:
+    StationCatalog();
+    ~StationCatalog();
+
+    // Opens the catalog, creating an empty one if the file is missing or bad
+    bool open(const char* filePath);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    int count() const { return live; }
+    bool get(int index, char* name, size_t nameSize, char* url, size_t urlSize);
+    bool getLengths(int index, size_t& nameLen, size_t& urlLen);  // Index only, no string reads
+
+    bool add(const char* name, const char* url);
+    bool update(int index, const char* name, const char* url);
+    bool remove(int index);
+    bool clear();
+
+    // Rewrites the file without tombstones or dead strings
+    bool compact();
+    uint32_t getFileSize() const { return header.poolEnd; }
+    uint32_t getGarbageBytes() const { return header.garbage; }
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include "StationTable.h"
+#include <new>
+
+// Guards the published pointer and every reference count
+static portMUX_TYPE tableMux = portMUX_INITIALIZER_UNLOCKED;
+static StationTable* published = nullptr;
+static uint32_t publishedVersion = 0;
+
+StationTable* StationTable::build(int capacity, size_t textBytes) {
+    if (capacity < 0) return nullptr;
+
+    // Header, entries and strings (plus a terminator each) in one block
+    size_t textSize = textBytes + 2 * capacity;
+    size_t bytes = sizeof(StationTable) + capacity * sizeof(StationEntry) + textSize;
+    uint8_t* block = (uint8_t*)malloc(bytes);
+    if (!block) {
+        Serial.printf("StationTable: no memory for %u bytes\n", (unsigned)bytes);
+        return nullptr;
+    }
+
+    StationTable* table = new (block) StationTable();
+    table->refs = 1;
+    table->capacity = capacity;
+    table->entryCount = 0;
+    table->entries = (StationEntry*)(block + sizeof(StationTable));
+    table->text = (char*)(table->entries + capacity);
+    table->textSize = textSize;
+    table->textUsed = 0;
+    return table;
+}
+
+StationText StationTable::copyText(const char* s) {
+    StationText slice;
+    size_t len = strlen(s);
+
+    slice.data = text + textUsed;
+    slice.length = len;
+    memcpy(text + textUsed, s, len + 1);
+    textUsed += len + 1;
+    return slice;
+}
+
+bool StationTable::add(const char* name, const char* url) {
+    size_t needed = strlen(name) + strlen(url) + 2;
+    if (entryCount >= capacity || textUsed + needed > textSize) return false;
+
+    StationEntry& entry = entries[entryCount];
+    entry.name = copyText(name);
+    entry.url = copyText(url);
+    entryCount++;
+    return true;
+}
+
+const StationEntry* StationTable::get(int index) const {
+    if (index < 0 || index >= entryCount) return nullptr;
+    return &entries[index];
+}
+
+const char* StationTable::getName(int index) const {
+    const StationEntry* entry = get(index);
+    return entry ? entry->name.data : "";
+}
+
+const char* StationTable::getUrl(int index) const {
+    const StationEntry* entry = get(index);
+    return entry ? entry->url.data : "";
+}
+
+// ===== SHARING =====
+
+void StationTable::publish(StationTable* table) {
+    portENTER_CRITICAL(&tableMux);
+    StationTable* old = published;
+    published = table;
+    publishedVersion++;
+    portEXIT_CRITICAL(&tableMux);
+
+    if (old) old->release();
+    Serial.printf("StationTable: %d stations published\n", table ? table->count() : 0);
+}
+
+StationTable* StationTable::acquire() {
+    portENTER_CRITICAL(&tableMux);
+    StationTable* table = published;
+    if (table) table->refs++;
+    portEXIT_CRITICAL(&tableMux);
+    return table;
+}
+
+std::shared_ptr<const StationTable> StationTable::acquireShared() {
+    StationTable* table = acquire();
+    if (!table) return std::shared_ptr<const StationTable>();
+    return std::shared_ptr<const StationTable>(table, [](StationTable* held) { held->release(); });
+}
+
+void StationTable::release() {
+    portENTER_CRITICAL(&tableMux);
+    int left = --refs;
+    portEXIT_CRITICAL(&tableMux);
+
+    // Freed outside the critical section; nobody else can reach it now
+    if (left == 0) {
+        this->~StationTable();
+        free(this);
+    }
+}
+
+uint32_t StationTable::getVersion() {
+    portENTER_CRITICAL(&tableMux);
+    uint32_t version = publishedVersion;
+    portEXIT_CRITICAL(&tableMux);
+    return version;
+}
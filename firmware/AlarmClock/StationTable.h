@@ -0,0 +1,85 @@
+#ifndef STATION_TABLE_H
+#define STATION_TABLE_H
+
+#include <Arduino.h>
+#include <memory>
+
+// A name or URL inside a StationTable: points into the table's arena,
+// NUL-terminated so it can also be used as a C string
+struct StationText {
+    const char* data;
+    uint16_t length;
+};
+
+struct StationEntry {
+    StationText name;
+    StationText url;
+};
+
+// Immutable list of internet stations shared by the menu, audio, web and
+// alarm code. Entries and all their strings live in one allocation, so
+// building a table costs one malloc however many stations there are.
+//
+// A table is filled once with add() and then published; after that it is
+// read-only and can be used from any task. When the stations change, a
+// new table is built and published in its place. Readers hold a reference
+// (StationTableRef) while they use one, and the old table is freed when
+// the last reader lets go, so nobody ever sees a half-edited list.
+class StationTable {
+private:
+    volatile int refs;
+    int capacity;
+    int entryCount;
+    size_t textSize;
+    size_t textUsed;
+    StationEntry* entries;
+    char* text;
+
+    StationTable() {}
+    StationText copyText(const char* s);
+
+public:
+    // capacity stations whose names and URLs total at most textBytes
+    // (excluding terminators). Returns nullptr if out of memory.
+    static StationTable* build(int capacity, size_t textBytes);
+
+    // Only before publish(); false when capacity or text space runs out
+    bool add(const char* name, const char* url);
+
+    int count() const { return entryCount; }
+    const StationEntry* get(int index) const;
+    const char* getName(int index) const;   // "" when out of range
+    const char* getUrl(int index) const;
+
+    // Makes table the current list (taking over the caller's reference)
+    static void publish(StationTable* table);
+    // Current list with a reference held, or nullptr before the first publish
+    static StationTable* acquire();
+    void release();
+    // acquire() for callbacks that outlive the caller (a page still being
+    // sent): released when the last copy goes; empty before the first publish
+    static std::shared_ptr<const StationTable> acquireShared();
+    // Increments on every publish, so caches can tell when to refresh
+    static uint32_t getVersion();
+};
+
+// Holds a reference to the current table for as long as it is in scope
+class StationTableRef {
+private:
+    StationTable* table;
+
+public:
+    StationTableRef() : table(StationTable::acquire()) {}
+    ~StationTableRef() { if (table) table->release(); }
+
+    int count() const { return table ? table->count() : 0; }
+    const StationEntry* get(int index) const { return table ? table->get(index) : nullptr; }
+    const char* getName(int index) const { return table ? table->getName(index) : ""; }
+    const char* getUrl(int index) const { return table ? table->getUrl(index) : ""; }
+
+private:
+    StationTableRef(const StationTableRef&);
+    StationTableRef& operator=(const StationTableRef&);
+};
+
+#endif
@@ -1,4 +1,14 @@
 #include "StorageModule.h"
+#include "StationTable.h"
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+
+static StorageModule* shutdownStorage = nullptr;
+
+// Runs from esp_restart(), so a restart never loses settings still in RAM
+static void flushOnShutdown() {
+    shutdownStorage->flushSettings();
+}
 
 StorageModule::StorageModule() : isInitialized(false), stationCount(0) {
     for (int i = 0; i < MAX_STATIONS; i++) {
@@ -7,10 +17,17 @@ StorageModule::StorageModule() : isInitialized(false), stationCount(0) {
     }
 }
 
+StorageModule::~StorageModule() {
+    if (shutdownStorage == this) {
+        esp_unregister_shutdown_handler(flushOnShutdown);
+        shutdownStorage = nullptr;
+    }
+}
+
 bool StorageModule::begin() {
     // Initialize LittleFS
     Serial.println("Before Init LittleFS");
-    if (!LittleFS.begin(true,"/spiffs")) {  // true = format if mount fails
+    if (!LittleFS.begin(true, LITTLEFS_BASE_PATH)) {  // true = format if mount fails
         Serial.println("LittleFS Mount Failed");
         return false;
     }
@@ -21,6 +38,15 @@ bool StorageModule::begin() {
     prefs.begin("alarmclock", false);  // false = read/write mode
     
     isInitialized = true;
+
+    settings.setTiming(SETTINGS_QUIET_MS, SETTINGS_MIN_INTERVAL_MS);
+    if (!settings.load(*this)) {
+        migrateLegacySettings();
+    }
+    if (!shutdownStorage) {
+        shutdownStorage = this;
+        esp_register_shutdown_handler(flushOnShutdown);
+    }
     
     // Load saved data
     uint8_t h, m;
@@ -31,6 +57,15 @@ bool StorageModule::begin() {
     Serial.println("Before Load FM Stations");
     loadFMStations();
     
+    // Only the index is read here; names and URLs are read on demand
+    unsigned long start = micros();
+    if (!stationCatalog.open(STATION_CATALOG_FILE)) {
+        Serial.println("Failed to open station catalog");
+    }
+    Serial.printf("Station catalog: %d stations, %u bytes, opened in %lu us\n",
+                  stationCatalog.count(), (unsigned)stationCatalog.getFileSize(), micros() - start);
+    migrateLegacyStations();
+    
     return true;
 }
 
@@ -38,27 +73,159 @@ bool StorageModule::isReady() {
     return isInitialized;
 }
 
-// ===== NVS CONFIGURATION (fast, small data) =====
+// ===== SETTINGS JOURNAL =====
+// The small settings are one CRC-checked record written alternately to
+// "cfg_a" and "cfg_b", replacing a dozen separate keys.
+
+static const char* const SETTINGS_SLOT_KEYS[2] = { "cfg_a", "cfg_b" };
+
+bool StorageModule::readSlot(int slot, SettingsRecord& record) {
+    const char* key = SETTINGS_SLOT_KEYS[slot];
+    return prefs.getBytesLength(key) == sizeof(record) &&
+           prefs.getBytes(key, &record, sizeof(record)) == sizeof(record);
+}
+
+bool StorageModule::writeSlot(int slot, const SettingsRecord& record) {
+    return prefs.putBytes(SETTINGS_SLOT_KEYS[slot], &record, sizeof(record)) == sizeof(record);
+}
+
+void StorageModule::loop() {
+    if (!isInitialized) return;
+    if (settings.poll(millis())) {
+        Serial.printf("Settings committed (#%lu)\n", (unsigned long)settings.getSequence());
+    }
+}
+
+bool StorageModule::flushSettings() {
+    if (!isInitialized) return false;
+    if (!settings.isDirty()) return true;
+
+    bool ok = settings.flush(millis());
+    Serial.printf("Settings %s (#%lu)\n", ok ? "committed" : "commit failed",
+                  (unsigned long)settings.getSequence());
+    return ok;
+}
+
+void StorageModule::changeSettings(const SettingsData& data) {
+    settings.update(data, millis());
+}
+
+static uint16_t packFeatures(const FeatureFlags& flags) {
+    return (flags.enableTouchScreen ? 1 << 0 : 0) |
+           (flags.enableButtons     ? 1 << 1 : 0) |
+           (flags.enableDraw        ? 1 << 2 : 0) |
+           (flags.enableAudio       ? 1 << 3 : 0) |
+           (flags.enableStereo      ? 1 << 4 : 0) |
+           (flags.enableLED         ? 1 << 5 : 0) |
+           (flags.enableAlarms      ? 1 << 6 : 0) |
+           (flags.enableWeb         ? 1 << 7 : 0) |
+           (flags.enableFMRadio     ? 1 << 8 : 0) |
+           (flags.enablePRAM        ? 1 << 9 : 0) |
+           (flags.enableI2CScan     ? 1 << 10 : 0);
+}
+
+static void unpackFeatures(uint16_t bits, FeatureFlags& flags) {
+    flags.enableTouchScreen = bits & (1 << 0);
+    flags.enableButtons = bits & (1 << 1);
+    flags.enableDraw = bits & (1 << 2);
+    flags.enableAudio = bits & (1 << 3);
+    flags.enableStereo = bits & (1 << 4);
+    flags.enableLED = bits & (1 << 5);
+    flags.enableAlarms = bits & (1 << 6);
+    flags.enableWeb = bits & (1 << 7);
+    flags.enableFMRadio = bits & (1 << 8);
+    flags.enablePRAM = bits & (1 << 9);
+    flags.enableI2CScan = bits & (1 << 10);
+}
+
+static const char* const LEGACY_SETTING_KEYS[] = {
+    "volume", "brightness", "audioMode", "gmtOffset", "dstOffset",
+    "alarmHour", "alarmMin", "alarmEnabled", "fmFreq",
+    "feat_touch", "feat_btn", "feat_draw", "feat_audio", "feat_stereo", "feat_led",
+    "feat_alarms", "feat_web", "feat_fm", "feat_pram", "feat_i2c"
+};
+
+// First boot with the journal: carry over the per-key values older
+// firmware wrote, commit them as one record and drop the keys
+void StorageModule::migrateLegacySettings() {
+    SettingsData data = settings.get();
+
+    if (prefs.isKey("volume")) {
+        data.volume = prefs.getUChar("volume", 3);
+        data.savedMask |= SETTING_VOLUME;
+    }
+    if (prefs.isKey("brightness")) {
+        data.brightness = prefs.getUChar("brightness", 200);
+        data.savedMask |= SETTING_BRIGHTNESS;
+    }
+    if (prefs.isKey("audioMode")) {
+        data.useFMRadio = prefs.getBool("audioMode", false);
+        data.savedMask |= SETTING_AUDIO_MODE;
+    }
+    if (prefs.isKey("gmtOffset")) {
+        data.gmtOffset = prefs.getLong("gmtOffset", 0);
+        data.dstOffset = prefs.getInt("dstOffset", 0);
+        data.savedMask |= SETTING_TIMEZONE;
+    }
+    if (prefs.isKey("alarmHour")) {
+        data.alarmHour = prefs.getUChar("alarmHour", 7);
+        data.alarmMinute = prefs.getUChar("alarmMin", 0);
+        data.alarmEnabled = prefs.getBool("alarmEnabled", false);
+        data.fmFrequency = prefs.getFloat("fmFreq", 98.0);
+        data.savedMask |= SETTING_CONFIG;
+    }
+    if (prefs.isKey("feat_touch")) {
+        FeatureFlags flags;
+        flags.enableTouchScreen = prefs.getBool("feat_touch", true);
+        flags.enableButtons = prefs.getBool("feat_btn", true);
+        flags.enableDraw = prefs.getBool("feat_draw", true);
+        flags.enableAudio = prefs.getBool("feat_audio", true);
+        flags.enableStereo = prefs.getBool("feat_stereo", true);
+        flags.enableLED = prefs.getBool("feat_led", true);
+        flags.enableAlarms = prefs.getBool("feat_alarms", true);
+        flags.enableWeb = prefs.getBool("feat_web", true);
+        flags.enableFMRadio = prefs.getBool("feat_fm", false);
+        flags.enablePRAM = prefs.getBool("feat_pram", true);
+        flags.enableI2CScan = prefs.getBool("feat_i2c", true);
+        data.featureBits = packFeatures(flags);
+        data.savedMask |= SETTING_FEATURES;
+    }
+
+    if (data.savedMask == 0) return;  // Fresh device: nothing to carry over
+
+    changeSettings(data);
+    if (!flushSettings()) return;     // Keep the old keys until the record is safe
+
+    for (size_t i = 0; i < sizeof(LEGACY_SETTING_KEYS) / sizeof(LEGACY_SETTING_KEYS[0]); i++) {
+        prefs.remove(LEGACY_SETTING_KEYS[i]);
+    }
+    Serial.println("Migrated settings to journal");
+}
+
+// ===== CONFIGURATION (journaled) =====
 bool StorageModule::saveConfig(uint8_t alarmHour, uint8_t alarmMin, bool alarmEnabled, float fmFreq) {
     if (!isInitialized) return false;
     
-    prefs.putUChar("alarmHour", alarmHour);
-    prefs.putUChar("alarmMin", alarmMin);
-    prefs.putBool("alarmEnabled", alarmEnabled);
-    prefs.putFloat("fmFreq", fmFreq);
-    
-    Serial.println("Config saved to NVS");
+    SettingsData data = settings.get();
+    data.alarmHour = alarmHour;
+    data.alarmMinute = alarmMin;
+    data.alarmEnabled = alarmEnabled;
+    data.fmFrequency = fmFreq;
+    data.savedMask |= SETTING_CONFIG;
+    changeSettings(data);
     return true;
 }
 
 bool StorageModule::loadConfig(uint8_t &alarmHour, uint8_t &alarmMin, bool &alarmEnabled, float &fmFreq) {
     if (!isInitialized) return false;
     
-    // Load with defaults if keys don't exist
-    alarmHour = prefs.getUChar("alarmHour", 7);
-    alarmMin = prefs.getUChar("alarmMin", 0);
-    alarmEnabled = prefs.getBool("alarmEnabled", false);
-    fmFreq = prefs.getFloat("fmFreq", 98.0);
+    // Defaults if never saved
+    const SettingsData& data = settings.get();
+    bool saved = data.savedMask & SETTING_CONFIG;
+    alarmHour = saved ? data.alarmHour : 7;
+    alarmMin = saved ? data.alarmMinute : 0;
+    alarmEnabled = saved ? data.alarmEnabled : false;
+    fmFreq = saved ? data.fmFrequency : 98.0;
     
     Serial.printf("Config loaded: Alarm %02d:%02d %s, FM %.1f\n", 
                   alarmHour, alarmMin, alarmEnabled ? "ON" : "OFF", fmFreq);
@@ -170,43 +337,45 @@ void StorageModule::clearFMStations() {
     Serial.println("All FM stations cleared");
 }
 
-// ===== INTERNET RADIO STATION STORAGE =====
-bool StorageModule::saveInternetStation(int index, const char* name, const char* url) {
-    if (!isInitialized || index < 0 || index >= MAX_INTERNET_STATIONS) return false;
-    
-    char nameKey[16], urlKey[16];
-    sprintf(nameKey, "inet_n_%d", index);
-    sprintf(urlKey, "inet_u_%d", index);
+bool StorageModule::replaceFMStations(const FMRadioPreset* presets, int count) {
+    if (count < 0 || count > MAX_STATIONS) return false;
     
-    prefs.putString(nameKey, name);
-    prefs.putString(urlKey, url);
+    for (int i = 0; i < count; i++) {
+        fmPresets[i].frequency = presets[i].frequency;
+        strncpy(fmPresets[i].name, presets[i].name, 31);
+        fmPresets[i].name[31] = '\0';
+    }
+    stationCount = count;
     
-    Serial.printf("Saved internet station %d: %s\n", index, name);
-    return true;
+    return saveFMStations();
 }
 
-bool StorageModule::loadInternetStation(int index, String &name, String &url) {
+// ===== INTERNET RADIO STATION STORAGE =====
+bool StorageModule::saveInternetStation(int index, const char* name, const char* url) {
     if (!isInitialized || index < 0 || index >= MAX_INTERNET_STATIONS) return false;
     
-    char nameKey[16], urlKey[16];
-    sprintf(nameKey, "inet_n_%d", index);
-    sprintf(urlKey, "inet_u_%d", index);
-    
-    name = prefs.getString(nameKey, "");
-    url = prefs.getString(urlKey, "");
+    bool ok;
+    if (index == stationCatalog.count()) {
+        ok = stationCatalog.add(name, url);
+    } else {
+        ok = stationCatalog.update(index, name, url);
+    }
     
-    return (name.length() > 0 && url.length() > 0);
+    if (ok) {
+        Serial.printf("Saved internet station %d: %s\n", index, name);
+    } else {
+        Serial.printf("Failed to save internet station %d\n", index);
+    }
+    return ok;
+}
+
+bool StorageModule::loadInternetStation(int index, char* name, size_t nameSize, char* url, size_t urlSize) {
+    if (!isInitialized) return false;
+    return stationCatalog.get(index, name, nameSize, url, urlSize);
 }
 
 bool StorageModule::deleteInternetStation(int index) {
-    if (!isInitialized || index < 0 || index >= MAX_INTERNET_STATIONS) return false;
-    
-    char nameKey[16], urlKey[16];
-    sprintf(nameKey, "inet_n_%d", index);
-    sprintf(urlKey, "inet_u_%d", index);
-    
-    prefs.remove(nameKey);
-    prefs.remove(urlKey);
+    if (!isInitialized || !stationCatalog.remove(index)) return false;
     
     Serial.printf("Deleted internet station %d\n", index);
     return true;
@@ -214,52 +383,151 @@ bool StorageModule::deleteInternetStation(int index) {
 
 int StorageModule::getInternetStationCount() {
     if (!isInitialized) return 0;
-    return prefs.getInt("inet_count", 0);
+    return stationCatalog.count();
 }
 
-void StorageModule::setInternetStationCount(int count) {
+void StorageModule::clearInternetStations() {
     if (!isInitialized) return;
-    if (count >= 0 && count <= MAX_INTERNET_STATIONS) {
-        prefs.putInt("inet_count", count);
+    
+    stationCatalog.clear();
+    Serial.println("All internet stations cleared");
+}
+
+bool StorageModule::publishInternetStations() {
+    if (!isInitialized) return false;
+    
+    // Size the arena from the index, then read the strings straight into it
+    int count = stationCatalog.count();
+    size_t textBytes = 0;
+    for (int i = 0; i < count; i++) {
+        size_t nameLen, urlLen;
+        if (stationCatalog.getLengths(i, nameLen, urlLen)) {
+            textBytes += nameLen + urlLen;
+        }
     }
+    
+    StationTable* table = StationTable::build(count, textBytes);
+    if (!table) return false;
+    
+    char name[CATALOG_NAME_MAX];
+    char url[CATALOG_URL_MAX];
+    for (int i = 0; i < count; i++) {
+        if (stationCatalog.get(i, name, sizeof(name), url, sizeof(url))) {
+            table->add(name, url);
+        }
+    }
+    
+    StationTable::publish(table);
+    return true;
 }
 
-void StorageModule::clearInternetStations() {
-    if (!isInitialized) return;
+// Stations used to be NVS string pairs; move them into the catalog once.
+// The old keys stay until every station is safely in the catalog, so a
+// catalog that failed to open or a full filesystem only delays the move.
+void StorageModule::migrateLegacyStations() {
+    int legacyCount = prefs.getInt("inet_count", 0);
+    if (legacyCount <= 0) return;
+    if (!stationCatalog.isOpen()) {
+        Serial.println("Station catalog unavailable, keeping NVS stations");
+        return;
+    }
+    
+    int migrated = 0;
+    bool copy = stationCatalog.count() == 0;  // Non-empty: an earlier boot already copied them
+    for (int i = 0; i < legacyCount && i < LEGACY_INTERNET_STATIONS; i++) {
+        char nameKey[16], urlKey[16];
+        sprintf(nameKey, "inet_n_%d", i);
+        sprintf(urlKey, "inet_u_%d", i);
+        
+        String name = prefs.getString(nameKey, "");
+        String url = prefs.getString(urlKey, "");
+        if (name.length() == 0 || url.length() == 0) continue;
+        
+        if (copy && !stationCatalog.add(name.c_str(), url.c_str())) {
+            Serial.printf("Failed to migrate internet station %d, keeping NVS stations\n", i);
+            stationCatalog.clear();  // Start over next boot
+            return;
+        }
+        migrated++;
+    }
     
-    for (int i = 0; i < MAX_INTERNET_STATIONS; i++) {
-        deleteInternetStation(i);
+    if (stationCatalog.count() != migrated) {
+        Serial.printf("Station catalog has %d stations, NVS %d: keeping NVS stations\n",
+                      stationCatalog.count(), migrated);
+        return;
     }
-    setInternetStationCount(0);
-    Serial.println("All internet stations cleared");
+    if (copy) Serial.printf("Migrated %d internet stations from NVS\n", migrated);
+    
+    for (int i = 0; i < LEGACY_INTERNET_STATIONS; i++) {
+        char key[16];
+        sprintf(key, "inet_n_%d", i);
+        prefs.remove(key);
+        sprintf(key, "inet_u_%d", i);
+        prefs.remove(key);
+    }
+    prefs.remove("inet_count");
 }
 
 // ===== TIMEZONE SETTINGS =====
 bool StorageModule::saveTimezone(long gmtOffset, long dstOffset) {
     if (!isInitialized) return false;
     
-    prefs.putLong("gmtOffset", gmtOffset);
-    prefs.putInt("dstOffset", dstOffset);
+    SettingsData data = settings.get();
+    data.gmtOffset = gmtOffset;
+    data.dstOffset = dstOffset;
+    data.savedMask |= SETTING_TIMEZONE;
+    changeSettings(data);
     
-    Serial.printf("Timezone saved: GMT %ld, DST %d\n", gmtOffset, dstOffset);
+    Serial.printf("Timezone saved: GMT %ld, DST %ld\n", gmtOffset, dstOffset);
     return true;
 }
 
 bool StorageModule::loadTimezone(long &gmtOffset, long &dstOffset) {
     if (!isInitialized) return false;
     
-    gmtOffset = prefs.getLong("gmtOffset", 0);
-    dstOffset = prefs.getInt("dstOffset", 0);
+    const SettingsData& data = settings.get();
+    bool saved = data.savedMask & SETTING_TIMEZONE;
+    gmtOffset = saved ? data.gmtOffset : 0;
+    dstOffset = saved ? data.dstOffset : 0;
     
-    Serial.printf("Timezone loaded: GMT %ld, DST %d\n", gmtOffset, dstOffset);
+    Serial.printf("Timezone loaded: GMT %ld, DST %ld\n", gmtOffset, dstOffset);
     return true;
 }
 
+bool StorageModule::saveTimezoneRules(const String& name, const String& posix) {
+    if (!isInitialized || posix.length() == 0) return false;
+    
+    prefs.putString("tzName", name);
+    prefs.putString("tzPosix", posix);
+    Serial.println("Timezone rules cached: " + name + " = " + posix);
+    return true;
+}
+
+bool StorageModule::loadTimezoneRules(String& name, String& posix) {
+    if (!isInitialized || !prefs.isKey("tzPosix")) return false;
+    
+    name = prefs.getString("tzName", "");
+    posix = prefs.getString("tzPosix", "");
+    return posix.length() > 0;
+}
+
+// ===== CLOCK SEED =====
+bool StorageModule::saveLastEpoch(uint32_t epoch) {
+    if (!isInitialized) return false;
+    return prefs.putULong("lastEpoch", epoch) == sizeof(uint32_t);
+}
+
+uint32_t StorageModule::loadLastEpoch() {
+    if (!isInitialized) return 0;
+    return prefs.getULong("lastEpoch", 0);
+}
+
 void StorageModule::factoryReset() {
     Serial.println("Performing factory reset...");
     
-    // Clear NVS preferences
+    // Clear NVS preferences (journal slots included)
     prefs.clear();
+    settings.load(*this);
     
     // Clear FM stations
     clearFMStations();
@@ -275,135 +543,230 @@ void StorageModule::factoryReset() {
     Serial.println("Factory reset complete");
 }
 
+// ===== WIFI JOIN CACHE =====
+bool StorageModule::saveWiFiCache(const WiFiApCache& cache) {
+    if (!isInitialized) return false;
+    return prefs.putBytes("wifiAp", &cache, sizeof(cache)) == sizeof(cache);
+}
+
+bool StorageModule::loadWiFiCache(WiFiApCache& cache) {
+    if (!isInitialized || prefs.getBytesLength("wifiAp") != sizeof(cache)) return false;
+    return prefs.getBytes("wifiAp", &cache, sizeof(cache)) == sizeof(cache);
+}
+
+// ===== ALARM RECORDS =====
+// Each alarm is one versioned, CRC-checked NVS blob ("alm_<n>") instead of
+// eleven separate keys. Older firmware's per-field keys are migrated on load.
+
+#define ALARM_RECORD_VERSION 1
+
+struct __attribute__((packed)) AlarmRecord {
+    uint8_t version;
+    uint8_t enabled;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t repeatMode;
+    uint8_t soundType;
+    int16_t stationIndex;
+    float fmFrequency;
+    uint16_t lastYear;
+    uint8_t lastMonth;
+    uint8_t lastDay;
+    char mp3File[64];
+    uint32_t crc;           // CRC32 of everything above
+};
+
+static uint32_t alarmRecordCRC(const AlarmRecord& rec) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&rec, offsetof(AlarmRecord, crc));
+}
+
+static void packAlarm(const AlarmConfig& alarm, AlarmRecord& rec) {
+    memset(&rec, 0, sizeof(rec));
+    rec.version = ALARM_RECORD_VERSION;
+    rec.enabled = alarm.enabled ? 1 : 0;
+    rec.hour = alarm.hour;
+    rec.minute = alarm.minute;
+    rec.repeatMode = (uint8_t)alarm.repeatMode;
+    rec.soundType = (uint8_t)alarm.soundType;
+    rec.stationIndex = (int16_t)alarm.stationIndex;
+    rec.fmFrequency = alarm.fmFrequency;
+    rec.lastYear = alarm.lastYear;
+    rec.lastMonth = alarm.lastMonth;
+    rec.lastDay = alarm.lastDay;
+    strlcpy(rec.mp3File, alarm.mp3File.c_str(), sizeof(rec.mp3File));
+    rec.crc = alarmRecordCRC(rec);
+}
+
+static bool unpackAlarm(const AlarmRecord& rec, AlarmConfig& alarm) {
+    if (rec.version != ALARM_RECORD_VERSION || rec.crc != alarmRecordCRC(rec)) {
+        return false;
+    }
+    char mp3[sizeof(rec.mp3File) + 1];
+    memcpy(mp3, rec.mp3File, sizeof(rec.mp3File));
+    mp3[sizeof(rec.mp3File)] = '\0';
+
+    alarm.enabled = rec.enabled != 0;
+    alarm.hour = rec.hour;
+    alarm.minute = rec.minute;
+    alarm.repeatMode = (AlarmRepeat)rec.repeatMode;
+    alarm.soundType = (AlarmSoundType)rec.soundType;
+    alarm.stationIndex = rec.stationIndex;
+    alarm.fmFrequency = rec.fmFrequency;
+    alarm.mp3File = mp3;
+    alarm.lastYear = rec.lastYear;
+    alarm.lastMonth = rec.lastMonth;
+    alarm.lastDay = rec.lastDay;
+    return true;
+}
+
+static const char* const LEGACY_ALARM_FIELDS[] = {
+    "en", "h", "m", "rep", "snd", "idx", "fm", "mp3", "yr", "mon", "day"
+};
+
+// Old layout: "alm_<n>_<field>"; key must hold 16 bytes
+static const char* legacyAlarmKey(char* key, int index, const char* field) {
+    snprintf(key, 16, "alm_%d_%s", index, field);
+    return key;
+}
+
 bool StorageModule::saveAlarm(int index, const AlarmConfig& alarm) {
     if (!isInitialized || index < 0 || index >= MAX_ALARMS) return false;
-    
-    char prefix[16];
-    sprintf(prefix, "alm_%d_", index);
-    
-    prefs.putBool((String(prefix) + "en").c_str(), alarm.enabled);
-    prefs.putUChar((String(prefix) + "h").c_str(), alarm.hour);
-    prefs.putUChar((String(prefix) + "m").c_str(), alarm.minute);
-    prefs.putUChar((String(prefix) + "rep").c_str(), (uint8_t)alarm.repeatMode);
-    prefs.putUChar((String(prefix) + "snd").c_str(), (uint8_t)alarm.soundType);
-    prefs.putInt((String(prefix) + "idx").c_str(), alarm.stationIndex);
-    prefs.putFloat((String(prefix) + "fm").c_str(), alarm.fmFrequency);
-    prefs.putString((String(prefix) + "mp3").c_str(), alarm.mp3File);
-    prefs.putUShort((String(prefix) + "yr").c_str(), alarm.lastYear);
-    prefs.putUChar((String(prefix) + "mon").c_str(), alarm.lastMonth);
-    prefs.putUChar((String(prefix) + "day").c_str(), alarm.lastDay);
-    
-    Serial.printf("Saved Alarm %d: %02d:%02d %s\n", 
+
+    char key[16];
+    snprintf(key, sizeof(key), "alm_%d", index);
+
+    AlarmRecord rec;
+    packAlarm(alarm, rec);
+
+    // Skip the flash write when nothing changed
+    AlarmRecord current;
+    if (prefs.getBytesLength(key) == sizeof(current) &&
+        prefs.getBytes(key, &current, sizeof(current)) == sizeof(current) &&
+        memcmp(&current, &rec, sizeof(rec)) == 0) {
+        return true;
+    }
+
+    if (prefs.putBytes(key, &rec, sizeof(rec)) != sizeof(rec)) {
+        Serial.printf("Failed to save Alarm %d\n", index);
+        return false;
+    }
+
+    Serial.printf("Saved Alarm %d: %02d:%02d %s\n",
                   index, alarm.hour, alarm.minute, alarm.enabled ? "ON" : "OFF");
     return true;
 }
 
 bool StorageModule::loadAlarm(int index, AlarmConfig& alarm) {
     if (!isInitialized || index < 0 || index >= MAX_ALARMS) return false;
-    
-    char prefix[16];
-    sprintf(prefix, "alm_%d_", index);
-    
-    alarm.enabled = prefs.getBool((String(prefix) + "en").c_str(), false);
-    alarm.hour = prefs.getUChar((String(prefix) + "h").c_str(), 7);
-    alarm.minute = prefs.getUChar((String(prefix) + "m").c_str(), 0);
-    alarm.repeatMode = (AlarmRepeat)prefs.getUChar((String(prefix) + "rep").c_str(), ALARM_DAILY);
-    alarm.soundType = (AlarmSoundType)prefs.getUChar((String(prefix) + "snd").c_str(), SOUND_INTERNET_RADIO);
-    alarm.stationIndex = prefs.getInt((String(prefix) + "idx").c_str(), 0);
-    alarm.fmFrequency = prefs.getFloat((String(prefix) + "fm").c_str(), 98.0);
-    alarm.mp3File = prefs.getString((String(prefix) + "mp3").c_str(), "");
-    alarm.lastYear = prefs.getUShort((String(prefix) + "yr").c_str(), 0);
-    alarm.lastMonth = prefs.getUChar((String(prefix) + "mon").c_str(), 0);
-    alarm.lastDay = prefs.getUChar((String(prefix) + "day").c_str(), 0);
-    
+
+    char key[16];
+    snprintf(key, sizeof(key), "alm_%d", index);
+
+    AlarmRecord rec;
+    size_t len = prefs.getBytesLength(key);
+    if (len == sizeof(rec) && prefs.getBytes(key, &rec, sizeof(rec)) == sizeof(rec)) {
+        if (unpackAlarm(rec, alarm)) return true;
+        Serial.printf("Alarm %d record corrupt, using defaults\n", index);
+        alarm = AlarmConfig();
+        return false;
+    }
+    if (len != 0) {
+        Serial.printf("Alarm %d record has unknown size %u, using defaults\n", index, (unsigned)len);
+        alarm = AlarmConfig();
+        return false;
+    }
+
+    if (migrateLegacyAlarm(index, alarm)) return true;
+
+    alarm = AlarmConfig();
     return true;
-} // Here
+}
 
-// Add these methods to your existing StorageModule.cpp file
-// Place them after your existing methods, before the final closing brace
+// Read an alarm stored with the old one-key-per-field layout, rewrite it
+// as a single record and remove the old keys
+bool StorageModule::migrateLegacyAlarm(int index, AlarmConfig& alarm) {
+    char key[16];
+    if (!prefs.isKey(legacyAlarmKey(key, index, "en"))) return false;
+
+    alarm.enabled = prefs.getBool(legacyAlarmKey(key, index, "en"), false);
+    alarm.hour = prefs.getUChar(legacyAlarmKey(key, index, "h"), 7);
+    alarm.minute = prefs.getUChar(legacyAlarmKey(key, index, "m"), 0);
+    alarm.repeatMode = (AlarmRepeat)prefs.getUChar(legacyAlarmKey(key, index, "rep"), ALARM_DAILY);
+    alarm.soundType = (AlarmSoundType)prefs.getUChar(legacyAlarmKey(key, index, "snd"), SOUND_INTERNET_RADIO);
+    alarm.stationIndex = prefs.getInt(legacyAlarmKey(key, index, "idx"), 0);
+    alarm.fmFrequency = prefs.getFloat(legacyAlarmKey(key, index, "fm"), 98.0);
+    alarm.mp3File = prefs.getString(legacyAlarmKey(key, index, "mp3"), "");
+    alarm.lastYear = prefs.getUShort(legacyAlarmKey(key, index, "yr"), 0);
+    alarm.lastMonth = prefs.getUChar(legacyAlarmKey(key, index, "mon"), 0);
+    alarm.lastDay = prefs.getUChar(legacyAlarmKey(key, index, "day"), 0);
+
+    if (!saveAlarm(index, alarm)) return true;  // Keep old keys, retry next boot
+
+    for (size_t i = 0; i < sizeof(LEGACY_ALARM_FIELDS) / sizeof(LEGACY_ALARM_FIELDS[0]); i++) {
+        prefs.remove(legacyAlarmKey(key, index, LEGACY_ALARM_FIELDS[i]));
+    }
+    Serial.printf("Migrated Alarm %d to record format\n", index);
+    return true;
+}
 
 // ===== FEATURE FLAGS =====
 bool StorageModule::saveFeatureFlags(const FeatureFlags& flags) {
     if (!isInitialized) return false;
     
-    prefs.putBool("feat_touch", flags.enableTouchScreen);
-    prefs.putBool("feat_btn", flags.enableButtons);
-    prefs.putBool("feat_draw", flags.enableDraw);
-    prefs.putBool("feat_audio", flags.enableAudio);
-    prefs.putBool("feat_stereo", flags.enableStereo);
-    prefs.putBool("feat_led", flags.enableLED);
-    prefs.putBool("feat_alarms", flags.enableAlarms);
-    prefs.putBool("feat_web", flags.enableWeb);
-    prefs.putBool("feat_fm", flags.enableFMRadio);
-    prefs.putBool("feat_pram", flags.enablePRAM);
-    prefs.putBool("feat_i2c", flags.enableI2CScan);
-    
-    Serial.println("Feature flags saved to NVS");
-    /*
-    Serial.print("Save EnableLED:");
-    if (flags.enableLED) {
-        Serial.println("true");
-    }
-    else {
-        Serial.println("false");
-    }
-    */
+    SettingsData data = settings.get();
+    data.featureBits = packFeatures(flags);
+    data.savedMask |= SETTING_FEATURES;
+    changeSettings(data);
+    
+    Serial.println("Feature flags saved");
     return true;
 }
 
 bool StorageModule::loadFeatureFlags(FeatureFlags& flags) {
     if (!isInitialized) return false;
     
-    // Load with defaults from constructor
-    flags.enableTouchScreen = prefs.getBool("feat_touch", true);
-    flags.enableButtons = prefs.getBool("feat_btn", true);
-    flags.enableDraw = prefs.getBool("feat_draw", true);
-    flags.enableAudio = prefs.getBool("feat_audio", true);
-    flags.enableStereo = prefs.getBool("feat_stereo", true);
-    flags.enableLED = prefs.getBool("feat_led", true);
-    flags.enableAlarms = prefs.getBool("feat_alarms", true);
-    flags.enableWeb = prefs.getBool("feat_web", true);
-    flags.enableFMRadio = prefs.getBool("feat_fm", false);
-    flags.enablePRAM = prefs.getBool("feat_pram", true);
-    flags.enableI2CScan = prefs.getBool("feat_i2c", true);
-    /*
-    Serial.print("Load EnableLED:");
-    if (flags.enableLED) {
-        Serial.println("true");
-    }
-    else {
-        Serial.println("false");
-    }
-    */
-    Serial.println("Feature flags loaded from NVS");
+    // Defaults from the constructor if never saved
+    const SettingsData& data = settings.get();
+    if (data.savedMask & SETTING_FEATURES) {
+        unpackFeatures(data.featureBits, flags);
+    } else {
+        flags = FeatureFlags();
+    }
+    Serial.println("Feature flags loaded");
     return true;
 }
 
 // ===== VOLUME AND BRIGHTNESS =====
 bool StorageModule::saveVolume(uint8_t volume) {
     if (!isInitialized) return false;
-    prefs.putUChar("volume", volume);
-    Serial.printf("Volume saved: %d\n", volume);
+    SettingsData data = settings.get();
+    data.volume = volume;
+    data.savedMask |= SETTING_VOLUME;
+    changeSettings(data);
     return true;
 }
 
 uint8_t StorageModule::loadVolume(uint8_t defaultValue) {
     if (!isInitialized) return defaultValue;
-    uint8_t vol = prefs.getUChar("volume", defaultValue);
+    const SettingsData& data = settings.get();
+    uint8_t vol = (data.savedMask & SETTING_VOLUME) ? data.volume : defaultValue;
     Serial.printf("Volume loaded: %d\n", vol);
     return vol;
 }
 
 bool StorageModule::saveBrightness(uint8_t brightness) {
     if (!isInitialized) return false;
-    prefs.putUChar("brightness", brightness);
-    Serial.printf("Brightness saved: %d\n", brightness);
+    SettingsData data = settings.get();
+    data.brightness = brightness;
+    data.savedMask |= SETTING_BRIGHTNESS;
+    changeSettings(data);
     return true;
 }
 
 uint8_t StorageModule::loadBrightness(uint8_t defaultValue) {
     if (!isInitialized) return defaultValue;
-    uint8_t bright = prefs.getUChar("brightness", defaultValue);
+    const SettingsData& data = settings.get();
+    uint8_t bright = (data.savedMask & SETTING_BRIGHTNESS) ? data.brightness : defaultValue;
     Serial.printf("Brightness loaded: %d\n", bright);
     return bright;
 }
@@ -411,14 +774,18 @@ uint8_t StorageModule::loadBrightness(uint8_t defaultValue) {
 // ===== AUDIO MODE SETTINGS =====
 bool StorageModule::saveAudioMode(bool useFMRadio) {
     if (!isInitialized) return false;
-    prefs.putBool("audioMode", useFMRadio);
+    SettingsData data = settings.get();
+    data.useFMRadio = useFMRadio;
+    data.savedMask |= SETTING_AUDIO_MODE;
+    changeSettings(data);
     Serial.printf("Audio mode saved: %s\n", useFMRadio ? "FM Radio" : "Internet Radio");
     return true;
 }
 
 bool StorageModule::loadAudioMode(bool defaultValue) {
     if (!isInitialized) return defaultValue;
-    bool mode = prefs.getBool("audioMode", defaultValue);
+    const SettingsData& data = settings.get();
+    bool mode = (data.savedMask & SETTING_AUDIO_MODE) ? data.useFMRadio : defaultValue;
     Serial.printf("Audio mode loaded: %s\n", mode ? "FM Radio" : "Internet Radio");
     return mode;
 }
@@ -6,13 +6,23 @@
 #include "CommonTypes.h"
 #include "AlarmData.h"
 #include "FeatureFlags.h"
+#include "StationCatalog.h"
+#include "SettingsJournal.h"
+#include "WiFiLink.h"
 
 #define MAX_STATIONS 20
-#define MAX_INTERNET_STATIONS 10
+#define MAX_INTERNET_STATIONS 250        // Catalog limit (was 10 NVS key pairs)
+#define LEGACY_INTERNET_STATIONS 10      // inet_n_%d/inet_u_%d keys migrated on first boot
+#ifndef LITTLEFS_BASE_PATH
+#define LITTLEFS_BASE_PATH "/spiffs"     // VFS mount point, for stdio access (the host build sets its own)
+#endif
+#define STATION_CATALOG_FILE LITTLEFS_BASE_PATH "/stations.cat"
+#define SETTINGS_QUIET_MS 3000           // Commit settings once unchanged this long
+#define SETTINGS_MIN_INTERVAL_MS 30000   // ...and at most this often (bounds flash wear)
 
 // Feature flags structure
 
-class StorageModule {
+class StorageModule : public SettingsSlotStore {
 
 private:
     Preferences prefs;
@@ -20,18 +30,37 @@ private:
     FMRadioPreset fmPresets[MAX_STATIONS];
     int stationCount;
     const char* stationsFile = "/fmstations.txt";
+    StationCatalog stationCatalog;
+    SettingsJournal settings;   // Volume, brightness, mode, time zone, config, flags
+
+    bool migrateLegacyAlarm(int index, AlarmConfig& alarm);
+    void migrateLegacyStations();
+    void migrateLegacySettings();
+    void changeSettings(const SettingsData& data);
 
 public:
     StorageModule();
+    ~StorageModule();
     
     bool begin();
     bool isReady();
+    // Commits pending settings once they have settled (call from a task loop)
+    void loop();
+    // Commits pending settings now (explicit saves, before a restart)
+    bool flushSettings();
+    uint32_t getSettingsWrites() const { return settings.getWriteCount(); }
+
+    // SettingsSlotStore: the journal's two NVS blobs
+    bool readSlot(int slot, SettingsRecord& record) override;
+    bool writeSlot(int slot, const SettingsRecord& record) override;
     
-    // Config management using NVS (Preferences)
+    // Config, audio mode, time zone, feature flags, volume and brightness
+    // live in the settings journal: save*() updates RAM and loop() commits.
+    // Config management:
     bool saveConfig(uint8_t alarmHour, uint8_t alarmMin, bool alarmEnabled, float fmFreq);
     bool loadConfig(uint8_t &alarmHour, uint8_t &alarmMin, bool &alarmEnabled, float &fmFreq);
     
-    // Alarm management using NVS
+    // Alarm management using NVS (one CRC-checked blob per alarm)
     bool saveAlarm(int index, const AlarmConfig& alarm);
     bool loadAlarm(int index, AlarmConfig& alarm);
     
@@ -44,20 +73,32 @@ public:
     int getFMStationCount();
     void setFMStationCount(int count);
     void clearFMStations();
+    bool replaceFMStations(const FMRadioPreset* presets, int count);  // One file write
     
-    // Internet Radio Station management using NVS
+    // Internet Radio Station management using the LittleFS catalog.
+    // Saving at index == count appends; deleting shifts later stations down.
     bool saveInternetStation(int index, const char* name, const char* url);
-    bool loadInternetStation(int index, String &name, String &url);
+    bool loadInternetStation(int index, char* name, size_t nameSize, char* url, size_t urlSize);
     bool deleteInternetStation(int index);
     int getInternetStationCount();
-    void setInternetStationCount(int count);
     void clearInternetStations();
+    // Rebuilds the shared StationTable from the catalog (call after edits)
+    bool publishInternetStations();
     // Audio mode settings (FM Radio vs Internet Radio)
     bool saveAudioMode(bool useFMRadio);
     bool loadAudioMode(bool defaultValue = false);  // false = Internet Radio, true = FM Radio
-    // Timezone settings using NVS
+    // Timezone settings
     bool saveTimezone(long gmtOffset, long dstOffset);
     bool loadTimezone(long &gmtOffset, long &dstOffset);
+    // Resolved zone rules, so boot never needs a network lookup
+    bool saveTimezoneRules(const String& name, const String& posix);
+    bool loadTimezoneRules(String& name, String& posix);
+    // Last NTP time, to start the clock before the network is up
+    bool saveLastEpoch(uint32_t epoch);
+    uint32_t loadLastEpoch();
+    // BSSID/channel of the last WiFi network joined, for a join without a scan
+    bool saveWiFiCache(const WiFiApCache& cache);
+    bool loadWiFiCache(WiFiApCache& cache);
     
     // Feature flags management
     bool saveFeatureFlags(const FeatureFlags& flags);
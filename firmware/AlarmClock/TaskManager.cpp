@@ -0,0 +1,141 @@
+#include "TaskManager.h"
+
+// Guards TaskManager::running, which tasks on both cores decrement
+static portMUX_TYPE runningMux = portMUX_INITIALIZER_UNLOCKED;
+
+TaskManager::TaskManager() : taskCount(0), started(false), stopping(false), running(0) {
+}
+
+TaskManager::~TaskManager() {
+    stop();
+}
+
+TaskManager::TaskSlot* TaskManager::allocSlot(const char* name, uint32_t periodMs,
+                                              BaseType_t core, UBaseType_t priority,
+                                              uint32_t stackSize, bool useAppLock) {
+    if (started || taskCount >= MAX_TASKS) {
+        Serial.printf("TaskManager: Cannot add task %s\n", name);
+        return nullptr;
+    }
+
+    TaskSlot& slot = slots[taskCount++];
+    slot.name = name;
+    slot.tick = nullptr;
+    slot.waitTick = nullptr;
+    slot.periodMs = periodMs > 0 ? periodMs : 1;
+    slot.core = core;
+    slot.priority = priority;
+    slot.stackSize = stackSize;
+    slot.useAppLock = useAppLock;
+    slot.handle = nullptr;
+    slot.owner = this;
+    return &slot;
+}
+
+bool TaskManager::addTask(const char* name, TaskTick tick, uint32_t periodMs,
+                          BaseType_t core, UBaseType_t priority, uint32_t stackSize,
+                          bool useAppLock) {
+    if (!tick) return false;
+    TaskSlot* slot = allocSlot(name, periodMs, core, priority, stackSize, useAppLock);
+    if (!slot) return false;
+    slot->tick = tick;
+    return true;
+}
+
+bool TaskManager::addTask(const char* name, TaskWaitTick tick, uint32_t periodMs,
+                          BaseType_t core, UBaseType_t priority, uint32_t stackSize,
+                          bool useAppLock) {
+    if (!tick) return false;
+    TaskSlot* slot = allocSlot(name, periodMs, core, priority, stackSize, useAppLock);
+    if (!slot) return false;
+    slot->waitTick = tick;
+    return true;
+}
+
+bool TaskManager::start() {
+    if (started) return true;
+    if (!AppLock::begin()) return false;
+
+    // Every task blocks on its start notification before the first tick,
+    // so if one can't be created the others are deleted while they hold
+    // nothing (audio included, which never takes the app lock)
+    stopping = false;
+    for (int i = 0; i < taskCount; i++) {
+        TaskSlot& slot = slots[i];
+        BaseType_t result = xTaskCreatePinnedToCore(
+            taskEntry, slot.name, slot.stackSize, &slot,
+            slot.priority, &slot.handle, slot.core);
+
+        if (result != pdPASS) {
+            Serial.printf("TaskManager: Failed to create task %s, deleting the others\n", slot.name);
+            slot.handle = nullptr;
+            for (int j = 0; j < i; j++) {
+                vTaskDelete(slots[j].handle);
+                slots[j].handle = nullptr;
+            }
+            return false;
+        }
+    }
+
+    started = true;
+    for (int i = 0; i < taskCount; i++) {
+        TaskSlot& slot = slots[i];
+        portENTER_CRITICAL(&runningMux);
+        running++;
+        portEXIT_CRITICAL(&runningMux);
+        xTaskNotifyGive(slot.handle);
+        Serial.printf("TaskManager: Started %s on core %d (priority %d, every %lu ms)\n",
+                      slot.name, slot.core, slot.priority, slot.periodMs);
+    }
+    return true;
+}
+
+void TaskManager::stop() {
+    if (!started) return;
+
+    stopping = true;
+    while (running > 0) vTaskDelay(1);
+    for (int i = 0; i < taskCount; i++) slots[i].handle = nullptr;
+    started = false;
+}
+
+void TaskManager::taskEntry(void* param) {
+    TaskSlot* slot = static_cast<TaskSlot*>(param);
+    TaskManager* owner = slot->owner;
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    TickType_t period = pdMS_TO_TICKS(slot->periodMs);
+    if (period == 0) period = 1;
+    TickType_t lastWake = xTaskGetTickCount();
+
+    while (!owner->stopping) {
+        uint32_t waitMs = 0;
+        if (slot->useAppLock) owner->lockApp();
+        if (slot->waitTick) {
+            waitMs = slot->waitTick();
+        } else {
+            slot->tick();
+        }
+        if (slot->useAppLock) owner->unlockApp();
+
+        // Deadline-driven tasks sleep exactly as long as they asked for
+        if (waitMs > 0) {
+            TickType_t waitTicks = pdMS_TO_TICKS(waitMs);
+            vTaskDelay(waitTicks > 0 ? waitTicks : 1);
+            lastWake = xTaskGetTickCount();
+            continue;
+        }
+
+        // Never busy-loop if a tick overran its period
+        if (xTaskDelayUntil(&lastWake, period) == pdFALSE) {
+            vTaskDelay(1);
+            lastWake = xTaskGetTickCount();
+        }
+    }
+
+    // Asked to stop: leave between ticks, holding nothing
+    portENTER_CRITICAL(&runningMux);
+    owner->running--;
+    portEXIT_CRITICAL(&runningMux);
+    vTaskDelete(NULL);
+}
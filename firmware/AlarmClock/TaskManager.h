@@ -0,0 +1,75 @@
+#ifndef TASK_MANAGER_H
+#define TASK_MANAGER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include "AppLock.h"
+
+#define MAX_TASKS 6
+
+// Periodic work function run by a task
+typedef void (*TaskTick)();
+
+// Work function that decides its own sleep: returns ms until it next needs
+// to run (0 = use the registered period)
+typedef uint32_t (*TaskWaitTick)();
+
+// Runs the main-loop work as pinned FreeRTOS tasks.
+// Audio gets its own core and a high priority; UI, network and alarm
+// tasks share the other core and serialize on the app lock, so a slow
+// page render or screen redraw can no longer starve audio.loop().
+//
+// No task runs a tick before start() has created all of them, and tasks
+// are never deleted mid-tick: stop() asks them to leave between ticks.
+class TaskManager {
+private:
+    struct TaskSlot {
+        const char* name;
+        TaskTick tick;
+        TaskWaitTick waitTick;
+        uint32_t periodMs;
+        BaseType_t core;
+        UBaseType_t priority;
+        uint32_t stackSize;
+        bool useAppLock;
+        TaskHandle_t handle;
+        TaskManager* owner;
+    };
+
+    TaskSlot slots[MAX_TASKS];
+    int taskCount;
+    bool started;
+    volatile bool stopping;
+    volatile int running;   // Tasks past their start notification, not yet exited
+
+    static void taskEntry(void* param);
+    TaskSlot* allocSlot(const char* name, uint32_t periodMs,
+                        BaseType_t core, UBaseType_t priority, uint32_t stackSize,
+                        bool useAppLock);
+
+public:
+    TaskManager();
+    ~TaskManager();
+
+    // Register a task; must be called before start()
+    bool addTask(const char* name, TaskTick tick, uint32_t periodMs,
+                 BaseType_t core, UBaseType_t priority, uint32_t stackSize,
+                 bool useAppLock);
+    // Register a task that sleeps until its own next deadline; periodMs is
+    // the fallback when the tick returns 0
+    bool addTask(const char* name, TaskWaitTick tick, uint32_t periodMs,
+                 BaseType_t core, UBaseType_t priority, uint32_t stackSize,
+                 bool useAppLock);
+    bool start();
+    bool isStarted() { return started; }
+    // Waits for every task to finish its current tick and exit; not from a task
+    void stop();
+
+    // The AppLock, which tasks registered with useAppLock hold for each tick
+    bool lockApp(uint32_t timeoutMs = portMAX_DELAY) { return AppLock::take(timeoutMs); }
+    void unlockApp() { AppLock::give(); }
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include "TimeFormat.h"
+#include <string.h>
+
+const char* const DAY_NAMES[7] = {
+    "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"
+};
+
+const char* const MONTH_NAMES[12] = {
+    "January", "February", "March", "April", "May", "June",
+    "July", "August", "September", "October", "November", "December"
+};
+
+const char DAY_ABBREVIATIONS[7][4] = {
+    "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+};
+
+const char MONTH_ABBREVIATIONS[12][4] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+// Out-of-range fields (a snapshot that was never filled) print as the
+// first entry rather than reading past a table
+static uint8_t dayIndex(const TimeSnapshot& t) {
+    return t.dayOfWeek < 7 ? t.dayOfWeek : 0;
+}
+
+static uint8_t monthIndex(const TimeSnapshot& t) {
+    return (t.month >= 1 && t.month <= 12) ? t.month - 1 : 0;
+}
+
+static size_t emptyText(char* out, size_t size) {
+    if (size > 0) out[0] = '\0';
+    return 0;
+}
+
+static char* put2(char* p, uint8_t value) {
+    *p++ = '0' + value / 10 % 10;
+    *p++ = '0' + value % 10;
+    return p;
+}
+
+static char* put4(char* p, uint16_t value) {
+    p = put2(p, value / 100);
+    return put2(p, value % 100);
+}
+
+static char* putText(char* p, const char* text) {
+    size_t len = strlen(text);
+    memcpy(p, text, len);
+    return p + len;
+}
+
+size_t formatClockTime(const TimeSnapshot& t, char* out, size_t size) {
+    if (size < TIME_TEXT_SIZE) return emptyText(out, size);
+    char* p = put2(out, t.hour);
+    *p++ = ':';
+    p = put2(p, t.minute);
+    *p++ = ':';
+    p = put2(p, t.second);
+    *p = '\0';
+    return p - out;
+}
+
+size_t formatHourMinute(const TimeSnapshot& t, char* out, size_t size) {
+    if (size < HOUR_MINUTE_SIZE) return emptyText(out, size);
+    char* p = put2(out, t.hour);
+    *p++ = ':';
+    p = put2(p, t.minute);
+    *p = '\0';
+    return p - out;
+}
+
+size_t formatShortDate(const TimeSnapshot& t, char* out, size_t size) {
+    if (size < DATE_TEXT_SIZE) return emptyText(out, size);
+    char* p = putText(out, DAY_ABBREVIATIONS[dayIndex(t)]);
+    *p++ = ',';
+    *p++ = ' ';
+    p = put2(p, t.day);
+    *p++ = ' ';
+    p = putText(p, MONTH_ABBREVIATIONS[monthIndex(t)]);
+    *p++ = ' ';
+    p = put4(p, t.year);
+    *p = '\0';
+    return p - out;
+}
+
+size_t formatFullDate(const TimeSnapshot& t, char* out, size_t size) {
+    if (size < FULL_DATE_TEXT_SIZE) return emptyText(out, size);
+    char* p = putText(out, DAY_NAMES[dayIndex(t)]);
+    *p++ = ',';
+    *p++ = ' ';
+    p = put2(p, t.day);
+    *p++ = ' ';
+    p = putText(p, MONTH_NAMES[monthIndex(t)]);
+    *p++ = ' ';
+    p = put4(p, t.year);
+    *p = '\0';
+    return p - out;
+}
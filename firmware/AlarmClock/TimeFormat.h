@@ -0,0 +1,56 @@
+#ifndef TIME_FORMAT_H
+#define TIME_FORMAT_H
+
+// Clock and date text written into caller buffers, with no heap use and no
+// printf format parsing. No Arduino dependencies.
+//
+// Each format has a fixed worst-case length, so the array overloads check
+// the buffer size at compile time:
+//   char text[TIME_TEXT_SIZE];
+//   formatClockTime(now, text);
+
+#include <stddef.h>
+#include <stdint.h>
+#include "TimeSnapshot.h"
+
+#define TIME_TEXT_SIZE       9   // "14:35:22"
+#define HOUR_MINUTE_SIZE     6   // "14:35"
+#define DATE_TEXT_SIZE       17  // "Mon, 21 Dec 2024"
+#define FULL_DATE_TEXT_SIZE  30  // "Wednesday, 21 September 2024"
+
+extern const char* const DAY_NAMES[7];      // "Sunday".."Saturday"
+extern const char* const MONTH_NAMES[12];   // "January".."December"
+extern const char DAY_ABBREVIATIONS[7][4];  // "Sun".."Sat"
+extern const char MONTH_ABBREVIATIONS[12][4];
+
+// Return the text length, or 0 (empty string) if size is below the *_SIZE above
+size_t formatClockTime(const TimeSnapshot& t, char* out, size_t size);    // "HH:MM:SS"
+size_t formatHourMinute(const TimeSnapshot& t, char* out, size_t size);   // "HH:MM"
+size_t formatShortDate(const TimeSnapshot& t, char* out, size_t size);    // "Mon, 21 Dec 2024"
+size_t formatFullDate(const TimeSnapshot& t, char* out, size_t size);     // "Monday, 21 December 2024"
+
+template <size_t N>
+inline size_t formatClockTime(const TimeSnapshot& t, char (&out)[N]) {
+    static_assert(N >= TIME_TEXT_SIZE, "buffer too small for HH:MM:SS");
+    return formatClockTime(t, out, N);
+}
+
+template <size_t N>
+inline size_t formatHourMinute(const TimeSnapshot& t, char (&out)[N]) {
+    static_assert(N >= HOUR_MINUTE_SIZE, "buffer too small for HH:MM");
+    return formatHourMinute(t, out, N);
+}
+
+template <size_t N>
+inline size_t formatShortDate(const TimeSnapshot& t, char (&out)[N]) {
+    static_assert(N >= DATE_TEXT_SIZE, "buffer too small for the short date");
+    return formatShortDate(t, out, N);
+}
+
+template <size_t N>
+inline size_t formatFullDate(const TimeSnapshot& t, char (&out)[N]) {
+    static_assert(N >= FULL_DATE_TEXT_SIZE, "buffer too small for the full date");
+    return formatFullDate(t, out, N);
+}
+
+#endif
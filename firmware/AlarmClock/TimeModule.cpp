@@ -1,51 +1,107 @@
+#include "Config.h"
 #include "TimeModule.h"
+#include "TimeFormat.h"
+#include "StorageModule.h"
+#include <sys/time.h>
+#include <lwip/tcpip.h>
 
 TimeModule::TimeModule(const char* tzName) 
-    : isInitialized(false), wifiConnected(false), timezoneName(tzName) {
+    : isInitialized(false), wifiConnected(false), timezoneName(tzName),
+      timezoneResolved(false), nextTimezoneAttempt(0), storage(nullptr),
+      udpOpen(false), ntpServerKnown(false), dnsPending(false), dnsAddress(0), lastEpochSave(0),
+      secondCallback(nullptr), minuteCallback(nullptr), dayCallback(nullptr) {
+    memset(&snapshot, 0, sizeof(snapshot));
 }
 
 bool TimeModule::begin(const char* ssid, const char* password) {
     // WiFi should already be connected by WiFiModule, but check anyway
     wifiConnected = (WiFi.status() == WL_CONNECTED);
     
-    if (!wifiConnected) {
-        Serial.println("WiFi not connected for time sync");
-        return false;
+    // ezTime's own NTP blocks (waitForSync/updateNTP); NtpSync polls instead
+    setInterval(0);
+    seedClock();
+    
+    if (!loadTimezoneOffline()) {
+        Serial.println("No cached timezone rules, using UTC until looked up");
+    }
+    
+    ntp.configure(NTP_SYNC_INTERVAL_MS, NTP_TIMEOUT_MS, NTP_BACKOFF_MIN_MS, NTP_BACKOFF_MAX_MS);
+    ntp.begin(*this, millis());
+    
+    isInitialized = true;
+    refreshSnapshot(true);
+    
+    if (snapshot.valid) {
+        char text[TIME_TEXT_SIZE];
+        formatClockTime(snapshot, text);
+        Serial.printf("Local time: %s (%s)\n", text, timezoneName.c_str());
+    }
+    
+    // Only a failure if there is neither a time nor a way to get one
+    return snapshot.valid || wifiConnected;
+}
+
+// Start from the best time available without the network: the RTC keeps
+// counting across software resets, NVS has the last NTP time after power loss
+void TimeModule::seedClock() {
+    time_t rtc = time(nullptr);
+    if (rtc >= NTP_MIN_VALID_EPOCH) {
+        UTC.setTime(rtc);
+        Serial.printf("Clock started from RTC: %lu\n", (unsigned long)rtc);
+        return;
+    }
+    
+    uint32_t saved = storage ? storage->loadLastEpoch() : 0;
+    if (saved >= NTP_MIN_VALID_EPOCH) {
+        UTC.setTime(saved);
+        Serial.printf("Clock started from last saved time: %lu (until NTP)\n", (unsigned long)saved);
+        return;
     }
     
-    Serial.println("Waiting for ezTime NTP sync...");
+    Serial.println("No saved time, waiting for NTP");
+}
+
+// Built-in rules for the configured name, else the rules cached in NVS
+bool TimeModule::loadTimezoneOffline() {
+    const char* builtIn = posixTzForName(timezoneName.c_str());
+    if (builtIn && zone.set(builtIn)) {
+        timezoneResolved = true;
+        Serial.println("Timezone: " + timezoneName + " (" + builtIn + ")");
+        return true;
+    }
     
-    // Wait for ezTime to sync with NTP
-    waitForSync();
+    String name, posix;
+    if (!storage || !storage->loadTimezoneRules(name, posix)) return false;
     
-    Serial.println("UTC time synced");
-    Serial.println("UTC: " + UTC.dateTime());
+    // A zone named in code wins over rules cached for a different one
+    if (timezoneName.length() > 0 && name != timezoneName) return false;
+    if (!zone.set(posix.c_str())) return false;
     
-    // Set timezone
+    timezoneName = name;
+    timezoneResolved = true;
+    Serial.println("Timezone from cache: " + name + " (" + posix + ")");
+    return true;
+}
+
+// Network lookup, only while nothing is cached; waits for the first NTP
+// reply so it doesn't compete with it and the network is known to work
+void TimeModule::resolveTimezone() {
+    if (!ntp.hasSynced() || (int32_t)(millis() - nextTimezoneAttempt) < 0) return;
+    
+    bool ok;
     if (timezoneName.length() > 0) {
-        if (!setTimezone(timezoneName.c_str())) {
-            Serial.println("Failed to set timezone, using UTC");
-            timezoneName = "UTC";
-        }
+        Serial.println("Looking up timezone " + timezoneName + "...");
+        ok = myTZ.setLocation(timezoneName);
     } else {
-        // Try to auto-detect timezone based on IP geolocation
         Serial.println("Auto-detecting timezone...");
-        if (!myTZ.setLocation()) {
-            Serial.println("Auto-detect failed, using UTC");
-            timezoneName = "UTC";
-            myTZ.setLocation("UTC");
-        } else {
-            timezoneName = myTZ.getTimezoneName();
-            Serial.println("Auto-detected timezone: " + timezoneName);
-        }
-    }
-    
-    Serial.println("Local time: " + myTZ.dateTime());
-    Serial.println("Timezone: " + timezoneName);
-    Serial.println("DST active: " + String(isDST() ? "Yes" : "No"));
+        ok = myTZ.setLocation();
+        if (ok) timezoneName = myTZ.getTimezoneName();
+    }
     
-    isInitialized = true;
-    return true;
+    if (!ok || !setTimezoneRules(timezoneName.c_str(), myTZ.getPosix().c_str())) {
+        Serial.println("Timezone lookup failed, using UTC for now");
+        nextTimezoneAttempt = millis() + TZ_RESOLVE_RETRY_MS;
+    }
 }
 
 bool TimeModule::setTimezone(const char* tzName) {
@@ -54,11 +110,10 @@ bool TimeModule::setTimezone(const char* tzName) {
         return true;  // Will be applied in begin()
     }
     
-    if (myTZ.setLocation(tzName)) {
-        timezoneName = tzName;
-        Serial.println("Timezone set to: " + timezoneName);
-        Serial.println("Local time: " + myTZ.dateTime());
-        Serial.println("DST active: " + String(isDST() ? "Yes" : "No"));
+    const char* builtIn = posixTzForName(tzName);
+    if (builtIn) return setTimezoneRules(tzName, builtIn);
+    
+    if (myTZ.setLocation(tzName) && setTimezoneRules(tzName, myTZ.getPosix().c_str())) {
         return true;
     }
     
@@ -66,18 +121,136 @@ bool TimeModule::setTimezone(const char* tzName) {
     return false;
 }
 
+// Applies at once and is cached, so later boots need no lookup
+bool TimeModule::setTimezoneRules(const char* tzName, const char* posix) {
+    if (!zone.set(posix)) {
+        Serial.println("Invalid timezone rules: " + String(posix));
+        return false;
+    }
+    
+    timezoneName = tzName;
+    timezoneResolved = true;
+    if (storage) storage->saveTimezoneRules(timezoneName, posix);
+    refreshSnapshot(true);
+    
+    Serial.println("Timezone set to: " + timezoneName + " (" + posix + ")");
+    Serial.println("DST active: " + String(isDST() ? "Yes" : "No"));
+    return true;
+}
+
 String TimeModule::getTimezoneName() {
-    return timezoneName;
+    return timezoneResolved ? timezoneName : String("UTC");  // UTC until the rules are known
 }
 
 bool TimeModule::isDST() {
     if (!isInitialized) return false;
-    return myTZ.isDST();
+    return zone.isDstAt(getEpoch());
 }
 
 void TimeModule::loop() {
-    // ezTime handles events automatically
-    events();  // This checks for DST changes and handles them
+    if (isInitialized && WiFi.status() == WL_CONNECTED) {
+        NtpResult result;
+        if (ntp.poll(millis(), result)) applyNtpResult(result);
+        if (!timezoneResolved) resolveTimezone();
+    }
+    
+    // DST changes need no events: the zone table already has them
+    refreshSnapshot(false);
+}
+
+void TimeModule::applyNtpResult(const NtpResult& result) {
+    time_t before = getEpoch();
+    UTC.setTime(result.unixSeconds, result.millis);
+    
+    // The RTC keeps this across software resets (see seedClock)
+    struct timeval tv = { (time_t)result.unixSeconds, (suseconds_t)result.millis * 1000 };
+    settimeofday(&tv, nullptr);
+    
+    Serial.printf("NTP sync: %lu, step %ld s, round trip %lu ms\n",
+                  (unsigned long)result.unixSeconds,
+                  before ? (long)((time_t)result.unixSeconds - before) : 0L,
+                  (unsigned long)result.roundTripMs);
+    
+    if (storage && (lastEpochSave == 0 || millis() - lastEpochSave >= NTP_EPOCH_SAVE_MS)) {
+        storage->saveLastEpoch(result.unixSeconds);
+        lastEpochSave = millis();
+    }
+    refreshSnapshot(true);
+}
+
+// ===== NTP TRANSPORT =====
+
+bool TimeModule::send(const uint8_t* packet, size_t len) {
+    if (!udpOpen) udpOpen = udp.begin(NTP_LOCAL_PORT);
+    if (!udpOpen) return false;
+    
+    // Resolve once, and again after a failure in case the pool address
+    // moved. The lookup runs in the background; until it answers, requests
+    // go to the last address that worked
+    if ((!ntpServerKnown || ntp.getFailures() > 0) && !dnsPending) {
+        startNtpLookup();
+    }
+    if (dnsAddress != 0) {
+        ntpServerIP = IPAddress(dnsAddress);
+        ntpServerKnown = true;
+        dnsAddress = 0;
+    }
+    if (!ntpServerKnown) return false;  // Counts as a failure; retried with backoff
+    
+    if (!udp.beginPacket(ntpServerIP, NTP_PORT)) return false;
+    udp.write(packet, len);
+    return udp.endPacket();
+}
+
+void TimeModule::startNtpLookup() {
+    ip_addr_t addr;
+    dnsPending = true;
+#if CONFIG_LWIP_TCPIP_CORE_LOCKING
+    LOCK_TCPIP_CORE();
+#endif
+    err_t err = dns_gethostbyname(NTP_SERVER, &addr, ntpDnsCallback, this);
+#if CONFIG_LWIP_TCPIP_CORE_LOCKING
+    UNLOCK_TCPIP_CORE();
+#endif
+    if (err == ERR_OK) {
+        ntpDnsCallback(NTP_SERVER, &addr, this);  // Cached or an IP literal
+    } else if (err != ERR_INPROGRESS) {
+        dnsPending = false;
+        Serial.printf("TimeModule: DNS lookup of %s failed to start (%d)\n", NTP_SERVER, err);
+    }
+}
+
+// Runs on the lwIP thread; only hands the address over
+void TimeModule::ntpDnsCallback(const char* name, const ip_addr_t* ip, void* arg) {
+    TimeModule* self = static_cast<TimeModule*>(arg);
+    if (ip && IP_IS_V4(ip)) {
+        self->dnsAddress = ip_addr_get_ip4_u32(ip);
+    } else {
+        Serial.printf("TimeModule: Could not resolve %s, keeping the last address\n", name);
+    }
+    self->dnsPending = false;
+}
+
+size_t TimeModule::receive(uint8_t* packet, size_t size) {
+    if (!udpOpen || udp.parsePacket() <= 0) return 0;
+    int len = udp.read(packet, size);
+    return len > 0 ? len : 0;
+}
+
+// The only place local time is converted; everything else reads the snapshot
+void TimeModule::refreshSnapshot(bool force) {
+    if (!isInitialized) return;
+
+    time_t epoch = getEpoch();
+    if (epoch == 0 || (!force && epoch == snapshot.epoch)) return;
+
+    TimeSnapshot previous = snapshot;
+    makeTimeSnapshot(epoch, *this, snapshot);
+
+    uint8_t ticks = timeSnapshotTicks(previous, snapshot);
+    if ((ticks & TIME_TICK_SECOND) && secondCallback) secondCallback(snapshot);
+    if ((ticks & TIME_TICK_MINUTE) && minuteCallback) minuteCallback(snapshot);
+    if ((ticks & TIME_TICK_DAY) && dayCallback) dayCallback(snapshot);
 }
 
 bool TimeModule::isReady() {
@@ -90,48 +263,62 @@ bool TimeModule::isWiFiConnected() {
 }
 
 uint8_t TimeModule::getHour() {
-    if (!isInitialized) return 0;
-    return myTZ.hour();
+    if (!snapshot.valid) return 0;
+    return snapshot.hour;
 }
 
 uint8_t TimeModule::getMinute() {
-    if (!isInitialized) return 0;
-    return myTZ.minute();
+    if (!snapshot.valid) return 0;
+    return snapshot.minute;
 }
 
 uint8_t TimeModule::getSecond() {
-    if (!isInitialized) return 0;
-    return myTZ.second();
+    if (!snapshot.valid) return 0;
+    return snapshot.second;
 }
 
 uint8_t TimeModule::getDay() {
-    if (!isInitialized) return 1;
-    return myTZ.day();
+    if (!snapshot.valid) return 1;
+    return snapshot.day;
 }
 
 uint8_t TimeModule::getMonth() {
-    if (!isInitialized) return 1;
-    return myTZ.month();
+    if (!snapshot.valid) return 1;
+    return snapshot.month;
 }
 
 uint16_t TimeModule::getYear() {
-    if (!isInitialized) return 2024;
-    return myTZ.year();
+    if (!snapshot.valid) return 2024;
+    return snapshot.year;
 }
 
 uint8_t TimeModule::getDayOfWeek() {
-    if (!isInitialized) return 0;
-    return myTZ.weekday();  // 0=Sunday, 6=Saturday (same as tm_wday)
+    if (!snapshot.valid) return 0;
+    return snapshot.dayOfWeek;  // 0=Sunday, 6=Saturday (same as tm_wday)
+}
+
+time_t TimeModule::getEpoch() {
+    if (!isInitialized || timeStatus() == timeNotSet) return 0;
+    return UTC.now();
+}
+
+time_t TimeModule::toLocal(time_t utc) {
+    return zone.toLocal(utc);
+}
+
+time_t TimeModule::localToEpoch(time_t local) {
+    // Gaps and overlaps at DST changes resolve as documented in PosixTz.h
+    return zone.localToEpoch(local);
 }
 
 String TimeModule::getDayName() {
-    if (!isInitialized) return "Unknown";
-    return myTZ.dateTime("l");  // "Monday", "Tuesday", etc.
+    if (!snapshot.valid) return "Unknown";
+    return DAY_NAMES[snapshot.dayOfWeek];  // "Monday", "Tuesday", etc.
 }
 
 String TimeModule::getMonthName() {
-    if (!isInitialized) return "Unknown";
-    return myTZ.dateTime("F");  // "January", "February", etc.
+    if (!snapshot.valid) return "Unknown";
+    return MONTH_NAMES[snapshot.month - 1];  // "January", "February", etc.
 }
 
 void TimeModule::setTime(uint8_t hour, uint8_t minute, uint8_t second) {
@@ -141,29 +328,6 @@ void TimeModule::setTime(uint8_t hour, uint8_t minute, uint8_t second) {
                   hour, minute, second);
 }
 
-void TimeModule::reconnectWiFi() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("Reconnecting to WiFi...");
-        WiFi.reconnect();
-        
-        int attempts = 0;
-        while (WiFi.status() != WL_CONNECTED && attempts < 10) {
-            delay(500);
-            Serial.print(".");
-            attempts++;
-        }
-        
-        if (WiFi.status() == WL_CONNECTED) {
-            Serial.println("\nReconnected!");
-            wifiConnected = true;
-            updateNTP();  // Sync time after reconnection
-        } else {
-            Serial.println("\nReconnection failed");
-            wifiConnected = false;
-        }
-    }
-}
-
 String TimeModule::getIPAddress() {
     if (wifiConnected) {
         return WiFi.localIP().toString();
@@ -179,39 +343,34 @@ int TimeModule::getWiFiSignal() {
 }
 
 bool TimeModule::syncTime() {
-    if (!wifiConnected) {
+    if (!isWiFiConnected()) {
         Serial.println("Cannot sync time - WiFi not connected");
         return false;
     }
     
-    Serial.println("Syncing time with NTP...");
-    updateNTP();
-    
-    // Wait a moment for sync
-    delay(1000);
-    
-    Serial.println("Time synced: " + myTZ.dateTime());
+    // The reply is applied by loop(); nothing waits for it here
+    Serial.println("NTP sync requested");
+    ntp.requestSync(millis());
     return true;
 }
 
 String TimeModule::getTimeString() {
-    if (!isInitialized) return "00:00:00";
-    return myTZ.dateTime("H:i:s");  // "14:35:22"
+    if (!snapshot.valid) return "00:00:00";
+    char text[TIME_TEXT_SIZE];
+    formatClockTime(snapshot, text);  // "14:35:22"
+    return String(text);
 }
 
 String TimeModule::getDateString() {
-    if (!isInitialized) return "Unknown";
-    // Format: "Mon, 21 Dec 2024"
-    return myTZ.dateTime("D, d M Y");
+    if (!snapshot.valid) return "Unknown";
+    char text[DATE_TEXT_SIZE];
+    formatShortDate(snapshot, text);  // "Mon, 21 Dec 2024"
+    return String(text);
 }
 
 String TimeModule::getFullDateString() {
-    if (!isInitialized) return "Unknown";
-    // Format: "Monday, 21 December 2024"
-    return myTZ.dateTime("l, d F Y");
+    if (!snapshot.valid) return "Unknown";
+    char text[FULL_DATE_TEXT_SIZE];
+    formatFullDate(snapshot, text);  // "Monday, 21 December 2024"
+    return String(text);
 }
-
-void TimeModule::updateEvents() {
-    // This is called by loop() automatically
-    // ezTime handles DST transitions through the events() system
-}
\ No newline at end of file
@@ -2,24 +2,77 @@
 #define TIME_MODULE_H
 
 #include <WiFi.h>
+#include <WiFiUdp.h>
 #include <ezTime.h>
+#include <lwip/ip_addr.h>
+#include <lwip/dns.h>
+#include "AlarmSchedule.h"
+#include "TimeSnapshot.h"
+#include "NtpSync.h"
+#include "PosixTz.h"
 
-class TimeModule {
+class StorageModule;
+
+typedef void (*TimeTickCallback)(const TimeSnapshot& now);
+
+class TimeModule : public LocalTimeMapping, public NtpTransport {
 private:
     bool isInitialized;
     bool wifiConnected;
-    Timezone myTZ;  // ezTime timezone object
+    Timezone myTZ;  // ezTime, only to look up rules for a zone name online
+    PosixTz zone;   // Rules in use: every local-time conversion goes through this
     String timezoneName;
+    bool timezoneResolved;            // Rules loaded (from NVS or a lookup)
+    uint32_t nextTimezoneAttempt;
+    StorageModule* storage;
+    NtpSync ntp;                      // ezTime's own NTP is off; this never blocks
+    WiFiUDP udp;
+    bool udpOpen;
+    IPAddress ntpServerIP;            // Last good address, kept while a lookup runs or fails
+    bool ntpServerKnown;
+    volatile bool dnsPending;         // Async lookup of NTP_SERVER in flight
+    volatile uint32_t dnsAddress;     // Its answer (IPv4, network order); 0 = none yet
+    uint32_t lastEpochSave;
+    TimeSnapshot snapshot;            // Local time as of the last loop()
+    TimeTickCallback secondCallback;
+    TimeTickCallback minuteCallback;
+    TimeTickCallback dayCallback;
     
-    void updateEvents();  // Check for DST changes
+    void refreshSnapshot(bool force);
+    void seedClock();
+    bool loadTimezoneOffline();
+    void resolveTimezone();
+    void applyNtpResult(const NtpResult& result);
+    void startNtpLookup();
+    static void ntpDnsCallback(const char* name, const ip_addr_t* ip, void* arg);
+    
+    // NtpTransport
+    bool send(const uint8_t* packet, size_t len) override;
+    size_t receive(uint8_t* packet, size_t size) override;
 
 public:
     TimeModule(const char* tzName = "");  // Pass timezone like "Europe/London" or "America/New_York"
     
+    // Before begin(): the last synced time and zone rules are kept here
+    void setStorage(StorageModule* store) { storage = store; }
+    
+    // Returns at once; the clock starts from the RTC or the last saved
+    // time, and NTP and the zone lookup run from loop()
     bool begin(const char* ssid, const char* password);
     bool isReady();
+    bool isSynced() { return ntp.hasSynced(); }  // At least one NTP reply this boot
+    NtpState getSyncState() { return ntp.getState(); }
     bool isWiFiConnected();
     
+    // Converted once per second in loop(); getters below read this too.
+    // Readers share the app lock with loop(), so it never changes mid-read.
+    const TimeSnapshot& getSnapshot() { return snapshot; }
+    
+    // Called from loop() when the local second/minute/day changes
+    void onSecond(TimeTickCallback callback) { secondCallback = callback; }
+    void onMinute(TimeTickCallback callback) { minuteCallback = callback; }
+    void onDay(TimeTickCallback callback) { dayCallback = callback; }
+    
     // Time getters
     uint8_t getHour();
     uint8_t getMinute();
@@ -31,24 +84,31 @@ public:
     String getDayName();     // "Monday", "Tuesday", etc.
     String getMonthName();   // "January", "February", etc.
     
+    // Absolute time for schedulers (0 until the clock has been set)
+    time_t getEpoch();                     // Seconds since 1970, UTC
+    time_t toLocal(time_t utc) override;          // UTC epoch -> local wall-clock seconds
+    time_t localToEpoch(time_t local) override;   // Local wall-clock seconds -> UTC epoch
+    
     // Time setters (manual adjustment - overrides NTP temporarily)
     void setTime(uint8_t hour, uint8_t minute, uint8_t second);
     
     // Timezone management
     bool setTimezone(const char* tzName);  // e.g., "Europe/London", "America/New_York"
+    bool setTimezoneRules(const char* tzName, const char* posix);  // e.g., "CET-1CEST,M3.5.0,M10.5.0/3"
+    const char* getTimezoneRules() { return zone.getSpec(); }
     String getTimezoneName();
     bool isDST();  // Is Daylight Saving Time active?
     
-    // WiFi management
-    void reconnectWiFi();
+    // WiFi status (WiFiModule owns the connection)
     String getIPAddress();
     int getWiFiSignal();
     
     // NTP sync
-    bool syncTime();
-    void loop();  // Call this regularly to handle DST changes
+    bool syncTime();  // Asks for a sync on the next loop(); does not wait
+    void loop();  // Call this regularly: NTP, DST events, snapshot and tick callbacks
     
-    // Formatted strings
+    // Formatted strings (allocate; the display formats getSnapshot() with
+    // TimeFormat into its own buffers instead)
     String getTimeString();      // "14:35:22"
     String getDateString();      // "Mon, 21 Dec 2024"
     String getFullDateString();  // "Monday, 21 December 2024"
@@ -0,0 +1,35 @@
+#include "TimeSnapshot.h"
+#include <string.h>
+
+void makeTimeSnapshot(time_t epoch, LocalTimeMapping& tz, TimeSnapshot& out) {
+    memset(&out, 0, sizeof(out));
+    out.epoch = epoch;
+    out.local = tz.toLocal(epoch);
+
+    long secs = (long)(out.local % SECONDS_PER_DAY);
+    out.days = (long)(out.local / SECONDS_PER_DAY);
+    if (secs < 0) {
+        secs += SECONDS_PER_DAY;
+        out.days--;
+    }
+
+    civilFromDays(out.days, out.year, out.month, out.day);
+    out.dayOfWeek = dayOfWeekFromDays(out.days);
+    out.hour = (uint8_t)(secs / 3600);
+    out.minute = (uint8_t)(secs / 60 % 60);
+    out.second = (uint8_t)(secs % 60);
+    out.valid = true;
+}
+
+uint8_t timeSnapshotTicks(const TimeSnapshot& prev, const TimeSnapshot& now) {
+    if (!now.valid) return 0;
+    if (!prev.valid) return TIME_TICK_SECOND | TIME_TICK_MINUTE | TIME_TICK_DAY;
+
+    if (now.local == prev.local) return 0;
+    uint8_t ticks = TIME_TICK_SECOND;
+
+    // Compare whole minutes, so a jump (NTP step, DST) still counts once
+    if (now.local / 60 != prev.local / 60) ticks |= TIME_TICK_MINUTE;
+    if (now.days != prev.days) ticks |= TIME_TICK_DAY;
+    return ticks;
+}
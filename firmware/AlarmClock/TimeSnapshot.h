@@ -0,0 +1,39 @@
+#ifndef TIME_SNAPSHOT_H
+#define TIME_SNAPSHOT_H
+
+// Broken-down local time, converted once per second by TimeModule and read
+// by everything else. Plain data with no Arduino or ezTime dependencies.
+
+#include <stdint.h>
+#include <time.h>
+#include "AlarmSchedule.h"
+
+struct TimeSnapshot {
+    time_t epoch;        // UTC seconds since 1970 (0 = clock not set)
+    time_t local;        // Local wall-clock seconds since 1970
+    long days;           // Local days since 1970 (changes at local midnight)
+    uint16_t year;
+    uint8_t month;       // 1-12
+    uint8_t day;         // 1-31
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint8_t dayOfWeek;   // 0=Sunday, 6=Saturday
+    bool valid;
+};
+
+// Which boundaries were crossed between two snapshots
+enum TimeTick {
+    TIME_TICK_SECOND = 1 << 0,
+    TIME_TICK_MINUTE = 1 << 1,
+    TIME_TICK_DAY    = 1 << 2
+};
+
+// One timezone conversion, then civil-date math
+void makeTimeSnapshot(time_t epoch, LocalTimeMapping& tz, TimeSnapshot& out);
+
+// TIME_TICK_* bits set when now differs from prev in that unit (or finer
+// units roll over); all set when prev is not valid yet
+uint8_t timeSnapshotTicks(const TimeSnapshot& prev, const TimeSnapshot& now);
+
+#endif
@@ -0,0 +1,289 @@
+// Generated by web/build_assets.py - do not edit by hand
+#include "WebAssets.h"
+
+static const uint8_t WEB_ASSET_APP_CSS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x58, 0x4d, 0x6f, 0xe3, 0x36,
+    0x10, 0xbd, 0xe7, 0x57, 0x10, 0x1b, 0x2c, 0xd6, 0x29, 0x2c, 0x43, 0x1f, 0x96, 0xed, 0xc8, 0xe8,
+    0xa1, 0x3d, 0x14, 0xe8, 0xa1, 0xa7, 0x45, 0x81, 0x16, 0x45, 0x0f, 0x14, 0x49, 0x49, 0xac, 0x65,
+    0x51, 0xa0, 0xa4, 0xd8, 0xde, 0xc5, 0xfe, 0xf7, 0x1d, 0x4a, 0x94, 0x44, 0xc9, 0x54, 0x12, 0xa0,
+    0x45, 0x13, 0x20, 0x96, 0x29, 0x72, 0xf8, 0x66, 0xf8, 0xe6, 0xcd, 0x30, 0x3f, 0xa0, 0xaf, 0xe8,
+    0x8c, 0x65, 0xca, 0x8b, 0x08, 0xb9, 0x47, 0x54, 0x62, 0x4a, 0x79, 0x91, 0xb6, 0xcf, 0xb1, 0xb8,
+    0x3a, 0x15, 0xff, 0xd2, 0x7e, 0x8d, 0x85, 0xa4, 0x4c, 0x3a, 0x30, 0x74, 0x44, 0xdf, 0x1e, 0x62,
+    0x41, 0x6f, 0xe8, 0xeb, 0x03, 0x82, 0x9f, 0x44, 0x14, 0xb5, 0x93, 0xe0, 0x33, 0xcf, 0x6f, 0x11,
+    0x72, 0x70, 0x59, 0xe6, 0xcc, 0xa9, 0x6e, 0x55, 0xcd, 0xce, 0x6b, 0xf4, 0x73, 0xce, 0x8b, 0xd3,
+    0x6f, 0x98, 0x7c, 0x6e, 0xbf, 0xff, 0x02, 0x33, 0xd7, 0xe8, 0xd3, 0x67, 0x96, 0x0a, 0x86, 0x7e,
+    0xff, 0xf5, 0xd3, 0x1a, 0xfd, 0x24, 0x39, 0xce, 0xd7, 0xa8, 0xc2, 0x45, 0xe5, 0x54, 0x4c, 0xf2,
+    0xe4, 0xd8, 0x9a, 0x8c, 0x31, 0x39, 0xa5, 0x52, 0x34, 0x05, 0x8d, 0x10, 0x58, 0x60, 0x58, 0x3a,
+    0xa9, 0xc4, 0x94, 0xb3, 0xa2, 0x5e, 0x79, 0x41, 0x48, 0x59, 0xba, 0x46, 0x8f, 0xbb, 0xdd, 0x9e,
+    0x31, 0x8c, 0xdc, 0x8f, 0xf0, 0xbc, 0xdf, 0x6d, 0x63, 0xec, 0x23, 0xcf, 0x75, 0x3f, 0x3e, 0x75,
+    0x26, 0xce, 0xbc, 0x70, 0x32, 0xc6, 0xd3, 0xac, 0x8e, 0xd4, 0xf0, 0x4b, 0xd6, 0x0d, 0x0f, 0xde,
+    0xf9, 0x6e, 0x79, 0x3d, 0x3e, 0x7c, 0x7b, 0xd8, 0x10, 0x00, 0x85, 0x61, 0x0f, 0xa9, 0xdd, 0x39,
+    0xe3, 0xab, 0x73, 0xe1, 0xb4, 0xce, 0x22, 0x74, 0x70, 0xdb, 0x49, 0xdd, 0xa8, 0x0e, 0x10, 0xc2,
+    0x4d, 0x2d, 0xee, 0x51, 0x5e, 0x32, 0x5e, 0x33, 0x3d, 0xdc, 0x05, 0x4a, 0xe1, 0x6d, 0x2a, 0xd8,
+    0x3c, 0xec, 0x6d, 0xb4, 0xd1, 0xcc, 0x30, 0x15, 0x17, 0x65, 0xc7, 0x03, 0xdb, 0x68, 0xab, 0xfe,
+    0xc8, 0x34, 0xc6, 0x2b, 0x77, 0xdd, 0xfe, 0x6e, 0x7c, 0x8d, 0x5f, 0xbc, 0x30, 0x99, 0xe4, 0x6a,
+    0x6a, 0xc6, 0x29, 0x65, 0x45, 0x8b, 0x35, 0x63, 0x98, 0x0e, 0x40, 0xff, 0x83, 0x20, 0x11, 0x91,
+    0x0b, 0x39, 0x01, 0x3f, 0xc4, 0x27, 0x18, 0x5c, 0xaf, 0xd9, 0xb5, 0x76, 0x70, 0xce, 0x53, 0x70,
+    0x9f, 0x80, 0x71, 0x26, 0x4d, 0x2c, 0x99, 0x67, 0xd2, 0x00, 0xc8, 0xc2, 0x20, 0xb6, 0xec, 0x6c,
+    0x46, 0x0d, 0x38, 0x53, 0xd7, 0xe2, 0x1c, 0xb5, 0x2e, 0xb7, 0x6b, 0x0b, 0xfc, 0xa2, 0x57, 0x51,
+    0x5e, 0x95, 0x39, 0x06, 0xe2, 0x24, 0x39, 0xbb, 0xde, 0x87, 0xf5, 0x31, 0x39, 0x24, 0xcf, 0x09,
+    0x9e, 0x04, 0xb6, 0xb7, 0xe6, 0x43, 0xe8, 0x2a, 0x91, 0x73, 0x8a, 0x1e, 0xd9, 0x33, 0x23, 0x2c,
+    0x99, 0x06, 0xce, 0xb9, 0x46, 0xfa, 0xac, 0xf4, 0x86, 0xb8, 0x07, 0x0a, 0x3b, 0x01, 0x96, 0x91,
+    0x26, 0xfa, 0xb4, 0xbd, 0xf1, 0xb4, 0x87, 0x28, 0x8c, 0x87, 0x67, 0x8b, 0xc2, 0x30, 0x4e, 0x19,
+    0x11, 0x12, 0xd7, 0x5c, 0xc0, 0xcb, 0x42, 0x14, 0x6c, 0x12, 0xdd, 0xc7, 0xed, 0x73, 0xe8, 0x86,
+    0xfb, 0xe3, 0x18, 0xa5, 0x8b, 0xe6, 0xe5, 0xce, 0x75, 0xb5, 0x11, 0x09, 0x09, 0xc0, 0xbb, 0xf5,
+    0x38, 0xcf, 0x91, 0xbb, 0x09, 0x2a, 0xab, 0xcf, 0xc1, 0xe0, 0x73, 0xbb, 0xa4, 0xc4, 0x12, 0xa0,
+    0x8c, 0x1e, 0x46, 0x99, 0xf2, 0xde, 0xc2, 0x8f, 0x49, 0x84, 0x7a, 0x5c, 0x1d, 0x37, 0xc6, 0xd5,
+    0x1b, 0x4c, 0x6a, 0xfe, 0xc2, 0xf4, 0xf2, 0xf9, 0xac, 0x3b, 0x34, 0x8e, 0xc5, 0x8e, 0x4a, 0x26,
+    0x40, 0xa4, 0x4d, 0xcc, 0xc8, 0x04, 0xef, 0x13, 0x21, 0xcf, 0x8e, 0x02, 0x55, 0x0e, 0xd9, 0x36,
+    0x61, 0x88, 0x6f, 0x99, 0x98, 0xe3, 0x98, 0xe5, 0x73, 0xba, 0xc4, 0xb9, 0x20, 0x27, 0x2b, 0xc9,
+    0x0e, 0xfd, 0x89, 0xbd, 0x2f, 0xfc, 0xd3, 0xbd, 0x78, 0x51, 0x36, 0x20, 0x51, 0xe6, 0x50, 0xc5,
+    0x72, 0x46, 0x7a, 0x8f, 0x46, 0xaa, 0x7c, 0x9c, 0x33, 0xc5, 0x1f, 0xd3, 0x5c, 0x05, 0x69, 0x91,
+    0x9f, 0x33, 0x79, 0x18, 0xe0, 0x1a, 0xf9, 0xe3, 0xed, 0x06, 0xd6, 0x19, 0xc4, 0xd0, 0x0b, 0x5b,
+    0xb7, 0x34, 0x43, 0x2c, 0xe0, 0xa3, 0x44, 0x90, 0xa6, 0xb2, 0xb9, 0xd0, 0xbd, 0xd1, 0x8e, 0x88,
+    0xa6, 0x56, 0x9a, 0x61, 0xd2, 0xd5, 0xb4, 0x3f, 0x39, 0xd5, 0xb8, 0x81, 0xc8, 0x16, 0xf3, 0x33,
+    0x55, 0x0e, 0x23, 0x7f, 0x3b, 0xf7, 0xfa, 0xce, 0xde, 0xfb, 0x1c, 0xb5, 0xe7, 0x05, 0x69, 0x64,
+    0xa5, 0xc0, 0x94, 0x82, 0x1b, 0x19, 0xb7, 0x98, 0x2c, 0xbd, 0x48, 0x87, 0x9a, 0x44, 0x71, 0x5d,
+    0x38, 0xa5, 0xe4, 0x30, 0x7c, 0xb3, 0xe5, 0x84, 0xc9, 0xec, 0xa9, 0x12, 0x4e, 0xd7, 0x2e, 0x67,
+    0x55, 0x18, 0xee, 0x0e, 0x34, 0x30, 0x60, 0xa9, 0xa0, 0x47, 0xdd, 0x63, 0x8e, 0x6b, 0xf6, 0xe7,
+    0xca, 0x81, 0x28, 0x3d, 0xd9, 0xe4, 0x1f, 0x30, 0xb6, 0xea, 0xd2, 0xa9, 0xbf, 0xe7, 0xfa, 0x6b,
+    0x88, 0xe8, 0x6e, 0x8d, 0xfc, 0x60, 0xbb, 0x06, 0x97, 0xb6, 0x4f, 0x03, 0x8a, 0xaa, 0x21, 0x84,
+    0x55, 0x95, 0x6d, 0x7f, 0xff, 0x80, 0xf7, 0xdb, 0xf0, 0x15, 0x0f, 0xf4, 0xda, 0x65, 0x0f, 0x7c,
+    0xef, 0x70, 0x08, 0x0e, 0xc3, 0x7c, 0x8a, 0x8b, 0xd4, 0x3e, 0x91, 0x92, 0x20, 0x7c, 0x75, 0xab,
+    0x6e, 0xe9, 0xf2, 0x4e, 0xe4, 0xe0, 0x07, 0x41, 0x30, 0x4c, 0xbf, 0x60, 0x59, 0x00, 0x8f, 0x6c,
+    0x33, 0x93, 0x84, 0x78, 0xee, 0x7e, 0x9a, 0xc4, 0xae, 0xce, 0x55, 0x63, 0xe9, 0x2b, 0x62, 0xe7,
+    0xe2, 0x83, 0x9e, 0x5f, 0xd5, 0xad, 0x2c, 0x3b, 0x04, 0x4b, 0x6a, 0xdd, 0xcb, 0xa8, 0x2f, 0xb3,
+    0xde, 0xc0, 0x56, 0xcb, 0x67, 0xfd, 0xc0, 0x58, 0xd9, 0x86, 0x3a, 0x61, 0x29, 0x68, 0xff, 0x34,
+    0x55, 0xcd, 0x93, 0x9b, 0xa3, 0xc5, 0x31, 0x42, 0xa0, 0xdb, 0x84, 0x39, 0x31, 0xab, 0x2f, 0x4c,
+    0x15, 0x76, 0x35, 0xa7, 0xad, 0x2c, 0x0e, 0xc4, 0xf3, 0x5c, 0xcd, 0xea, 0x8b, 0x95, 0xed, 0x33,
+    0xcf, 0xde, 0xa7, 0xfb, 0x36, 0x86, 0xfe, 0xb1, 0x0a, 0x5b, 0x82, 0x1a, 0x06, 0x79, 0x91, 0x08,
+    0x94, 0x05, 0xb3, 0x32, 0x60, 0xaa, 0xe8, 0xcc, 0xf9, 0x3e, 0xdd, 0x26, 0x06, 0xca, 0x79, 0x19,
+    0x21, 0xfb, 0x70, 0x4f, 0xef, 0x14, 0xc0, 0xdd, 0x3c, 0xf7, 0xcd, 0xc2, 0x05, 0x62, 0xed, 0xc4,
+    0x92, 0xe1, 0x13, 0x68, 0x9d, 0xfa, 0x80, 0x72, 0x9b, 0x4f, 0x0c, 0xab, 0xfa, 0x24, 0x8a, 0x6a,
+    0xb9, 0x75, 0x48, 0x71, 0x69, 0x74, 0x19, 0x38, 0x67, 0xf2, 0xae, 0x14, 0x99, 0xed, 0x98, 0x5d,
+    0x9f, 0xac, 0x25, 0x69, 0xb2, 0x61, 0xa7, 0x71, 0xfd, 0x0e, 0x9b, 0x57, 0x12, 0x94, 0x6e, 0x19,
+    0xa5, 0x53, 0x89, 0x79, 0xf4, 0xc2, 0x70, 0xef, 0x6f, 0xa7, 0xaa, 0xe9, 0x8d, 0xb5, 0x82, 0x04,
+    0x6c, 0x47, 0x62, 0xc3, 0x3c, 0x93, 0x52, 0x48, 0x3b, 0x77, 0xe9, 0x7e, 0x6e, 0x7c, 0xef, 0x7b,
+    0xe4, 0x15, 0xe3, 0x49, 0x48, 0x7a, 0xe3, 0xea, 0x94, 0x54, 0x37, 0x6f, 0x65, 0xcd, 0x3e, 0x09,
+    0x92, 0x69, 0xbd, 0xca, 0x59, 0x02, 0xcc, 0xdd, 0x8e, 0xa6, 0x4c, 0xf5, 0xfc, 0xb7, 0xd1, 0x35,
+    0xe1, 0xdc, 0x31, 0xcf, 0xdc, 0x68, 0xa9, 0xa1, 0xac, 0x00, 0x52, 0x5b, 0xbb, 0xe6, 0xbd, 0x7c,
+    0x57, 0x10, 0x54, 0xff, 0x81, 0x5c, 0x63, 0xe6, 0x52, 0x39, 0xef, 0x6f, 0x0c, 0x87, 0x05, 0x37,
+    0x46, 0xf7, 0x96, 0x92, 0xcc, 0x52, 0x58, 0xa1, 0xae, 0xc5, 0x27, 0x5e, 0xab, 0xab, 0x11, 0x34,
+    0xe9, 0xb8, 0x20, 0xcc, 0xa0, 0x50, 0x87, 0x27, 0x8a, 0xfa, 0x49, 0xda, 0x93, 0x3a, 0x6b, 0xce,
+    0xb1, 0x46, 0xb9, 0xbc, 0xbe, 0x55, 0x0e, 0xeb, 0xa8, 0xf6, 0xcc, 0x1f, 0x00, 0xf7, 0x9e, 0xf9,
+    0x4b, 0x27, 0x14, 0xf6, 0x31, 0x58, 0xae, 0x91, 0xf3, 0x6a, 0x6c, 0xc2, 0x3f, 0x8b, 0x2f, 0x60,
+    0x0a, 0x4a, 0xc0, 0x04, 0xfa, 0xff, 0x0b, 0xc3, 0x79, 0xc1, 0x79, 0xc3, 0xe6, 0xf2, 0xc0, 0x0b,
+    0x75, 0x20, 0x8e, 0xd9, 0x31, 0x8e, 0x4d, 0x7f, 0xe8, 0xbe, 0xd5, 0xe0, 0x9b, 0xed, 0xca, 0x26,
+    0xec, 0xc5, 0x6a, 0xd2, 0xaf, 0xc4, 0x22, 0xa7, 0xc7, 0xb7, 0x38, 0xdb, 0x25, 0x90, 0xd7, 0x8b,
+    0x25, 0xc9, 0x18, 0x39, 0xa9, 0x96, 0xc0, 0xec, 0x86, 0x07, 0xcc, 0xa9, 0xe4, 0xda, 0xa2, 0x7a,
+    0x72, 0xa0, 0x2c, 0x94, 0x4a, 0xad, 0x55, 0x73, 0xd6, 0x9c, 0x0b, 0x08, 0x93, 0x64, 0x70, 0xea,
+    0xf5, 0x4a, 0x5d, 0x70, 0x9c, 0x84, 0x43, 0xcb, 0x0a, 0x3e, 0xc1, 0xcd, 0x75, 0xe5, 0xab, 0x4b,
+    0x0c, 0xb4, 0x12, 0x89, 0x7c, 0x7a, 0x32, 0x35, 0x31, 0x9c, 0x5f, 0x64, 0xfd, 0x31, 0x25, 0x06,
+    0x28, 0xaa, 0xfc, 0x2c, 0x8b, 0xeb, 0x62, 0x89, 0xb2, 0xf5, 0xc0, 0x6f, 0xdc, 0xe1, 0xee, 0x64,
+    0x61, 0xd2, 0xe8, 0x0e, 0x8b, 0xc7, 0x6a, 0x37, 0xc1, 0xf8, 0x76, 0xb9, 0xbb, 0xf3, 0xaa, 0xed,
+    0x8d, 0xff, 0xaa, 0x6f, 0x25, 0xfb, 0xf1, 0x43, 0xff, 0xe6, 0xc3, 0xdf, 0x33, 0x96, 0xba, 0x77,
+    0x2c, 0x9d, 0xd7, 0x7b, 0xd9, 0xff, 0x43, 0x61, 0xb8, 0x64, 0x58, 0xc8, 0x38, 0xdd, 0xd9, 0xbc,
+    0xbe, 0x58, 0xfb, 0xd9, 0xa6, 0x82, 0x80, 0xe8, 0x16, 0x7d, 0xd0, 0x85, 0xef, 0x46, 0x93, 0x5a,
+    0xb2, 0x95, 0x11, 0x00, 0x00,
+};
+
+static const uint8_t WEB_ASSET_ALARMS_CSS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x56, 0x4d, 0x6f, 0xe3, 0x36,
+    0x10, 0xbd, 0xfb, 0x57, 0x10, 0x1b, 0x2c, 0x36, 0xbb, 0xb5, 0x0c, 0xc5, 0x9f, 0x89, 0x7c, 0x6a,
+    0x0f, 0x05, 0x7a, 0xe8, 0x69, 0x51, 0xa0, 0x57, 0x8a, 0x1c, 0x49, 0xdc, 0x50, 0xa4, 0x40, 0xd2,
+    0xb1, 0xdd, 0x45, 0xfe, 0x7b, 0x49, 0x51, 0xa2, 0x3e, 0x4c, 0xa3, 0x39, 0x34, 0x06, 0x02, 0x89,
+    0xe6, 0x3c, 0xbe, 0x99, 0x79, 0x6f, 0xe8, 0x6f, 0xe8, 0x27, 0xaa, 0xb1, 0x2a, 0x99, 0xc8, 0x50,
+    0x7a, 0x44, 0x0d, 0xa6, 0x94, 0x89, 0xb2, 0x7d, 0xce, 0xe5, 0x25, 0xd1, 0xec, 0x9f, 0xf6, 0x35,
+    0x97, 0x8a, 0x82, 0x4a, 0xec, 0xd2, 0x11, 0xbd, 0x2f, 0x72, 0x49, 0xaf, 0xe8, 0xe7, 0x02, 0xd9,
+    0xbf, 0x42, 0x0a, 0x93, 0x14, 0xb8, 0x66, 0xfc, 0x9a, 0xa1, 0x04, 0x37, 0x0d, 0x87, 0x44, 0x5f,
+    0xb5, 0x81, 0x7a, 0x89, 0x7e, 0xe3, 0x4c, 0xbc, 0xfe, 0x89, 0xc9, 0xf7, 0xf6, 0xfd, 0x77, 0xbb,
+    0x73, 0x89, 0xbe, 0x7c, 0x87, 0x52, 0x02, 0xfa, 0xeb, 0x8f, 0x2f, 0x4b, 0xf4, 0xab, 0x62, 0x98,
+    0x2f, 0x91, 0xc6, 0x42, 0x27, 0x1a, 0x14, 0x2b, 0x8e, 0x2d, 0x64, 0x8e, 0xc9, 0x6b, 0xa9, 0xe4,
+    0x49, 0xd0, 0x0c, 0x59, 0x04, 0xc0, 0x2a, 0x29, 0x15, 0xa6, 0x0c, 0x84, 0x79, 0x7c, 0xda, 0xec,
+    0x28, 0x94, 0x4b, 0xf4, 0xb0, 0xdf, 0x1f, 0x00, 0x30, 0x4a, 0x3f, 0xdb, 0xe7, 0xc3, 0x7e, 0x9b,
+    0xe3, 0x35, 0x7a, 0x4a, 0xd3, 0xcf, 0x5f, 0x3d, 0x44, 0xcd, 0x44, 0x52, 0x01, 0x2b, 0x2b, 0x93,
+    0xb9, 0xe5, 0xb7, 0xca, 0x2f, 0x87, 0xec, 0xd6, 0x69, 0x73, 0x39, 0x2e, 0xde, 0x17, 0x2b, 0x62,
+    0x49, 0x61, 0x7b, 0x86, 0xea, 0xd2, 0xa9, 0xf1, 0x25, 0x39, 0x33, 0x6a, 0xaa, 0x0c, 0xbd, 0xa4,
+    0xed, 0x26, 0xbf, 0xda, 0x15, 0x08, 0xe1, 0x93, 0x91, 0xb7, 0x2c, 0xcf, 0x15, 0x33, 0xd0, 0x2d,
+    0xfb, 0x42, 0x39, 0xbe, 0x27, 0x6d, 0x0f, 0xdf, 0xf5, 0x18, 0x6d, 0x35, 0x2b, 0x4c, 0xe5, 0xd9,
+    0xe1, 0x3c, 0x59, 0x6c, 0xb4, 0x75, 0xff, 0x54, 0x99, 0xe3, 0xc7, 0x74, 0xd9, 0x7e, 0x56, 0xeb,
+    0x8e, 0xbf, 0x7c, 0x03, 0x55, 0x70, 0xb7, 0xb5, 0x62, 0x94, 0x82, 0x68, 0xb9, 0x56, 0x80, 0x69,
+    0x20, 0xfa, 0x3f, 0x14, 0x89, 0x48, 0x2e, 0xd5, 0x84, 0x7c, 0xa8, 0xcf, 0x26, 0xa4, 0x6e, 0xe0,
+    0x62, 0x12, 0xcc, 0x59, 0x69, 0xd3, 0x27, 0x16, 0x1c, 0x54, 0xcb, 0x45, 0xe0, 0xb7, 0x8e, 0x08,
+    0x65, 0xba, 0xe1, 0xd8, 0x36, 0xbf, 0xe0, 0x70, 0xb9, 0x2d, 0xcd, 0x43, 0xf1, 0x5c, 0xbc, 0x14,
+    0x78, 0x52, 0x9c, 0x5c, 0x1a, 0x23, 0x6b, 0xdb, 0x05, 0x9b, 0xbe, 0x96, 0x9c, 0x51, 0xf4, 0x00,
+    0x2f, 0x40, 0xa0, 0x08, 0xd0, 0xb8, 0x57, 0x97, 0xc5, 0xb4, 0x45, 0x9c, 0xb1, 0x1b, 0x8a, 0x1a,
+    0x63, 0x17, 0xd6, 0x29, 0x10, 0xa9, 0xb0, 0x61, 0xd2, 0x7e, 0x29, 0xa4, 0x80, 0x49, 0xd6, 0x0f,
+    0xdb, 0x97, 0x5d, 0xba, 0x3b, 0x1c, 0x07, 0x11, 0x9f, 0x3b, 0xbd, 0xec, 0xd3, 0xb4, 0x03, 0x51,
+    0x56, 0x98, 0xcc, 0xc7, 0x63, 0xce, 0x51, 0xba, 0xda, 0xe8, 0x68, 0x1e, 0x9b, 0x90, 0x47, 0x1b,
+    0xd2, 0x60, 0x65, 0xa9, 0x0c, 0xb9, 0x64, 0x95, 0x6b, 0x67, 0xa4, 0x6f, 0x21, 0xeb, 0x31, 0x2f,
+    0xdf, 0xb3, 0x21, 0x7a, 0x85, 0x89, 0x61, 0x6f, 0xd0, 0x85, 0xcf, 0x77, 0xdd, 0xb0, 0x49, 0x22,
+    0x38, 0x4e, 0xe4, 0x96, 0x51, 0x07, 0x31, 0x6b, 0xb2, 0xfd, 0x1e, 0x73, 0xac, 0x6c, 0x20, 0x56,
+    0x34, 0x46, 0x72, 0xdc, 0xc0, 0x99, 0x81, 0x62, 0x82, 0x9f, 0x99, 0x66, 0x68, 0xf6, 0x2c, 0xe2,
+    0x5e, 0xfb, 0x07, 0x32, 0x2b, 0x10, 0x38, 0xe7, 0x10, 0x48, 0xf9, 0x83, 0xfa, 0xfc, 0xd6, 0xcf,
+    0xf8, 0xb0, 0xdd, 0x45, 0x04, 0x47, 0xb7, 0x40, 0xa9, 0x4f, 0xbc, 0x90, 0x16, 0xca, 0x7d, 0xd1,
+    0x04, 0x7b, 0x4f, 0x38, 0x79, 0x21, 0x4d, 0x37, 0x72, 0x9c, 0x03, 0x9f, 0x6b, 0x3b, 0xe7, 0x92,
+    0xbc, 0x46, 0xd3, 0x0a, 0x52, 0xfc, 0x98, 0xae, 0xa6, 0x67, 0x31, 0xd1, 0x9c, 0xec, 0x4c, 0x1c,
+    0x2f, 0x69, 0xe0, 0x40, 0xfa, 0x56, 0x75, 0x93, 0xc8, 0x79, 0x76, 0x6e, 0x81, 0x8f, 0x54, 0x33,
+    0xd2, 0x9e, 0xe7, 0x3e, 0xac, 0xa5, 0x66, 0xa7, 0x3b, 0x58, 0xac, 0xbd, 0xaf, 0x42, 0x7e, 0xb2,
+    0x29, 0x89, 0xb9, 0x4a, 0xda, 0x49, 0x75, 0xdb, 0xbc, 0xc1, 0x50, 0x1f, 0x3e, 0xe1, 0xbe, 0xd3,
+    0xc8, 0x49, 0x69, 0x57, 0xbc, 0x46, 0xb2, 0x91, 0x87, 0xef, 0xda, 0xaf, 0x1f, 0xc7, 0x7d, 0xf7,
+    0x72, 0x23, 0x92, 0x46, 0x31, 0xbb, 0x7c, 0x8d, 0x09, 0x78, 0xec, 0x95, 0xe9, 0xcc, 0xeb, 0x62,
+    0xf5, 0x89, 0x10, 0xd0, 0x3a, 0x16, 0x3b, 0x56, 0x59, 0x34, 0xf6, 0x8c, 0x95, 0xb0, 0x75, 0x8a,
+    0x1a, 0xa7, 0x20, 0x4f, 0xe9, 0x61, 0xaa, 0x8e, 0xb4, 0x13, 0x81, 0x0b, 0xa5, 0x58, 0x94, 0xf1,
+    0xb9, 0x40, 0xc9, 0x66, 0x77, 0xf7, 0x54, 0x6f, 0x90, 0xc9, 0x65, 0x10, 0x99, 0xc1, 0x3f, 0x4e,
+    0xda, 0xb0, 0xe2, 0x9a, 0x74, 0xde, 0xcf, 0x90, 0x1d, 0x4b, 0x04, 0x92, 0x1c, 0xcc, 0x19, 0xdc,
+    0x7d, 0xe2, 0xf6, 0xb4, 0x83, 0x33, 0xb1, 0xb8, 0xb5, 0x9e, 0x8e, 0xcf, 0x7b, 0x36, 0xf1, 0x47,
+    0x1b, 0x56, 0xc3, 0xf8, 0xf6, 0xf7, 0x3d, 0x5e, 0x43, 0x1d, 0x69, 0x71, 0x2e, 0x39, 0x8d, 0xfb,
+    0xc3, 0xc2, 0x19, 0x59, 0x96, 0x1c, 0xe6, 0x39, 0x30, 0xe1, 0xee, 0xb3, 0x64, 0x64, 0xb9, 0x46,
+    0xf6, 0x3a, 0x50, 0xc0, 0xb1, 0x9b, 0x86, 0xc7, 0xb1, 0x3d, 0xf6, 0x41, 0x9c, 0xfd, 0x95, 0xbf,
+    0xd9, 0x76, 0x84, 0xbb, 0x13, 0x5a, 0x9f, 0x75, 0xe7, 0x48, 0x5b, 0x07, 0x66, 0xae, 0xee, 0x17,
+    0xce, 0x18, 0x24, 0x9d, 0x22, 0xf8, 0x2e, 0x69, 0x6b, 0xa7, 0x50, 0xe4, 0x81, 0x05, 0xce, 0xad,
+    0xd1, 0x4e, 0xfd, 0xa5, 0x19, 0x17, 0xaf, 0x6c, 0x02, 0x26, 0x87, 0xc2, 0x84, 0x17, 0x15, 0xf0,
+    0xbd, 0x77, 0x7c, 0x85, 0xd3, 0xf9, 0x1c, 0x0b, 0x63, 0x8e, 0x10, 0x72, 0x6b, 0x87, 0xd5, 0x56,
+    0x47, 0xbd, 0x17, 0xf2, 0xf6, 0xc4, 0xb3, 0x1c, 0xec, 0x64, 0x81, 0xff, 0xe2, 0xdf, 0x2b, 0xe4,
+    0xd3, 0xa7, 0x69, 0x0d, 0xd6, 0xc1, 0xb5, 0x5d, 0x8d, 0x86, 0x05, 0x9f, 0xd2, 0x76, 0x18, 0x0a,
+    0x3e, 0x8d, 0x61, 0xe1, 0x26, 0x91, 0xd1, 0xaf, 0x8c, 0x8f, 0x64, 0xb2, 0x73, 0x13, 0xef, 0x7d,
+    0xd1, 0x36, 0x2e, 0x23, 0x15, 0x90, 0x57, 0x7b, 0x0f, 0xfc, 0x82, 0xa6, 0x1d, 0x89, 0x94, 0xab,
+    0xf7, 0xeb, 0xdd, 0xd0, 0x69, 0x4d, 0x5a, 0x2a, 0x6e, 0xfa, 0x66, 0xfe, 0xd1, 0xaa, 0x0b, 0xfe,
+    0x7e, 0x74, 0x79, 0x7e, 0x75, 0x18, 0xff, 0x02, 0x84, 0x54, 0x72, 0x12, 0x1d, 0x0b, 0x00, 0x00,
+};
+
+static const uint8_t WEB_ASSET_APP_JS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x59, 0xdd, 0x6f, 0xdb, 0x36,
+    0x10, 0x7f, 0xcf, 0x5f, 0xc1, 0xf6, 0x21, 0x92, 0x56, 0xc7, 0x76, 0xd6, 0x15, 0xd8, 0x92, 0x65,
+    0x45, 0xd6, 0x36, 0x40, 0x87, 0x76, 0x09, 0xea, 0xb6, 0x2f, 0x45, 0x11, 0x30, 0xd2, 0xd9, 0x16,
+    0x26, 0x89, 0x1e, 0x49, 0xc5, 0xf5, 0x3a, 0xff, 0xef, 0xbb, 0x23, 0xa9, 0x4f, 0xcb, 0x8a, 0x5b,
+    0x2c, 0xc8, 0x32, 0x34, 0x2f, 0xb1, 0xa8, 0xfb, 0xbe, 0xdf, 0x1d, 0x8f, 0xd4, 0x68, 0xc4, 0x4e,
+    0xe8, 0x8f, 0x4d, 0xe6, 0x5c, 0x42, 0x64, 0x1f, 0xf6, 0xf6, 0xa6, 0x79, 0x16, 0xea, 0x58, 0x64,
+    0x4c, 0xcd, 0xc5, 0xf2, 0x34, 0x01, 0xa9, 0xfd, 0x14, 0x94, 0xe2, 0x33, 0x18, 0xb0, 0x58, 0xbd,
+    0x90, 0x52, 0x48, 0x76, 0xc2, 0xa6, 0x3c, 0x51, 0x10, 0xb0, 0xcf, 0x7b, 0x0c, 0xff, 0x42, 0x91,
+    0x29, 0xcd, 0x38, 0xd1, 0xe2, 0xab, 0x48, 0x84, 0x79, 0x0a, 0x99, 0x1e, 0xce, 0x40, 0xbf, 0x48,
+    0x80, 0x7e, 0xfe, 0xba, 0x7a, 0x19, 0xf9, 0x9e, 0x21, 0xf0, 0x82, 0x63, 0xc3, 0x63, 0x1e, 0x86,
+    0x1a, 0x3e, 0xe9, 0x67, 0x22, 0xd3, 0x48, 0x83, 0x9c, 0x4e, 0x4f, 0x9d, 0x20, 0x4c, 0xb8, 0x52,
+    0xbf, 0xf3, 0x14, 0xf0, 0xb5, 0x15, 0xc0, 0x3c, 0xf6, 0x88, 0xf9, 0x85, 0x25, 0x4f, 0x99, 0x07,
+    0xf4, 0xc3, 0x63, 0x47, 0xcc, 0x53, 0x79, 0x18, 0xa2, 0x88, 0xa6, 0x0a, 0xa5, 0x57, 0x09, 0x0c,
+    0xa3, 0x58, 0x2d, 0x12, 0xbe, 0x22, 0x29, 0x57, 0x89, 0x08, 0xff, 0xf0, 0x2c, 0x89, 0x02, 0xfd,
+    0x36, 0x4e, 0x41, 0xe4, 0xda, 0xf7, 0x03, 0x76, 0xf2, 0x8b, 0x73, 0xa8, 0x87, 0x3b, 0x13, 0x19,
+    0x38, 0xe6, 0xf5, 0x80, 0xfd, 0x30, 0x1e, 0x8f, 0x51, 0xdb, 0x7a, 0x6f, 0x6f, 0x34, 0x62, 0x53,
+    0xd0, 0xe1, 0x1c, 0xc5, 0xe8, 0x39, 0xd7, 0x4c, 0x82, 0x96, 0x31, 0x28, 0xb6, 0x9c, 0x43, 0x86,
+    0x2b, 0xc0, 0x42, 0x52, 0xcb, 0x78, 0xa6, 0x96, 0x20, 0x15, 0x7b, 0x32, 0x7e, 0xcc, 0xfc, 0xab,
+    0x5c, 0xad, 0x82, 0x23, 0xf3, 0x56, 0xc2, 0x9f, 0x39, 0x60, 0x10, 0x97, 0x5c, 0x91, 0x28, 0x9d,
+    0xcb, 0x0c, 0x53, 0xc2, 0x97, 0xa8, 0xf4, 0x0a, 0xa6, 0x42, 0x02, 0x8b, 0x51, 0x26, 0xcf, 0x06,
+    0x4c, 0x09, 0xb4, 0x3a, 0x8b, 0xe2, 0x6c, 0x46, 0x4b, 0x7c, 0xc6, 0xe3, 0x0c, 0xf3, 0xc2, 0x14,
+    0x9f, 0x42, 0x95, 0x3b, 0x63, 0xca, 0x1b, 0x34, 0x61, 0xe5, 0xe7, 0x32, 0x19, 0x30, 0xb1, 0xa0,
+    0x65, 0x85, 0x0e, 0x7c, 0x46, 0xab, 0xb9, 0xd6, 0x90, 0x2e, 0x34, 0x3d, 0x3e, 0x2e, 0x72, 0x88,
+    0xf6, 0xa2, 0x4e, 0xe7, 0x43, 0x9d, 0x27, 0x18, 0xa2, 0x7d, 0x99, 0x2f, 0x41, 0x2d, 0xf0, 0x09,
+    0x9a, 0x41, 0x8a, 0xa7, 0xac, 0x7c, 0x83, 0xb1, 0xe2, 0x3a, 0x57, 0xec, 0x01, 0x42, 0x8a, 0xdc,
+    0xfb, 0xfb, 0xef, 0x4a, 0xd1, 0xcf, 0x27, 0xec, 0x30, 0x28, 0x74, 0x14, 0x0c, 0xc7, 0xa5, 0x18,
+    0x0b, 0x20, 0x05, 0xf8, 0x3f, 0x22, 0xab, 0x16, 0x5c, 0x2a, 0x78, 0x99, 0xe9, 0x4a, 0xf6, 0x1c,
+    0x78, 0x84, 0x71, 0x23, 0x4c, 0xf9, 0x9e, 0x71, 0xec, 0xe0, 0x74, 0xaa, 0x41, 0x7a, 0xc1, 0x80,
+    0x1d, 0x8e, 0x03, 0x52, 0x76, 0x58, 0xc9, 0x73, 0x8a, 0x32, 0x58, 0xb2, 0x0b, 0x29, 0xd2, 0x58,
+    0x01, 0x49, 0x12, 0xc9, 0xb5, 0x31, 0xbf, 0x96, 0x74, 0xb7, 0x3a, 0x28, 0x75, 0x7f, 0x87, 0xd2,
+    0x30, 0xa5, 0x41, 0x29, 0x8a, 0xfe, 0x6c, 0x04, 0x2c, 0x40, 0xb6, 0x44, 0xb6, 0x16, 0xd4, 0x03,
+    0x74, 0xd5, 0x21, 0x70, 0x5d, 0x62, 0xc3, 0x56, 0xda, 0xab, 0x18, 0x2d, 0x70, 0x61, 0xf2, 0x47,
+    0x70, 0x8d, 0xb0, 0x57, 0x81, 0x2b, 0x3c, 0x24, 0x72, 0xd5, 0xa2, 0x58, 0xca, 0xe5, 0x1f, 0x98,
+    0xfe, 0x88, 0x6b, 0x7e, 0x90, 0x20, 0xcf, 0xc9, 0xc3, 0x9f, 0xa7, 0x31, 0x24, 0xd1, 0x2f, 0x0f,
+    0x19, 0x96, 0x2a, 0xcb, 0x17, 0xf8, 0x06, 0xdf, 0x4f, 0xd1, 0x37, 0x83, 0x1e, 0x05, 0xf2, 0x1a,
+    0x63, 0xa1, 0xd8, 0x6f, 0x93, 0xf3, 0xdf, 0x49, 0x52, 0x04, 0x89, 0xe6, 0xca, 0x80, 0x65, 0x81,
+    0x15, 0xa5, 0x58, 0x26, 0x58, 0x22, 0xb2, 0x19, 0x48, 0x0c, 0x0a, 0x72, 0x4a, 0x48, 0x04, 0x37,
+    0x18, 0xd2, 0xc2, 0x14, 0xba, 0x85, 0x68, 0x2e, 0x25, 0x55, 0x22, 0x59, 0x08, 0xc3, 0x5a, 0x2b,
+    0xe0, 0x8b, 0x45, 0xb2, 0x22, 0xe3, 0x27, 0xc6, 0x76, 0xdf, 0x1a, 0x50, 0x40, 0x07, 0xe1, 0xc9,
+    0x7c, 0x9b, 0x42, 0x63, 0x25, 0x43, 0x44, 0x36, 0x29, 0xe8, 0xaf, 0x6c, 0x0b, 0x08, 0x74, 0xb9,
+    0x9a, 0x40, 0x02, 0xa1, 0x16, 0xf2, 0x34, 0x49, 0x7c, 0xef, 0x43, 0xcd, 0x51, 0xaa, 0x6e, 0x2b,
+    0xe5, 0x11, 0xf3, 0x1e, 0x7e, 0xf4, 0x82, 0x21, 0x8a, 0x7f, 0xc1, 0x11, 0x94, 0x90, 0x34, 0xb1,
+    0x47, 0x7f, 0x90, 0xb4, 0x5a, 0x88, 0xd5, 0xfb, 0xc1, 0x48, 0xf8, 0x48, 0x91, 0x65, 0x9e, 0x47,
+    0x4d, 0xe2, 0x80, 0x1a, 0x44, 0xe3, 0x65, 0x85, 0x96, 0x75, 0x91, 0xad, 0xbd, 0x5a, 0x37, 0x53,
+    0x49, 0x8c, 0x80, 0xeb, 0x6b, 0x67, 0xd7, 0x22, 0xc1, 0x17, 0x13, 0x43, 0x57, 0xb4, 0x1c, 0xaa,
+    0x07, 0xf7, 0xc2, 0xab, 0xc2, 0xc0, 0xf6, 0xf7, 0x0b, 0x79, 0xf8, 0xab, 0x14, 0xc8, 0x31, 0xb8,
+    0xd7, 0xe0, 0x64, 0x9a, 0xb2, 0xb1, 0x44, 0xf5, 0xa8, 0xd9, 0x95, 0xe1, 0x35, 0x4f, 0x72, 0x28,
+    0xdd, 0x1b, 0x5a, 0x0d, 0x95, 0x07, 0x76, 0xf9, 0xbd, 0x59, 0x7d, 0x6e, 0x7b, 0x95, 0xdf, 0x20,
+    0x2d, 0x3d, 0x5c, 0xd7, 0x1b, 0xbc, 0xe6, 0x52, 0xd7, 0xb2, 0x5a, 0xe8, 0x25, 0x27, 0x1e, 0x2c,
+    0xe3, 0x2c, 0x12, 0xcb, 0xe1, 0x0b, 0xc2, 0xe8, 0x44, 0xe4, 0x32, 0x04, 0xaa, 0xb1, 0x07, 0xdd,
+    0x59, 0xac, 0xa7, 0x10, 0x53, 0x56, 0x54, 0xfa, 0x71, 0x23, 0xa0, 0x56, 0xc8, 0x89, 0xa9, 0xca,
+    0x9a, 0x58, 0xdf, 0x73, 0x85, 0x50, 0xc4, 0xd0, 0x12, 0x0e, 0x45, 0xe6, 0xb6, 0x03, 0x64, 0x31,
+    0x04, 0x94, 0xfd, 0x36, 0x10, 0x09, 0xef, 0x43, 0xd3, 0x2d, 0x7c, 0x43, 0x33, 0x24, 0x33, 0x02,
+    0x5b, 0x75, 0x55, 0x9c, 0xa3, 0xc8, 0xe8, 0x7b, 0x15, 0x2b, 0x44, 0x09, 0xa0, 0xb5, 0xcf, 0xcf,
+    0x5f, 0x3b, 0xc8, 0xbc, 0xc2, 0x32, 0x80, 0xc8, 0x1b, 0xb4, 0x83, 0x81, 0x22, 0xaa, 0xb2, 0xbd,
+    0xa0, 0xde, 0xbf, 0x30, 0xa6, 0xb4, 0xf6, 0x48, 0x8a, 0xf4, 0xb3, 0x5c, 0x69, 0x91, 0xfa, 0xcd,
+    0xcd, 0x30, 0xb3, 0x5b, 0xd6, 0x56, 0xf0, 0x10, 0x23, 0x6d, 0x6b, 0x88, 0x6f, 0x93, 0xdb, 0xe3,
+    0x1a, 0x2f, 0xf6, 0x95, 0x9b, 0x58, 0xdf, 0xc9, 0xa4, 0xe2, 0xac, 0x92, 0x66, 0xb4, 0x52, 0x9a,
+    0x50, 0x44, 0x03, 0x45, 0xe5, 0x56, 0xee, 0x5d, 0x24, 0xc0, 0xb1, 0x8b, 0xa3, 0x34, 0x44, 0xe3,
+    0x95, 0xd0, 0x73, 0x6b, 0x2a, 0xcf, 0x22, 0xf6, 0xee, 0xcd, 0x2b, 0x0c, 0x84, 0x96, 0x79, 0x01,
+    0x97, 0xaa, 0x95, 0x36, 0x0a, 0x84, 0x0c, 0xa0, 0x28, 0x61, 0x00, 0x7c, 0x62, 0x1e, 0x90, 0xc5,
+    0x36, 0xe6, 0x8d, 0xc0, 0x6c, 0xd2, 0x14, 0x0d, 0xa3, 0xea, 0xa1, 0xde, 0x88, 0x28, 0x51, 0x6d,
+    0x65, 0x6c, 0x0a, 0x7a, 0x2e, 0x22, 0xdc, 0xce, 0x2f, 0xce, 0x27, 0x6f, 0xbd, 0x41, 0xb9, 0xee,
+    0xb6, 0x80, 0x23, 0xf6, 0xd9, 0x73, 0xc9, 0x3b, 0x78, 0xbb, 0x5a, 0x80, 0x87, 0x94, 0x04, 0x8b,
+    0x38, 0x34, 0xda, 0x46, 0x9f, 0x0e, 0x96, 0xcb, 0xe5, 0x01, 0x36, 0x8d, 0xf4, 0x00, 0x55, 0x42,
+    0x16, 0x0a, 0x4a, 0xf0, 0xba, 0x92, 0x73, 0x25, 0xa2, 0x15, 0xf2, 0x90, 0x55, 0x27, 0xd4, 0x6d,
+    0x2c, 0xc9, 0xbb, 0x37, 0x2f, 0x9f, 0x89, 0x14, 0x37, 0x1b, 0x94, 0x6b, 0x2c, 0x0e, 0xa8, 0x01,
+    0xed, 0xa3, 0x88, 0x6d, 0x44, 0xe4, 0x90, 0xeb, 0xf2, 0x7b, 0xd5, 0x2e, 0x51, 0xdf, 0x27, 0xcb,
+    0xdd, 0x8b, 0x7a, 0x94, 0x1f, 0xd4, 0xc9, 0x08, 0xa7, 0xcd, 0x76, 0x56, 0xe5, 0xc8, 0x60, 0xf8,
+    0xb8, 0x21, 0x1a, 0x7d, 0xa3, 0x0e, 0x68, 0x87, 0xaf, 0x6e, 0x2e, 0xcf, 0x0c, 0x44, 0x47, 0x66,
+    0x3c, 0x32, 0x84, 0x8d, 0x54, 0xae, 0x5b, 0xf9, 0x41, 0xc8, 0x2e, 0x4e, 0xf3, 0x28, 0x16, 0x7e,
+    0x67, 0x52, 0xe8, 0x75, 0x4f, 0x52, 0xee, 0x9b, 0xdb, 0x65, 0x25, 0x3b, 0x48, 0xaa, 0xee, 0x6a,
+    0xc6, 0x46, 0x51, 0x60, 0xf6, 0xcb, 0xaa, 0x19, 0x5b, 0xda, 0x57, 0x16, 0x33, 0x72, 0xde, 0x69,
+    0x2d, 0x37, 0xb2, 0x8e, 0xfe, 0x5f, 0x2a, 0x1b, 0x80, 0x6f, 0x15, 0x69, 0xd3, 0x40, 0xab, 0xc3,
+    0x38, 0x0b, 0x93, 0x3c, 0x02, 0xe5, 0x57, 0x27, 0x8c, 0xa0, 0x35, 0x88, 0x74, 0xc2, 0x78, 0x63,
+    0xf4, 0xb9, 0x01, 0x37, 0x74, 0xbe, 0xf0, 0x76, 0x67, 0xad, 0x01, 0xa7, 0x83, 0x73, 0xe3, 0x68,
+    0x83, 0xe7, 0x0f, 0x93, 0x8f, 0xa1, 0x1d, 0xfe, 0x7c, 0x9a, 0x9c, 0x9f, 0x98, 0xe3, 0x4b, 0x39,
+    0x08, 0xe1, 0x3c, 0x85, 0x71, 0xea, 0xf3, 0x6c, 0x03, 0x53, 0xeb, 0xdb, 0xed, 0x53, 0x38, 0xc8,
+    0x82, 0x86, 0xa2, 0x2a, 0x71, 0x26, 0x81, 0x4f, 0x8d, 0x31, 0x05, 0x8b, 0x6c, 0x1a, 0xcb, 0xd4,
+    0xf7, 0x4e, 0x71, 0x2e, 0x5e, 0x89, 0x9c, 0xa9, 0xdc, 0xfd, 0x58, 0x72, 0x1c, 0x19, 0x70, 0xba,
+    0xb5, 0x12, 0x70, 0xbe, 0xa5, 0x43, 0x92, 0x95, 0xf3, 0xb4, 0x99, 0xbf, 0x9b, 0xca, 0xc2, 0x4a,
+    0xb8, 0xcb, 0xca, 0x30, 0x7e, 0x1b, 0xd4, 0x9b, 0x5f, 0xb7, 0xdd, 0x7e, 0x77, 0x86, 0xcf, 0xb8,
+    0x84, 0xcf, 0xad, 0x01, 0x80, 0xc6, 0x83, 0x33, 0x3c, 0xe7, 0xd0, 0xf0, 0xf6, 0x6d, 0x92, 0xf8,
+    0x0f, 0x6e, 0xa9, 0x14, 0x41, 0x29, 0x92, 0xee, 0x1d, 0xb5, 0xeb, 0x60, 0x62, 0x1a, 0x56, 0x91,
+    0xc0, 0x1b, 0x4e, 0x57, 0xef, 0x89, 0x16, 0x9b, 0x5c, 0xf3, 0x90, 0xe7, 0xf6, 0xca, 0xf5, 0x86,
+    0xa2, 0x5f, 0x65, 0x3c, 0x9b, 0xeb, 0x0c, 0x3b, 0xf4, 0x97, 0x29, 0xbb, 0x2a, 0xf9, 0x76, 0x56,
+    0xa8, 0xf8, 0xb5, 0xf3, 0xab, 0x35, 0x2b, 0x58, 0xc3, 0x77, 0x3f, 0x38, 0x36, 0x76, 0xfe, 0xe6,
+    0x10, 0x06, 0xfa, 0xd2, 0x9d, 0x25, 0xef, 0x00, 0xd5, 0x56, 0xb3, 0x81, 0xac, 0xfd, 0x79, 0x2b,
+    0x08, 0xf5, 0x6c, 0x0c, 0x4d, 0x38, 0x23, 0x0b, 0xb9, 0xe6, 0x89, 0xf5, 0xd6, 0x06, 0x60, 0x54,
+    0x58, 0xc1, 0xa5, 0x95, 0xc3, 0x0a, 0x0f, 0x7d, 0x79, 0xac, 0xa8, 0x76, 0xcb, 0x65, 0x45, 0x7f,
+    0x17, 0xf9, 0xac, 0xb4, 0x9b, 0x9c, 0x56, 0x8f, 0xb7, 0x93, 0xd7, 0x2a, 0xb6, 0xf5, 0xdc, 0x56,
+    0x5a, 0x6f, 0x7d, 0xd2, 0x07, 0xad, 0xe3, 0x6c, 0xb6, 0x65, 0xd2, 0x27, 0x93, 0xce, 0x00, 0x0f,
+    0xfa, 0xe8, 0x5e, 0x2b, 0xf7, 0x14, 0xc9, 0xbe, 0xac, 0x4f, 0x1d, 0xdb, 0x19, 0xd2, 0x15, 0x57,
+    0x16, 0x15, 0xe7, 0x73, 0x13, 0x13, 0x73, 0xc7, 0x71, 0xe6, 0x1e, 0x7d, 0x5a, 0x6f, 0x10, 0x2e,
+    0xb8, 0xe4, 0xa9, 0x72, 0x64, 0x38, 0xa9, 0x4f, 0x80, 0xcb, 0x70, 0x7e, 0x61, 0x56, 0xfd, 0x42,
+    0x0a, 0xf6, 0x20, 0x31, 0xd1, 0x12, 0x7d, 0xf0, 0x83, 0x4e, 0x44, 0xa1, 0x0b, 0x97, 0x85, 0x31,
+    0x77, 0x00, 0x28, 0xeb, 0xc4, 0xfd, 0x3d, 0x00, 0x63, 0xf8, 0xcc, 0x01, 0xf8, 0x35, 0xba, 0xd7,
+    0x82, 0x00, 0x2f, 0xd6, 0x7b, 0xbf, 0x66, 0x14, 0x44, 0xbd, 0x65, 0x4f, 0x49, 0x32, 0x94, 0x97,
+    0x29, 0x91, 0xde, 0x41, 0xdd, 0x97, 0x76, 0x9a, 0xb2, 0x2f, 0x9f, 0xee, 0x75, 0xe2, 0x68, 0x32,
+    0xfd, 0x0b, 0x67, 0xa7, 0x56, 0xde, 0x66, 0xa9, 0x3e, 0x9f, 0x4e, 0xb1, 0xd5, 0xf6, 0xe5, 0xad,
+    0x24, 0xea, 0x3a, 0xad, 0x47, 0x6a, 0x07, 0x09, 0x25, 0xd1, 0x8d, 0x99, 0xd7, 0xce, 0xce, 0xbb,
+    0xc8, 0x7b, 0xe9, 0xa7, 0xc9, 0x7b, 0x15, 0x1a, 0x9a, 0x45, 0x4b, 0x0f, 0xcc, 0xbb, 0xf2, 0xe9,
+    0xde, 0xce, 0xa0, 0xa7, 0x09, 0x97, 0xa9, 0xea, 0x1b, 0x41, 0x27, 0x22, 0xcf, 0xa2, 0x73, 0xfb,
+    0xad, 0xa6, 0x79, 0x8c, 0x2c, 0x6f, 0xa7, 0xb3, 0x88, 0xc2, 0xdd, 0x97, 0xf8, 0x92, 0xe8, 0xb2,
+    0x3c, 0x8a, 0x35, 0x30, 0xb4, 0x95, 0x51, 0x72, 0xac, 0x3a, 0xa7, 0xbd, 0xce, 0xdb, 0xfe, 0xba,
+    0x58, 0xb3, 0x02, 0x0f, 0xf4, 0x63, 0xf3, 0xe5, 0xc2, 0x7e, 0xae, 0xa4, 0xcf, 0x9b, 0xb5, 0x4f,
+    0x8f, 0xdb, 0x77, 0xa7, 0xf4, 0x8b, 0xd5, 0x1c, 0x7e, 0x85, 0x9a, 0x74, 0xf1, 0xf8, 0x8b, 0xf5,
+    0x7c, 0xdf, 0xad, 0xa7, 0x5e, 0xdb, 0x5a, 0xcc, 0x66, 0x09, 0x98, 0x6c, 0x36, 0x93, 0x64, 0xba,
+    0x75, 0x6d, 0xb9, 0xa3, 0x97, 0x6f, 0x32, 0xd9, 0xcc, 0x52, 0x0d, 0xf6, 0x25, 0x95, 0xde, 0x6f,
+    0xe4, 0x73, 0x88, 0x2e, 0xc4, 0x88, 0xc2, 0xa3, 0xe6, 0x0e, 0x0f, 0x19, 0xbf, 0x4a, 0xe8, 0x53,
+    0xf9, 0x76, 0x71, 0x8e, 0xa4, 0x2e, 0x31, 0x9c, 0x43, 0x48, 0x9f, 0xf3, 0x9e, 0x9a, 0x58, 0x1f,
+    0x51, 0x62, 0xeb, 0x42, 0x25, 0x2c, 0x70, 0x17, 0xef, 0x93, 0x69, 0x29, 0xb6, 0x80, 0xee, 0x5f,
+    0xc2, 0xaf, 0x91, 0x95, 0x40, 0x6d, 0x38, 0x69, 0xdf, 0x3a, 0x98, 0xce, 0xe1, 0xdc, 0x73, 0x27,
+    0x59, 0x1b, 0x0d, 0x5a, 0x9f, 0x8b, 0x5c, 0x9a, 0x45, 0x0a, 0xe7, 0x87, 0xf1, 0x47, 0xb3, 0x98,
+    0xc6, 0x59, 0xae, 0xa1, 0x5a, 0x3e, 0x74, 0x1f, 0xdd, 0x9c, 0x8a, 0x47, 0xa8, 0x63, 0xdf, 0xfa,
+    0x66, 0x68, 0x5c, 0x20, 0x88, 0xb3, 0xb4, 0xd4, 0xbc, 0x28, 0x9f, 0x6a, 0xf7, 0xa3, 0xed, 0x52,
+    0xa9, 0x5f, 0xe8, 0xd4, 0xe5, 0xbb, 0x5b, 0x9b, 0x97, 0xa5, 0x2f, 0xdb, 0xa3, 0x63, 0x29, 0xb7,
+    0x84, 0xb9, 0x57, 0xee, 0x78, 0x7f, 0x9a, 0x9e, 0x49, 0xf8, 0xf3, 0xe4, 0xa7, 0x1f, 0x87, 0xe3,
+    0x7d, 0x2c, 0x8e, 0xb3, 0x38, 0x41, 0xd3, 0x5d, 0xb3, 0xb2, 0xb7, 0x6a, 0x9b, 0x46, 0x1f, 0x6e,
+    0x35, 0xda, 0x49, 0xeb, 0x35, 0xd7, 0xd2, 0x7c, 0x9d, 0xb5, 0xbb, 0x5a, 0xf8, 0x7d, 0xc3, 0x42,
+    0x8b, 0x34, 0xe4, 0xb5, 0x9f, 0xfd, 0xfa, 0x90, 0xe6, 0x14, 0xd4, 0xac, 0x3b, 0x6e, 0x5c, 0xab,
+    0x96, 0x42, 0x86, 0x8d, 0x03, 0x7a, 0x97, 0xe9, 0xa5, 0xad, 0xdd, 0x77, 0x27, 0x6d, 0x49, 0x37,
+    0xdc, 0x66, 0xf2, 0xc6, 0xcd, 0xb9, 0xb2, 0x8e, 0xf0, 0x8c, 0xbd, 0xbe, 0x78, 0xcc, 0xa6, 0xa8,
+    0x86, 0xe1, 0x96, 0x94, 0x2f, 0xe8, 0x82, 0x8b, 0xa1, 0x7c, 0xba, 0x3f, 0x1c, 0xa1, 0x86, 0x11,
+    0x8b, 0x62, 0x69, 0xbe, 0x74, 0xae, 0xbc, 0xd6, 0xdd, 0x6e, 0xfd, 0xf2, 0xb0, 0xba, 0x0f, 0xdd,
+    0x1d, 0x2d, 0xde, 0xf6, 0x7b, 0x47, 0x3b, 0x3c, 0x52, 0x5f, 0xfb, 0x3f, 0x8c, 0xf7, 0xbc, 0xeb,
+    0x96, 0x71, 0xe3, 0x52, 0xb1, 0x77, 0x50, 0xe0, 0xdd, 0xa3, 0x41, 0xd0, 0xda, 0x0e, 0x34, 0x28,
+    0xbd, 0x75, 0x3b, 0xf8, 0x57, 0x36, 0xfa, 0x66, 0x9f, 0xfc, 0xef, 0x35, 0xab, 0xbb, 0x68, 0x39,
+    0xdf, 0x9a, 0x48, 0xd9, 0x44, 0x76, 0xeb, 0x11, 0x5d, 0x25, 0x4f, 0xd0, 0xbd, 0xef, 0x25, 0x5f,
+    0x2b, 0xf4, 0xaf, 0x28, 0xe3, 0x7f, 0x00, 0x34, 0x04, 0xdd, 0xb9, 0x96, 0x28, 0x00, 0x00,
+};
+
+const WebAsset WEB_ASSETS[WEB_ASSET_COUNT] = {
+    { WEB_ASSET_APP_CSS, "text/css", "\"8638288f\"", WEB_ASSET_APP_CSS_GZ, sizeof(WEB_ASSET_APP_CSS_GZ) },
+    { WEB_ASSET_ALARMS_CSS, "text/css", "\"e44444ac\"", WEB_ASSET_ALARMS_CSS_GZ, sizeof(WEB_ASSET_ALARMS_CSS_GZ) },
+    { WEB_ASSET_APP_JS, "application/javascript", "\"58999415\"", WEB_ASSET_APP_JS_GZ, sizeof(WEB_ASSET_APP_JS_GZ) },
+};
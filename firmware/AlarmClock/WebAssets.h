@@ -0,0 +1,23 @@
+// Generated by web/build_assets.py - do not edit by hand
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+#define WEB_ASSET_APP_CSS "/www/app.8638288f.css"
+#define WEB_ASSET_ALARMS_CSS "/www/alarms.e44444ac.css"
+#define WEB_ASSET_APP_JS "/www/app.58999415.js"
+
+struct WebAsset {
+    const char* path;         // Hashed URL; the LittleFS file is path + ".gz"
+    const char* contentType;
+    const char* etag;
+    const uint8_t* gzData;    // Flash copy when LittleFS has no upload
+    size_t gzSize;
+};
+
+#define WEB_ASSET_COUNT 3
+
+extern const WebAsset WEB_ASSETS[WEB_ASSET_COUNT];
+
+#endif
@@ -0,0 +1,76 @@
+#include "WebGuard.h"
+#include "AppLock.h"
+
+volatile int WebGuard::openRequests = 0;
+volatile uint32_t WebGuard::rejected = 0;
+
+// Shown in place of a page that couldn't be served; the browser retries
+static const char BUSY_PAGE[] PROGMEM = R"html(<!DOCTYPE html>
+<html><head><meta charset="UTF-8"><meta http-equiv="refresh" content="1">
+<title>Alarm Clock</title></head>
+<body style="font-family: sans-serif; text-align: center; padding: 40px; color: #495057;">Busy, reloading&hellip;</body></html>
+)html";
+
+void WebGuard::reject(AsyncWebServerRequest* request, const char* reason, bool page) {
+    rejected++;
+    Serial.printf("WebGuard: %s for %s (%s)\n", page ? "reload page" : "503", request->url().c_str(), reason);
+
+    AsyncWebServerResponse* response;
+    if (page) {
+        response = request->beginResponse_P(200, "text/html", (const uint8_t*)BUSY_PAGE, strlen_P(BUSY_PAGE));
+        response->addHeader("Cache-Control", "no-store");
+    } else {
+        response = request->beginResponse(503, "text/plain", "Busy, please retry");
+        response->addHeader("Retry-After", "1");
+    }
+    request->send(response);
+}
+
+ArRequestHandlerFunction WebGuard::wrap(WebHandler handler, bool useAppLock, void (*onDone)(AsyncWebServerRequest*)) {
+    return guard(handler, useAppLock, false, onDone);
+}
+
+ArRequestHandlerFunction WebGuard::wrapPage(WebHandler handler) {
+    return guard(handler, true, true, nullptr);
+}
+
+ArRequestHandlerFunction WebGuard::guard(WebHandler handler, bool useAppLock, bool page,
+                                         void (*onDone)(AsyncWebServerRequest*)) {
+    return [handler, useAppLock, page, onDone](AsyncWebServerRequest* request) {
+        // Form posts to a page's URL are answered like any other action
+        bool navigation = page && request->method() == HTTP_GET;
+
+        // Requests only ever run on the AsyncTCP task, so the counter needs no lock
+        if (openRequests >= WEB_MAX_REQUESTS) {
+            reject(request, "too many requests", navigation);
+            return;
+        }
+        if (ESP.getMaxAllocHeap() < WEB_MIN_FREE_BLOCK) {
+            reject(request, "low memory", navigation);
+            return;
+        }
+
+        // Waiting here stalls every connection on the AsyncTCP task, so
+        // actions only retry briefly; a page waits out a tick of the UI or
+        // network task, which a person loading it won't notice
+        bool locked = false;
+        if (useAppLock) {
+            if (!AppLock::take(navigation ? WEB_PAGE_WAIT_MS : WEB_LOCK_TIMEOUT_MS)) {
+                reject(request, "app busy", navigation);
+                return;
+            }
+            locked = true;
+        }
+
+        // Counted until the response has gone out and the connection closed
+        openRequests++;
+        request->onDisconnect([onDone, request]() {
+            openRequests--;
+            if (onDone) onDone(request);
+        });
+
+        handler(request);
+
+        if (locked) AppLock::give();
+    };
+}
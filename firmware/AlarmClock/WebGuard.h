@@ -0,0 +1,40 @@
+#ifndef WEB_GUARD_H
+#define WEB_GUARD_H
+
+#include <Arduino.h>
+#include <functional>
+#include <ESPAsyncWebServer.h>
+#include "Config.h"
+
+typedef std::function<void(AsyncWebServerRequest*)> WebHandler;
+
+// Admission control for web request handlers.
+// ESPAsyncWebServer runs handlers on the AsyncTCP task, in parallel with
+// setup(), loop() or the app tasks, so handlers that touch shared modules
+// take the AppLock like those do. When too many requests are open, memory is
+// short or the lock stays busy, the request gets a 503 instead of queueing.
+// Pages a browser navigates to wait longer for the lock, and instead of a
+// 503 get a small page that reloads itself.
+class WebGuard {
+private:
+    static volatile int openRequests;
+    static volatile uint32_t rejected;
+
+    static void reject(AsyncWebServerRequest* request, const char* reason, bool page);
+    static ArRequestHandlerFunction guard(WebHandler handler, bool useAppLock, bool page,
+                                          void (*onDone)(AsyncWebServerRequest*));
+
+public:
+    // onDone (optional) runs once the response is fully sent or the client
+    // goes away, e.g. to release a buffer the response was reading from
+    static ArRequestHandlerFunction wrap(WebHandler handler, bool useAppLock = true,
+                                         void (*onDone)(AsyncWebServerRequest*) = nullptr);
+    // wrap() for a top-level page (/, /alarms, ...): GETs wait up to
+    // WEB_PAGE_WAIT_MS and are never answered with a 503
+    static ArRequestHandlerFunction wrapPage(WebHandler handler);
+
+    static int getOpenRequests() { return openRequests; }
+    static uint32_t getRejected() { return rejected; }
+};
+
+#endif
@@ -1,43 +1,50 @@
 #ifndef WEBSERVER_ALARMS_H
 #define WEBSERVER_ALARMS_H
 
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 #include "StorageModule.h"
 #include "AudioModule.h"
 #include "FMRadioModule.h"
 #include "AlarmData.h"
 #include "CommonTypes.h"
 #include "Config.h"
+#include "HtmlStream.h"
+#include <memory>
 
 // Forward declaration
 class AlarmController;
+class JsonWriter;
+class StationTable;
+struct Mp3Listing;
 
 class WebServerAlarms {
 private:
-    WebServer* server;
+    AsyncWebServer* server;
     StorageModule* storage;
     AudioModule* audio;
     FMRadioModule* fmRadio;
     AlarmController* alarmController;  // NEW: Reference to alarm controller
-    InternetRadioStation* stationList;
-    int stationCount;
     
-    void handleAlarms();
-    void handleSaveAlarm();
-    void handleTestAlarm();
-    void handleListMP3();
+    void handleAlarms(AsyncWebServerRequest* request);
+    void handleSaveAlarm(AsyncWebServerRequest* request);
+    void handleTestAlarm(AsyncWebServerRequest* request);
+    void handleListMP3(AsyncWebServerRequest* request);
     
-    String getHTMLHeader();
-    String getHTMLFooter();
-    String getAlarmsHTML();
-    String getMP3FilesList();  // NEW: Get list of MP3 files for dropdown
+    // Alarms page, built without Strings (see HtmlStream)
+    void sendAlarmsPage(AsyncWebServerRequest* request);
+    void sendAlarmCard(HtmlStream& out, int index, const AlarmConfig& alarm,
+                       const std::shared_ptr<const StationTable>& stations,
+                       const std::shared_ptr<const Mp3Listing>& mp3);
+    void sendMP3Options(HtmlStream& out, const std::shared_ptr<const Mp3Listing>& mp3,
+                        const String& selected);  // MP3 files for dropdown
 
 public:
-    WebServerAlarms(WebServer* srv, StorageModule* stor, AudioModule* aud, FMRadioModule* fm);
+    WebServerAlarms(AsyncWebServer* srv, StorageModule* stor, AudioModule* aud, FMRadioModule* fm);
     
     void setupRoutes();
-    void setStationList(InternetRadioStation* stations, int count);
     void setAlarmController(AlarmController* ctrl);  // NEW: Set alarm controller reference
+
+    static void writeMP3List(JsonWriter& json, bool detailed = false);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,582 @@
+#include "WebServerApi.h"
+#include "WebServerAlarms.h"
+#include "AudioModule.h"
+#include "FMRadioModule.h"
+#include "DisplayILI9341.h"
+#include "AlarmController.h"
+#include "EventStream.h"
+#include "HtmlStream.h"
+#include "JsonWriter.h"
+#include "JsonReader.h"
+#include "WebGuard.h"
+#include "StationTable.h"
+
+#define API_KEY_SIZE 16   // Longest field name we look at, plus terminator
+
+WebServerApi::WebServerApi(AsyncWebServer* srv, StorageModule* stor, AudioModule* aud,
+                           FMRadioModule* fm, DisplayILI9341* disp, EventStream* ev)
+    : server(srv), storage(stor), audio(aud), fmRadio(fm), display(disp),
+      events(ev), alarmController(nullptr) {
+}
+
+void WebServerApi::setupRoutes() {
+    if (!server || !storage) {
+        Serial.println("ERROR: WebServerApi::setupRoutes() - server or storage missing");
+        return;
+    }
+
+    // Writes accept POST too, for clients that can't send PUT
+    route("/api/v1/status", HTTP_GET, &WebServerApi::handleStatus);
+    route("/api/v1/alarms", HTTP_GET, &WebServerApi::handleGetAlarms);
+    route("/api/v1/alarms", HTTP_PUT | HTTP_POST, &WebServerApi::handlePutAlarms);
+    route("/api/v1/stations", HTTP_GET, &WebServerApi::handleGetStations);
+    route("/api/v1/stations", HTTP_PUT | HTTP_POST, &WebServerApi::handlePutStations);
+    route("/api/v1/fm", HTTP_GET, &WebServerApi::handleGetFM);
+    route("/api/v1/fm", HTTP_PUT | HTTP_POST, &WebServerApi::handlePutFM);
+    route("/api/v1/control", HTTP_GET, &WebServerApi::handleGetControl);
+    route("/api/v1/control", HTTP_PUT | HTTP_POST, &WebServerApi::handlePutControl);
+    route("/api/v1/mp3", HTTP_GET, &WebServerApi::handleListMP3);
+
+    Serial.println("WebServerApi routes registered under /api/v1");
+}
+
+void WebServerApi::route(const char* uri, WebRequestMethodComposite method, ApiHandler handler) {
+    server->on(uri, method, WebGuard::wrap([this, handler](AsyncWebServerRequest* request) {
+        (this->*handler)(request);
+    }), nullptr, collectBody);
+}
+
+// ===== REQUEST HELPERS =====
+
+void WebServerApi::collectBody(AsyncWebServerRequest* request, uint8_t* data,
+                               size_t len, size_t index, size_t total) {
+    if (total > API_MAX_BODY) return;  // requireBody() answers 413
+
+    if (index == 0 && !request->_tempObject) {
+        char* body = (char*)malloc(total + 1);
+        if (!body) return;
+        body[total] = '\0';
+        request->_tempObject = body;
+    }
+
+    char* body = (char*)request->_tempObject;
+    if (body && index + len <= total) {
+        memcpy(body + index, data, len);
+    }
+}
+
+// Returns the collected body, or answers the request and returns nullptr
+const char* WebServerApi::requireBody(AsyncWebServerRequest* request) {
+    if (request->contentLength() > API_MAX_BODY) {
+        sendError(request, 413, "body too large");
+        return nullptr;
+    }
+    if (!request->_tempObject) {
+        sendError(request, 400, "JSON body required");
+        return nullptr;
+    }
+    return (const char*)request->_tempObject;
+}
+
+void WebServerApi::sendError(AsyncWebServerRequest* request, int code, const char* message) {
+    HtmlStream out(request);
+    out.begin(code, "application/json");
+
+    JsonWriter json(out);
+    json.beginObject();
+    json.field("error", message);
+    json.endObject();
+
+    out.end();
+}
+
+// "/api/v1/alarms" -> -1 (whole list), "/api/v1/alarms/2" -> 2, bad suffix -> -2
+static int pathIndex(AsyncWebServerRequest* request, const char* base) {
+    const char* url = request->url().c_str();
+    size_t baseLen = strlen(base);
+
+    if (url[baseLen] == '\0') return -1;
+    if (url[baseLen] != '/' || url[baseLen + 1] == '\0') return -2;
+
+    char* end;
+    long index = strtol(url + baseLen + 1, &end, 10);
+    if (*end != '\0' || index < 0) return -2;
+    return (int)index;
+}
+
+// ===== STATUS =====
+
+void WebServerApi::handleStatus(AsyncWebServerRequest* request) {
+    LiveStatus status;
+    if (events) {
+        events->sample(status);
+    } else {
+        memset(&status, 0, sizeof(status));
+    }
+
+    HtmlStream out(request);
+    out.begin(200, "application/json");
+
+    JsonWriter json(out);
+    json.beginObject();
+    json.field("time", status.time);
+    json.field("station", status.station);
+    json.field("status", status.status);
+    json.field("playing", audio ? audio->getIsPlaying() : false);
+    json.field("volume", status.volume);
+    json.field("alarm", status.alarm);
+    json.field("rds", status.rds);
+    json.field("source", storage->loadAudioMode() ? "fm" : "internet");
+    json.field("uptime", (unsigned long)(millis() / 1000));
+    json.field("freeHeap", (unsigned long)ESP.getFreeHeap());
+    json.endObject();
+
+    out.end();
+}
+
+// ===== ALARMS =====
+
+void WebServerApi::writeAlarm(JsonWriter& json, int index, const AlarmConfig& alarm) {
+    json.beginObject();
+    json.field("index", index);
+    json.field("enabled", alarm.enabled);
+    json.field("hour", alarm.hour);
+    json.field("minute", alarm.minute);
+    json.field("repeat", (int)alarm.repeatMode);
+    json.field("soundType", (int)alarm.soundType);
+    json.field("stationIndex", alarm.stationIndex);
+    json.field("fmFreq", (double)alarm.fmFrequency, 1);
+    json.field("mp3File", alarm.mp3File.c_str());
+    json.endObject();
+}
+
+// Field names match the /save_alarm form. Fields that are absent keep
+// their current value, so a PUT can change just "enabled".
+const char* WebServerApi::readAlarm(JsonReader& in, AlarmConfig& alarm) {
+    char key[API_KEY_SIZE];
+    long number;
+
+    if (!in.beginObject()) return "alarm must be an object";
+
+    while (in.nextKey(key, sizeof(key))) {
+        if (strcmp(key, "enabled") == 0) {
+            in.readBool(alarm.enabled);
+        } else if (strcmp(key, "hour") == 0) {
+            if (!in.readInt(number)) break;
+            if (number < 0 || number > 23) return "hour out of range";
+            alarm.hour = number;
+        } else if (strcmp(key, "minute") == 0) {
+            if (!in.readInt(number)) break;
+            if (number < 0 || number > 59) return "minute out of range";
+            alarm.minute = number;
+        } else if (strcmp(key, "repeat") == 0) {
+            if (!in.readInt(number)) break;
+            if (number < ALARM_ONCE || number > ALARM_WEEKENDS) return "invalid repeat";
+            alarm.repeatMode = (AlarmRepeat)number;
+        } else if (strcmp(key, "soundType") == 0) {
+            if (!in.readInt(number)) break;
+            if (number < SOUND_INTERNET_RADIO || number > SOUND_MP3_FILE) return "invalid soundType";
+            alarm.soundType = (AlarmSoundType)number;
+        } else if (strcmp(key, "stationIndex") == 0) {
+            if (!in.readInt(number)) break;
+            if (number < 0 || number >= MAX_INTERNET_STATIONS) return "stationIndex out of range";
+            alarm.stationIndex = number;
+        } else if (strcmp(key, "fmFreq") == 0) {
+            double freq;
+            if (!in.readNumber(freq)) break;
+            if (freq < 87.5 || freq > 108.0) return "fmFreq out of range";
+            alarm.fmFrequency = freq;
+        } else if (strcmp(key, "mp3File") == 0) {
+            char file[64];
+            if (!in.readString(file, sizeof(file))) break;
+            alarm.mp3File = file;
+        } else {
+            in.skipValue();  // "index" and unknown fields
+        }
+    }
+
+    return in.ok() ? nullptr : "malformed alarm";
+}
+
+void WebServerApi::handleGetAlarms(AsyncWebServerRequest* request) {
+    int index = pathIndex(request, "/api/v1/alarms");
+    if (index < -1 || index >= MAX_ALARMS) {
+        sendError(request, 404, "no such alarm");
+        return;
+    }
+
+    HtmlStream out(request);
+    out.begin(200, "application/json");
+    JsonWriter json(out);
+
+    AlarmConfig alarm;
+    if (index >= 0) {
+        storage->loadAlarm(index, alarm);
+        writeAlarm(json, index, alarm);
+    } else {
+        json.beginArray();
+        for (int i = 0; i < MAX_ALARMS; i++) {
+            alarm = AlarmConfig();
+            storage->loadAlarm(i, alarm);
+            writeAlarm(json, i, alarm);
+        }
+        json.endArray();
+    }
+
+    out.end();
+}
+
+void WebServerApi::handlePutAlarms(AsyncWebServerRequest* request) {
+    int index = pathIndex(request, "/api/v1/alarms");
+    if (index < -1 || index >= MAX_ALARMS) {
+        sendError(request, 404, "no such alarm");
+        return;
+    }
+
+    const char* body = requireBody(request);
+    if (!body) return;
+
+    // Parse everything before saving anything, so a bad entry changes nothing
+    AlarmConfig alarms[MAX_ALARMS];
+    for (int i = 0; i < MAX_ALARMS; i++) {
+        storage->loadAlarm(i, alarms[i]);
+    }
+
+    JsonReader in(body, strlen(body));
+    const char* error = nullptr;
+    bool touched[MAX_ALARMS] = {false};
+
+    if (index >= 0) {
+        error = readAlarm(in, alarms[index]);
+        touched[index] = true;
+    } else if (in.beginArray()) {
+        // Bulk replace: element i is alarm i, alarms not listed are cleared
+        int count = 0;
+        while (!error && in.nextElement()) {
+            if (count >= MAX_ALARMS) {
+                error = "too many alarms";
+                break;
+            }
+            AlarmConfig fresh;
+            fresh.lastYear = alarms[count].lastYear;
+            fresh.lastMonth = alarms[count].lastMonth;
+            fresh.lastDay = alarms[count].lastDay;
+            error = readAlarm(in, fresh);
+            alarms[count] = fresh;
+            count++;
+        }
+        for (int i = count; i < MAX_ALARMS; i++) {
+            alarms[i] = AlarmConfig();
+        }
+        for (int i = 0; i < MAX_ALARMS; i++) touched[i] = true;
+    }
+
+    if (!error && (!in.ok() || !in.atEnd())) error = "malformed JSON";
+    if (error) {
+        sendError(request, 400, error);
+        return;
+    }
+
+    for (int i = 0; i < MAX_ALARMS; i++) {
+        if (touched[i] && !storage->saveAlarm(i, alarms[i])) {
+            sendError(request, 500, "failed to save alarm");
+            return;
+        }
+    }
+
+    if (alarmController) {
+        alarmController->reloadAlarms();
+    }
+    Serial.printf("API: alarms updated (%s)\n", index >= 0 ? "single" : "bulk");
+
+    handleGetAlarms(request);
+}
+
+// ===== INTERNET STATIONS =====
+
+const char* WebServerApi::readStation(JsonReader& in, char* name, size_t nameSize,
+                                      char* url, size_t urlSize) {
+    char key[API_KEY_SIZE];
+    name[0] = '\0';
+    url[0] = '\0';
+
+    if (!in.beginObject()) return "station must be an object";
+
+    while (in.nextKey(key, sizeof(key))) {
+        if (strcmp(key, "name") == 0) {
+            in.readString(name, nameSize);
+        } else if (strcmp(key, "url") == 0) {
+            in.readString(url, urlSize);
+        } else {
+            in.skipValue();
+        }
+    }
+
+    if (!in.ok()) return "malformed station (name or url too long?)";
+    if (name[0] == '\0' || strncmp(url, "http", 4) != 0) return "station needs a name and an http(s) url";
+    return nullptr;
+}
+
+void WebServerApi::handleGetStations(AsyncWebServerRequest* request) {
+    HtmlStream out(request);
+    out.begin(200, "application/json");
+
+    JsonWriter json(out);
+    json.beginArray();
+
+    StationTableRef stations;
+    for (int i = 0; i < stations.count(); i++) {
+        const StationEntry* station = stations.get(i);
+        json.beginObject();
+        json.field("name", station->name.data);
+        json.field("url", station->url.data);
+        json.endObject();
+    }
+
+    json.endArray();
+    out.end();
+}
+
+void WebServerApi::handlePutStations(AsyncWebServerRequest* request) {
+    const char* body = requireBody(request);
+    if (!body) return;
+    size_t length = strlen(body);
+
+    char name[CATALOG_NAME_MAX];
+    char url[CATALOG_URL_MAX];
+    int count = 0;
+
+    // Validate the whole list before touching storage, then parse again to save
+    for (int pass = 0; pass < 2; pass++) {
+        JsonReader in(body, length);
+        const char* error = nullptr;
+        count = 0;
+        if (pass == 1) storage->clearInternetStations();
+
+        if (in.beginArray()) {
+            while (!error && in.nextElement()) {
+                if (count >= MAX_INTERNET_STATIONS) {
+                    error = "too many stations";
+                    break;
+                }
+                error = readStation(in, name, sizeof(name), url, sizeof(url));
+                if (!error && pass == 1 && !storage->saveInternetStation(count, name, url)) {
+                    sendError(request, 500, "failed to save station");
+                    return;
+                }
+                count++;
+            }
+        }
+
+        if (!error && (!in.ok() || !in.atEnd())) error = "expected an array of stations";
+        if (error) {
+            sendError(request, 400, error);
+            return;
+        }
+    }
+
+    storage->publishInternetStations();
+    Serial.printf("API: %d internet stations saved\n", count);
+
+    handleGetStations(request);
+}
+
+// ===== FM RADIO =====
+
+const char* WebServerApi::readPreset(JsonReader& in, FMRadioPreset& preset) {
+    char key[API_KEY_SIZE];
+    preset.frequency = 0;
+    preset.name[0] = '\0';
+
+    if (!in.beginObject()) return "preset must be an object";
+
+    while (in.nextKey(key, sizeof(key))) {
+        if (strcmp(key, "frequency") == 0) {
+            double freq;
+            if (in.readNumber(freq)) preset.frequency = freq;
+        } else if (strcmp(key, "name") == 0) {
+            in.readString(preset.name, sizeof(preset.name));
+        } else {
+            in.skipValue();
+        }
+    }
+
+    if (!in.ok()) return "malformed preset";
+    if (preset.frequency < 87.5 || preset.frequency > 108.0) return "preset frequency out of range";
+    return nullptr;
+}
+
+void WebServerApi::handleGetFM(AsyncWebServerRequest* request) {
+    HtmlStream out(request);
+    out.begin(200, "application/json");
+
+    JsonWriter json(out);
+    json.beginObject();
+    if (fmRadio) {
+        json.field("frequency", (double)fmRadio->getFrequency(), 1);
+    } else {
+        json.key("frequency");
+        json.nullValue();
+    }
+
+    json.key("presets");
+    json.beginArray();
+    int count = storage->getFMStationCount();
+    for (int i = 0; i < count; i++) {
+        FMRadioPreset* preset = storage->getFMStation(i);
+        if (!preset) continue;
+        json.beginObject();
+        json.field("frequency", (double)preset->frequency, 1);
+        json.field("name", preset->name);
+        json.endObject();
+    }
+    json.endArray();
+
+    json.endObject();
+    out.end();
+}
+
+void WebServerApi::handlePutFM(AsyncWebServerRequest* request) {
+    const char* body = requireBody(request);
+    if (!body) return;
+
+    JsonReader in(body, strlen(body));
+    char key[API_KEY_SIZE];
+    const char* error = nullptr;
+
+    double frequency = 0;
+    bool hasFrequency = false;
+    FMRadioPreset presets[MAX_STATIONS];
+    int presetCount = -1;  // -1: presets not sent, leave them alone
+
+    if (in.beginObject()) {
+        while (!error && in.nextKey(key, sizeof(key))) {
+            if (strcmp(key, "frequency") == 0) {
+                hasFrequency = in.readNumber(frequency);
+                if (hasFrequency && (frequency < 87.5 || frequency > 108.0)) {
+                    error = "frequency out of range";
+                }
+            } else if (strcmp(key, "presets") == 0) {
+                presetCount = 0;
+                if (!in.beginArray()) break;
+                while (!error && in.nextElement()) {
+                    if (presetCount >= MAX_STATIONS) {
+                        error = "too many presets";
+                        break;
+                    }
+                    error = readPreset(in, presets[presetCount++]);
+                }
+            } else {
+                in.skipValue();
+            }
+        }
+    }
+
+    if (!error && (!in.ok() || !in.atEnd())) error = "malformed JSON";
+    if (error) {
+        sendError(request, 400, error);
+        return;
+    }
+
+    if (presetCount >= 0 && !storage->replaceFMStations(presets, presetCount)) {
+        sendError(request, 500, "failed to save presets");
+        return;
+    }
+    if (hasFrequency && fmRadio) {
+        fmRadio->setFrequency(frequency);
+    }
+
+    handleGetFM(request);
+}
+
+// ===== CONTROL =====
+
+void WebServerApi::handleGetControl(AsyncWebServerRequest* request) {
+    HtmlStream out(request);
+    out.begin(200, "application/json");
+
+    JsonWriter json(out);
+    json.beginObject();
+    if (audio) {
+        json.field("volume", audio->getCurrentVolume());
+        json.field("maxVolume", audio->getMaxVolume());
+    }
+    if (display) {
+        json.field("brightness", display->getBrightness());
+    }
+    json.field("source", storage->loadAudioMode() ? "fm" : "internet");
+    json.endObject();
+
+    out.end();
+}
+
+void WebServerApi::handlePutControl(AsyncWebServerRequest* request) {
+    const char* body = requireBody(request);
+    if (!body) return;
+
+    JsonReader in(body, strlen(body));
+    char key[API_KEY_SIZE];
+    const char* error = nullptr;
+    long volume = -1;
+    long brightness = -1;
+    char source[16] = "";
+
+    if (in.beginObject()) {
+        while (!error && in.nextKey(key, sizeof(key))) {
+            if (strcmp(key, "volume") == 0) {
+                in.readInt(volume);
+                if (!audio) error = "audio not available";
+                else if (volume < 0 || volume > audio->getMaxVolume()) error = "volume out of range";
+            } else if (strcmp(key, "brightness") == 0) {
+                in.readInt(brightness);
+                if (!display) error = "display not available";
+                else if (brightness < 0 || brightness > 255) error = "brightness out of range";
+            } else if (strcmp(key, "source") == 0) {
+                in.readString(source, sizeof(source));
+                if (strcmp(source, "fm") != 0 && strcmp(source, "internet") != 0) {
+                    error = "source must be \"fm\" or \"internet\"";
+                }
+            } else {
+                in.skipValue();
+            }
+        }
+    }
+
+    if (!error && (!in.ok() || !in.atEnd())) error = "malformed JSON";
+    if (error) {
+        sendError(request, 400, error);
+        return;
+    }
+
+    if (volume >= 0) {
+        audio->setVolume(volume);
+        storage->saveVolume(volume);
+    }
+    if (brightness >= 0) {
+        display->setBrightness(brightness);
+        storage->saveBrightness(brightness);
+    }
+    if (source[0]) {
+        bool useFMRadio = (strcmp(source, "fm") == 0);
+        if (!storage->saveAudioMode(useFMRadio)) {
+            sendError(request, 500, "failed to save audio mode");
+            return;
+        }
+        pinMode(MODE_SWITCH_PIN, OUTPUT);
+        digitalWrite(MODE_SWITCH_PIN, useFMRadio ? HIGH : LOW);
+    }
+
+    handleGetControl(request);
+}
+
+// ===== MP3 FILES =====
+
+void WebServerApi::handleListMP3(AsyncWebServerRequest* request) {
+    HtmlStream out(request);
+    out.begin(200, "application/json");
+
+    JsonWriter json(out);
+    WebServerAlarms::writeMP3List(json, true);
+
+    out.end();
+}
@@ -0,0 +1,77 @@
+#ifndef WEBSERVER_API_H
+#define WEBSERVER_API_H
+
+#include <ESPAsyncWebServer.h>
+#include "Config.h"
+#include "StorageModule.h"   // After Config.h: its MAX_STATIONS/MAX_ALARMS are the ones storage uses
+#include "AlarmData.h"
+#include "CommonTypes.h"
+
+class AudioModule;
+class FMRadioModule;
+class DisplayILI9341;
+class AlarmController;
+class EventStream;
+class JsonReader;
+class JsonWriter;
+
+// Versioned JSON API (/api/v1/*) for scripts and apps. Responses are
+// streamed through JsonWriter; request bodies are parsed in place with
+// JsonReader. PUT replaces a whole collection in one request, so a client
+// never needs N round trips to rewrite alarms or stations:
+//
+//   GET       /api/v1/status             live status (same fields as /events)
+//   GET/PUT   /api/v1/alarms             all alarms (array)
+//   GET/PUT   /api/v1/alarms/<n>         one alarm; PUT may send only changed fields
+//   GET/PUT   /api/v1/stations           internet stations (array of {name,url})
+//   GET/PUT   /api/v1/fm                 FM frequency and presets
+//   GET/PUT   /api/v1/control            volume, brightness, audio source
+//   GET       /api/v1/mp3                alarm sound files with title and duration
+//
+// Errors come back as {"error":"..."} with a 4xx/5xx code.
+class WebServerApi {
+private:
+    AsyncWebServer* server;
+    StorageModule* storage;
+    AudioModule* audio;
+    FMRadioModule* fmRadio;
+    DisplayILI9341* display;
+    EventStream* events;
+    AlarmController* alarmController;
+
+    typedef void (WebServerApi::*ApiHandler)(AsyncWebServerRequest* request);
+    void route(const char* uri, WebRequestMethodComposite method, ApiHandler handler);
+
+    // Request bodies are collected into request->_tempObject (freed with the request)
+    static void collectBody(AsyncWebServerRequest* request, uint8_t* data,
+                            size_t len, size_t index, size_t total);
+    const char* requireBody(AsyncWebServerRequest* request);
+    void sendError(AsyncWebServerRequest* request, int code, const char* message);
+
+    void handleStatus(AsyncWebServerRequest* request);
+    void handleGetAlarms(AsyncWebServerRequest* request);
+    void handlePutAlarms(AsyncWebServerRequest* request);
+    void handleGetStations(AsyncWebServerRequest* request);
+    void handlePutStations(AsyncWebServerRequest* request);
+    void handleGetFM(AsyncWebServerRequest* request);
+    void handlePutFM(AsyncWebServerRequest* request);
+    void handleGetControl(AsyncWebServerRequest* request);
+    void handlePutControl(AsyncWebServerRequest* request);
+    void handleListMP3(AsyncWebServerRequest* request);
+
+    // Serialization
+    void writeAlarm(JsonWriter& json, int index, const AlarmConfig& alarm);
+    static const char* readAlarm(JsonReader& in, AlarmConfig& alarm);  // nullptr or error
+    static const char* readStation(JsonReader& in, char* name, size_t nameSize,
+                                   char* url, size_t urlSize);
+    static const char* readPreset(JsonReader& in, FMRadioPreset& preset);
+
+public:
+    WebServerApi(AsyncWebServer* srv, StorageModule* stor, AudioModule* aud,
+                 FMRadioModule* fm, DisplayILI9341* disp, EventStream* ev);
+
+    void setupRoutes();
+    void setAlarmController(AlarmController* ctrl) { alarmController = ctrl; }
+};
+
+#endif
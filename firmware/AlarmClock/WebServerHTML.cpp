@@ -2,250 +2,21 @@
 #include "FeatureFlags.h"
 #include "StorageModule.h"
 #include "TimeModule.h"
+#include "TimeFormat.h"
 #include "AudioModule.h"
 #include "DisplayILI9341.h"
+#include "WebAssets.h"
 
-String WebServerHTML::getHTMLHeader() {
-    return R"html(
+// ===== STATIC PAGE SECTIONS (served straight from flash) =====
+
+static const char HTML_HEADER[] PROGMEM = R"html(
 <!DOCTYPE html>
 <html>
 <head>
     <meta charset="UTF-8">
     <meta name="viewport" content="width=device-width, initial-scale=1.0">
     <title>Alarm Clock Radio</title>
-    <style>
-        * { margin: 0; padding: 0; box-sizing: border-box; }
-        body {
-            font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Arial, sans-serif;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            min-height: 100vh;
-            padding: 20px;
-        }
-        .container {
-            max-width: 800px;
-            margin: 0 auto;
-            background: white;
-            border-radius: 15px;
-            box-shadow: 0 10px 40px rgba(0,0,0,0.2);
-            overflow: hidden;
-        }
-        .header {
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            color: white;
-            padding: 30px;
-            text-align: center;
-        }
-        .header h1 {
-            font-size: 2em;
-            margin-bottom: 10px;
-        }
-        .nav {
-            display: flex;
-            background: #f8f9fa;
-            border-bottom: 2px solid #e9ecef;
-            overflow-x: auto;
-        }
-        .nav a {
-            flex: 1;
-            min-width: 100px;
-            padding: 15px;
-            text-align: center;
-            text-decoration: none;
-            color: #495057;
-            font-weight: 600;
-            transition: all 0.3s;
-            border-bottom: 3px solid transparent;
-        }
-        .nav a:hover {
-            background: #e9ecef;
-            color: #667eea;
-        }
-        .nav a.active {
-            color: #667eea;
-            border-bottom-color: #667eea;
-        }
-        .content {
-            padding: 30px;
-        }
-        .form-group {
-            margin-bottom: 20px;
-        }
-        .form-group label {
-            display: block;
-            margin-bottom: 8px;
-            color: #495057;
-            font-weight: 600;
-        }
-        .form-group input, .form-group select {
-            width: 100%;
-            padding: 12px;
-            border: 2px solid #e9ecef;
-            border-radius: 8px;
-            font-size: 16px;
-            transition: border-color 0.3s;
-        }
-        .form-group input:focus, .form-group select:focus {
-            outline: none;
-            border-color: #667eea;
-        }
-        button {
-            padding: 12px 24px;
-            border: none;
-            border-radius: 8px;
-            font-size: 16px;
-            font-weight: 600;
-            cursor: pointer;
-            transition: all 0.3s;
-            margin: 5px;
-        }
-        .btn-primary {
-            background: #667eea;
-            color: white;
-        }
-        .btn-primary:hover {
-            background: #5568d3;
-            transform: translateY(-2px);
-            box-shadow: 0 5px 15px rgba(102, 126, 234, 0.4);
-        }
-        .btn-success {
-            background: #28a745;
-            color: white;
-        }
-        .btn-success:hover {
-            background: #218838;
-        }
-        .btn-danger {
-            background: #dc3545;
-            color: white;
-        }
-        .btn-danger:hover {
-            background: #c82333;
-        }
-        .btn-warning {
-            background: #ffc107;
-            color: #000;
-        }
-        .btn-warning:hover {
-            background: #e0a800;
-        }
-        .station-card {
-            background: #f8f9fa;
-            padding: 20px;
-            border-radius: 10px;
-            margin-bottom: 15px;
-            display: flex;
-            justify-content: space-between;
-            align-items: center;
-            transition: all 0.3s;
-        }
-        .station-card:hover {
-            background: #e9ecef;
-            transform: translateX(5px);
-        }
-        .station-info h3 {
-            color: #495057;
-            margin-bottom: 5px;
-        }
-        .station-info p {
-            color: #6c757d;
-            font-size: 0.9em;
-            word-break: break-all;
-        }
-        .station-actions {
-            display: flex;
-            gap: 10px;
-        }
-        .alert {
-            padding: 15px;
-            border-radius: 8px;
-            margin-bottom: 20px;
-            display: none;
-        }
-        .alert.success {
-            background: #d4edda;
-            color: #155724;
-            border: 1px solid #c3e6cb;
-        }
-        .alert.error {
-            background: #f8d7da;
-            color: #721c24;
-            border: 1px solid #f5c6cb;
-        }
-        .info-box {
-            background: #e7f3ff;
-            border-left: 4px solid #667eea;
-            padding: 15px;
-            border-radius: 8px;
-            margin-bottom: 20px;
-        }
-        .info-box h3 {
-            color: #667eea;
-            margin-bottom: 10px;
-        }
-        .slider-container {
-            margin: 30px 0;
-        }
-        .slider {
-            width: 100%;
-            height: 8px;
-            border-radius: 5px;
-            background: #e9ecef;
-            outline: none;
-            -webkit-appearance: none;
-        }
-        .slider::-webkit-slider-thumb {
-            -webkit-appearance: none;
-            appearance: none;
-            width: 25px;
-            height: 25px;
-            border-radius: 50%;
-            background: #667eea;
-            cursor: pointer;
-        }
-        .slider::-moz-range-thumb {
-            width: 25px;
-            height: 25px;
-            border-radius: 50%;
-            background: #667eea;
-            cursor: pointer;
-        }
-        .slider-value {
-            display: inline-block;
-            min-width: 50px;
-            text-align: center;
-            font-size: 1.5em;
-            font-weight: bold;
-            color: #667eea;
-            margin-left: 15px;
-        }
-        .checkbox-group {
-            display: grid;
-            grid-template-columns: repeat(auto-fit, minmax(200px, 1fr));
-            gap: 15px;
-            margin: 20px 0;
-        }
-        .checkbox-item {
-            display: flex;
-            align-items: center;
-            padding: 12px;
-            background: #f8f9fa;
-            border-radius: 8px;
-            transition: background 0.3s;
-        }
-        .checkbox-item:hover {
-            background: #e9ecef;
-        }
-        .checkbox-item input[type="checkbox"] {
-            width: 20px;
-            height: 20px;
-            margin-right: 10px;
-            cursor: pointer;
-        }
-        .checkbox-item label {
-            cursor: pointer;
-            user-select: none;
-        }
-    </style>
+    <link rel="stylesheet" href=")html" WEB_ASSET_APP_CSS R"html(">
 </head>
 <body>
     <div class="container">
@@ -254,36 +25,15 @@ String WebServerHTML::getHTMLHeader() {
             <p>Control Panel</p>
         </div>
 )html";
-}
 
-String WebServerHTML::getHTMLFooter() {
-    return R"html(
+static const char HTML_FOOTER[] PROGMEM = R"html(
     </div>
-    <script>
-        function showAlert(message, isError = false) {
-            const alert = document.getElementById('alert');
-            alert.textContent = message;
-            alert.className = 'alert ' + (isError ? 'error' : 'success');
-            alert.style.display = 'block';
-            setTimeout(() => {
-                alert.style.display = 'none';
-            }, 4000);
-        }
-    </script>
+    <script src=")html" WEB_ASSET_APP_JS R"html("></script>
 </body>
 </html>
 )html";
-}
 
-String WebServerHTML::getControlHTML(AudioModule* audioModule, DisplayILI9341* displayModule, TimeModule* timeModule) {
-    String html = getHTMLHeader();
-    
-    // Get current values
-    int currentVolume = audioModule ? audioModule->getCurrentVolume() : 3;
-    int maxVolume = audioModule ? audioModule->getMaxVolume() : 21;
-    int currentBrightness = displayModule ? displayModule->getBrightness() : 200;
-    
-    html += R"html(
+static const char CONTROL_TOP[] PROGMEM = R"html(
         <div class="nav">
             <a href="/">Play</a>
             <a href="/control" class="active">Control</a>
@@ -303,10 +53,9 @@ String WebServerHTML::getControlHTML(AudioModule* audioModule, DisplayILI9341* d
                 <h2 style="color: #495057; margin-bottom: 15px;">🔊 Volume</h2>
                 <div style="display: flex; align-items: center;">
                     <input type="range" class="slider" id="volumeSlider" 
-                           min="0" max=")html" + String(maxVolume) + R"html(" 
-                           value=")html" + String(currentVolume) + R"html(" 
-                           oninput="updateVolumeDisplay(this.value)">
-                    <span class="slider-value" id="volumeValue">)html" + String(currentVolume) + R"html(</span>
+                           min="0" max=")html";
+
+static const char CONTROL_BRIGHTNESS[] PROGMEM = R"html(</span>
                 </div>
                 <button class="btn-primary" onclick="saveVolume()" style="margin-top: 15px;">💾 Save Volume</button>
             </div>
@@ -316,9 +65,9 @@ String WebServerHTML::getControlHTML(AudioModule* audioModule, DisplayILI9341* d
                 <div style="display: flex; align-items: center;">
                     <input type="range" class="slider" id="brightnessSlider" 
                            min="0" max="255" 
-                           value=")html" + String(currentBrightness) + R"html(" 
-                           oninput="updateBrightnessDisplay(this.value)">
-                    <span class="slider-value" id="brightnessValue">)html" + String(currentBrightness) + R"html(</span>
+                           value=")html";
+
+static const char CONTROL_STATUS[] PROGMEM = R"html(</span>
                 </div>
                 <button class="btn-primary" onclick="saveBrightness()" style="margin-top: 15px;">💾 Save Brightness</button>
             </div>
@@ -327,93 +76,12 @@ String WebServerHTML::getControlHTML(AudioModule* audioModule, DisplayILI9341* d
                 <h3>Current Status</h3>
 )html";
 
-    if (audioModule) {
-        html += "<p><strong>Now Playing:</strong> " + audioModule->getCurrentStationName() + "</p>";
-        html += "<p><strong>Audio Status:</strong> " + String(audioModule->getIsPlaying() ? "Playing" : "Stopped") + "</p>";
-    }
-    
-    if (timeModule) {
-        html += "<p><strong>Time:</strong> " + timeModule->getTimeString() + "</p>";
-    }
-    
-    html += R"html(
+static const char CONTROL_BOTTOM[] PROGMEM = R"html(
             </div>
         </div>
-        <script>
-            function updateVolumeDisplay(value) {
-                document.getElementById('volumeValue').textContent = value;
-            }
-            
-            function updateBrightnessDisplay(value) {
-                document.getElementById('brightnessValue').textContent = value;
-            }
-            
-            function saveVolume() {
-                const volume = document.getElementById('volumeSlider').value;
-                
-                fetch('/set_volume', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: 'volume=' + volume
-                })
-                .then(response => response.text())
-                .then(data => {
-                    showAlert('Volume saved: ' + volume);
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-            
-            function saveBrightness() {
-                const brightness = document.getElementById('brightnessSlider').value;
-                
-                fetch('/set_brightness', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: 'brightness=' + brightness
-                })
-                .then(response => response.text())
-                .then(data => {
-                    showAlert('Brightness saved: ' + brightness);
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-        </script>
 )html";
-    
-    html += getHTMLFooter();
-    return html;
-}
 
-String WebServerHTML::getSettingsHTML(StorageModule* storage, TimeModule* timeModule) {
-    String html = getHTMLHeader();
-    
-    // Get current timezone settings
-    long gmtOffset = 0;
-    long dstOffset = 0;
-    if (storage) {
-        storage->loadTimezone(gmtOffset, dstOffset);
-    }
-    
-    int gmtHours = gmtOffset / 3600;
-    int dstHours = dstOffset / 3600;
-    
-    // Get current feature flags
-    FeatureFlags flags;
-    if (storage) {
-        storage->loadFeatureFlags(flags);
-    }
-    
-    // Get current audio mode
-    bool useFMRadio = false;
-    if (storage) {
-        useFMRadio = storage->loadAudioMode(false);
-    }
-    
-    html += R"html(
+static const char SETTINGS_TOP[] PROGMEM = R"html(
         <div class="nav">
             <a href="/">Play</a>
             <a href="/control">Control</a>
@@ -434,61 +102,9 @@ String WebServerHTML::getSettingsHTML(StorageModule* storage, TimeModule* timeMo
             
             <form id="featuresForm">
                 <div class="checkbox-group">
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="touchscreen" name="touchscreen" )html" + 
-                        String(flags.enableTouchScreen ? "checked" : "") + R"html(>
-                        <label for="touchscreen">TouchScreen</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="buttons" name="buttons" )html" + 
-                        String(flags.enableButtons ? "checked" : "") + R"html(>
-                        <label for="buttons">Buttons</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="draw" name="draw" )html" + 
-                        String(flags.enableDraw ? "checked" : "") + R"html(>
-                        <label for="draw">Draw</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="audio" name="audio" )html" + 
-                        String(flags.enableAudio ? "checked" : "") + R"html(>
-                        <label for="audio">Audio</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="stereo" name="stereo" )html" + 
-                        String(flags.enableStereo ? "checked" : "") + R"html(>
-                        <label for="stereo">Stereo</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="led" name="led" )html" + 
-                        String(flags.enableLED ? "checked" : "") + R"html(>
-                        <label for="led">LED</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="alarms" name="alarms" )html" + 
-                        String(flags.enableAlarms ? "checked" : "") + R"html(>
-                        <label for="alarms">Alarms</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="web" name="web" )html" + 
-                        String(flags.enableWeb ? "checked" : "") + R"html(>
-                        <label for="web">Web Server</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="fmradio" name="fmradio" )html" + 
-                        String(flags.enableFMRadio ? "checked" : "") + R"html(>
-                        <label for="fmradio">FM Radio</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="pram" name="pram" )html" + 
-                        String(flags.enablePRAM ? "checked" : "") + R"html(>
-                        <label for="pram">PSRAM</label>
-                    </div>
-                    <div class="checkbox-item">
-                        <input type="checkbox" id="i2cscan" name="i2cscan" )html" + 
-                        String(flags.enableI2CScan ? "checked" : "") + R"html(>
-                        <label for="i2cscan">I2C Scan</label>
-                    </div>
+)html";
+
+static const char SETTINGS_AUDIO_MODE[] PROGMEM = R"html(
                 </div>
                 
                 <button type="button" class="btn-primary" onclick="saveFeatures()">💾 Save Features</button>
@@ -505,12 +121,9 @@ String WebServerHTML::getSettingsHTML(StorageModule* storage, TimeModule* timeMo
             <div class="form-group">
                 <label>Audio Source</label>
                 <select id="audioMode">
-                    <option value="0")html";
-    if (!useFMRadio) html += " selected";
-    html += R"html(">Internet Radio (Streaming)</option>
-                    <option value="1")html";
-    if (useFMRadio) html += " selected";
-    html += R"html(">FM Radio</option>
+)html";
+
+static const char SETTINGS_TIMEZONE[] PROGMEM = R"html(
                 </select>
             </div>
             
@@ -521,36 +134,23 @@ String WebServerHTML::getSettingsHTML(StorageModule* storage, TimeModule* timeMo
             
             <div class="info-box">
                 <h3>Timezone Configuration</h3>
-                <p>Set your timezone offset from GMT and daylight saving time adjustment. <strong>Restart required</strong> after changes.</p>
+                <p>Set your timezone offset from GMT and daylight saving time adjustment. Applies immediately as a fixed offset; for automatic DST, POST <code>posix</code> rules (e.g. <code>GMT0BST,M3.5.0/1,M10.5.0</code>) to <code>/save_timezone</code>.</p>
             </div>
             
             <div class="form-group">
                 <label>GMT Offset (hours)</label>
                 <select id="gmtOffset">)html";
 
-    // Generate GMT offset options from -12 to +14
-    for (int i = -12; i <= 14; i++) {
-        String selected = (i == gmtHours) ? " selected" : "";
-        String sign = (i >= 0) ? "+" : "";
-        html += "<option value='" + String(i) + "'" + selected + ">GMT" + sign + String(i) + ":00</option>";
-    }
-    
-    html += R"html(
+static const char SETTINGS_DST[] PROGMEM = R"html(
                 </select>
             </div>
             
             <div class="form-group">
                 <label>Daylight Saving Time Offset (hours)</label>
                 <select id="dstOffset">
-                    <option value="0")html";
-    if (dstHours == 0) html += " selected";
-    html += R"html(>No DST (0 hours)</option>
-                    <option value="1")html";
-    if (dstHours == 1) html += " selected";
-    html += R"html(>+1 hour (Standard DST)</option>
-                    <option value="2")html";
-    if (dstHours == 2) html += " selected";
-    html += R"html(>+2 hours</option>
+)html";
+
+static const char SETTINGS_SYSTEM[] PROGMEM = R"html(
                 </select>
             </div>
             
@@ -561,78 +161,156 @@ String WebServerHTML::getSettingsHTML(StorageModule* storage, TimeModule* timeMo
             
             <div class="info-box">)html";
 
+static const char SETTINGS_BOTTOM[] PROGMEM = R"html(
+            </div>
+        </div>
+)html";
+
+// ===== HELPERS =====
+
+static void sendOption(HtmlStream& out, const char* value, const char* label, bool selected) {
+    out.printf("<option value=\"%s\"%s>%s</option>\n", value, selected ? " selected" : "", label);
+}
+
+static void sendCheckbox(HtmlStream& out, const char* id, const char* label, bool checked) {
+    out.printf("<div class=\"checkbox-item\"><input type=\"checkbox\" id=\"%s\" name=\"%s\"%s>"
+               "<label for=\"%s\">%s</label></div>\n",
+               id, id, checked ? " checked" : "", id, label);
+}
+
+// ===== PAGES =====
+
+void WebServerHTML::sendHTMLHeader(HtmlStream& out) {
+    out.sendStatic(HTML_HEADER);
+}
+
+void WebServerHTML::sendHTMLFooter(HtmlStream& out) {
+    out.sendStatic(HTML_FOOTER);
+}
+
+void WebServerHTML::sendControlPage(HtmlStream& out, AudioModule* audioModule, DisplayILI9341* displayModule, TimeModule* timeModule) {
+    // Get current values
+    int currentVolume = audioModule ? audioModule->getCurrentVolume() : 3;
+    int maxVolume = audioModule ? audioModule->getMaxVolume() : 21;
+    int currentBrightness = displayModule ? displayModule->getBrightness() : 200;
+    
+    sendHTMLHeader(out);
+    out.sendStatic(CONTROL_TOP);
+    out.printf("%d\" value=\"%d\" oninput=\"updateVolumeDisplay(this.value)\">\n"
+               "<span class=\"slider-value\" id=\"volumeValue\">%d",
+               maxVolume, currentVolume, currentVolume);
+    out.sendStatic(CONTROL_BRIGHTNESS);
+    out.printf("%d\" oninput=\"updateBrightnessDisplay(this.value)\">\n"
+               "<span class=\"slider-value\" id=\"brightnessValue\">%d",
+               currentBrightness, currentBrightness);
+    out.sendStatic(CONTROL_STATUS);
+
+    if (audioModule) {
+        char text[64];
+        audioModule->getCurrentStationName(text, sizeof(text));
+        out.printf("<p><strong>Now Playing:</strong> <span data-live=\"station\">%s</span></p>", text);
+        audioModule->getStatusText(text, sizeof(text));
+        out.printf("<p><strong>Audio Status:</strong> <span data-live=\"status\">%s</span></p>", text);
+
+        AudioBufferStats stats;
+        audioModule->getBufferStats(stats);
+        if (stats.sizeBytes > 0) {
+            out.printf("<p><strong>Stream Buffer:</strong> %u%% of %u KB%s (target %u KB)</p>",
+                       (unsigned)((uint64_t)stats.filledBytes * 100 / stats.sizeBytes),
+                       stats.sizeBytes / 1024, stats.inPsram ? " PSRAM" : "",
+                       stats.targetBytes / 1024);
+            out.printf("<p><strong>Underruns:</strong> %u (last %u ms, total %u ms)</p>",
+                       stats.underruns, stats.lastRebufferMs, stats.totalRebufferMs);
+        }
+    }
+    
     if (timeModule) {
-        html += "<p><strong>Current Time:</strong> " + timeModule->getTimeString() + "</p>";
-        html += "<p><strong>Current Date:</strong> " + timeModule->getDateString() + "</p>";
-        html += "<p><strong>IP Address:</strong> " + timeModule->getIPAddress() + "</p>";
+        char timeText[TIME_TEXT_SIZE];
+        formatClockTime(timeModule->getSnapshot(), timeText);
+        out.printf("<p><strong>Time:</strong> <span data-live=\"time\">%s</span></p>", timeText);
     }
+
+    // Filled in by /events (see app.js)
+    out.print("<p><strong>Alarm:</strong> <span data-live=\"alarm\">-</span></p>");
+    out.print("<p><strong>RDS:</strong> <span data-live=\"rds\">-</span></p>");
     
+    out.sendStatic(CONTROL_BOTTOM);
+    sendHTMLFooter(out);
+}
+
+void WebServerHTML::sendSettingsPage(HtmlStream& out, StorageModule* storage, TimeModule* timeModule) {
+    // Get current timezone settings
+    long gmtOffset = 0;
+    long dstOffset = 0;
     if (storage) {
-        html += "<p><strong>Saved Stations:</strong> " + String(storage->getInternetStationCount()) + " / 10</p>";
-        html += "<p><strong>Audio Mode:</strong> " + String(useFMRadio ? "FM Radio" : "Internet Radio") + "</p>";
+        storage->loadTimezone(gmtOffset, dstOffset);
     }
     
-    html += R"html(
-            </div>
-        </div>
-        
-        <script>
-            function saveFeatures() {
-                const form = document.getElementById('featuresForm');
-                const formData = new FormData(form);
-                const params = new URLSearchParams(formData).toString();
-                
-                fetch('/save_features', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: params
-                })
-                .then(response => response.text())
-                .then(data => {
-                    showAlert(data);
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-            
-            function saveAudioMode() {
-                const audioMode = document.getElementById('audioMode').value;
-                
-                fetch('/save_audio_mode', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: 'audioMode=' + audioMode
-                })
-                .then(response => response.text())
-                .then(data => {
-                    showAlert(data);
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-            
-            function saveTimezone() {
-                const gmtOffset = document.getElementById('gmtOffset').value;
-                const dstOffset = document.getElementById('dstOffset').value;
-                
-                fetch('/save_timezone', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: 'gmtOffset=' + gmtOffset + '&dstOffset=' + dstOffset
-                })
-                .then(response => response.text())
-                .then(data => {
-                    showAlert(data);
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-        </script>
-)html";
+    int gmtHours = gmtOffset / 3600;
+    int dstHours = dstOffset / 3600;
+    
+    // Get current feature flags
+    FeatureFlags flags;
+    if (storage) {
+        storage->loadFeatureFlags(flags);
+    }
+    
+    // Get current audio mode
+    bool useFMRadio = false;
+    if (storage) {
+        useFMRadio = storage->loadAudioMode(false);
+    }
+    
+    sendHTMLHeader(out);
+    out.sendStatic(SETTINGS_TOP);
+    
+    sendCheckbox(out, "touchscreen", "TouchScreen", flags.enableTouchScreen);
+    sendCheckbox(out, "buttons", "Buttons", flags.enableButtons);
+    sendCheckbox(out, "draw", "Draw", flags.enableDraw);
+    sendCheckbox(out, "audio", "Audio", flags.enableAudio);
+    sendCheckbox(out, "stereo", "Stereo", flags.enableStereo);
+    sendCheckbox(out, "led", "LED", flags.enableLED);
+    sendCheckbox(out, "alarms", "Alarms", flags.enableAlarms);
+    sendCheckbox(out, "web", "Web Server", flags.enableWeb);
+    sendCheckbox(out, "fmradio", "FM Radio", flags.enableFMRadio);
+    sendCheckbox(out, "pram", "PSRAM", flags.enablePRAM);
+    sendCheckbox(out, "i2cscan", "I2C Scan", flags.enableI2CScan);
     
-    html += getHTMLFooter();
-    return html;
-}
\ No newline at end of file
+    out.sendStatic(SETTINGS_AUDIO_MODE);
+    sendOption(out, "0", "Internet Radio (Streaming)", !useFMRadio);
+    sendOption(out, "1", "FM Radio", useFMRadio);
+    
+    out.sendStatic(SETTINGS_TIMEZONE);
+
+    // Generate GMT offset options from -12 to +14
+    for (int i = -12; i <= 14; i++) {
+        out.printf("<option value='%d'%s>GMT%s%d:00</option>",
+                   i, (i == gmtHours) ? " selected" : "", (i >= 0) ? "+" : "", i);
+    }
+    
+    out.sendStatic(SETTINGS_DST);
+    sendOption(out, "0", "No DST (0 hours)", dstHours == 0);
+    sendOption(out, "1", "+1 hour (Standard DST)", dstHours == 1);
+    sendOption(out, "2", "+2 hours", dstHours == 2);
+    
+    out.sendStatic(SETTINGS_SYSTEM);
+
+    if (timeModule) {
+        const TimeSnapshot& now = timeModule->getSnapshot();
+        char timeText[TIME_TEXT_SIZE];
+        char dateText[DATE_TEXT_SIZE];
+        formatClockTime(now, timeText);
+        formatShortDate(now, dateText);
+        out.printf("<p><strong>Current Time:</strong> <span data-live=\"time\">%s</span></p>", timeText);
+        out.printf("<p><strong>Current Date:</strong> %s</p>", now.valid ? dateText : "Unknown");
+        out.printf("<p><strong>IP Address:</strong> %s</p>", timeModule->getIPAddress().c_str());
+    }
+    
+    if (storage) {
+        out.printf("<p><strong>Saved Stations:</strong> %d / %d</p>", storage->getInternetStationCount(), MAX_INTERNET_STATIONS);
+        out.printf("<p><strong>Audio Mode:</strong> %s</p>", useFMRadio ? "FM Radio" : "Internet Radio");
+    }
+    
+    out.sendStatic(SETTINGS_BOTTOM);
+    sendHTMLFooter(out);
+}
@@ -2,6 +2,7 @@
 #define WEBSERVER_HTML_H
 
 #include <Arduino.h>
+#include "HtmlStream.h"
 
 // Forward declarations
 class StorageModule;
@@ -11,10 +12,10 @@ class DisplayILI9341;
 
 class WebServerHTML {
 public:
-    static String getHTMLHeader();
-    static String getHTMLFooter();
-    static String getControlHTML(AudioModule* audioModule, DisplayILI9341* displayModule, TimeModule* timeModule);
-    static String getSettingsHTML(StorageModule* storage, TimeModule* timeModule);
+    static void sendHTMLHeader(HtmlStream& out);
+    static void sendHTMLFooter(HtmlStream& out);
+    static void sendControlPage(HtmlStream& out, AudioModule* audioModule, DisplayILI9341* displayModule, TimeModule* timeModule);
+    static void sendSettingsPage(HtmlStream& out, StorageModule* storage, TimeModule* timeModule);
 };
 
 #endif
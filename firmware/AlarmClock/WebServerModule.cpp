@@ -5,21 +5,33 @@
 #include "FMRadioModule.h"
 #include "AlarmController.h"
 #include "WebServerAlarms.h"
+#include "WebServerApi.h"
 #include "DisplayILI9341.h"
 #include "WebServerHTML.h"
+#include "StationTable.h"
+#include "WebAssets.h"
+#include "Profiler.h"
+#include "Metrics.h"
+#include "WebGuard.h"
+#include "HtmlStream.h"
+#include <LittleFS.h>
+#include <WiFi.h>
 
 WebServerModule::WebServerModule() 
     : server(nullptr), playCallback(nullptr), storage(nullptr), 
-      timeModule(nullptr), audioModule(nullptr), fmRadioModule(nullptr),
-      displayModule(nullptr), stationList(nullptr), stationCount(0), 
-      alarmServer(nullptr), alarmController(nullptr) {
-    server = new WebServer(80);
+      timeModule(nullptr), wifiModule(nullptr), audioModule(nullptr), fmRadioModule(nullptr),
+      displayModule(nullptr),
+      alarmServer(nullptr), apiServer(nullptr), alarmController(nullptr) {
+    server = new AsyncWebServer(80);
 }
 
 WebServerModule::~WebServerModule() {
     if (alarmServer) {
         delete alarmServer;
     }
+    if (apiServer) {
+        delete apiServer;
+    }
     if (server) {
         delete server;
     }
@@ -35,20 +47,36 @@ void WebServerModule::begin(const char* mdnsName) {
     }
     
     // Setup main routes
-    server->on("/", [this]() { handleRoot(); });
-    server->on("/stations", [this]() { handleStations(); });
-    server->on("/add_station", HTTP_POST, [this]() { handleAddStation(); });
-    server->on("/delete_station", HTTP_POST, [this]() { handleDeleteStation(); });
-    server->on("/settings", [this]() { handleSettings(); });
-    server->on("/save_timezone", HTTP_POST, [this]() { handleSaveTimezone(); });
-    server->on("/save_features", HTTP_POST, [this]() { handleSaveFeatures(); });
-    server->on("/save_audio_mode", HTTP_POST, [this]() { handleSaveAudioMode(); });
-    server->on("/control", [this]() { handleControl(); });
-    server->on("/set_volume", HTTP_POST, [this]() { handleSetVolume(); });
-    server->on("/set_brightness", HTTP_POST, [this]() { handleSetBrightness(); });
-    server->on("/play", HTTP_POST, [this]() { handlePlay(); });
-    server->on("/stop", HTTP_POST, [this]() { handleStop(); });
-    server->onNotFound([this]() { handleNotFound(); });
+    routePage("/", &WebServerModule::handleRoot);
+    routePage("/stations", &WebServerModule::handleStations);
+    route("/add_station", HTTP_POST, &WebServerModule::handleAddStation);
+    route("/delete_station", HTTP_POST, &WebServerModule::handleDeleteStation);
+    routePage("/settings", &WebServerModule::handleSettings);
+    route("/save_timezone", HTTP_POST, &WebServerModule::handleSaveTimezone);
+    route("/save_features", HTTP_POST, &WebServerModule::handleSaveFeatures);
+    route("/save_audio_mode", HTTP_POST, &WebServerModule::handleSaveAudioMode);
+    routePage("/control", &WebServerModule::handleControl);
+    route("/set_volume", HTTP_POST, &WebServerModule::handleSetVolume);
+    route("/set_brightness", HTTP_POST, &WebServerModule::handleSetBrightness);
+    route("/play", HTTP_POST, &WebServerModule::handlePlay);
+    route("/stop", HTTP_POST, &WebServerModule::handleStop);
+
+    // Diagnostics only read mux-protected or atomic values, no app lock needed
+    server->on("/metrics", HTTP_GET, WebGuard::wrap(
+        [this](AsyncWebServerRequest* request) { handleMetrics(request); }, false, releaseMetricsBuffer));
+    server->on("/metrics/reset", HTTP_POST, WebGuard::wrap(
+        [this](AsyncWebServerRequest* request) { handleResetMetrics(request); }, false));
+    server->onNotFound([this](AsyncWebServerRequest* request) { handleNotFound(request); });
+
+    // Hashed, pre-gzipped CSS/JS (see web/build_assets.py)
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        const WebAsset* asset = &WEB_ASSETS[i];
+        server->on(asset->path, HTTP_GET, WebGuard::wrap(
+            [this, asset](AsyncWebServerRequest* request) { handleAsset(request, *asset); }, false));
+    }
+
+    // Live status push
+    events.begin(server);
 
     Serial.println("Main routes registered");
     
@@ -56,14 +84,6 @@ void WebServerModule::begin(const char* mdnsName) {
     if (storage && audioModule) {
         Serial.println("Creating WebServerAlarms...");
         alarmServer = new WebServerAlarms(server, storage, audioModule, fmRadioModule);
-        
-        if (stationList && stationCount > 0) {
-            Serial.printf("Setting station list (%d stations) for alarms\n", stationCount);
-            alarmServer->setStationList(stationList, stationCount);
-        } else {
-            Serial.println("WARNING: No station list available for alarms");
-        }
-        
         alarmServer->setupRoutes();
         Serial.println("Alarm routes registered");
     } else {
@@ -72,6 +92,12 @@ void WebServerModule::begin(const char* mdnsName) {
         if (!audioModule) Serial.println("  - Audio module missing");
     }
     
+    // JSON API (also used by scripts; see WebServerApi.h)
+    if (storage) {
+        apiServer = new WebServerApi(server, storage, audioModule, fmRadioModule, displayModule, &events);
+        apiServer->setupRoutes();
+    }
+    
     server->begin();
     Serial.println("Web server started on port 80");
     Serial.println("Available routes:");
@@ -79,15 +105,31 @@ void WebServerModule::begin(const char* mdnsName) {
     Serial.println("  /control        - Volume/Brightness control");
     Serial.println("  /stations       - Station management");
     Serial.println("  /settings       - Settings & Features");
+    Serial.println("  /events         - Live status (Server-Sent Events)");
+    Serial.println("  /metrics        - Diagnostics (Prometheus text)");
     if (alarmServer) {
         Serial.println("  /alarms         - Alarm management");
     }
+    if (apiServer) {
+        Serial.println("  /api/v1/...     - JSON API");
+    }
 }
 
+// Requests are served by the AsyncTCP task; this only pushes live status
 void WebServerModule::handleClient() {
-    if (server) {
-        server->handleClient();
-    }
+    events.loop();
+}
+
+void WebServerModule::route(const char* uri, WebRequestMethodComposite method, RouteHandler handler) {
+    server->on(uri, method, WebGuard::wrap([this, handler](AsyncWebServerRequest* request) {
+        (this->*handler)(request);
+    }));
+}
+
+void WebServerModule::routePage(const char* uri, RouteHandler handler) {
+    server->on(uri, HTTP_ANY, WebGuard::wrapPage([this, handler](AsyncWebServerRequest* request) {
+        (this->*handler)(request);
+    }));
 }
 
 void WebServerModule::setPlayCallback(PlayCallback callback) {
@@ -100,113 +142,120 @@ void WebServerModule::setStorageModule(StorageModule* stor) {
 
 void WebServerModule::setTimeModule(TimeModule* time) {
     timeModule = time;
+    events.setTimeModule(time);
+}
+
+void WebServerModule::setWiFiModule(WiFiModule* wifi) {
+    wifiModule = wifi;
 }
 
 void WebServerModule::setAudioModule(AudioModule* aud) {
     audioModule = aud;
+    events.setAudioModule(aud);
 }
 
 void WebServerModule::setFMRadioModule(FMRadioModule* fm) {
     fmRadioModule = fm;
+    events.setFMRadioModule(fm);
 }
 
 void WebServerModule::setDisplayModule(DisplayILI9341* disp) {
     displayModule = disp;
 }
 
-void WebServerModule::setStationList(InternetRadioStation* stations, int count) {
-    stationList = stations;
-    stationCount = count;
-}
-
 void WebServerModule::setAlarmController(AlarmController* ctrl) {
     alarmController = ctrl;
+    events.setAlarmController(ctrl);
     Serial.println("WebServerModule: AlarmController reference set");
     
     // If alarmServer already exists, pass it the reference
     if (alarmServer && alarmController) {
         alarmServer->setAlarmController(alarmController);
     }
+    if (apiServer) {
+        apiServer->setAlarmController(alarmController);
+    }
 }
 
 // ===== ROUTE HANDLERS =====
 
-void WebServerModule::handleRoot() {
-    server->send(200, "text/html", getMainHTML());
+void WebServerModule::handleRoot(AsyncWebServerRequest* request) {
+    sendMainPage(request);
 }
 
-void WebServerModule::handleControl() {
-    server->send(200, "text/html", getControlHTML());
+void WebServerModule::handleControl(AsyncWebServerRequest* request) {
+    sendControlPage(request);
 }
 
-void WebServerModule::handleStations() {
-    server->send(200, "text/html", getStationsHTML());
+void WebServerModule::handleStations(AsyncWebServerRequest* request) {
+    sendStationsPage(request);
 }
 
-void WebServerModule::handleSettings() {
-    server->send(200, "text/html", getSettingsHTML());
+void WebServerModule::handleSettings(AsyncWebServerRequest* request) {
+    sendSettingsPage(request);
 }
 
-void WebServerModule::handleSetVolume() {
-    if (!server->hasArg("volume") || !audioModule || !storage) {
-        server->send(400, "text/plain", "Missing parameters");
+void WebServerModule::handleSetVolume(AsyncWebServerRequest* request) {
+    if (!request->hasArg("volume") || !audioModule || !storage) {
+        request->send(400, "text/plain", "Missing parameters");
         return;
     }
     
-    int volume = server->arg("volume").toInt();
+    int volume = request->arg("volume").toInt();
     audioModule->setVolume(volume);
     storage->saveVolume(volume);
     
     Serial.printf("Volume set to %d via web\n", volume);
-    server->send(200, "text/plain", "Volume updated");
+    request->send(200, "text/plain", "Volume updated");
 }
 
-void WebServerModule::handleSetBrightness() {
-    if (!server->hasArg("brightness") || !displayModule || !storage) {
-        server->send(400, "text/plain", "Missing parameters");
+void WebServerModule::handleSetBrightness(AsyncWebServerRequest* request) {
+    if (!request->hasArg("brightness") || !displayModule || !storage) {
+        request->send(400, "text/plain", "Missing parameters");
         return;
     }
     
-    int brightness = server->arg("brightness").toInt();
+    int brightness = request->arg("brightness").toInt();
     displayModule->setBrightness(brightness);
     storage->saveBrightness(brightness);
     
     Serial.printf("Brightness set to %d via web\n", brightness);
-    server->send(200, "text/plain", "Brightness updated");
+    request->send(200, "text/plain", "Brightness updated");
 }
 
-void WebServerModule::handleSaveFeatures() {
+void WebServerModule::handleSaveFeatures(AsyncWebServerRequest* request) {
     if (!storage) {
-        server->send(400, "text/plain", "Storage not available");
+        request->send(400, "text/plain", "Storage not available");
         return;
     }
     
     FeatureFlags flags;
-    flags.enableTouchScreen = server->hasArg("touchscreen");
-    flags.enableButtons = server->hasArg("buttons");
-    flags.enableDraw = server->hasArg("draw");
-    flags.enableAudio = server->hasArg("audio");
-    flags.enableStereo = server->hasArg("stereo");
-    flags.enableLED = server->hasArg("led");
-    flags.enableAlarms = server->hasArg("alarms");
-    flags.enableWeb = server->hasArg("web");
-    flags.enableFMRadio = server->hasArg("fmradio");
-    flags.enablePRAM = server->hasArg("pram");
-    flags.enableI2CScan = server->hasArg("i2cscan");
-    
-    if (storage->saveFeatureFlags(flags)) {
-        server->send(200, "text/plain", "Feature flags saved. Restart device for changes to take effect.");
+    flags.enableTouchScreen = request->hasArg("touchscreen");
+    flags.enableButtons = request->hasArg("buttons");
+    flags.enableDraw = request->hasArg("draw");
+    flags.enableAudio = request->hasArg("audio");
+    flags.enableStereo = request->hasArg("stereo");
+    flags.enableLED = request->hasArg("led");
+    flags.enableAlarms = request->hasArg("alarms");
+    flags.enableWeb = request->hasArg("web");
+    flags.enableFMRadio = request->hasArg("fmradio");
+    flags.enablePRAM = request->hasArg("pram");
+    flags.enableI2CScan = request->hasArg("i2cscan");
+    
+    // Committed now: these only apply after a restart, often a power cycle
+    if (storage->saveFeatureFlags(flags) && storage->flushSettings()) {
+        request->send(200, "text/plain", "Feature flags saved. Restart device for changes to take effect.");
     } else {
-        server->send(500, "text/plain", "Failed to save feature flags");
+        request->send(500, "text/plain", "Failed to save feature flags");
     }
 }
-void WebServerModule::handleSaveAudioMode() {
-    if (!server->hasArg("audioMode") || !storage) {
-        server->send(400, "text/plain", "Missing parameters");
+void WebServerModule::handleSaveAudioMode(AsyncWebServerRequest* request) {
+    if (!request->hasArg("audioMode") || !storage) {
+        request->send(400, "text/plain", "Missing parameters");
         return;
     }
     
-    bool useFMRadio = (server->arg("audioMode") == "1");
+    bool useFMRadio = (request->arg("audioMode") == "1");
     
     // Save to storage
     if (storage->saveAudioMode(useFMRadio)) {
@@ -218,146 +267,256 @@ void WebServerModule::handleSaveAudioMode() {
                      useFMRadio ? "FM Radio" : "Internet Radio",
                      useFMRadio ? "HIGH" : "LOW");
         
-        server->send(200, "text/plain", 
+        request->send(200, "text/plain", 
                     String("Audio mode set to ") + 
                     (useFMRadio ? "FM Radio" : "Internet Radio") + 
                     ". Mode switch applied immediately.");
     } else {
-        server->send(500, "text/plain", "Failed to save audio mode");
+        request->send(500, "text/plain", "Failed to save audio mode");
     }
 }
-void WebServerModule::handleAddStation() {
-    if (!server->hasArg("name") || !server->hasArg("url") || !storage) {
-        server->send(400, "text/plain", "Missing parameters or storage not available");
+void WebServerModule::handleAddStation(AsyncWebServerRequest* request) {
+    if (!request->hasArg("name") || !request->hasArg("url") || !storage) {
+        request->send(400, "text/plain", "Missing parameters or storage not available");
         return;
     }
     
-    String name = server->arg("name");
-    String url = server->arg("url");
+    String name = request->arg("name");
+    String url = request->arg("url");
     
     int count = storage->getInternetStationCount();
     if (count >= MAX_INTERNET_STATIONS) {
-        server->send(400, "text/plain", "Maximum stations reached (10)");
+        request->send(400, "text/plain", "Maximum stations reached");
         return;
     }
     
     if (storage->saveInternetStation(count, name.c_str(), url.c_str())) {
-        storage->setInternetStationCount(count + 1);
-        server->send(200, "text/plain", "Station added successfully");
+        storage->publishInternetStations();
+        request->send(200, "text/plain", "Station added successfully");
     } else {
-        server->send(500, "text/plain", "Failed to save station");
+        request->send(500, "text/plain", "Failed to save station");
     }
 }
 
-void WebServerModule::handleDeleteStation() {
-    if (!server->hasArg("index") || !storage) {
-        server->send(400, "text/plain", "Missing parameters");
+void WebServerModule::handleDeleteStation(AsyncWebServerRequest* request) {
+    if (!request->hasArg("index") || !storage) {
+        request->send(400, "text/plain", "Missing parameters");
         return;
     }
     
-    int index = server->arg("index").toInt();
+    int index = request->arg("index").toInt();
     int count = storage->getInternetStationCount();
     
     if (index < 0 || index >= count) {
-        server->send(400, "text/plain", "Invalid station index");
+        request->send(400, "text/plain", "Invalid station index");
         return;
     }
     
-    // Shift all stations down
-    for (int i = index; i < count - 1; i++) {
-        String name, url;
-        if (storage->loadInternetStation(i + 1, name, url)) {
-            storage->saveInternetStation(i, name.c_str(), url.c_str());
-        }
+    // Tombstoned in the catalog; later stations move up one
+    if (!storage->deleteInternetStation(index)) {
+        request->send(500, "text/plain", "Failed to delete station");
+        return;
     }
+    storage->publishInternetStations();
     
-    // Delete the last station
-    storage->deleteInternetStation(count - 1);
-    storage->setInternetStationCount(count - 1);
-    
-    server->send(200, "text/plain", "Station deleted successfully");
+    request->send(200, "text/plain", "Station deleted successfully");
 }
 
-void WebServerModule::handleSaveTimezone() {
-    if (!server->hasArg("gmtOffset") || !server->hasArg("dstOffset") || !storage || !timeModule) {
-        server->send(400, "text/plain", "Missing parameters");
+void WebServerModule::handleSaveTimezone(AsyncWebServerRequest* request) {
+    if (!storage || !timeModule) {
+        request->send(500, "text/plain", "Time not available");
+        return;
+    }
+    
+    // Full rules ("GMT0BST,M3.5.0/1,M10.5.0") switch DST automatically
+    if (request->hasArg("posix")) {
+        String posix = request->arg("posix");
+        if (!timeModule->setTimezoneRules(request->arg("name").c_str(), posix.c_str())) {
+            request->send(400, "text/plain", "Invalid POSIX timezone");
+            return;
+        }
+        request->send(200, "text/plain", "Timezone saved: " + posix);
         return;
     }
     
-    long gmtOffset = server->arg("gmtOffset").toInt() * 3600; // Convert hours to seconds
-    int dstOffset = server->arg("dstOffset").toInt() * 3600;  // Convert hours to seconds
+    if (!request->hasArg("gmtOffset") || !request->hasArg("dstOffset")) {
+        request->send(400, "text/plain", "Missing parameters");
+        return;
+    }
     
-    if (storage->saveTimezone(gmtOffset, dstOffset)) {
-        server->send(200, "text/plain", "Timezone saved. Restart device for changes to take effect.");
+    long gmtOffset = request->arg("gmtOffset").toInt() * 3600; // Convert hours to seconds
+    int dstOffset = request->arg("dstOffset").toInt() * 3600;  // Convert hours to seconds
+    
+    // The offsets form sets a fixed offset (DST added all year, as before)
+    char posix[TZ_POSIX_MAX];
+    posixTzFixed(gmtOffset + dstOffset, posix, sizeof(posix));
+    
+    if (storage->saveTimezone(gmtOffset, dstOffset) && storage->flushSettings() &&
+        timeModule->setTimezoneRules("", posix)) {
+        request->send(200, "text/plain", "Timezone saved: " + String(posix));
     } else {
-        server->send(500, "text/plain", "Failed to save timezone");
+        request->send(500, "text/plain", "Failed to save timezone");
     }
 }
 
-void WebServerModule::handlePlay() {
-    if (!server->hasArg("name") || !server->hasArg("url")) {
-        server->send(400, "text/plain", "Missing parameters");
+void WebServerModule::handlePlay(AsyncWebServerRequest* request) {
+    if (!request->hasArg("name") || !request->hasArg("url")) {
+        request->send(400, "text/plain", "Missing parameters");
         return;
     }
     
-    String name = server->arg("name");
-    String url = server->arg("url");
+    String name = request->arg("name");
+    String url = request->arg("url");
     
     Serial.printf("Web request to play: %s - %s\n", name.c_str(), url.c_str());
     
     if (playCallback) {
         playCallback(name.c_str(), url.c_str());
-        server->send(200, "text/plain", "Playing: " + name);
+        request->send(200, "text/plain", "Playing: " + name);
     } else {
-        server->send(500, "text/plain", "No callback registered");
+        request->send(500, "text/plain", "No callback registered");
     }
 }
 
-void WebServerModule::handleStop() {
+void WebServerModule::handleStop(AsyncWebServerRequest* request) {
     Serial.println("Web request to stop audio");
     
     if (audioModule) {
         audioModule->stop();
-        server->send(200, "text/plain", "Audio stopped");
+        request->send(200, "text/plain", "Audio stopped");
     } else {
-        server->send(500, "text/plain", "Audio module not available");
+        request->send(500, "text/plain", "Audio module not available");
+    }
+}
+
+void WebServerModule::handleAsset(AsyncWebServerRequest* request, const WebAsset& asset) {
+    AsyncWebServerResponse* response;
+
+    if (request->hasHeader("If-None-Match") &&
+        request->getHeader("If-None-Match")->value() == asset.etag) {
+        response = request->beginResponse(304);
+    } else if (LittleFS.exists(String(asset.path) + ".gz")) {
+        // Picks up path + ".gz" and adds Content-Encoding: gzip
+        response = request->beginResponse(LittleFS, asset.path, asset.contentType);
+    } else {
+        // Filesystem image not uploaded - serve the copy built into flash
+        response = request->beginResponse_P(200, asset.contentType, asset.gzData, asset.gzSize);
+        response->addHeader("Content-Encoding", "gzip");
+    }
+
+    // URLs change whenever the content does, so browsers may cache forever
+    response->addHeader("Cache-Control", "public, max-age=31536000, immutable");
+    response->addHeader("ETag", asset.etag);
+    request->send(response);
+}
+
+// Rendered into a static buffer so scraping doesn't churn the heap it reports on.
+// The response reads from it while sending, so one scrape at a time.
+static char metricsText[METRICS_BUFFER_SIZE];
+static AsyncWebServerRequest* metricsOwner = nullptr;
+
+void WebServerModule::releaseMetricsBuffer(AsyncWebServerRequest* request) {
+    if (metricsOwner == request) metricsOwner = nullptr;
+}
+
+void WebServerModule::handleMetrics(AsyncWebServerRequest* request) {
+    if (metricsOwner) {
+        request->send(503, "text/plain", "Scrape in progress");
+        return;
+    }
+    metricsOwner = request;
+
+    MetricsBuffer out(metricsText, sizeof(metricsText));
+
+    out.gauge("uptime_seconds", (uint32_t)(millis() / 1000));
+
+    // Internal heap
+    out.gauge("heap_free_bytes", (uint32_t)ESP.getFreeHeap());
+    out.gauge("heap_min_free_bytes", (uint32_t)ESP.getMinFreeHeap());
+    out.gauge("heap_largest_free_block_bytes", (uint32_t)ESP.getMaxAllocHeap());
+
+    // PSRAM
+    out.gauge("psram_size_bytes", (uint32_t)ESP.getPsramSize());
+    out.gauge("psram_free_bytes", (uint32_t)ESP.getFreePsram());
+    out.gauge("psram_largest_free_block_bytes", (uint32_t)ESP.getMaxAllocPsram());
+
+    // Audio stream
+    if (audioModule) {
+        AudioBufferStats stats;
+        audioModule->getBufferStats(stats);
+        out.gauge("audio_buffer_size_bytes", stats.sizeBytes);
+        out.gauge("audio_buffer_filled_bytes", stats.filledBytes);
+        out.gauge("audio_prebuffer_target_bytes", stats.targetBytes);
+        out.gauge("audio_bitrate_bps", stats.bitRate);
+        out.counter("audio_underruns_total", stats.underruns);
+        out.counter("audio_rebuffer_ms_total", stats.totalRebufferMs);
     }
+
+    // WiFi
+    bool wifiUp = WiFi.status() == WL_CONNECTED;
+    out.gauge("wifi_connected", (uint32_t)(wifiUp ? 1 : 0));
+    if (wifiUp) {
+        out.gauge("wifi_rssi_dbm", (int32_t)WiFi.RSSI());
+    }
+    if (wifiModule) {
+        out.counter("wifi_link_drops_total", wifiModule->getDrops());
+        out.counter("wifi_join_attempts_total", wifiModule->getAttempts());
+    }
+
+    // Web server
+    out.gauge("web_open_requests", (int32_t)WebGuard::getOpenRequests());
+    out.counter("web_rejected_total", WebGuard::getRejected());
+    out.gauge("web_event_listeners", (int32_t)events.getClientCount());
+    out.gauge("web_page_buffer_bytes", (uint32_t)HtmlStream::getHeldBytes());
+    out.gauge("web_page_buffer_peak_bytes", (uint32_t)HtmlStream::getPeakBytes());
+
+    // Settings journal
+    if (storage) {
+        out.counter("settings_flash_writes_total", storage->getSettingsWrites());
+    }
+
+    // Work loop
+    out.gauge("loop_rate_hz", Metrics::getLoopRate());
+    out.counter("alarm_checks_total", Metrics::getAlarmChecks());
+#if ENABLE_PROFILER
+    Profiler::writeMetrics(out);
+#endif
+
+    if (out.hasOverflowed()) {
+        Serial.println("WebServer: /metrics truncated, raise METRICS_BUFFER_SIZE");
+    }
+
+    request->send_P(200, "text/plain; version=0.0.4", (const uint8_t*)out.c_str(), out.size());
+}
+
+void WebServerModule::handleResetMetrics(AsyncWebServerRequest* request) {
+    Profiler::reset();
+    request->send(200, "text/plain", "Profiler reset");
 }
 
-void WebServerModule::handleNotFound() {
+void WebServerModule::handleNotFound(AsyncWebServerRequest* request) {
     String message = "File Not Found\n\n";
     message += "URI: ";
-    message += server->uri();
+    message += request->url();
     message += "\nMethod: ";
-    message += (server->method() == HTTP_GET) ? "GET" : "POST";
+    message += request->methodToString();
     message += "\nArguments: ";
-    message += server->args();
+    message += request->args();
     message += "\n";
     
-    for (uint8_t i = 0; i < server->args(); i++) {
-        message += " " + server->argName(i) + ": " + server->arg(i) + "\n";
+    for (size_t i = 0; i < request->args(); i++) {
+        message += " " + request->argName(i) + ": " + request->arg(i) + "\n";
     }
     
     Serial.println("404 Not Found:");
     Serial.println(message);
     
-    server->send(404, "text/plain", message);
+    request->send(404, "text/plain", message);
 }
 
-// ===== HTML GENERATION (delegated to WebServerHTML) =====
+// ===== HTML GENERATION (streamed via HtmlStream) =====
 
-String WebServerModule::getControlHTML() {
-    return WebServerHTML::getControlHTML(audioModule, displayModule, timeModule);
-}
-
-String WebServerModule::getSettingsHTML() {
-    return WebServerHTML::getSettingsHTML(storage, timeModule);
-}
-
-String WebServerModule::getMainHTML() {
-    String html = WebServerHTML::getHTMLHeader();
-    
-    html += R"html(
+static const char MAIN_TOP[] PROGMEM = R"html(
         <div class="nav">
             <a href="/" class="active">Play</a>
             <a href="/control">Control</a>
@@ -389,81 +548,11 @@ String WebServerModule::getMainHTML() {
             <h2 style="margin-top: 40px; margin-bottom: 20px; color: #495057;">Your Saved Stations</h2>
 )html";
 
-    // Load and display saved stations
-    if (storage) {
-        int count = storage->getInternetStationCount();
-        
-        if (count == 0) {
-            html += "<p style='color: #6c757d; text-align: center; padding: 40px;'>No stations saved yet. Add some in the Manage Stations page!</p>";
-        } else {
-            for (int i = 0; i < count; i++) {
-                String name, url;
-                if (storage->loadInternetStation(i, name, url)) {
-                    html += "<div class='station-card'>";
-                    html += "<div class='station-info'>";
-                    html += "<h3>" + name + "</h3>";
-                    html += "<p>" + url + "</p>";
-                    html += "</div>";
-                    html += "<button class='btn-success' onclick='playStation(\"" + name + "\", \"" + url + "\")'>▶ Play</button>";
-                    html += "</div>";
-                }
-            }
-        }
-    }
-    
-    html += R"html(
+static const char MAIN_BOTTOM[] PROGMEM = R"html(
         </div>
-        <script>
-            function playCustom() {
-                const name = document.getElementById('playName').value;
-                const url = document.getElementById('playUrl').value;
-                
-                if (!name || !url) {
-                    showAlert('Please enter both name and URL', true);
-                    return;
-                }
-                
-                playStation(name, url);
-            }
-            
-            function playStation(name, url) {
-                fetch('/play', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: 'name=' + encodeURIComponent(name) + '&url=' + encodeURIComponent(url)
-                })
-                .then(response => response.text())
-                .then(data => {
-                    showAlert(data);
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-            
-            function stopAudio() {
-                fetch('/stop', {
-                    method: 'POST'
-                })
-                .then(response => response.text())
-                .then(data => {
-                    showAlert(data);
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-        </script>
 )html";
-    
-    html += WebServerHTML::getHTMLFooter();
-    return html;
-}
 
-String WebServerModule::getStationsHTML() {
-    String html = WebServerHTML::getHTMLHeader();
-    
-    html += R"html(
+static const char STATIONS_TOP[] PROGMEM = R"html(
         <div class="nav">
             <a href="/">Play</a>
             <a href="/control">Control</a>
@@ -476,7 +565,10 @@ String WebServerModule::getStationsHTML() {
             
             <div class="info-box">
                 <h3>Station Management</h3>
-                <p>Add up to 10 internet radio stations. These will be stored permanently and available for quick playback.</p>
+                <p>Add up to )html";
+
+// Follows the station limit, printed from MAX_INTERNET_STATIONS
+static const char STATIONS_FORM[] PROGMEM = R"html( internet radio stations. These will be stored permanently and available for quick playback.</p>
             </div>
             
             <h2 style="margin-bottom: 20px; color: #495057;">Add New Station</h2>
@@ -498,102 +590,81 @@ String WebServerModule::getStationsHTML() {
             <div id="stationsList">
 )html";
 
-    // Load and display saved stations with delete buttons
-    if (storage) {
-        int count = storage->getInternetStationCount();
-        
-        if (count == 0) {
-            html += "<p style='color: #6c757d; text-align: center; padding: 40px;'>No stations saved yet.</p>";
-        } else {
-            for (int i = 0; i < count; i++) {
-                String name, url;
-                if (storage->loadInternetStation(i, name, url)) {
-                    html += "<div class='station-card' id='station-" + String(i) + "'>";
-                    html += "<div class='station-info'>";
-                    html += "<h3>" + name + "</h3>";
-                    html += "<p>" + url + "</p>";
-                    html += "</div>";
-                    html += "<div class='station-actions'>";
-                    html += "<button class='btn-success' onclick='playFromList(\"" + name + "\", \"" + url + "\")'>▶ Play</button>";
-                    html += "<button class='btn-danger' onclick='deleteStation(" + String(i) + ")'>🗑 Delete</button>";
-                    html += "</div>";
-                    html += "</div>";
-                }
-            }
-        }
-    }
-    
-    html += R"html(
+static const char STATIONS_BOTTOM[] PROGMEM = R"html(
             </div>
         </div>
-        <script>
-            function addStation() {
-                const name = document.getElementById('newName').value;
-                const url = document.getElementById('newUrl').value;
-                
-                if (!name || !url) {
-                    showAlert('Please enter both name and URL', true);
-                    return;
-                }
-                
-                fetch('/add_station', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: 'name=' + encodeURIComponent(name) + '&url=' + encodeURIComponent(url)
-                })
-                .then(response => response.text())
-                .then(data => {
-                    if (data.includes('success')) {
-                        showAlert(data);
-                        document.getElementById('newName').value = '';
-                        document.getElementById('newUrl').value = '';
-                        setTimeout(() => location.reload(), 1500);
-                    } else {
-                        showAlert(data, true);
-                    }
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-            
-            function deleteStation(index) {
-                if (!confirm('Are you sure you want to delete this station?')) {
-                    return;
-                }
-                
-                fetch('/delete_station', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: 'index=' + index
-                })
-                .then(response => response.text())
-                .then(data => {
-                    showAlert(data);
-                    setTimeout(() => location.reload(), 1000);
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-            
-            function playFromList(name, url) {
-                fetch('/play', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: 'name=' + encodeURIComponent(name) + '&url=' + encodeURIComponent(url)
-                })
-                .then(response => response.text())
-                .then(data => {
-                    showAlert(data);
-                })
-                .catch(error => {
-                    showAlert('Error: ' + error, true);
-                });
-            }
-        </script>
 )html";
+
+void WebServerModule::sendControlPage(AsyncWebServerRequest* request) {
+    HtmlStream out(request);
+    out.begin();
+    WebServerHTML::sendControlPage(out, audioModule, displayModule, timeModule);
+    out.end();
+}
+
+void WebServerModule::sendSettingsPage(AsyncWebServerRequest* request) {
+    HtmlStream out(request);
+    out.begin();
+    WebServerHTML::sendSettingsPage(out, storage, timeModule);
+    out.end();
+}
+
+void WebServerModule::sendMainPage(AsyncWebServerRequest* request) {
+    HtmlStream out(request);
+    out.begin();
+    WebServerHTML::sendHTMLHeader(out);
+    out.sendStatic(MAIN_TOP);
+
+    // Saved stations, written from the shared table as the page is sent
+    std::shared_ptr<const StationTable> stations = StationTable::acquireShared();
+    int count = stations ? stations->count() : 0;
+    
+    if (count == 0) {
+        out.print("<p style='color: #6c757d; text-align: center; padding: 40px;'>No stations saved yet. Add some in the Manage Stations page!</p>");
+    } else {
+        out.sendRows(count, [stations](HtmlRowOut& row, int i) {
+            const StationEntry* station = stations->get(i);
+            row.print("<div class='station-card'><div class='station-info'>");
+            row.printf("<h3>%s</h3><p>%s</p></div>", station->name.data, station->url.data);
+            row.printf("<button class='btn-success' onclick='playStation(\"%s\", \"%s\")'>▶ Play</button>",
+                       station->name.data, station->url.data);
+            row.print("</div>");
+        });
+    }
+    
+    out.sendStatic(MAIN_BOTTOM);
+    WebServerHTML::sendHTMLFooter(out);
+    out.end();
+}
+
+void WebServerModule::sendStationsPage(AsyncWebServerRequest* request) {
+    HtmlStream out(request);
+    out.begin();
+    WebServerHTML::sendHTMLHeader(out);
+    out.sendStatic(STATIONS_TOP);
+    out.print(MAX_INTERNET_STATIONS);
+    out.sendStatic(STATIONS_FORM);
+
+    // Saved stations with delete buttons
+    std::shared_ptr<const StationTable> stations = StationTable::acquireShared();
+    int count = stations ? stations->count() : 0;
+    
+    if (count == 0) {
+        out.print("<p style='color: #6c757d; text-align: center; padding: 40px;'>No stations saved yet.</p>");
+    } else {
+        out.sendRows(count, [stations](HtmlRowOut& row, int i) {
+            const StationEntry* station = stations->get(i);
+            row.printf("<div class='station-card' id='station-%d'><div class='station-info'>", i);
+            row.printf("<h3>%s</h3><p>%s</p></div>", station->name.data, station->url.data);
+            row.print("<div class='station-actions'>");
+            row.printf("<button class='btn-success' onclick='playFromList(\"%s\", \"%s\")'>▶ Play</button>",
+                       station->name.data, station->url.data);
+            row.printf("<button class='btn-danger' onclick='deleteStation(%d)'>🗑 Delete</button>", i);
+            row.print("</div></div>");
+        });
+    }
     
-    html += WebServerHTML::getHTMLFooter();
-    return html;
+    out.sendStatic(STATIONS_BOTTOM);
+    WebServerHTML::sendHTMLFooter(out);
+    out.end();
 }
@@ -1,71 +1,85 @@
 #ifndef WEBSERVER_MODULE_H
 #define WEBSERVER_MODULE_H
 
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 #include <ESPmDNS.h>
 #include "StorageModule.h"
 #include "TimeModule.h"
+#include "WiFiModule.h"
 #include "CommonTypes.h"
+#include "EventStream.h"
 
 // Forward declarations
 class AudioModule;
 class FMRadioModule;
 class DisplayILI9341;
 class WebServerAlarms;
+class WebServerApi;
 class AlarmController;
+struct WebAsset;
 
 // Callback type for playing custom stations
 typedef void (*PlayCallback)(const char* name, const char* url);
 
 class WebServerModule {
 private:
-    WebServer* server;
+    AsyncWebServer* server;
     PlayCallback playCallback;
     StorageModule* storage;
     TimeModule* timeModule;
+    WiFiModule* wifiModule;
     AudioModule* audioModule;
     FMRadioModule* fmRadioModule;
     DisplayILI9341* displayModule;
-    InternetRadioStation* stationList;
-    int stationCount;
     WebServerAlarms* alarmServer;
+    WebServerApi* apiServer;
     AlarmController* alarmController;
+    EventStream events;
     
-    // Route handlers
-    void handleRoot();
-    void handleControl();
-    void handleStations();
-    void handleAddStation();
-    void handleDeleteStation();
-    void handleSettings();
-    void handleSaveTimezone();
-    void handleSaveFeatures();
-    void handleSetVolume();
-    void handleSetBrightness();
-    void handlePlay();
-    void handleStop();
-    void handleNotFound();
-    void handleSaveAudioMode();
+    // Route handlers (run on the AsyncTCP task, see WebGuard)
+    typedef void (WebServerModule::*RouteHandler)(AsyncWebServerRequest* request);
+    void route(const char* uri, WebRequestMethodComposite method, RouteHandler handler);
+    // A page a browser navigates to (see WebGuard::wrapPage)
+    void routePage(const char* uri, RouteHandler handler);
+
+    void handleRoot(AsyncWebServerRequest* request);
+    void handleControl(AsyncWebServerRequest* request);
+    void handleStations(AsyncWebServerRequest* request);
+    void handleAddStation(AsyncWebServerRequest* request);
+    void handleDeleteStation(AsyncWebServerRequest* request);
+    void handleSettings(AsyncWebServerRequest* request);
+    void handleSaveTimezone(AsyncWebServerRequest* request);
+    void handleSaveFeatures(AsyncWebServerRequest* request);
+    void handleSetVolume(AsyncWebServerRequest* request);
+    void handleSetBrightness(AsyncWebServerRequest* request);
+    void handlePlay(AsyncWebServerRequest* request);
+    void handleStop(AsyncWebServerRequest* request);
+    void handleNotFound(AsyncWebServerRequest* request);
+    void handleSaveAudioMode(AsyncWebServerRequest* request);
+    void handleAsset(AsyncWebServerRequest* request, const WebAsset& asset);
+    void handleMetrics(AsyncWebServerRequest* request);
+    void handleResetMetrics(AsyncWebServerRequest* request);
+    static void releaseMetricsBuffer(AsyncWebServerRequest* request);
     
-    // HTML generation (delegated to WebServerHTML)
-    String getMainHTML();
-    String getControlHTML();
-    String getStationsHTML();
-    String getSettingsHTML();
+    // HTML pages, built without Strings (see HtmlStream)
+    void sendMainPage(AsyncWebServerRequest* request);
+    void sendControlPage(AsyncWebServerRequest* request);
+    void sendStationsPage(AsyncWebServerRequest* request);
+    void sendSettingsPage(AsyncWebServerRequest* request);
 
 public:
     WebServerModule();
     ~WebServerModule();
     
     void begin(const char* mdnsName = "alarmclock");
-    void handleClient();
+    void handleClient();  // Pushes /events updates; requests are served asynchronously
     void setPlayCallback(PlayCallback callback);
     void setStorageModule(StorageModule* stor);
     void setTimeModule(TimeModule* time);
+    void setWiFiModule(WiFiModule* wifi);
     void setAudioModule(AudioModule* aud);      
     void setFMRadioModule(FMRadioModule* fm);
     void setDisplayModule(DisplayILI9341* disp);
-    void setStationList(InternetRadioStation* stations, int count);  
     void setAlarmController(AlarmController* ctrl);
 };
 
@@ -0,0 +1,156 @@
+#include "WiFiLink.h"
+#include <string.h>
+
+WiFiLink::WiFiLink()
+    : radio(nullptr), apCount(0), cacheChanged(false),
+      state(WIFI_LINK_IDLE), apIndex(0), roundStart(0), fastAttempt(false), fastTried(false),
+      attemptStart(0), deadline(0),
+      connectTimeoutMs(10000), fastTimeoutMs(3000), backoffMinMs(2000), backoffMaxMs(300000),
+      failedRounds(0), attempts(0), drops(0), connectedSince(0) {
+    memset(aps, 0, sizeof(aps));
+    memset(&cache, 0, sizeof(cache));
+}
+
+void WiFiLink::configure(uint32_t connectTimeout, uint32_t fastTimeout, uint32_t backoffMin, uint32_t backoffMax) {
+    connectTimeoutMs = connectTimeout;
+    fastTimeoutMs = fastTimeout;
+    backoffMinMs = backoffMin;
+    backoffMaxMs = backoffMax;
+}
+
+bool WiFiLink::addAp(const char* ssid, const char* password) {
+    if (apCount >= WIFI_MAX_APS || !ssid || !ssid[0] ||
+        strlen(ssid) >= WIFI_SSID_MAX || (password && strlen(password) >= WIFI_PASS_MAX)) {
+        return false;
+    }
+
+    strcpy(aps[apCount].ssid, ssid);
+    strcpy(aps[apCount].password, password ? password : "");
+    apCount++;
+    return true;
+}
+
+const char* WiFiLink::getApSsid(int index) const {
+    if (index < 0 || index >= apCount) return "";
+    return aps[index].ssid;
+}
+
+void WiFiLink::setCache(const WiFiApCache& saved) {
+    cache = saved;
+    if (cache.apIndex >= apCount) cache.valid = 0;
+}
+
+bool WiFiLink::takeCacheChanged() {
+    bool changed = cacheChanged;
+    cacheChanged = false;
+    return changed;
+}
+
+// ===== ATTEMPTS =====
+
+void WiFiLink::begin(WiFiRadio& driver, uint32_t nowMs) {
+    radio = &driver;
+    failedRounds = 0;
+    if (apCount > 0) beginRound(nowMs);
+}
+
+void WiFiLink::stop() {
+    if (radio && state != WIFI_LINK_IDLE) radio->leave();
+    state = WIFI_LINK_IDLE;
+}
+
+void WiFiLink::beginRound(uint32_t nowMs) {
+    apIndex = cache.valid ? cache.apIndex : 0;
+    roundStart = apIndex;
+    fastTried = false;
+    attempt(nowMs);
+}
+
+void WiFiLink::attempt(uint32_t nowMs) {
+    const WiFiAp& ap = aps[apIndex];
+    fastAttempt = cache.valid && cache.apIndex == apIndex && !fastTried;
+
+    state = WIFI_LINK_CONNECTING;
+    attemptStart = nowMs;
+    deadline = nowMs + (fastAttempt ? fastTimeoutMs : connectTimeoutMs);
+    attempts++;
+
+    radio->join(ap.ssid, ap.password, fastAttempt ? cache.bssid : nullptr, fastAttempt ? cache.channel : 0);
+}
+
+void WiFiLink::fail(uint32_t nowMs) {
+    // The AP may have moved channel: same network again, with a scan
+    if (fastAttempt) {
+        fastTried = true;
+        attempt(nowMs);
+        return;
+    }
+
+    apIndex = (apIndex + 1) % apCount;
+    fastTried = false;
+    if (apIndex != roundStart) {
+        attempt(nowMs);
+        return;
+    }
+
+    // Every network failed: 1x, 2x, 4x ... the minimum, capped
+    failedRounds++;
+    uint32_t backoff = backoffMaxMs;
+    if (failedRounds <= 16) {
+        uint64_t scaled = (uint64_t)backoffMinMs << (failedRounds - 1);
+        if (scaled < backoffMaxMs) backoff = (uint32_t)scaled;
+    }
+
+    radio->leave();
+    state = WIFI_LINK_BACKOFF;
+    deadline = nowMs + backoff;
+}
+
+// ===== EVENTS =====
+
+void WiFiLink::onConnected(uint32_t nowMs, const uint8_t* bssid, uint8_t channel) {
+    if (state == WIFI_LINK_IDLE) return;
+
+    state = WIFI_LINK_CONNECTED;
+    failedRounds = 0;
+    connectedSince = nowMs;
+
+    if (bssid && channel &&
+        (!cache.valid || cache.apIndex != apIndex || cache.channel != channel ||
+         memcmp(cache.bssid, bssid, sizeof(cache.bssid)) != 0)) {
+        memcpy(cache.bssid, bssid, sizeof(cache.bssid));
+        cache.channel = channel;
+        cache.apIndex = apIndex;
+        cache.valid = 1;
+        cacheChanged = true;
+    }
+}
+
+void WiFiLink::onDisconnected(uint32_t nowMs) {
+    switch (state) {
+        case WIFI_LINK_CONNECTED:
+            drops++;
+            beginRound(nowMs);  // Straight back to the cached BSSID
+            break;
+
+        case WIFI_LINK_CONNECTING:
+            if (nowMs - attemptStart >= WIFI_EVENT_SETTLE_MS) fail(nowMs);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void WiFiLink::poll(uint32_t nowMs) {
+    if (state != WIFI_LINK_CONNECTING && state != WIFI_LINK_BACKOFF) return;
+    if ((int32_t)(nowMs - deadline) < 0) return;
+
+    if (state == WIFI_LINK_CONNECTING) fail(nowMs);
+    else beginRound(nowMs);
+}
+
+uint32_t WiFiLink::msUntilRetry(uint32_t nowMs) const {
+    if (state != WIFI_LINK_BACKOFF || (int32_t)(nowMs - deadline) >= 0) return 0;
+    return deadline - nowMs;
+}
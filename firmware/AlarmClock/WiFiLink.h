@@ -0,0 +1,117 @@
+#ifndef WIFI_LINK_H
+#define WIFI_LINK_H
+
+// WiFi connection policy as an event-driven state machine with no Arduino
+// or ESP-IDF dependencies. The radio is reached through WiFiRadio, link
+// events are fed in by the caller and time comes in through poll(), so
+// nothing here waits. On a host it runs against a simulated radio.
+//
+// A round tries each configured network in turn, starting with the one
+// that last worked. That one is first joined straight to its cached
+// BSSID and channel (no scan), then with a normal scan if that fails.
+// When a whole round fails, the next round starts after an exponential
+// backoff. A dropped link starts a new round at once.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define WIFI_MAX_APS         3
+#define WIFI_SSID_MAX        33    // 32 + terminator
+#define WIFI_PASS_MAX        65    // 64 + terminator
+#define WIFI_EVENT_SETTLE_MS 300   // Disconnects this soon after a join belong to the previous one
+
+enum WiFiLinkState {
+    WIFI_LINK_IDLE,         // Not started, or stopped
+    WIFI_LINK_CONNECTING,   // Join in progress
+    WIFI_LINK_CONNECTED,    // Associated and has an address
+    WIFI_LINK_BACKOFF       // Every network failed; waiting to try again
+};
+
+struct WiFiAp {
+    char ssid[WIFI_SSID_MAX];
+    char password[WIFI_PASS_MAX];
+};
+
+// Where the last good connection was, for a join without a scan
+struct WiFiApCache {
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t apIndex;
+    uint8_t valid;
+    uint8_t reserved[3];
+};
+
+// The WiFi driver (Arduino WiFi on the device, a simulation on a host)
+class WiFiRadio {
+public:
+    virtual ~WiFiRadio() {}
+    // Starts a join and returns at once; bssid nullptr = scan for the SSID
+    virtual void join(const char* ssid, const char* password, const uint8_t* bssid, uint8_t channel) = 0;
+    virtual void leave() = 0;
+};
+
+class WiFiLink {
+private:
+    WiFiRadio* radio;
+    WiFiAp aps[WIFI_MAX_APS];
+    int apCount;
+    WiFiApCache cache;
+    bool cacheChanged;
+
+    WiFiLinkState state;
+    int apIndex;            // Network being tried or in use
+    int roundStart;         // Network the current round began with
+    bool fastAttempt;       // Current join uses the cached BSSID
+    bool fastTried;         // Cached BSSID already tried this round
+    uint32_t attemptStart;
+    uint32_t deadline;      // End of the join, or of the backoff
+
+    uint32_t connectTimeoutMs;
+    uint32_t fastTimeoutMs;
+    uint32_t backoffMinMs;
+    uint32_t backoffMaxMs;
+
+    uint32_t failedRounds;  // In a row; reset on connect
+    uint32_t attempts;
+    uint32_t drops;
+    uint32_t connectedSince;
+
+    void beginRound(uint32_t nowMs);
+    void attempt(uint32_t nowMs);
+    void fail(uint32_t nowMs);
+
+public:
+    WiFiLink();
+
+    void configure(uint32_t connectTimeout, uint32_t fastTimeout, uint32_t backoffMin, uint32_t backoffMax);
+    bool addAp(const char* ssid, const char* password);
+    int getApCount() const { return apCount; }
+    const char* getApSsid(int index) const;
+
+    // Cached join target, loaded from and saved to NVS by the caller
+    void setCache(const WiFiApCache& saved);
+    const WiFiApCache& getCache() const { return cache; }
+    bool takeCacheChanged();  // True once after each change
+
+    void begin(WiFiRadio& driver, uint32_t nowMs);
+    void stop();
+
+    // Link events from the driver
+    void onConnected(uint32_t nowMs, const uint8_t* bssid, uint8_t channel);
+    void onDisconnected(uint32_t nowMs);
+
+    // Join timeouts and the end of a backoff
+    void poll(uint32_t nowMs);
+
+    WiFiLinkState getState() const { return state; }
+    bool isConnected() const { return state == WIFI_LINK_CONNECTED; }
+    int getApIndex() const { return apIndex; }
+    uint32_t getFailedRounds() const { return failedRounds; }
+    uint32_t getAttempts() const { return attempts; }
+    uint32_t getDrops() const { return drops; }
+    uint32_t getConnectedSince() const { return connectedSince; }
+    // Until the next join (0 unless backing off)
+    uint32_t msUntilRetry(uint32_t nowMs) const;
+};
+
+#endif
@@ -1,71 +1,145 @@
+#include "Config.h"
 #include "WiFiModule.h"
+#include "StorageModule.h"
 
-WiFiModule::WiFiModule(const char* ssid, const char* password) 
-    : ssid(ssid), password(password), connected(false), lastCheckTime(0) {
+WiFiModule::WiFiModule(const char* ssid, const char* password)
+    : storage(nullptr), events(nullptr), statusCallback(nullptr),
+      lastConnected(false), joinedChannel(0) {
+    memset(joinedBssid, 0, sizeof(joinedBssid));
+    link.configure(WIFI_CONNECT_TIMEOUT_MS, WIFI_FAST_TIMEOUT_MS, WIFI_BACKOFF_MIN_MS, WIFI_BACKOFF_MAX_MS);
+    addNetwork(ssid, password);
 }
 
-bool WiFiModule::connect() {
-    Serial.print("Connecting to WiFi: ");
-    Serial.println(ssid);
-    
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(ssid, password);
-    
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-        delay(500);
-        Serial.print(".");
-        attempts++;
+bool WiFiModule::addNetwork(const char* ssid, const char* password) {
+    if (!link.addAp(ssid, password)) {
+        Serial.printf("WiFi: Can't add network %s\n", ssid ? ssid : "(null)");
+        return false;
     }
-    
-    if (WiFi.status() == WL_CONNECTED) {
-        connected = true;
-        Serial.println("\nWiFi connected!");
-        Serial.print("IP address: ");
-        Serial.println(WiFi.localIP());
-        Serial.print("Signal strength: ");
-        Serial.print(WiFi.RSSI());
-        Serial.println(" dBm");
-        return true;
-    } else {
-        connected = false;
-        Serial.println("\nWiFi connection failed!");
+    return true;
+}
+
+bool WiFiModule::begin() {
+    events = xQueueCreate(WIFI_EVENT_QUEUE_LEN, sizeof(WiFiEventRecord));
+    if (!events) {
+        Serial.println("WiFi: Failed to create event queue");
         return false;
     }
+
+    WiFiApCache cache;
+    if (storage && storage->loadWiFiCache(cache)) {
+        link.setCache(cache);
+    }
+
+    WiFi.onEvent([this](arduino_event_id_t event, arduino_event_info_t info) {
+        handleEvent(event, info);
+    });
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(false);  // Reconnects are WiFiLink's job
+
+    Serial.printf("WiFi: %d network(s), first join %s\n", link.getApCount(),
+                  link.getCache().valid ? "to the cached BSSID" : "with a scan");
+    link.begin(*this, millis());
+    return true;
+}
+
+// Runs on the WiFi event task: copy what loop() needs and return
+void WiFiModule::handleEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    WiFiEventRecord record;
+    memset(&record, 0, sizeof(record));
+
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+            memcpy(joinedBssid, info.wifi_sta_connected.bssid, sizeof(joinedBssid));
+            joinedChannel = info.wifi_sta_connected.channel;
+            return;  // Not usable until DHCP is done
+
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            record.up = true;
+            record.channel = joinedChannel;
+            memcpy(record.bssid, joinedBssid, sizeof(record.bssid));
+            break;
+
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+            record.reason = info.wifi_sta_disconnected.reason;
+            break;
+
+        case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+            break;
+
+        default:
+            return;
+    }
+
+    if (xQueueSend(events, &record, 0) != pdTRUE) {
+        Serial.println("WiFi: Event queue full, dropped event");
+    }
 }
 
-void WiFiModule::checkConnection() {
-    unsigned long now = millis();
-    
-    if (now - lastCheckTime < CHECK_INTERVAL) {
-        return;
+void WiFiModule::loop() {
+    if (!events) return;
+
+    uint32_t now = millis();
+    WiFiEventRecord record;
+    while (xQueueReceive(events, &record, 0) == pdTRUE) {
+        if (record.up) {
+            link.onConnected(now, record.bssid, record.channel);
+        } else {
+            if (record.reason) Serial.printf("WiFi: Disconnected (reason %d)\n", record.reason);
+            link.onDisconnected(now);
+        }
     }
-    
-    lastCheckTime = now;
-    
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("WiFi connection lost, attempting to reconnect...");
-        connected = false;
-        reconnect();
+    link.poll(now);
+
+    if (link.takeCacheChanged() && storage) {
+        storage->saveWiFiCache(link.getCache());
+    }
+    publishStatus();
+}
+
+void WiFiModule::publishStatus() {
+    bool connected = link.isConnected();
+    if (connected == lastConnected) return;
+    lastConnected = connected;
+
+    if (connected) {
+        Serial.printf("WiFi connected to %s: %s, %d dBm\n", getSSID().c_str(),
+                      WiFi.localIP().toString().c_str(), WiFi.RSSI());
     } else {
-        connected = true;
+        Serial.println("WiFi connection lost, reconnecting in the background");
     }
+    if (statusCallback) statusCallback(connected);
 }
 
-void WiFiModule::reconnect() {
+// Boot only, so the web server and NTP can start with a link when one is
+// in range; at runtime nothing waits for WiFi
+bool WiFiModule::waitForConnection(uint32_t ms) {
+    uint32_t start = millis();
+    while (!link.isConnected() && millis() - start < ms) {
+        delay(20);
+        loop();
+    }
+    return link.isConnected();
+}
+
+// ===== RADIO =====
+
+void WiFiModule::join(const char* ssid, const char* password, const uint8_t* bssid, uint8_t channel) {
+    Serial.printf("WiFi: Joining %s%s\n", ssid, bssid ? " (cached BSSID)" : "");
+    WiFi.begin(ssid, password, channel, bssid);  // Returns at once; the result arrives as an event
+}
+
+void WiFiModule::leave() {
     WiFi.disconnect();
-    delay(100);
-    connect();
 }
 
 void WiFiModule::disconnect() {
-    WiFi.disconnect();
-    connected = false;
+    link.stop();
+    publishStatus();
     Serial.println("WiFi disconnected");
 }
 
 bool WiFiModule::isConnected() {
-    return connected && (WiFi.status() == WL_CONNECTED);
+    return link.isConnected();
 }
 
 String WiFiModule::getLocalIP() {
@@ -83,5 +157,5 @@ int WiFiModule::getSignalStrength() {
 }
 
 String WiFiModule::getSSID() {
-    return String(ssid);
-}
\ No newline at end of file
+    return String(link.getApSsid(link.getApIndex()));
+}
@@ -3,27 +3,60 @@
 
 #include <WiFi.h>
 #include <string>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "WiFiLink.h"
 
-class WiFiModule {
+class StorageModule;
+
+typedef void (*WiFiStatusCallback)(bool connected);
+
+// Driver events, copied out of the WiFi event task for loop() to handle
+struct WiFiEventRecord {
+    bool up;             // Got an address (else: disconnected)
+    uint8_t reason;      // Disconnect reason
+    uint8_t channel;
+    uint8_t bssid[6];
+};
+
+class WiFiModule : public WiFiRadio {
 private:
-    const char* ssid;
-    const char* password;
-    bool connected;
-    unsigned long lastCheckTime;
-    static const unsigned long CHECK_INTERVAL = 30000; // Check every 30 seconds
+    WiFiLink link;
+    StorageModule* storage;
+    QueueHandle_t events;
+    WiFiStatusCallback statusCallback;
+    bool lastConnected;
+    uint8_t joinedBssid[6];   // From STA_CONNECTED, reported with GOT_IP
+    uint8_t joinedChannel;
+
+    void handleEvent(arduino_event_id_t event, arduino_event_info_t info);
+    void publishStatus();
+
+    // WiFiRadio
+    void join(const char* ssid, const char* password, const uint8_t* bssid, uint8_t channel) override;
+    void leave() override;
 
 public:
     WiFiModule(const char* ssid, const char* password);
-    
-    bool connect();
-    void checkConnection();
-    void reconnect();
+
+    bool addNetwork(const char* ssid, const char* password);  // Fallbacks, tried in order
+    void setStorage(StorageModule* store) { storage = store; }  // Before begin(): join cache
+
+    bool begin();                        // Starts connecting and returns at once
+    bool waitForConnection(uint32_t ms); // Boot only: runs loop() until connected or ms pass
+    void loop();                         // Link events, join timeouts, backoff
     void disconnect();
-    
+
+    // Called from loop() when the link comes up or goes down
+    void onStatus(WiFiStatusCallback callback) { statusCallback = callback; }
+
     bool isConnected();
+    WiFiLinkState getState() { return link.getState(); }
+    uint32_t getDrops() { return link.getDrops(); }
+    uint32_t getAttempts() { return link.getAttempts(); }
     String getLocalIP();
     int getSignalStrength();
     String getSSID();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,202 @@
+#include "Arduino.h"
+#include <chrono>
+#include <ctype.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// ===== STRING =====
+
+static std::string formatNumber(const char* format, ...) {
+    char buffer[48];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    return buffer;
+}
+
+String::String(int value) : s(formatNumber("%d", value)) {}
+String::String(unsigned int value) : s(formatNumber("%u", value)) {}
+String::String(long value) : s(formatNumber("%ld", value)) {}
+String::String(unsigned long value) : s(formatNumber("%lu", value)) {}
+String::String(float value, unsigned int decimals) : s(formatNumber("%.*f", decimals, (double)value)) {}
+String::String(double value, unsigned int decimals) : s(formatNumber("%.*f", decimals, value)) {}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t pos = s.find(c, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const char* str, unsigned int from) const {
+    size_t pos = s.find(str, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char c) const {
+    size_t pos = s.rfind(c);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int from) const {
+    return substring(from, s.length());
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= s.length()) return String();
+    if (to > s.length()) to = s.length();
+    return String(s.substr(from, to - from));
+}
+
+bool String::startsWith(const char* prefix) const {
+    return s.compare(0, strlen(prefix), prefix) == 0;
+}
+
+bool String::endsWith(const char* suffix) const {
+    size_t len = strlen(suffix);
+    return len <= s.length() && s.compare(s.length() - len, len, suffix) == 0;
+}
+
+void String::trim() {
+    size_t start = 0;
+    while (start < s.length() && isspace((unsigned char)s[start])) start++;
+    size_t end = s.length();
+    while (end > start && isspace((unsigned char)s[end - 1])) end--;
+    s = s.substr(start, end - start);
+}
+
+void String::toLowerCase() {
+    for (size_t i = 0; i < s.length(); i++) s[i] = tolower((unsigned char)s[i]);
+}
+
+void String::toUpperCase() {
+    for (size_t i = 0; i < s.length(); i++) s[i] = toupper((unsigned char)s[i]);
+}
+
+String operator+(const String& a, const String& b) {
+    String result(a);
+    result += b;
+    return result;
+}
+
+String operator+(const String& a, const char* b) {
+    String result(a);
+    result += b;
+    return result;
+}
+
+String operator+(const char* a, const String& b) {
+    String result(a);
+    result += b;
+    return result;
+}
+
+// ===== PRINT =====
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char local[128];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(local, sizeof(local), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(local)) return write((const uint8_t*)local, len);
+
+    std::string big(len + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&big[0], big.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)big.data(), len);
+}
+
+HardwareSerial::HardwareSerial() : echo(getenv("HOST_SERIAL") != nullptr) {}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (echo) fputc(c, stdout);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (echo) fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+// ===== TIME =====
+
+static uint64_t virtualMicros = 0;
+
+unsigned long millis() {
+    return (unsigned long)(uint32_t)(virtualMicros / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)(uint32_t)virtualMicros;
+}
+
+void delay(uint32_t ms) {
+    hostClockAdvance(ms);
+}
+
+void delayMicroseconds(uint32_t us) {
+    hostClockAdvanceMicros(us);
+}
+
+void yield() {}
+
+void hostClockAdvance(uint32_t ms) {
+    virtualMicros += (uint64_t)ms * 1000;
+}
+
+void hostClockAdvanceMicros(uint64_t us) {
+    virtualMicros += us;
+}
+
+void hostClockSet(uint64_t us) {
+    virtualMicros = us;
+}
+
+static time_t rtcSetTo = 0;
+
+int hostSetTimeOfDay(const struct timeval* tv, const void* tz) {
+    (void)tz;
+    if (!tv) return -1;
+    rtcSetTo = tv->tv_sec;
+    return 0;
+}
+
+time_t hostRtcSetTo() {
+    return rtcSetTo;
+}
+
+// ===== CHIP =====
+
+uint32_t EspClass::getCycleCount() {
+    using namespace std::chrono;
+    uint64_t ns = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    return (uint32_t)(ns * getCpuFrequencyMhz() / 1000);
+}
+
+static bool psramFull = false;
+
+bool psramFound() {
+    return true;
+}
+
+void* ps_malloc(size_t size) {
+    return psramFull ? nullptr : malloc(size);
+}
+
+void* ps_calloc(size_t count, size_t size) {
+    return psramFull ? nullptr : calloc(count, size);
+}
+
+void hostSetPsramFull(bool full) {
+    psramFull = full;
+}
@@ -0,0 +1,229 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// The parts of the Arduino-ESP32 core the firmware uses, for building on a
+// PC. Time is virtual: millis()/micros() only move when delay() is called
+// or a test advances the clock, so timeouts and backoff run instantly and
+// the same way every time. ESP.getCycleCount() is the exception: it reads
+// the host's monotonic clock, so profiled scopes measure real work.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <algorithm>
+
+using std::min;
+using std::max;
+using std::abs;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH          1
+#define LOW           0
+#define INPUT         0x01
+#define OUTPUT        0x03
+#define INPUT_PULLUP  0x05
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+static inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+static inline size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+// ===== FLASH =====
+// Flash is ordinary memory on the host, as it is memory-mapped on the ESP32
+
+#define PROGMEM
+typedef const char* PGM_P;
+#define strlen_P strlen
+
+// ===== STRING =====
+
+class String {
+private:
+    std::string s;
+
+public:
+    String() {}
+    String(const char* str) : s(str ? str : "") {}
+    String(const std::string& str) : s(str) {}
+    String(char c) : s(1, c) {}
+    explicit String(int value);
+    explicit String(unsigned int value);
+    explicit String(long value);
+    explicit String(unsigned long value);
+    explicit String(float value, unsigned int decimals = 2);
+    explicit String(double value, unsigned int decimals = 2);
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return s.length(); }
+    bool isEmpty() const { return s.empty(); }
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+
+    char charAt(unsigned int index) const { return index < s.length() ? s[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const char* str, unsigned int from = 0) const;
+    int lastIndexOf(char c) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+    bool startsWith(const char* prefix) const;
+    bool endsWith(const char* suffix) const;
+
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return (float)atof(s.c_str()); }
+
+    String& operator+=(const String& other) { s += other.s; return *this; }
+    String& operator+=(const char* str) { if (str) s += str; return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+    bool concat(const char* str) { *this += str; return true; }
+
+    bool operator==(const String& other) const { return s == other.s; }
+    bool operator==(const char* str) const { return s == (str ? str : ""); }
+    bool operator!=(const String& other) const { return s != other.s; }
+    bool operator!=(const char* str) const { return !(*this == str); }
+    bool equals(const char* str) const { return *this == str; }
+};
+
+String operator+(const String& a, const String& b);
+String operator+(const String& a, const char* b);
+String operator+(const char* a, const String& b);
+
+// ===== PRINT =====
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(const String& str) { return write(str.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(unsigned int value) { return printf("%u", value); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(double value, int digits = 2) { return printf("%.*f", digits, value); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+// Serial output is dropped unless HOST_SERIAL is set in the environment,
+// so test logs stay readable
+class HardwareSerial : public Print {
+private:
+    bool echo;
+
+public:
+    HardwareSerial();
+    void begin(unsigned long baud) { (void)baud; }
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void setEcho(bool on) { echo = on; }
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+// ===== TIME =====
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// Host only: move the virtual clock (delay() does the same)
+void hostClockAdvance(uint32_t ms);
+void hostClockAdvanceMicros(uint64_t us);
+void hostClockSet(uint64_t us);
+
+// The RTC: time() reads the host's clock, and the firmware setting it
+// (after NTP) is recorded instead of changing the host's
+int hostSetTimeOfDay(const struct timeval* tv, const void* tz);
+#define settimeofday hostSetTimeOfDay
+
+// Host only: seconds the firmware last set the RTC to, 0 if never
+time_t hostRtcSetTo();
+
+// ===== CHIP =====
+
+class EspClass {
+public:
+    uint32_t getCycleCount();
+    uint32_t getFreeHeap() { return 256 * 1024; }
+    uint32_t getMinFreeHeap() { return 192 * 1024; }
+    uint32_t getMaxAllocHeap() { return 128 * 1024; }
+    uint32_t getPsramSize() { return 8 * 1024 * 1024; }
+    uint32_t getFreePsram() { return 8 * 1024 * 1024; }
+    uint32_t getMaxAllocPsram() { return 4 * 1024 * 1024; }
+    void restart() { exit(0); }
+};
+
+extern EspClass ESP;
+
+static inline uint32_t getCpuFrequencyMhz() { return 240; }
+bool psramFound();
+void* ps_malloc(size_t size);
+void* ps_calloc(size_t count, size_t size);
+
+// Host only: make PSRAM allocations fail, as when it is exhausted
+void hostSetPsramFull(bool full);
+
+static inline void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+static inline void digitalWrite(uint8_t pin, uint8_t value) { (void)pin; (void)value; }
+static inline int digitalRead(uint8_t pin) { (void)pin; return HIGH; }
+static inline uint16_t analogRead(uint8_t pin) { (void)pin; return 0; }
+static inline bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t bits) { (void)pin; (void)freq; (void)bits; return true; }
+static inline bool ledcWrite(uint8_t pin, uint32_t duty) { (void)pin; (void)duty; return true; }
+
+// ===== FREERTOS CRITICAL SECTIONS =====
+
+struct portMUX_TYPE {
+    std::mutex lock;
+
+    // Firmware resets a mux by assigning the initializer to it
+    portMUX_TYPE() {}
+    portMUX_TYPE(const portMUX_TYPE&) {}
+    portMUX_TYPE& operator=(const portMUX_TYPE&) { return *this; }
+};
+
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) ((mux)->lock.lock())
+#define portEXIT_CRITICAL(mux)  ((mux)->lock.unlock())
+
+#endif
@@ -0,0 +1,69 @@
+#include "Audio.h"
+
+static bool stationAccepts = true;
+static uint32_t stationRate = 48;       // Bursts at 3x real time until the buffer fills
+static uint32_t stationConnectMs = 0;
+
+static const uint32_t PLAYBACK_BYTES_PER_MS = 16;
+
+Audio::Audio()
+    : bufferSize(HOST_AUDIO_RAM_BUFFER), filled(0), lastFeed(0), running(false),
+      streaming(false), volume(0) {
+}
+
+bool Audio::setBufsize(int ramBuffer, int psramBuffer) {
+    (void)ramBuffer;
+    if (psramBuffer <= 0 || !psramFound()) return false;
+    bufferSize = psramBuffer;
+    return true;
+}
+
+bool Audio::connecttohost(const char* url) {
+    stopSong();
+    if (!url) return false;
+    hostClockAdvance(stationConnectMs);
+    if (!stationAccepts) return false;
+    source = url;
+    running = true;
+    streaming = true;
+    lastFeed = millis();
+    return true;
+}
+
+bool Audio::connecttoFS(fs::FS& fs, const char* path, int32_t startPos) {
+    (void)startPos;
+    stopSong();
+    if (!path || !fs.exists(path)) return false;
+    source = path;
+    running = true;
+    return true;
+}
+
+uint32_t Audio::stopSong() {
+    uint32_t position = filled;
+    running = false;
+    streaming = false;
+    filled = 0;
+    source = "";
+    return position;
+}
+
+void Audio::loop() {
+    if (!streaming) return;
+
+    uint32_t now = millis();
+    uint32_t elapsed = now - lastFeed;
+    lastFeed = now;
+
+    uint64_t in = (uint64_t)elapsed * stationRate;
+    uint64_t out = (uint64_t)elapsed * PLAYBACK_BYTES_PER_MS;
+    uint64_t level = filled + in;
+    level = level > out ? level - out : 0;
+    filled = level > bufferSize ? bufferSize : (uint32_t)level;
+}
+
+void Audio::hostSetStation(bool accepts, uint32_t bytesPerMs, uint32_t connectMs) {
+    stationAccepts = accepts;
+    stationRate = bytesPerMs;
+    stationConnectMs = connectMs;
+}
@@ -0,0 +1,52 @@
+#ifndef HOST_AUDIO_H
+#define HOST_AUDIO_H
+
+// ESP32-audioI2S without a network or a DAC. The library opens its own
+// socket, so the station lives here too: connecting takes the virtual time
+// a test sets, a connected stream fills the input buffer at the station's
+// rate and playback drains it at the bit rate, so prebuffering, underruns
+// and stalls happen in virtual time. Files play from any FS whose path
+// exists.
+
+#include <Arduino.h>
+#include <FS.h>
+
+#define HOST_AUDIO_RAM_BUFFER  16000   // The library's input buffer without PSRAM
+
+class Audio {
+private:
+    uint32_t bufferSize;
+    uint32_t filled;
+    uint32_t lastFeed;
+    bool running;
+    bool streaming;
+    uint8_t volume;
+    String source;
+
+public:
+    Audio();
+
+    bool setPinout(uint8_t bclk, uint8_t lrc, uint8_t dout) { (void)bclk; (void)lrc; (void)dout; return true; }
+    bool setBufsize(int ramBuffer, int psramBuffer);
+    void setVolume(uint8_t vol) { volume = vol; }
+    uint8_t getVolume() const { return volume; }
+
+    bool connecttohost(const char* url);
+    bool connecttoFS(fs::FS& fs, const char* path, int32_t startPos = -1);
+    uint32_t stopSong();
+    bool isRunning() const { return running; }
+    void loop();
+
+    uint32_t inBufferFilled() const { return filled; }
+    uint32_t inBufferSize() const { return bufferSize; }
+    uint32_t getBitRate() const { return running ? 128000 : 0; }
+
+    // Host only: how stations behave from the next connect on. A refused
+    // connect fails connecttohost(); the rate is bytes per virtual ms
+    // (16 is real time at 128 kbit/s, 0 a stalled station). connectMs is
+    // the TCP connect and ICY exchange, which connecttohost() blocks for
+    static void hostSetStation(bool accepts, uint32_t bytesPerMs, uint32_t connectMs = 0);
+    const char* hostSource() const { return source.c_str(); }
+};
+
+#endif
@@ -0,0 +1,221 @@
+#include "ESPAsyncWebServer.h"
+
+// ===== RESPONSE =====
+
+AsyncWebServerResponse::AsyncWebServerResponse(int code, const String& contentType, const std::string& content)
+    : code(code), contentType(contentType), content(content), index(0), chunked(false) {
+}
+
+AsyncWebServerResponse::AsyncWebServerResponse(const String& contentType, AwsResponseFiller filler)
+    : code(200), contentType(contentType), filler(filler), index(0), chunked(true) {
+}
+
+const char* AsyncWebServerResponse::hostHeader(const char* name) const {
+    for (const AsyncWebHeader& header : headers) {
+        if (strcasecmp(header.name().c_str(), name) == 0) return header.value().c_str();
+    }
+    return nullptr;
+}
+
+size_t AsyncWebServerResponse::hostFill(uint8_t* buffer, size_t maxLen) {
+    size_t n;
+    if (chunked) {
+        n = filler ? filler(buffer, maxLen, index) : 0;
+    } else {
+        n = min(maxLen, content.size() - index);
+        memcpy(buffer, content.data() + index, n);
+    }
+    index += n;
+    return n;
+}
+
+std::string AsyncWebServerResponse::hostDrain(size_t window) {
+    std::string body;
+    std::vector<uint8_t> buffer(window);
+    size_t n;
+    while ((n = hostFill(buffer.data(), window)) > 0) {
+        body.append((const char*)buffer.data(), n);
+    }
+    return body;
+}
+
+// ===== REQUEST =====
+
+AsyncWebServerRequest::AsyncWebServerRequest(WebRequestMethodComposite method, const char* url)
+    : requestMethod(method), requestUrl(url), response(nullptr), _tempObject(nullptr) {
+}
+
+// The connection closing after the response, as for every request
+AsyncWebServerRequest::~AsyncWebServerRequest() {
+    hostDisconnect();
+    free(_tempObject);
+}
+
+const char* AsyncWebServerRequest::methodToString() const {
+    switch (requestMethod) {
+        case HTTP_GET:     return "GET";
+        case HTTP_POST:    return "POST";
+        case HTTP_DELETE:  return "DELETE";
+        case HTTP_PUT:     return "PUT";
+        case HTTP_PATCH:   return "PATCH";
+        case HTTP_HEAD:    return "HEAD";
+        case HTTP_OPTIONS: return "OPTIONS";
+        default:           return "UNKNOWN";
+    }
+}
+
+bool AsyncWebServerRequest::hasArg(const char* name) const {
+    for (const AsyncWebHeader& param : params) {
+        if (param.name() == name) return true;
+    }
+    return false;
+}
+
+const String& AsyncWebServerRequest::arg(const char* name) const {
+    static const String empty;
+    for (const AsyncWebHeader& param : params) {
+        if (param.name() == name) return param.value();
+    }
+    return empty;
+}
+
+const AsyncWebHeader* AsyncWebServerRequest::getHeader(const char* name) const {
+    for (const AsyncWebHeader& header : headers) {
+        if (strcasecmp(header.name().c_str(), name) == 0) return &header;
+    }
+    return nullptr;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const String& contentType,
+                                                             const String& content) {
+    return new AsyncWebServerResponse(code, contentType, content.c_str());
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(FS& fs, const String& path,
+                                                             const String& contentType) {
+    File file = fs.open(path, FILE_READ);
+    if (!file) return new AsyncWebServerResponse(404, contentType, "");
+
+    std::string content(file.size(), '\0');
+    file.read((uint8_t*)&content[0], content.size());
+    file.close();
+    return new AsyncWebServerResponse(200, contentType, content);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P(int code, const String& contentType,
+                                                               const uint8_t* content, size_t length) {
+    return new AsyncWebServerResponse(code, contentType, std::string((const char*)content, length));
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginChunkedResponse(const String& contentType,
+                                                                    AwsResponseFiller filler) {
+    return new AsyncWebServerResponse(contentType, filler);
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse* response) {
+    // The library keeps the first response; a second one is a handler bug
+    if (this->response) {
+        delete response;
+        return;
+    }
+    this->response = response;
+}
+
+void AsyncWebServerRequest::send(int code, const String& contentType, const String& content) {
+    send(beginResponse(code, contentType, content));
+}
+
+void AsyncWebServerRequest::hostDisconnect() {
+    for (ArDisconnectHandler& handler : disconnectHandlers) handler();
+    disconnectHandlers.clear();
+    delete response;
+    response = nullptr;
+}
+
+// ===== EVENT SOURCE =====
+
+void AsyncEventSourceClient::send(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+    (void)reconnect;
+    if (!open) return;
+    HostEvent received = { event ? event : "", message ? message : "", id };
+    this->received.push_back(received);
+}
+
+void AsyncEventSource::send(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+    for (AsyncEventSourceClient& client : clients) client.send(message, event, id, reconnect);
+}
+
+size_t AsyncEventSource::count() const {
+    size_t open = 0;
+    for (const AsyncEventSourceClient& client : clients) {
+        if (client.connected()) open++;
+    }
+    return open;
+}
+
+void AsyncEventSource::close() {
+    for (AsyncEventSourceClient& client : clients) client.close();
+}
+
+AsyncEventSourceClient* AsyncEventSource::hostConnect() {
+    clients.emplace_back();
+    AsyncEventSourceClient* client = &clients.back();
+    if (connectHandler) connectHandler(client);
+    return client;
+}
+
+// ===== SERVER =====
+
+static std::vector<AsyncWebServer*> listening;
+
+AsyncWebServer::~AsyncWebServer() {
+    listening.erase(std::remove(listening.begin(), listening.end(), this), listening.end());
+}
+
+void AsyncWebServer::begin() {
+    if (std::find(listening.begin(), listening.end(), this) == listening.end()) listening.push_back(this);
+}
+
+AsyncWebServer* AsyncWebServer::hostListening(uint16_t port) {
+    for (size_t i = listening.size(); i-- > 0;) {
+        if (listening[i]->port == port) return listening[i];
+    }
+    return nullptr;
+}
+
+void AsyncWebServer::on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction handler,
+                        ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody) {
+    (void)onUpload;
+    Route route = { uri, method, handler, onBody };
+    routes.push_back(route);
+}
+
+bool AsyncWebServer::hostHandle(AsyncWebServerRequest* request) {
+    String path = request->url();
+    int query = path.indexOf('?');
+    if (query >= 0) path = path.substring(0, query);
+
+    for (Route& route : routes) {
+        // As the library matches: the path itself or anything below it
+        bool match = route.uri == path || path.startsWith((route.uri + "/").c_str());
+        if ((route.method & request->method()) && match) {
+            std::string body = request->hostBody();
+            if (route.onBody && !body.empty()) {
+                route.onBody(request, (uint8_t*)&body[0], body.size(), 0, body.size());
+            }
+            route.handler(request);
+            return true;
+        }
+    }
+    if (!notFound) return false;
+    notFound(request);
+    return true;
+}
+
+AsyncEventSourceClient* AsyncWebServer::hostOpenEvents(const char* url) {
+    for (AsyncWebHandler* handler : handlers) {
+        AsyncEventSource* source = dynamic_cast<AsyncEventSource*>(handler);
+        if (source && source->url() == url) return source->hostConnect();
+    }
+    return nullptr;
+}
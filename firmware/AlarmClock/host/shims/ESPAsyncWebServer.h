@@ -0,0 +1,230 @@
+#ifndef HOST_ESP_ASYNC_WEB_SERVER_H
+#define HOST_ESP_ASYNC_WEB_SERVER_H
+
+// The parts of ESPAsyncWebServer the firmware uses, without a network.
+// A test builds a request, hands it to a handler (or to the server's
+// route table) and drains the response it was sent the way AsyncTCP
+// would: a chunked filler is called for one TCP window at a time.
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <functional>
+#include <list>
+#include <vector>
+
+enum WebRequestMethod {
+    HTTP_GET     = 0b00000001,
+    HTTP_POST    = 0b00000010,
+    HTTP_DELETE  = 0b00000100,
+    HTTP_PUT     = 0b00001000,
+    HTTP_PATCH   = 0b00010000,
+    HTTP_HEAD    = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY     = 0b01111111
+};
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServerRequest;
+
+typedef std::function<void(AsyncWebServerRequest* request)> ArRequestHandlerFunction;
+typedef std::function<size_t(uint8_t* buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<void(AsyncWebServerRequest* request, const String& filename, size_t index,
+                           uint8_t* data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index,
+                           size_t total)> ArBodyHandlerFunction;
+typedef std::function<void()> ArDisconnectHandler;
+
+// Payload of one TCP segment, the most a filler is asked for at a time
+#define HOST_TCP_WINDOW 1436
+
+class AsyncWebHeader {
+private:
+    String headerName;
+    String headerValue;
+
+public:
+    AsyncWebHeader(const String& name, const String& value) : headerName(name), headerValue(value) {}
+    const String& name() const { return headerName; }
+    const String& value() const { return headerValue; }
+};
+
+// ===== RESPONSE =====
+
+class AsyncWebServerResponse {
+private:
+    int code;
+    String contentType;
+    std::vector<AsyncWebHeader> headers;
+    std::string content;
+    AwsResponseFiller filler;
+    size_t index;
+    bool chunked;
+
+public:
+    AsyncWebServerResponse(int code, const String& contentType, const std::string& content);
+    AsyncWebServerResponse(const String& contentType, AwsResponseFiller filler);
+    virtual ~AsyncWebServerResponse() {}
+
+    void setCode(int code) { this->code = code; }
+    void addHeader(const char* name, const char* value) { headers.push_back(AsyncWebHeader(name, value)); }
+
+    // Host only
+    int hostCode() const { return code; }
+    const char* hostContentType() const { return contentType.c_str(); }
+    bool hostChunked() const { return chunked; }
+    // The value of a header, or nullptr
+    const char* hostHeader(const char* name) const;
+    // The next window of body, as AsyncTCP would ask for it; 0 at the end
+    size_t hostFill(uint8_t* buffer, size_t maxLen);
+    // The rest of the body
+    std::string hostDrain(size_t window = HOST_TCP_WINDOW);
+};
+
+// ===== REQUEST =====
+
+class AsyncWebServerRequest {
+private:
+    WebRequestMethodComposite requestMethod;
+    String requestUrl;
+    std::vector<AsyncWebHeader> params;
+    std::vector<AsyncWebHeader> headers;
+    std::vector<ArDisconnectHandler> disconnectHandlers;
+    AsyncWebServerResponse* response;
+    std::string body;
+
+public:
+    void* _tempObject;      // Handler scratch (a collected body); free()d with the request
+
+    AsyncWebServerRequest(WebRequestMethodComposite method, const char* url);
+    ~AsyncWebServerRequest();
+
+    const String& url() const { return requestUrl; }
+    WebRequestMethodComposite method() const { return requestMethod; }
+    const char* methodToString() const;
+    size_t contentLength() const { return body.size(); }
+
+    size_t args() const { return params.size(); }
+    bool hasArg(const char* name) const;
+    const String& arg(const char* name) const;
+    const String& arg(const String& name) const { return arg(name.c_str()); }
+    const String& arg(size_t i) const { return params[i].value(); }
+    const String& argName(size_t i) const { return params[i].name(); }
+
+    bool hasHeader(const char* name) const { return getHeader(name) != nullptr; }
+    const AsyncWebHeader* getHeader(const char* name) const;
+
+    void onDisconnect(ArDisconnectHandler handler) { disconnectHandlers.push_back(handler); }
+
+    AsyncWebServerResponse* beginResponse(int code, const String& contentType = String(),
+                                          const String& content = String());
+    AsyncWebServerResponse* beginResponse(FS& fs, const String& path,
+                                          const String& contentType = String());
+    AsyncWebServerResponse* beginResponse_P(int code, const String& contentType,
+                                            const uint8_t* content, size_t length);
+    AsyncWebServerResponse* beginChunkedResponse(const String& contentType, AwsResponseFiller filler);
+
+    void send(AsyncWebServerResponse* response);
+    void send(int code, const String& contentType = String(), const String& content = String());
+    void send_P(int code, const String& contentType, PGM_P content) { send(code, contentType, content); }
+    void send_P(int code, const String& contentType, const uint8_t* content, size_t length) {
+        send(beginResponse_P(code, contentType, content, length));
+    }
+
+    // Host only
+    void hostAddArg(const char* name, const char* value) { params.push_back(AsyncWebHeader(name, value)); }
+    void hostAddHeader(const char* name, const char* value) { headers.push_back(AsyncWebHeader(name, value)); }
+    // Request body, handed to the route's body handler in one piece
+    void hostSetBody(const char* text) { body = text; }
+    const std::string& hostBody() const { return body; }
+    // What the handler sent, or nullptr
+    AsyncWebServerResponse* hostResponse() const { return response; }
+    // The client went away: onDisconnect handlers run, the response is freed
+    void hostDisconnect();
+};
+
+class AsyncWebHandler {
+public:
+    virtual ~AsyncWebHandler() {}
+};
+
+// ===== EVENT SOURCE =====
+
+// One message as the client received it
+struct HostEvent {
+    String event;       // Empty for the default "message" event
+    String data;
+    uint32_t id;
+};
+
+class AsyncEventSourceClient {
+private:
+    std::vector<HostEvent> received;
+    bool open;
+
+public:
+    AsyncEventSourceClient() : open(true) {}
+
+    void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+    void close() { open = false; }
+    bool connected() const { return open; }
+
+    // Host only
+    const std::vector<HostEvent>& hostReceived() const { return received; }
+};
+
+typedef std::function<void(AsyncEventSourceClient* client)> ArEventHandlerFunction;
+
+class AsyncEventSource : public AsyncWebHandler {
+private:
+    String sourceUrl;
+    ArEventHandlerFunction connectHandler;
+    std::list<AsyncEventSourceClient> clients;     // Kept after closing, so tests can read them
+
+public:
+    explicit AsyncEventSource(const String& url) : sourceUrl(url) {}
+
+    void onConnect(ArEventHandlerFunction handler) { connectHandler = handler; }
+    void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+    size_t count() const;
+    void close();
+    const String& url() const { return sourceUrl; }
+
+    // Host only: a browser opens the stream; the handler runs as on AsyncTCP
+    AsyncEventSourceClient* hostConnect();
+};
+
+// ===== SERVER =====
+
+class AsyncWebServer {
+private:
+    struct Route {
+        String uri;
+        WebRequestMethodComposite method;
+        ArRequestHandlerFunction handler;
+        ArBodyHandlerFunction onBody;
+    };
+    std::vector<Route> routes;
+    std::vector<AsyncWebHandler*> handlers;
+    ArRequestHandlerFunction notFound;
+    uint16_t port;
+
+public:
+    explicit AsyncWebServer(uint16_t port) : port(port) {}
+    ~AsyncWebServer();
+
+    void begin();
+    void on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction handler,
+            ArUploadHandlerFunction onUpload = nullptr, ArBodyHandlerFunction onBody = nullptr);
+    void onNotFound(ArRequestHandlerFunction handler) { notFound = handler; }
+    AsyncWebHandler& addHandler(AsyncWebHandler* handler) { handlers.push_back(handler); return *handler; }
+
+    // Host only: route a request as the server would; false if nothing took it
+    bool hostHandle(AsyncWebServerRequest* request);
+    // Opens the event stream added at url; nullptr if there is none
+    AsyncEventSourceClient* hostOpenEvents(const char* url);
+    // The server begin() started on port, or nullptr: how a test reaches
+    // one that a module owns
+    static AsyncWebServer* hostListening(uint16_t port = 80);
+};
+
+#endif
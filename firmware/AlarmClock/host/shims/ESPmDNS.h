@@ -0,0 +1,26 @@
+#ifndef HOST_ESP_MDNS_H
+#define HOST_ESP_MDNS_H
+
+// mDNS accepts a name and services and announces nothing
+
+#include <Arduino.h>
+
+class MDNSResponder {
+private:
+    String hostName;
+
+public:
+    bool begin(const char* name) { hostName = name ? name : ""; return !hostName.isEmpty(); }
+    void end() { hostName = ""; }
+    bool addService(const char* service, const char* proto, uint16_t port) {
+        (void)service; (void)proto; (void)port;
+        return !hostName.isEmpty();
+    }
+
+    // Host only
+    const char* hostGetName() const { return hostName.c_str(); }
+};
+
+extern MDNSResponder MDNS;
+
+#endif
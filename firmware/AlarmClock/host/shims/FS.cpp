@@ -0,0 +1,163 @@
+#include "FS.h"
+#include "LittleFS.h"
+#include "SD.h"
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LittleFSFS LittleFS;
+SDFS SD;
+
+// ===== FILE =====
+
+size_t File::write(uint8_t c) {
+    return fp && fputc(c, fp) != EOF ? 1 : 0;
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    return fp ? fwrite(buffer, 1, size, fp) : 0;
+}
+
+int File::available() {
+    if (!fp) return 0;
+    long pos = ftell(fp);
+    return pos < 0 ? 0 : (int)(size() - pos);
+}
+
+int File::read() {
+    return fp ? fgetc(fp) : -1;
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+    return fp ? fread(buffer, 1, size, fp) : 0;
+}
+
+int File::peek() {
+    if (!fp) return -1;
+    int c = fgetc(fp);
+    if (c != EOF) ungetc(c, fp);
+    return c;
+}
+
+String File::readStringUntil(char terminator) {
+    std::string line;
+    int c;
+    while ((c = read()) >= 0 && c != terminator) line += (char)c;
+    return String(line);
+}
+
+bool File::seek(uint32_t pos) {
+    return fp && fseek(fp, pos, SEEK_SET) == 0;
+}
+
+size_t File::position() const {
+    return fp ? (size_t)ftell(fp) : 0;
+}
+
+size_t File::size() const {
+    struct stat st;
+    if (!fp) return 0;
+    fflush(fp);
+    return fstat(fileno(fp), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::flush() {
+    if (fp) fflush(fp);
+}
+
+time_t File::getLastWrite() const {
+    struct stat st;
+    return stat(hostPath.c_str(), &st) == 0 ? st.st_mtime : 0;
+}
+
+void File::close() {
+    if (fp) fclose(fp);
+    if (dir) closedir(dir);
+    fp = nullptr;
+    dir = nullptr;
+}
+
+File File::openNextFile(const char* mode) {
+    if (!dir) return File();
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) break;
+    }
+    if (!entry) return File();
+
+    std::string childPath = (path == "/" ? "" : path) + "/" + entry->d_name;
+    std::string childHost = hostPath + "/" + entry->d_name;
+    struct stat st;
+    if (stat(childHost.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR* child = opendir(childHost.c_str());
+        return child ? File(child, childPath, childHost) : File();
+    }
+    FILE* child = fopen(childHost.c_str(), strcmp(mode, "r") == 0 ? "rb" : mode);
+    return child ? File(child, childPath, childHost) : File();
+}
+
+// ===== FILESYSTEM =====
+
+static bool makeDirs(const std::string& path) {
+    for (size_t i = 1; i <= path.length(); i++) {
+        if (i == path.length() || path[i] == '/') {
+            std::string part = path.substr(0, i);
+            if (::mkdir(part.c_str(), 0755) != 0 && errno != EEXIST) return false;
+        }
+    }
+    return true;
+}
+
+static void removeTree(const std::string& path) {
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")) continue;
+        std::string child = path + "/" + entry->d_name;
+        removeTree(child);
+        ::remove(child.c_str());
+    }
+    closedir(dir);
+}
+
+bool fs::FS::mount(const char* basePath) {
+    base = basePath;
+    mounted = makeDirs(base);
+    return mounted;
+}
+
+bool fs::FS::format() {
+    if (!mounted) return false;
+    removeTree(base);
+    return true;
+}
+
+File fs::FS::open(const char* path, const char* mode) {
+    if (!mounted || !path || path[0] != '/') return File();
+    std::string host = hostPath(path);
+    struct stat st;
+    if (strcmp(mode, "r") == 0 && stat(host.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(host.c_str());
+        return dir ? File(dir, path, host) : File();
+    }
+    FILE* fp = fopen(host.c_str(), strcmp(mode, "r") == 0 ? "rb" : mode);
+    return fp ? File(fp, path, host) : File();
+}
+
+bool fs::FS::exists(const char* path) {
+    struct stat st;
+    return mounted && path && stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool fs::FS::remove(const char* path) {
+    return mounted && ::remove(hostPath(path).c_str()) == 0;
+}
+
+bool fs::FS::rename(const char* from, const char* to) {
+    return mounted && ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool fs::FS::mkdir(const char* path) {
+    return mounted && makeDirs(hostPath(path));
+}
@@ -0,0 +1,87 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+// Arduino's File and filesystem base on a host directory. A filesystem is
+// mounted at a base path (begin() in LittleFS and SD), and every path the
+// firmware opens is resolved under it, so files written through the shim
+// and through stdio land in the same place.
+
+#include <Arduino.h>
+#include <dirent.h>
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+class File : public Print {
+private:
+    FILE* fp;
+    DIR* dir;
+    std::string path;       // As the firmware opened it
+    std::string hostPath;
+
+public:
+    File() : fp(nullptr), dir(nullptr) {}
+    File(FILE* file, const std::string& filePath, const std::string& host)
+        : fp(file), dir(nullptr), path(filePath), hostPath(host) {}
+    File(DIR* directory, const std::string& dirPath, const std::string& host)
+        : fp(nullptr), dir(directory), path(dirPath), hostPath(host) {}
+
+    operator bool() const { return fp != nullptr || dir != nullptr; }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    int available();
+    int read();
+    size_t read(uint8_t* buffer, size_t size);
+    int peek();
+    String readStringUntil(char terminator);
+    bool seek(uint32_t pos);
+    size_t position() const;
+    size_t size() const;
+    const char* name() const { return path.c_str(); }
+    time_t getLastWrite() const;
+    void flush();
+    void close();
+
+    // Directories
+    bool isDirectory() const { return dir != nullptr; }
+    File openNextFile(const char* mode = FILE_READ);
+    void rewindDirectory() { if (dir) rewinddir(dir); }
+};
+
+namespace fs {
+
+class FS {
+protected:
+    std::string base;
+    bool mounted;
+
+    bool mount(const char* basePath);
+
+public:
+    FS() : mounted(false) {}
+    virtual ~FS() {}
+
+    void end() { mounted = false; }
+    bool format();
+
+    File open(const char* path, const char* mode = FILE_READ);
+    File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool rename(const char* from, const char* to);
+    bool mkdir(const char* path);
+
+    // Host only: where a path on this filesystem lives on the host
+    std::string hostPath(const char* path) const { return base + path; }
+};
+
+}  // namespace fs
+
+using fs::FS;
+
+#endif
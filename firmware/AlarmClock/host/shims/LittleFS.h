@@ -0,0 +1,21 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+// LittleFS on a host directory. begin() takes the base path the firmware
+// mounts at, so files opened through LittleFS and through stdio (the
+// station catalog, the media index) land in the same place. The host
+// build points LITTLEFS_BASE_PATH at a directory under the build tree.
+
+#include <FS.h>
+
+class LittleFSFS : public fs::FS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs") {
+        (void)formatOnFail;
+        return mount(basePath);
+    }
+};
+
+extern LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,157 @@
+#include "Preferences.h"
+
+typedef std::map<std::string, std::vector<uint8_t> > NvsNamespace;
+
+static std::map<std::string, NvsNamespace> nvs;
+static uint32_t writes = 0;
+static uint32_t bytesWritten = 0;
+
+static bool validKey(const char* key) {
+    return key && key[0] && strlen(key) <= NVS_KEY_MAX;
+}
+
+bool Preferences::begin(const char* name, bool readOnlyMode) {
+    if (!validKey(name)) return false;
+    space = name;
+    readOnly = readOnlyMode;
+    opened = true;
+    nvs[space];
+    return true;
+}
+
+bool Preferences::clear() {
+    if (!opened || readOnly) return false;
+    nvs[space].clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!opened || readOnly) return false;
+    return nvs[space].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) const {
+    if (!opened || !key) return false;
+    const NvsNamespace& entries = nvs[space];
+    return entries.find(key) != entries.end();
+}
+
+size_t Preferences::freeEntries() const {
+    // 3 pages of 126 entries (the default partition), one per short value;
+    // blobs and strings take one more per 32 bytes
+    size_t used = 0;
+    for (NvsNamespace::const_iterator it = nvs[space].begin(); it != nvs[space].end(); ++it) {
+        used += 1 + (it->second.size() > 8 ? (it->second.size() + 31) / 32 : 0);
+    }
+    return used < 378 ? 378 - used : 0;
+}
+
+size_t Preferences::put(const char* key, const void* value, size_t len) {
+    if (!opened || readOnly || !validKey(key)) return 0;
+
+    std::vector<uint8_t> data((const uint8_t*)value, (const uint8_t*)value + len);
+    std::vector<uint8_t>& stored = nvs[space][key];
+    if (stored != data) {
+        stored = data;
+        writes++;
+        bytesWritten += len;
+    }
+    return len;
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+    if (!value) return 0;
+    size_t len = strlen(value);
+    return put(key, value, len + 1) ? len : 0;
+}
+
+size_t Preferences::get(const char* key, void* value, size_t len) const {
+    if (!opened || !key) return 0;
+    const NvsNamespace& entries = nvs[space];
+    NvsNamespace::const_iterator it = entries.find(key);
+    if (it == entries.end() || it->second.size() > len) return 0;
+    memcpy(value, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+// Scalar reads only succeed when the stored size matches, as with NVS types
+bool Preferences::getValue(const char* key, void* value, size_t len) const {
+    return getBytesLength(key) == len && get(key, value, len) == len;
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) const {
+    bool value;
+    return getValue(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+uint8_t Preferences::getUChar(const char* key, uint8_t defaultValue) const {
+    uint8_t value;
+    return getValue(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+uint16_t Preferences::getUShort(const char* key, uint16_t defaultValue) const {
+    uint16_t value;
+    return getValue(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) const {
+    int32_t value;
+    return getValue(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) const {
+    uint32_t value;
+    return getValue(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+int32_t Preferences::getLong(const char* key, int32_t defaultValue) const {
+    return getInt(key, defaultValue);
+}
+
+uint32_t Preferences::getULong(const char* key, uint32_t defaultValue) const {
+    return getUInt(key, defaultValue);
+}
+
+float Preferences::getFloat(const char* key, float defaultValue) const {
+    float value;
+    return getValue(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) const {
+    size_t len = getBytesLength(key);
+    if (len == 0) return defaultValue;
+    std::vector<char> buffer(len);
+    if (get(key, buffer.data(), len) != len || buffer[len - 1] != '\0') return defaultValue;
+    return String(buffer.data());
+}
+
+size_t Preferences::getBytesLength(const char* key) const {
+    if (!opened || !key) return 0;
+    const NvsNamespace& entries = nvs[space];
+    NvsNamespace::const_iterator it = entries.find(key);
+    return it == entries.end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) const {
+    return get(key, buf, maxLen);
+}
+
+// ===== HOST ONLY =====
+
+void Preferences::hostErase() {
+    nvs.clear();
+    hostResetCounters();
+}
+
+void Preferences::hostResetCounters() {
+    writes = 0;
+    bytesWritten = 0;
+}
+
+uint32_t Preferences::hostWrites() {
+    return writes;
+}
+
+uint32_t Preferences::hostBytesWritten() {
+    return bytesWritten;
+}
@@ -0,0 +1,66 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+// In-memory NVS. Namespaces outlive the Preferences objects that open them,
+// so a test can "reboot" by constructing a new module over the same data.
+// Like NVS, writing a value identical to the stored one costs no flash
+// write; every other put is counted, for wear and latency tests.
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+#define NVS_KEY_MAX 15   // NVS limit, without the terminator
+
+class Preferences {
+private:
+    std::string space;
+    bool opened;
+    bool readOnly;
+
+    size_t put(const char* key, const void* value, size_t len);
+    size_t get(const char* key, void* value, size_t len) const;
+    bool getValue(const char* key, void* value, size_t len) const;
+
+public:
+    Preferences() : opened(false), readOnly(false) {}
+
+    bool begin(const char* name, bool readOnlyMode = false);
+    void end() { opened = false; }
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key) const;
+    size_t freeEntries() const;
+
+    size_t putBool(const char* key, bool value) { return put(key, &value, sizeof(value)); }
+    size_t putUChar(const char* key, uint8_t value) { return put(key, &value, sizeof(value)); }
+    size_t putUShort(const char* key, uint16_t value) { return put(key, &value, sizeof(value)); }
+    size_t putInt(const char* key, int32_t value) { return put(key, &value, sizeof(value)); }
+    size_t putUInt(const char* key, uint32_t value) { return put(key, &value, sizeof(value)); }
+    size_t putLong(const char* key, int32_t value) { return put(key, &value, sizeof(value)); }
+    size_t putULong(const char* key, uint32_t value) { return put(key, &value, sizeof(value)); }
+    size_t putFloat(const char* key, float value) { return put(key, &value, sizeof(value)); }
+    size_t putString(const char* key, const char* value);
+    size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+    size_t putBytes(const char* key, const void* value, size_t len) { return put(key, value, len); }
+
+    bool getBool(const char* key, bool defaultValue = false) const;
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0) const;
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0) const;
+    int32_t getInt(const char* key, int32_t defaultValue = 0) const;
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0) const;
+    int32_t getLong(const char* key, int32_t defaultValue = 0) const;
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0) const;
+    float getFloat(const char* key, float defaultValue = NAN) const;
+    String getString(const char* key, const String& defaultValue = String()) const;
+    size_t getBytesLength(const char* key) const;
+    size_t getBytes(const char* key, void* buf, size_t maxLen) const;
+
+    // Host only: wipe every namespace, and count writes that reached flash
+    static void hostErase();
+    static void hostResetCounters();
+    static uint32_t hostWrites();
+    static uint32_t hostBytesWritten();
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+// The SD card as a second host directory. Nothing mounts it unless a test
+// calls begin(), so by default every lookup misses, as on a clock without
+// a card.
+
+#include <FS.h>
+
+class SDFS : public fs::FS {
+public:
+    bool begin(uint8_t csPin = 0, const char* basePath = "/sd") {
+        (void)csPin;
+        return mount(basePath);
+    }
+};
+
+extern SDFS SD;
+
+#endif
@@ -0,0 +1,41 @@
+#include "SI4735.h"
+
+SI4735::SI4735()
+    : minFrequency(8750), maxFrequency(10800), frequency(8750), step(10),
+      volume(30), muted(false), fm(false), rssi(0) {
+    rdsText[0] = '\0';
+}
+
+void SI4735::setup(uint8_t resetPin, int8_t interruptPin, uint8_t defaultFunction,
+                   uint8_t audioMode, uint8_t clockType, uint8_t gpo2Enable) {
+    (void)resetPin; (void)interruptPin; (void)defaultFunction;
+    (void)audioMode; (void)clockType; (void)gpo2Enable;
+}
+
+void SI4735::setFM(uint16_t fromFreq, uint16_t toFreq, uint16_t initialFreq, uint16_t stepFreq) {
+    minFrequency = fromFreq;
+    maxFrequency = toFreq;
+    step = stepFreq;
+    fm = true;
+    setFrequency(initialFreq);
+}
+
+void SI4735::setFrequency(uint16_t freq) {
+    if (freq < minFrequency || freq > maxFrequency) return;
+    frequency = freq;
+    rdsText[0] = '\0';
+}
+
+// Like the chip, stepping past either end of the band wraps to the other
+void SI4735::frequencyUp() {
+    setFrequency(frequency + step > maxFrequency ? minFrequency : frequency + step);
+}
+
+void SI4735::frequencyDown() {
+    setFrequency(frequency < minFrequency + step ? maxFrequency : frequency - step);
+}
+
+void SI4735::hostSetSignal(uint8_t rssiDbuv, const char* text) {
+    rssi = rssiDbuv;
+    strlcpy(rdsText, text ? text : "", sizeof(rdsText));
+}
@@ -0,0 +1,67 @@
+#ifndef HOST_SI4735_H
+#define HOST_SI4735_H
+
+// A Si4735 with no I2C behind it: it remembers the band, frequency, volume
+// and mute, steps and wraps like the chip, and reports whatever signal and
+// RDS text a test sets.
+
+#include <Arduino.h>
+
+#define FM_CURRENT_MODE 0
+#ifndef SI473X_ANALOG_DIGITAL_AUDIO
+#define SI473X_ANALOG_DIGITAL_AUDIO 1
+#endif
+#ifndef XOSCEN_RCLK
+#define XOSCEN_RCLK 1
+#endif
+
+class SI4735 {
+private:
+    uint16_t minFrequency;
+    uint16_t maxFrequency;
+    uint16_t frequency;     // 10 kHz units
+    uint16_t step;
+    uint8_t volume;
+    bool muted;
+    bool fm;
+    uint8_t rssi;
+    char rdsText[65];
+
+public:
+    SI4735();
+
+    void setup(uint8_t resetPin, int8_t interruptPin, uint8_t defaultFunction,
+               uint8_t audioMode = 0, uint8_t clockType = 0, uint8_t gpo2Enable = 0);
+    void setFM(uint16_t fromFreq, uint16_t toFreq, uint16_t initialFreq, uint16_t stepFreq);
+    void setFrequency(uint16_t freq);
+    uint16_t getFrequency() { return frequency; }
+    void frequencyUp();
+    void frequencyDown();
+
+    void setVolume(uint8_t vol) { volume = vol > 63 ? 63 : vol; }
+    uint8_t getVolume() { return volume; }
+    void setAudioMute(bool off) { muted = off; }
+
+    void digitalOutputSampleRate(uint16_t rate) { (void)rate; }
+    void digitalOutputFormat(uint8_t osize, uint8_t omono, uint8_t omode, uint8_t ofall) {
+        (void)osize; (void)omono; (void)omode; (void)ofall;
+    }
+
+    void getCurrentReceivedSignalQuality() {}
+    uint8_t getCurrentRSSI() { return rssi; }
+    bool isCurrentTuneFM() { return fm; }
+
+    void setRdsConfig(uint8_t enable, uint8_t blockA, uint8_t blockB, uint8_t blockC, uint8_t blockD) {
+        (void)enable; (void)blockA; (void)blockB; (void)blockC; (void)blockD;
+    }
+    void getRdsStatus() {}
+    bool getRdsReceived() { return rdsText[0] != '\0'; }
+    bool getRdsSync() { return rdsText[0] != '\0'; }
+    char* getRdsText() { return rdsText; }
+
+    // Host only: what the tuned station sounds like
+    void hostSetSignal(uint8_t rssiDbuv, const char* text);
+    bool hostIsMuted() const { return muted; }
+};
+
+#endif
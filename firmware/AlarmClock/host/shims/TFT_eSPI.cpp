@@ -0,0 +1,208 @@
+#include "TFT_eSPI.h"
+
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
+    : _width(w), _height(h), buffer(nullptr), pixelsPushed(0),
+      cursorX(0), cursorY(0), textFont(1), textSize(1),
+      textColor(TFT_WHITE), textBgColor(TFT_WHITE),
+      touchDown(false), touchRawX(0), touchRawY(0) {
+    if (w > 0 && h > 0) buffer = (uint16_t*)calloc((size_t)w * h, sizeof(uint16_t));
+}
+
+TFT_eSPI::~TFT_eSPI() {
+    free(buffer);
+}
+
+void TFT_eSPI::init() {
+    pixelsPushed = 0;
+}
+
+// 1 and 3 are landscape; the buffer keeps its size, only the shape changes
+void TFT_eSPI::setRotation(uint8_t rotation) {
+    int16_t shortSide = min(_width, _height);
+    int16_t longSide = max(_width, _height);
+    _width = (rotation & 1) ? longSide : shortSide;
+    _height = (rotation & 1) ? shortSide : longSide;
+}
+
+// ===== PIXELS =====
+
+void TFT_eSPI::setPixel(int32_t x, int32_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= _width || y >= _height || !buffer) return;
+    buffer[y * _width + x] = color;
+    pixelsPushed++;
+}
+
+void TFT_eSPI::hLine(int32_t x, int32_t y, int32_t w, uint16_t color) {
+    for (int32_t i = 0; i < w; i++) setPixel(x + i, y, color);
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) const {
+    if (x < 0 || y < 0 || x >= _width || y >= _height || !buffer) return 0;
+    return buffer[y * _width + x];
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+    setPixel(x, y, color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    for (int32_t row = 0; row < h; row++) hLine(x, y + row, w, color);
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    if (w <= 0 || h <= 0) return;
+    hLine(x, y, w, color);
+    if (h > 1) hLine(x, y + h - 1, w, color);
+    for (int32_t row = 1; row < h - 1; row++) {
+        setPixel(x, y + row, color);
+        if (w > 1) setPixel(x + w - 1, y + row, color);
+    }
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+    hLine(x, y, w, color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+    for (int32_t row = 0; row < h; row++) setPixel(x, y + row, color);
+}
+
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+    int32_t dx = abs(x1 - x0);
+    int32_t dy = -abs(y1 - y0);
+    int32_t sx = x0 < x1 ? 1 : -1;
+    int32_t sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx + dy;
+
+    while (true) {
+        setPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+void TFT_eSPI::drawCircle(int32_t cx, int32_t cy, int32_t r, uint32_t color) {
+    int32_t x = r;
+    int32_t y = 0;
+    int32_t err = 1 - r;
+
+    while (x >= y) {
+        setPixel(cx + x, cy + y, color);
+        setPixel(cx - x, cy + y, color);
+        setPixel(cx + x, cy - y, color);
+        setPixel(cx - x, cy - y, color);
+        setPixel(cx + y, cy + x, color);
+        setPixel(cx - y, cy + x, color);
+        setPixel(cx + y, cy - x, color);
+        setPixel(cx - y, cy - x, color);
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+void TFT_eSPI::fillCircle(int32_t cx, int32_t cy, int32_t r, uint32_t color) {
+    for (int32_t dy = -r; dy <= r; dy++) {
+        int32_t half = (int32_t)sqrt((double)(r * r - dy * dy));
+        hLine(cx - half, cy + dy, 2 * half + 1, color);
+    }
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+    for (int32_t row = 0; row < h; row++) {
+        for (int32_t col = 0; col < w; col++) setPixel(x + col, y + row, data[row * w + col]);
+    }
+}
+
+// ===== TEXT =====
+
+// A glyph is its cell in the background colour with a pattern derived from
+// the character in the foreground colour, so different text differs
+void TFT_eSPI::drawGlyph(char c) {
+    int16_t w = glyphWidth();
+    int16_t h = glyphHeight();
+
+    if (textBgColor != textColor) fillRect(cursorX, cursorY, w, h, textBgColor);
+    if (c != ' ') {
+        uint8_t pattern = (uint8_t)(c * 37 + 11);
+        for (int16_t row = 0; row < h - textSize; row++) {
+            for (int16_t col = 0; col < w - textSize; col++) {
+                int bit = ((row / textSize) * 3 + (col / textSize)) & 7;
+                if (pattern & (1 << bit)) setPixel(cursorX + col, cursorY + row, textColor);
+            }
+        }
+    }
+    cursorX += w;
+}
+
+size_t TFT_eSPI::write(uint8_t c) {
+    if (c == '\r') return 1;
+    if (c == '\n') {
+        cursorX = 0;
+        cursorY += glyphHeight();
+        return 1;
+    }
+    if (cursorX + glyphWidth() > _width) {
+        cursorX = 0;
+        cursorY += glyphHeight();
+    }
+    drawGlyph((char)c);
+    return 1;
+}
+
+// ===== SPRITES =====
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI* tft) : TFT_eSPI(0, 0), parent(tft), created(false) {}
+
+TFT_eSprite::~TFT_eSprite() {
+    deleteSprite();
+}
+
+void* TFT_eSprite::createSprite(int16_t w, int16_t h) {
+    if (created) return buffer;
+    if (w <= 0 || h <= 0) return nullptr;
+    buffer = (uint16_t*)ps_calloc((size_t)w * h, sizeof(uint16_t));
+    if (!buffer) return nullptr;
+    _width = w;
+    _height = h;
+    created = true;
+    return buffer;
+}
+
+void TFT_eSprite::deleteSprite() {
+    free(buffer);
+    buffer = nullptr;
+    _width = 0;
+    _height = 0;
+    created = false;
+}
+
+void TFT_eSprite::fillSprite(uint32_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+    if (!created) return;
+    parent->pushImage(x, y, _width, _height, buffer);
+}
+
+bool TFT_eSprite::pushSprite(int32_t x, int32_t y, int32_t sx, int32_t sy, int32_t sw, int32_t sh) {
+    if (!created || sx < 0 || sy < 0 || sw <= 0 || sh <= 0 ||
+        sx + sw > _width || sy + sh > _height) {
+        return false;
+    }
+    for (int32_t row = 0; row < sh; row++) {
+        parent->pushImage(x, y + row, sw, 1, buffer + (sy + row) * _width + sx);
+    }
+    return true;
+}
@@ -0,0 +1,137 @@
+#ifndef HOST_TFT_ESPI_H
+#define HOST_TFT_ESPI_H
+
+// TFT_eSPI drawing into RAM. The panel is a 16-bit framebuffer, and every
+// pixel sent to it (fills, lines, text, pushImage, pushSprite) is counted,
+// standing in for SPI traffic. Sprites draw into their own buffer and count
+// nothing until they are pushed. Text uses block glyphs of the right size
+// (6x8 per size step for font 1, 8x16 for font 2): enough to see what
+// changed, not what it says.
+
+#include <Arduino.h>
+
+#define TFT_WIDTH   240
+#define TFT_HEIGHT  320
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_DARKCYAN    0x03EF
+#define TFT_MAROON      0x7800
+#define TFT_PURPLE      0x780F
+#define TFT_OLIVE       0x7BE0
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_DARKGREY    0x7BEF
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+#define TFT_ORANGE      0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK        0xFE19
+#define TFT_BROWN       0x9A60
+#define TFT_GOLD        0xFEA0
+#define TFT_SILVER      0xC618
+#define TFT_SKYBLUE     0x867D
+#define TFT_VIOLET      0x915C
+
+class TFT_eSPI : public Print {
+protected:
+    int16_t _width;
+    int16_t _height;
+    uint16_t* buffer;
+    uint32_t pixelsPushed;
+
+    int16_t cursorX;
+    int16_t cursorY;
+    uint8_t textFont;
+    uint8_t textSize;
+    uint16_t textColor;
+    uint16_t textBgColor;
+
+    bool touchDown;
+    uint16_t touchRawX;
+    uint16_t touchRawY;
+
+    void setPixel(int32_t x, int32_t y, uint16_t color);
+    void hLine(int32_t x, int32_t y, int32_t w, uint16_t color);
+    void drawGlyph(char c);
+    int16_t glyphWidth() const { return (textFont == 1 ? 6 : 8) * textSize; }
+    int16_t glyphHeight() const { return (textFont == 1 ? 8 : 16) * textSize; }
+
+public:
+    TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+    virtual ~TFT_eSPI();
+
+    void init();
+    void begin() { init(); }
+    void setRotation(uint8_t rotation);
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    void fillScreen(uint32_t color);
+    void drawPixel(int32_t x, int32_t y, uint32_t color);
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+    uint16_t readPixel(int32_t x, int32_t y) const;
+
+    void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+    void setCursor(int16_t x, int16_t y, uint8_t font) { cursorX = x; cursorY = y; textFont = font; }
+    void setTextFont(uint8_t font) { textFont = font; }
+    void setTextSize(uint8_t size) { textSize = size ? size : 1; }
+    void setTextColor(uint16_t color) { textColor = color; textBgColor = color; }
+    void setTextColor(uint16_t fg, uint16_t bg) { textColor = fg; textBgColor = bg; }
+    int16_t textWidth(const char* text) const { return strlen(text) * glyphWidth(); }
+    int16_t fontHeight() const { return glyphHeight(); }
+    int16_t getCursorX() const { return cursorX; }
+    int16_t getCursorY() const { return cursorY; }
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    // Touch reports raw controller coordinates; there is no calibration
+    bool getTouch(uint16_t* x, uint16_t* y, uint16_t threshold = 600) { (void)threshold; return getTouchRaw(x, y); }
+    uint8_t getTouchRaw(uint16_t* x, uint16_t* y) {
+        if (touchDown) { *x = touchRawX; *y = touchRawY; }
+        return touchDown;
+    }
+    void setTouch(uint16_t* data) { (void)data; }
+
+    // Host only: pixels sent to this display since the last reset
+    uint32_t hostPixelsPushed() const { return pixelsPushed; }
+    void hostResetPixelsPushed() { pixelsPushed = 0; }
+    const uint16_t* hostFramebuffer() const { return buffer; }
+    // A finger on the panel at raw controller coordinates, until released
+    void hostTouch(uint16_t rawX, uint16_t rawY) { touchDown = true; touchRawX = rawX; touchRawY = rawY; }
+    void hostRelease() { touchDown = false; }
+};
+
+class TFT_eSprite : public TFT_eSPI {
+private:
+    TFT_eSPI* parent;
+    bool created;
+
+public:
+    explicit TFT_eSprite(TFT_eSPI* tft);
+    ~TFT_eSprite();
+
+    void setColorDepth(int8_t depth) { (void)depth; }
+    void* createSprite(int16_t w, int16_t h);
+    void deleteSprite();
+    void* getPointer() { return buffer; }
+
+    void fillSprite(uint32_t color);
+    void pushSprite(int32_t x, int32_t y);
+    bool pushSprite(int32_t x, int32_t y, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "WiFi.h"
+#include "WiFiUdp.h"
+#include "ESPmDNS.h"
+
+WiFiClass WiFi;
+
+// ===== ADDRESS =====
+
+String IPAddress::toString() const {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(text);
+}
+
+// ===== STATION =====
+
+void WiFiClass::deliver(arduino_event_id_t event, const arduino_event_info_t& info) {
+    for (WiFiEventFuncCb& handler : handlers) handler(event, info);
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* password, int32_t channel,
+                             const uint8_t* bssid, bool connect) {
+    (void)password;
+    (void)channel;
+    (void)bssid;
+    (void)connect;
+    joining = ssid ? ssid : "";
+    linkStatus = WL_DISCONNECTED;
+    return linkStatus;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp) {
+    (void)wifiOff;
+    (void)eraseAp;
+    bool wasUp = linkStatus == WL_CONNECTED;
+    joining = "";
+    linkStatus = WL_DISCONNECTED;
+    if (wasUp) {
+        arduino_event_info_t info;
+        memset(&info, 0, sizeof(info));
+        info.wifi_sta_disconnected.reason = 8;  // ASSOC_LEAVE
+        deliver(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, info);
+    }
+    return true;
+}
+
+IPAddress WiFiClass::localIP() const {
+    return linkStatus == WL_CONNECTED ? IPAddress(192, 168, 1, 50) : IPAddress();
+}
+
+void WiFiClass::hostConnect(const uint8_t* bssid, uint8_t channel) {
+    arduino_event_info_t info;
+    memset(&info, 0, sizeof(info));
+    if (bssid) memcpy(info.wifi_sta_connected.bssid, bssid, 6);
+    info.wifi_sta_connected.channel = channel;
+    deliver(ARDUINO_EVENT_WIFI_STA_CONNECTED, info);
+
+    linkStatus = WL_CONNECTED;
+    memset(&info, 0, sizeof(info));
+    deliver(ARDUINO_EVENT_WIFI_STA_GOT_IP, info);
+}
+
+void WiFiClass::hostDrop(uint8_t reason) {
+    linkStatus = WL_CONNECTION_LOST;
+    arduino_event_info_t info;
+    memset(&info, 0, sizeof(info));
+    info.wifi_sta_disconnected.reason = reason;
+    deliver(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, info);
+}
+
+// ===== UDP =====
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+    (void)port;
+    if (!open || (uint32_t)ip == 0 || WiFi.status() != WL_CONNECTED) return 0;
+    outgoing.clear();
+    return 1;
+}
+
+size_t WiFiUDP::write(const uint8_t* buffer, size_t size) {
+    outgoing.insert(outgoing.end(), buffer, buffer + size);
+    return size;
+}
+
+int WiFiUDP::endPacket() {
+    sent.push_back(outgoing);
+    outgoing.clear();
+    return 1;
+}
+
+int WiFiUDP::parsePacket() {
+    if (!open || inbox.empty()) return 0;
+    current = inbox.front();
+    inbox.pop_front();
+    readPos = 0;
+    return (int)current.size();
+}
+
+int WiFiUDP::read(uint8_t* buffer, size_t size) {
+    size_t n = min(size, current.size() - readPos);
+    memcpy(buffer, current.data() + readPos, n);
+    readPos += n;
+    return (int)n;
+}
+
+// ===== MDNS =====
+
+MDNSResponder MDNS;
@@ -0,0 +1,102 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+// The station-mode WiFi the firmware uses, with no radio. begin() only
+// records the join; a test decides how it ends with hostWiFiConnect() or
+// hostWiFiDrop(), which deliver the driver events the way the WiFi event
+// task does (on the calling thread here).
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+
+class IPAddress {
+private:
+    uint32_t address;   // Network order, as lwIP keeps it
+
+public:
+    IPAddress() : address(0) {}
+    IPAddress(uint32_t addr) : address(addr) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : address((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+
+    operator uint32_t() const { return address; }
+    uint8_t operator[](int index) const { return (address >> (8 * index)) & 0xFF; }
+    String toString() const;
+};
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_START = 2,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP = 9
+} arduino_event_id_t;
+
+typedef union {
+    struct {
+        uint8_t ssid[32];
+        uint8_t ssid_len;
+        uint8_t bssid[6];
+        uint8_t channel;
+    } wifi_sta_connected;
+    struct {
+        uint8_t ssid[32];
+        uint8_t ssid_len;
+        uint8_t bssid[6];
+        uint8_t reason;
+    } wifi_sta_disconnected;
+} arduino_event_info_t;
+
+typedef std::function<void(arduino_event_id_t event, arduino_event_info_t info)> WiFiEventFuncCb;
+
+class WiFiClass {
+private:
+    std::vector<WiFiEventFuncCb> handlers;
+    wl_status_t linkStatus;
+    String joining;
+
+    void deliver(arduino_event_id_t event, const arduino_event_info_t& info);
+
+public:
+    WiFiClass() : linkStatus(WL_DISCONNECTED) {}
+
+    int onEvent(WiFiEventFuncCb handler) { handlers.push_back(handler); return (int)handlers.size(); }
+    bool mode(wifi_mode_t mode) { (void)mode; return true; }
+    bool setAutoReconnect(bool on) { (void)on; return true; }
+    wl_status_t begin(const char* ssid, const char* password = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+
+    wl_status_t status() const { return linkStatus; }
+    IPAddress localIP() const;
+    int8_t RSSI() const { return linkStatus == WL_CONNECTED ? -58 : 0; }
+    String SSID() const { return linkStatus == WL_CONNECTED ? joining : String(); }
+
+    // Host only: the pending join succeeds (CONNECTED then GOT_IP) or the
+    // link goes down with a driver reason code
+    void hostConnect(const uint8_t* bssid = nullptr, uint8_t channel = 6);
+    void hostDrop(uint8_t reason = 8);
+    // SSID of the last begin(), empty after disconnect()
+    const char* hostJoining() const { return joining.c_str(); }
+};
+
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef HOST_WIFI_UDP_H
+#define HOST_WIFI_UDP_H
+
+// A UDP socket with no network: sent datagrams are kept for a test to
+// read back, and replies are whatever the test queues.
+
+#include <WiFi.h>
+#include <deque>
+#include <vector>
+
+class WiFiUDP {
+private:
+    std::deque<std::vector<uint8_t>> inbox;
+    std::vector<uint8_t> current;       // Last parsePacket(), read from front
+    size_t readPos;
+    std::vector<uint8_t> outgoing;
+    std::vector<std::vector<uint8_t>> sent;
+    bool open;
+
+public:
+    WiFiUDP() : readPos(0), open(false) {}
+
+    uint8_t begin(uint16_t port) { (void)port; open = true; return 1; }
+    void stop() { open = false; }
+    int beginPacket(IPAddress ip, uint16_t port);
+    size_t write(const uint8_t* buffer, size_t size);
+    int endPacket();
+    int parsePacket();
+    int read(uint8_t* buffer, size_t size);
+
+    // Host only
+    void hostQueueReply(const uint8_t* data, size_t size) { inbox.emplace_back(data, data + size); }
+    const std::vector<std::vector<uint8_t>>& hostSent() const { return sent; }
+};
+
+#endif
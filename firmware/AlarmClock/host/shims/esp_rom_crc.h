@@ -0,0 +1,20 @@
+#ifndef HOST_ESP_ROM_CRC_H
+#define HOST_ESP_ROM_CRC_H
+
+// The ROM CRC routines, in C (same results as the chip)
+
+#include <stdint.h>
+
+// CRC-32 as used by zlib and Ethernet (reflected, polynomial 0xEDB88320)
+static inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include "esp_system.h"
+#include <stdlib.h>
+
+#define SHUTDOWN_HANDLERS_MAX 5
+
+static shutdown_handler_t handlers[SHUTDOWN_HANDLERS_MAX];
+
+esp_err_t esp_register_shutdown_handler(shutdown_handler_t handler) {
+    for (int i = 0; i < SHUTDOWN_HANDLERS_MAX; i++) {
+        if (handlers[i] == handler) return ESP_ERR_INVALID_STATE;
+        if (!handlers[i]) {
+            handlers[i] = handler;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t esp_unregister_shutdown_handler(shutdown_handler_t handler) {
+    for (int i = 0; i < SHUTDOWN_HANDLERS_MAX; i++) {
+        if (handlers[i] == handler) {
+            handlers[i] = nullptr;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_INVALID_STATE;
+}
+
+void hostRunShutdownHandlers(void) {
+    for (int i = SHUTDOWN_HANDLERS_MAX - 1; i >= 0; i--) {
+        if (handlers[i]) handlers[i]();
+    }
+}
+
+void esp_restart(void) {
+    hostRunShutdownHandlers();
+    exit(0);
+}
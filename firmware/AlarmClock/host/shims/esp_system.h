@@ -0,0 +1,22 @@
+#ifndef HOST_ESP_SYSTEM_H
+#define HOST_ESP_SYSTEM_H
+
+// Restart and shutdown hooks. esp_restart() runs the registered handlers
+// and exits; tests call hostRunShutdownHandlers() to simulate a clean
+// restart without ending the process.
+
+typedef void (*shutdown_handler_t)(void);
+
+typedef int esp_err_t;
+#define ESP_OK              0
+#define ESP_ERR_NO_MEM      0x101
+#define ESP_ERR_INVALID_STATE 0x103
+
+esp_err_t esp_register_shutdown_handler(shutdown_handler_t handler);
+esp_err_t esp_unregister_shutdown_handler(shutdown_handler_t handler);
+void esp_restart(void);
+
+// Host only
+void hostRunShutdownHandlers(void);
+
+#endif
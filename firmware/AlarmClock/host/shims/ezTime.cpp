@@ -0,0 +1,45 @@
+#include "ezTime.h"
+#include <map>
+
+Timezone UTC;
+
+static std::map<std::string, std::string> zones;
+static bool clockSet = false;
+static time_t clockSeconds = 0;
+static uint32_t clockBaseMs = 0;        // millis() when clockSeconds was set, less its ms
+
+bool Timezone::setLocation(const String& location) {
+    std::map<std::string, std::string>::iterator zone = zones.find(location.c_str());
+    if (location.isEmpty() || zone == zones.end()) return false;
+    name = location;
+    posix = zone->second;
+    return true;
+}
+
+void Timezone::setTime(time_t t, uint16_t ms) {
+    clockSeconds = t;
+    clockBaseMs = (uint32_t)millis() - ms;
+    clockSet = true;
+}
+
+time_t Timezone::now() const {
+    if (!clockSet) return 0;
+    return clockSeconds + (time_t)(((uint32_t)millis() - clockBaseMs) / 1000);
+}
+
+timeStatus_t timeStatus() {
+    return clockSet ? timeSet : timeNotSet;
+}
+
+void setInterval(uint16_t seconds) {
+    (void)seconds;
+}
+
+void hostEzTimeAddZone(const char* name, const char* posix) {
+    zones[name] = posix;
+}
+
+void hostEzTimeReset() {
+    zones.clear();
+    clockSet = false;
+}
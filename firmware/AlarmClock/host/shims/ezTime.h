@@ -0,0 +1,45 @@
+#ifndef HOST_EZTIME_H
+#define HOST_EZTIME_H
+
+// The few ezTime calls the firmware still makes: UTC as the clock NTP
+// sets (it runs on the virtual millis(), as ezTime's does on the real
+// one) and Timezone::setLocation() as an online rules lookup. There is no
+// timezone server here; lookups answer only for zones a test has added.
+
+#include <Arduino.h>
+#include <time.h>
+
+typedef enum {
+    timeNotSet,
+    timeSet,
+    timeNeedsSync
+} timeStatus_t;
+
+class Timezone {
+private:
+    String name;
+    String posix;
+
+public:
+    Timezone() {}
+
+    // "" looks the zone up from the public IP, which the host never knows
+    bool setLocation(const String& location = "");
+    String getTimezoneName() const { return name; }
+    String getPosix() const { return posix; }
+
+    // The clock is shared by every Timezone, as in ezTime
+    void setTime(time_t t, uint16_t ms = 0);
+    time_t now() const;
+};
+
+extern Timezone UTC;
+
+timeStatus_t timeStatus();
+void setInterval(uint16_t seconds = 0);
+
+// Host only: what setLocation(name) finds; clears the clock back to unset
+void hostEzTimeAddZone(const char* name, const char* posix);
+void hostEzTimeReset();
+
+#endif
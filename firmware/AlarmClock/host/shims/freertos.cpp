@@ -0,0 +1,254 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include <atomic>
+#include <chrono>
+#include <string.h>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+// ===== TASKS =====
+
+struct HostTask {
+    std::mutex mutex;
+    std::condition_variable wake;
+    uint32_t notifications;
+    bool deleted;
+
+    HostTask() : notifications(0), deleted(false) {}
+};
+
+// Thrown to unwind a task that was deleted; caught where its thread starts
+struct HostTaskExit {};
+
+// Handles stay valid for the life of the process, as a test may still
+// hold one after the task has gone
+static std::mutex tasksMutex;
+static std::list<HostTask> tasks;
+static std::atomic<int> running(0);
+static std::atomic<int> createsBeforeFailure(-1);
+static thread_local HostTask* currentTask = nullptr;
+
+static const steady_clock::time_point tickZero = steady_clock::now();
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackSize,
+                                   void* param, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core) {
+    (void)name;
+    (void)stackSize;
+    (void)priority;
+    (void)core;
+
+    int left = createsBeforeFailure.load();
+    if (left == 0) return pdFAIL;
+    if (left > 0) createsBeforeFailure = left - 1;
+
+    HostTask* task;
+    {
+        std::lock_guard<std::mutex> guard(tasksMutex);
+        tasks.emplace_back();
+        task = &tasks.back();
+    }
+    if (handle) *handle = task;
+
+    running++;
+    std::thread([task, function, param]() {
+        currentTask = task;
+        try {
+            function(param);
+        } catch (HostTaskExit&) {
+        }
+        running--;
+    }).detach();
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return currentTask;
+}
+
+// Unwinds the calling task if it has been deleted
+static void exitIfDeleted(HostTask* task) {
+    if (task && task->deleted) throw HostTaskExit();
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (!task || task == currentTask) throw HostTaskExit();
+
+    std::lock_guard<std::mutex> guard(task->mutex);
+    task->deleted = true;
+    task->wake.notify_all();
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)std::chrono::duration_cast<milliseconds>(steady_clock::now() - tickZero).count();
+}
+
+// Sleeps until the tick reaches `until`, waking early only to be deleted
+static void sleepUntil(TickType_t until) {
+    steady_clock::time_point deadline = tickZero + milliseconds(until);
+    HostTask* task = currentTask;
+    if (!task) {
+        std::this_thread::sleep_until(deadline);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(task->mutex);
+    task->wake.wait_until(lock, deadline, [task]() { return task->deleted; });
+    exitIfDeleted(task);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    sleepUntil(xTaskGetTickCount() + ticks);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t* previousWake, TickType_t increment) {
+    TickType_t target = *previousWake + increment;
+    *previousWake = target;
+    if ((int32_t)(target - xTaskGetTickCount()) <= 0) {
+        exitIfDeleted(currentTask);
+        return pdFALSE;
+    }
+    sleepUntil(target);
+    return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait) {
+    HostTask* task = currentTask;
+    if (!task) return 0;
+
+    std::unique_lock<std::mutex> lock(task->mutex);
+    auto ready = [task]() { return task->notifications > 0 || task->deleted; };
+    if (ticksToWait == portMAX_DELAY) {
+        task->wake.wait(lock, ready);
+    } else {
+        task->wake.wait_for(lock, milliseconds(ticksToWait), ready);
+    }
+    exitIfDeleted(task);
+
+    uint32_t value = task->notifications;
+    if (value > 0) task->notifications = clearOnExit ? 0 : value - 1;
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    std::lock_guard<std::mutex> guard(task->mutex);
+    task->notifications++;
+    task->wake.notify_all();
+    return pdPASS;
+}
+
+void hostTaskFailCreateAfter(int successes) {
+    createsBeforeFailure = successes;
+}
+
+int hostTaskRunning() {
+    return running.load();
+}
+
+// ===== SEMAPHORES =====
+
+struct HostSemaphore {
+    std::recursive_timed_mutex mutex;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new HostSemaphore();
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+    return new HostSemaphore();
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+    if (ticksToWait == portMAX_DELAY) {
+        semaphore->mutex.lock();
+        return pdTRUE;
+    }
+    return semaphore->mutex.try_lock_for(milliseconds(ticksToWait)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore) {
+    semaphore->mutex.unlock();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+    return xSemaphoreTakeRecursive(semaphore, ticksToWait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return xSemaphoreGiveRecursive(semaphore);
+}
+
+// ===== QUEUES =====
+
+struct HostQueue {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::vector<uint8_t>> items;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    if (length == 0) return nullptr;
+    HostQueue* queue = new HostQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+// Waits on the queue until ready() or ticksToWait pass
+template <typename Ready>
+static bool waitQueue(HostQueue* queue, std::unique_lock<std::mutex>& lock, TickType_t ticksToWait,
+                      Ready ready) {
+    if (ticksToWait == portMAX_DELAY) {
+        queue->changed.wait(lock, ready);
+        return true;
+    }
+    return queue->changed.wait_for(lock, milliseconds(ticksToWait), ready);
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitQueue(queue, lock, ticksToWait, [queue]() { return queue->items.size() < queue->length; })) {
+        return pdFALSE;
+    }
+    const uint8_t* bytes = (const uint8_t*)item;
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitQueue(queue, lock, ticksToWait, [queue]() { return !queue->items.empty(); })) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> guard(queue->mutex);
+    return queue->items.size();
+}
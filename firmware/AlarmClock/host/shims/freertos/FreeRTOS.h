@@ -0,0 +1,26 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+// The slice of FreeRTOS the firmware uses, on host threads. Tasks are
+// std::threads, the tick is one real millisecond (unlike millis(), which
+// is virtual), and core and priority are accepted but not enforced.
+// Deleting another task takes effect the next time it blocks (delay,
+// notification wait), which is where firmware tasks get deleted anyway.
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE               0
+#define pdTRUE                1
+#define pdPASS                pdTRUE
+#define pdFAIL                pdFALSE
+#define portMAX_DELAY         0xFFFFFFFFUL
+#define configTICK_RATE_HZ    1000
+#define portTICK_PERIOD_MS    1
+#define pdMS_TO_TICKS(ms)     ((TickType_t)(ms))
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+struct HostTask;
+typedef HostTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackSize,
+                                   void* param, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core);
+void vTaskDelete(TaskHandle_t task);    // nullptr = the calling task
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+TickType_t xTaskGetTickCount();
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskDelayUntil(TickType_t* previousWake, TickType_t increment);
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+// Host only: the next `successes` creations work, the one after fails
+// (-1 = never fail)
+void hostTaskFailCreateAfter(int successes);
+// Tasks whose function has not yet returned or been deleted
+int hostTaskRunning();
+
+#endif
@@ -0,0 +1,89 @@
+#include "lwip/dns.h"
+#include <arpa/inet.h>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+// ===== DNS =====
+
+struct HostDnsLookup {
+    std::string name;
+    dns_found_callback found;
+    void* arg;
+};
+
+static std::mutex dnsMutex;
+static std::map<std::string, uint32_t> dnsNames;
+static std::set<std::string> dnsCache;
+static std::vector<HostDnsLookup> dnsQueue;
+
+static void fillAddress(ip_addr_t* addr, uint32_t ipv4) {
+    addr->u_addr.ip4.addr = ipv4;
+    addr->type = IPADDR_TYPE_V4;
+}
+
+err_t dns_gethostbyname(const char* hostname, ip_addr_t* addr, dns_found_callback found,
+                        void* callback_arg) {
+    if (!hostname || !hostname[0] || !addr) return ERR_ARG;
+
+    struct in_addr literal;
+    if (inet_pton(AF_INET, hostname, &literal) == 1) {
+        fillAddress(addr, literal.s_addr);
+        return ERR_OK;
+    }
+
+    std::lock_guard<std::mutex> guard(dnsMutex);
+    std::map<std::string, uint32_t>::iterator known = dnsNames.find(hostname);
+    if (known != dnsNames.end() && dnsCache.count(hostname)) {
+        fillAddress(addr, known->second);
+        return ERR_OK;
+    }
+    HostDnsLookup lookup = { hostname, found, callback_arg };
+    dnsQueue.push_back(lookup);
+    return ERR_INPROGRESS;
+}
+
+void hostDnsAdd(const char* name, uint32_t ipv4) {
+    std::lock_guard<std::mutex> guard(dnsMutex);
+    dnsNames[name] = ipv4;
+}
+
+int hostDnsAnswer() {
+    std::vector<HostDnsLookup> answering;
+    std::map<std::string, uint32_t> names;
+    {
+        std::lock_guard<std::mutex> guard(dnsMutex);
+        answering.swap(dnsQueue);
+        names = dnsNames;
+        for (const HostDnsLookup& lookup : answering) {
+            if (names.count(lookup.name)) dnsCache.insert(lookup.name);
+        }
+    }
+
+    // Outside the lock: a callback may start another lookup
+    for (const HostDnsLookup& lookup : answering) {
+        std::map<std::string, uint32_t>::iterator known = names.find(lookup.name);
+        if (known == names.end()) {
+            if (lookup.found) lookup.found(lookup.name.c_str(), nullptr, lookup.arg);
+            continue;
+        }
+        ip_addr_t addr;
+        fillAddress(&addr, known->second);
+        if (lookup.found) lookup.found(lookup.name.c_str(), &addr, lookup.arg);
+    }
+    return (int)answering.size();
+}
+
+int hostDnsPending() {
+    std::lock_guard<std::mutex> guard(dnsMutex);
+    return (int)dnsQueue.size();
+}
+
+void hostDnsReset() {
+    std::lock_guard<std::mutex> guard(dnsMutex);
+    dnsNames.clear();
+    dnsCache.clear();
+    dnsQueue.clear();
+}
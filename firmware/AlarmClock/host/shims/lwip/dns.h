@@ -0,0 +1,24 @@
+#ifndef HOST_LWIP_DNS_H
+#define HOST_LWIP_DNS_H
+
+// lwIP's asynchronous resolver with a resolver the test controls. IP
+// literals and names already answered return ERR_OK at once; any other
+// lookup is queued, and its callback runs when the test calls
+// hostDnsAnswer(), on the test's thread as it would on the lwIP thread.
+
+#include "ip_addr.h"
+
+typedef void (*dns_found_callback)(const char* name, const ip_addr_t* ipaddr, void* callback_arg);
+
+err_t dns_gethostbyname(const char* hostname, ip_addr_t* addr, dns_found_callback found,
+                        void* callback_arg);
+
+// Host only: what the resolver answers for a name (unknown names fail)
+void hostDnsAdd(const char* name, uint32_t ipv4);
+// Answers the queued lookups; returns how many were answered
+int hostDnsAnswer();
+int hostDnsPending();
+// Forgets the cache and the names, drops queued lookups
+void hostDnsReset();
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef HOST_LWIP_ERR_H
+#define HOST_LWIP_ERR_H
+
+#include <stdint.h>
+
+typedef int8_t err_t;
+
+#define ERR_OK          0
+#define ERR_MEM        -1
+#define ERR_INPROGRESS -5
+#define ERR_VAL        -6
+#define ERR_ARG        -16
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef HOST_LWIP_IP_ADDR_H
+#define HOST_LWIP_IP_ADDR_H
+
+#include <stdint.h>
+#include "err.h"
+
+#define IPADDR_TYPE_V4 0
+#define IPADDR_TYPE_V6 6
+
+// Dual-stack layout, as the ESP32 builds lwIP; only IPv4 is ever filled in
+typedef struct {
+    union {
+        struct { uint32_t addr; } ip4;
+    } u_addr;
+    uint8_t type;
+} ip_addr_t;
+
+#define IP_IS_V4(ip)               ((ip)->type == IPADDR_TYPE_V4)
+#define ip_addr_get_ip4_u32(ip)    ((ip)->u_addr.ip4.addr)
+
+#endif
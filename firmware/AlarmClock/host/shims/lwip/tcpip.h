@@ -0,0 +1,9 @@
+#ifndef HOST_LWIP_TCPIP_H
+#define HOST_LWIP_TCPIP_H
+
+// No core lock on the host (CONFIG_LWIP_TCPIP_CORE_LOCKING is unset, as in
+// the default ESP32 Arduino build); the DNS shim has its own
+
+#include "err.h"
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef HOST_FIXTURES_H
+#define HOST_FIXTURES_H
+
+// Device state shared by the suites that run firmware modules: NVS,
+// the LittleFS directory and the virtual clock
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <LittleFS.h>
+
+// A factory-fresh device at t=0
+static inline void resetDevice() {
+    Preferences::hostErase();
+    LittleFS.begin(true, LITTLEFS_BASE_PATH);
+    LittleFS.format();
+    hostClockSet(0);
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// A small test runner for the host build. Tests register themselves:
+//
+//   TEST(Suite, name) { CHECK(x); CHECK_EQ(a, b); }
+//   TEST_XFAIL(Suite, name, "why") { ... }   // known difference: must fail
+//   BENCH(name) { ... }                       // prints its own numbers
+//
+// Checks record a failure and carry on. "host_tests Suite" runs one suite
+// (one ctest entry each), "host_tests --bench [name]" runs benchmarks.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum HostTestKind {
+    HOST_TEST,
+    HOST_TEST_XFAIL,
+    HOST_BENCH
+};
+
+typedef void (*HostTestFunction)();
+
+struct HostTestRegistrar {
+    HostTestRegistrar(const char* suite, const char* name, HostTestFunction function,
+                      HostTestKind kind, const char* reason = nullptr);
+};
+
+void hostTestFail(const char* file, int line, const char* message);
+void hostTestFailEq(const char* file, int line, const char* expression, long long actual, long long expected);
+void hostTestFailStr(const char* file, int line, const char* expression, const char* actual, const char* expected);
+// Failures so far in the running test
+int hostTestFailures();
+// Host steady clock, for benchmarks
+uint64_t hostBenchNanos();
+
+#define HOST_TEST_DEFINE(suite, name, kind, reason) \
+    static void hostTest_##suite##_##name(); \
+    static HostTestRegistrar hostTestReg_##suite##_##name(#suite, #name, hostTest_##suite##_##name, kind, reason); \
+    static void hostTest_##suite##_##name()
+
+#define TEST(suite, name)               HOST_TEST_DEFINE(suite, name, HOST_TEST, nullptr)
+#define TEST_XFAIL(suite, name, reason) HOST_TEST_DEFINE(suite, name, HOST_TEST_XFAIL, reason)
+#define BENCH(name)                     HOST_TEST_DEFINE(Bench, name, HOST_BENCH, nullptr)
+
+#define CHECK(cond) \
+    do { if (!(cond)) hostTestFail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        long long a_ = (long long)(actual); \
+        long long e_ = (long long)(expected); \
+        if (a_ != e_) hostTestFailEq(__FILE__, __LINE__, #actual, a_, e_); \
+    } while (0)
+
+#define CHECK_STR(actual, expected) \
+    do { \
+        const char* a_ = (actual); \
+        const char* e_ = (expected); \
+        if (strcmp(a_, e_) != 0) hostTestFailStr(__FILE__, __LINE__, #actual, a_, e_); \
+    } while (0)
+
+#endif
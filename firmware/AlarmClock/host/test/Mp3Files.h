@@ -0,0 +1,93 @@
+#ifndef HOST_MP3_FILES_H
+#define HOST_MP3_FILES_H
+
+// Byte-level MP3 files for the probe and the media index: ID3v2 and
+// ID3v1 tags and MPEG-1 Layer III frames at 128 kbit/s, 44.1 kHz stereo
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+typedef std::vector<uint8_t> Bytes;
+
+static const size_t MP3_FRAME_BYTES = 417;    // 144 * 128000 / 44100
+
+static inline void appendSyncsafe(Bytes& out, uint32_t value) {
+    out.push_back((value >> 21) & 0x7F);
+    out.push_back((value >> 14) & 0x7F);
+    out.push_back((value >> 7) & 0x7F);
+    out.push_back(value & 0x7F);
+}
+
+static inline void appendBE32(Bytes& out, uint32_t value) {
+    out.push_back(value >> 24);
+    out.push_back(value >> 16);
+    out.push_back(value >> 8);
+    out.push_back(value);
+}
+
+// One ID3v2.3/2.4 frame: header, then encoding byte and text
+static inline Bytes id3Frame(uint8_t version, const char* id, uint8_t encoding, const Bytes& text) {
+    Bytes frame(id, id + 4);
+    uint32_t size = 1 + text.size();
+    if (version == 4) appendSyncsafe(frame, size);
+    else appendBE32(frame, size);
+    frame.push_back(0);
+    frame.push_back(0);
+    frame.push_back(encoding);
+    frame.insert(frame.end(), text.begin(), text.end());
+    return frame;
+}
+
+static inline Bytes id3v2Tag(uint8_t version, const Bytes& frames, size_t padding = 0) {
+    Bytes tag = { 'I', 'D', '3', version, 0, 0 };
+    appendSyncsafe(tag, frames.size() + padding);
+    tag.insert(tag.end(), frames.begin(), frames.end());
+    tag.resize(tag.size() + padding, 0);
+    return tag;
+}
+
+static inline Bytes latin1(const char* text) {
+    return Bytes(text, text + strlen(text));
+}
+
+static inline Bytes id3v1Tag(const char* title) {
+    Bytes tag(128, 0);
+    memcpy(&tag[0], "TAG", 3);
+    memset(&tag[3], ' ', 30);
+    memcpy(&tag[3], title, strlen(title) < 30 ? strlen(title) : 30);
+    return tag;
+}
+
+// count frames; with xingFrames, the first carries a Xing header instead of audio
+static inline Bytes mp3Frames(size_t count, uint32_t xingFrames = 0, uint32_t xingBytes = 0) {
+    Bytes out;
+    for (size_t i = 0; i < count; i++) {
+        size_t start = out.size();
+        out.resize(start + MP3_FRAME_BYTES, 0x55);
+        out[start] = 0xFF;
+        out[start + 1] = 0xFB;
+        out[start + 2] = 0x90;
+        out[start + 3] = 0x00;
+        if (i == 0 && xingFrames > 0) {
+            uint8_t* xing = &out[start + 4 + 32];
+            memcpy(xing, "Xing", 4);
+            Bytes fields;
+            appendBE32(fields, 3);
+            appendBE32(fields, xingFrames);
+            appendBE32(fields, xingBytes);
+            memcpy(xing + 4, fields.data(), fields.size());
+        }
+    }
+    return out;
+}
+
+static inline Bytes concat(const Bytes& a, const Bytes& b, const Bytes& c = Bytes()) {
+    Bytes out = a;
+    out.insert(out.end(), b.begin(), b.end());
+    out.insert(out.end(), c.begin(), c.end());
+    return out;
+}
+
+#endif
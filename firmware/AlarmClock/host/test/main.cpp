@@ -0,0 +1,104 @@
+#include "HostTest.h"
+#include <chrono>
+#include <vector>
+
+struct HostTestCase {
+    const char* suite;
+    const char* name;
+    HostTestFunction function;
+    HostTestKind kind;
+    const char* reason;
+};
+
+static std::vector<HostTestCase>& registry() {
+    static std::vector<HostTestCase> tests;
+    return tests;
+}
+
+static int failures = 0;
+
+HostTestRegistrar::HostTestRegistrar(const char* suite, const char* name, HostTestFunction function,
+                                     HostTestKind kind, const char* reason) {
+    HostTestCase test = { suite, name, function, kind, reason };
+    registry().push_back(test);
+}
+
+void hostTestFail(const char* file, int line, const char* message) {
+    printf("  %s:%d: CHECK(%s) failed\n", file, line, message);
+    failures++;
+}
+
+void hostTestFailEq(const char* file, int line, const char* expression, long long actual, long long expected) {
+    printf("  %s:%d: %s is %lld, expected %lld\n", file, line, expression, actual, expected);
+    failures++;
+}
+
+void hostTestFailStr(const char* file, int line, const char* expression, const char* actual, const char* expected) {
+    printf("  %s:%d: %s is \"%s\", expected \"%s\"\n", file, line, expression, actual, expected);
+    failures++;
+}
+
+int hostTestFailures() {
+    return failures;
+}
+
+uint64_t hostBenchNanos() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static bool selected(const HostTestCase& test, bool bench, const char* filter) {
+    if ((test.kind == HOST_BENCH) != bench) return false;
+    if (!filter) return true;
+    return strcmp(filter, bench ? test.name : test.suite) == 0;
+}
+
+// host_tests [Suite]           run the tests (of one suite)
+// host_tests --bench [name]    run the benchmarks (or one)
+// host_tests --list            list everything
+int main(int argc, char** argv) {
+    bool bench = argc > 1 && strcmp(argv[1], "--bench") == 0;
+    const char* filter = argc > (bench ? 2 : 1) ? argv[bench ? 2 : 1] : nullptr;
+
+    if (filter && strcmp(filter, "--list") == 0) {
+        for (size_t i = 0; i < registry().size(); i++) {
+            const HostTestCase& test = registry()[i];
+            printf("%s.%s%s\n", test.suite, test.name, test.kind == HOST_TEST_XFAIL ? " (xfail)" : "");
+        }
+        return 0;
+    }
+
+    int run = 0;
+    int failed = 0;
+    for (size_t i = 0; i < registry().size(); i++) {
+        const HostTestCase& test = registry()[i];
+        if (!selected(test, bench, filter)) continue;
+
+        printf("[ RUN   ] %s.%s\n", test.suite, test.name);
+        fflush(stdout);
+        failures = 0;
+        test.function();
+        run++;
+
+        if (test.kind == HOST_TEST_XFAIL) {
+            if (failures > 0) {
+                printf("[ XFAIL ] %s.%s: %s\n", test.suite, test.name, test.reason);
+            } else {
+                printf("[ XPASS ] %s.%s: expected to fail (%s)\n", test.suite, test.name, test.reason);
+                failed++;
+            }
+        } else if (failures > 0) {
+            printf("[ FAIL  ] %s.%s\n", test.suite, test.name);
+            failed++;
+        } else {
+            printf("[    OK ] %s.%s\n", test.suite, test.name);
+        }
+    }
+
+    if (run == 0) {
+        printf("No %s matching \"%s\"\n", bench ? "benchmarks" : "tests", filter ? filter : "");
+        return 1;
+    }
+    printf("%d run, %d failed\n", run, failed);
+    return failed ? 1 : 0;
+}
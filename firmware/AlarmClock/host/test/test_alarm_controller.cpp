@@ -0,0 +1,126 @@
+#include "HostTest.h"
+#include "Fixtures.h"
+#include "AlarmController.h"
+#include "AudioModule.h"
+#include "FMRadioModule.h"
+#include "DisplayILI9341.h"
+#include "StorageModule.h"
+#include "TimeModule.h"
+#include <ezTime.h>
+#include <lwip/dns.h>
+
+// Alarms saved in storage ring on the TimeModule clock and start the
+// audio they were set up with, as in loop(): checkAlarms() then audio
+
+static const time_t MONDAY_0629_UTC = 1748845740;   // 2025-06-02 06:29:00
+
+struct AlarmRig {
+    StorageModule storage;
+    DisplayILI9341 display;
+    FMRadioModule fm;
+    AudioModule audio;
+    TimeModule time;
+    AlarmController alarms;
+
+    AlarmRig()
+        : display(-1, -1, -1, -1, -1, -1, -1), audio(-1, -1, -1, 21, 10),
+          alarms(&audio, &fm, &display, &storage) {
+        resetDevice();
+        hostEzTimeReset();
+        hostDnsReset();
+        storage.begin();
+        display.begin();
+        audio.begin();
+        time.setStorage(&storage);
+        time.begin("", "");
+    }
+
+    void saveAlarm(int index, uint8_t hour, uint8_t minute, AlarmSoundType sound) {
+        AlarmConfig alarm;
+        alarm.enabled = true;
+        alarm.hour = hour;
+        alarm.minute = minute;
+        alarm.repeatMode = ALARM_DAILY;
+        alarm.soundType = sound;
+        alarm.stationIndex = 0;
+        alarm.mp3File = "wake.mp3";
+        storage.saveAlarm(index, alarm);
+    }
+};
+
+static void writeFile(const char* path, size_t size) {
+    LittleFS.mkdir("/mp3");
+    File file = LittleFS.open(path, "w");
+    for (size_t i = 0; i < size; i++) file.write((uint8_t)i);
+    file.close();
+}
+
+TEST(AlarmController, ringsAtItsMinute) {
+    AlarmRig rig;
+    writeFile("/mp3/wake.mp3", 4096);
+    rig.saveAlarm(0, 6, 30, SOUND_MP3_FILE);
+    rig.alarms.begin();
+
+    UTC.setTime(MONDAY_0629_UTC);
+    rig.alarms.checkAlarms(&rig.time);
+    CHECK(!rig.alarms.isAlarmTriggered());
+    CHECK(!rig.audio.isMP3Playing());
+
+    hostClockAdvance(60 * 1000);
+    rig.alarms.checkAlarms(&rig.time);
+    CHECK(rig.alarms.isAlarmTriggered());
+    CHECK_EQ(rig.alarms.getTriggeredAlarmIndex(), 0);
+    CHECK(rig.audio.isMP3Playing());
+    CHECK_STR(rig.audio.getCurrentMP3File().c_str(), "wake.mp3");
+
+    // Today is recorded, so a reboot a second later doesn't ring again
+    AlarmConfig saved;
+    CHECK(rig.storage.loadAlarm(0, saved));
+    CHECK_EQ(saved.lastYear, 2025);
+    CHECK_EQ(saved.lastMonth, 6);
+    CHECK_EQ(saved.lastDay, 2);
+
+    rig.alarms.snoozeAlarm();
+    CHECK(rig.alarms.isAlarmSnoozed());
+    CHECK(!rig.audio.isMP3Playing());
+}
+
+TEST(AlarmController, followsTheTimezone) {
+    AlarmRig rig;
+    writeFile("/mp3/wake.mp3", 4096);
+    rig.saveAlarm(0, 8, 30, SOUND_MP3_FILE);
+    rig.alarms.begin();
+
+    // 06:29 UTC is 08:29 in Berlin in June
+    CHECK(rig.time.setTimezone("Europe/Berlin"));
+    UTC.setTime(MONDAY_0629_UTC);
+    rig.alarms.checkAlarms(&rig.time);
+    CHECK(!rig.alarms.isAlarmTriggered());
+
+    hostClockAdvance(60 * 1000);
+    rig.alarms.checkAlarms(&rig.time);
+    CHECK(rig.alarms.isAlarmTriggered());
+}
+
+TEST(AlarmController, stationAlarmStreamsOnceResolved) {
+    AlarmRig rig;
+    rig.storage.saveInternetStation(0, "Morning FM", "http://radio.example:8000/live");
+    rig.storage.publishInternetStations();
+    hostDnsAdd("radio.example", 0x0A00000A);
+    rig.saveAlarm(0, 6, 30, SOUND_INTERNET_RADIO);
+    rig.alarms.begin();
+
+    UTC.setTime(MONDAY_0629_UTC + 60);
+    rig.alarms.checkAlarms(&rig.time);
+    CHECK(rig.alarms.isAlarmTriggered());
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_RESOLVING);
+
+    CHECK_EQ(hostDnsAnswer(), 1);
+    for (int i = 0; i < 200 && rig.audio.getStreamState() != STREAM_PLAYING; i++) {
+        rig.audio.loop();
+        hostClockAdvance(10);
+    }
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_PLAYING);
+    CHECK(rig.audio.getIsPlaying());
+    CHECK_STR(rig.audio.getCurrentStationName().c_str(), "Morning FM");
+}
@@ -0,0 +1,180 @@
+#include "HostTest.h"
+#include "Fixtures.h"
+#include "StorageModule.h"
+
+// Alarms are one CRC-checked NVS blob each; older firmware's eleven keys
+// per alarm are migrated on first load
+
+static AlarmConfig makeAlarm(uint8_t hour, uint8_t minute, AlarmRepeat repeat, AlarmSoundType sound) {
+    AlarmConfig alarm;
+    alarm.enabled = true;
+    alarm.hour = hour;
+    alarm.minute = minute;
+    alarm.repeatMode = repeat;
+    alarm.soundType = sound;
+    alarm.stationIndex = 42;
+    alarm.fmFrequency = 101.7f;
+    alarm.mp3File = "birdsong.mp3";
+    alarm.lastYear = 2025;
+    alarm.lastMonth = 3;
+    alarm.lastDay = 30;
+    return alarm;
+}
+
+static void checkSameAlarm(const AlarmConfig& a, const AlarmConfig& b) {
+    CHECK_EQ(a.enabled, b.enabled);
+    CHECK_EQ(a.hour, b.hour);
+    CHECK_EQ(a.minute, b.minute);
+    CHECK_EQ(a.repeatMode, b.repeatMode);
+    CHECK_EQ(a.soundType, b.soundType);
+    CHECK_EQ(a.stationIndex, b.stationIndex);
+    CHECK(a.fmFrequency == b.fmFrequency);
+    CHECK_STR(a.mp3File.c_str(), b.mp3File.c_str());
+    CHECK_EQ(a.lastYear, b.lastYear);
+    CHECK_EQ(a.lastMonth, b.lastMonth);
+    CHECK_EQ(a.lastDay, b.lastDay);
+}
+
+TEST(AlarmRecords, roundTripAcrossReboot) {
+    resetDevice();
+    AlarmConfig saved[MAX_ALARMS] = {
+        makeAlarm(6, 45, ALARM_WEEKDAYS, SOUND_INTERNET_RADIO),
+        makeAlarm(9, 0, ALARM_WEEKENDS, SOUND_FM_RADIO),
+        makeAlarm(23, 59, ALARM_ONCE, SOUND_MP3_FILE),
+    };
+    saved[1].enabled = false;
+    {
+        StorageModule storage;
+        CHECK(storage.begin());
+        for (int i = 0; i < MAX_ALARMS; i++) CHECK(storage.saveAlarm(i, saved[i]));
+    }
+
+    StorageModule storage;
+    CHECK(storage.begin());
+    for (int i = 0; i < MAX_ALARMS; i++) {
+        AlarmConfig loaded;
+        CHECK(storage.loadAlarm(i, loaded));
+        checkSameAlarm(loaded, saved[i]);
+    }
+}
+
+TEST(AlarmRecords, oneFlashWritePerChange) {
+    resetDevice();
+    StorageModule storage;
+    storage.begin();
+    AlarmConfig alarm = makeAlarm(7, 30, ALARM_DAILY, SOUND_INTERNET_RADIO);
+
+    Preferences::hostResetCounters();
+    storage.saveAlarm(0, alarm);
+    storage.saveAlarm(0, alarm);        // Unchanged: no write
+    alarm.lastDay = 31;                 // What a trigger updates
+    storage.saveAlarm(0, alarm);
+    CHECK_EQ(Preferences::hostWrites(), 2);
+    CHECK(Preferences::hostBytesWritten() < 2 * 96);
+}
+
+TEST(AlarmRecords, missingAlarmLoadsDefaults) {
+    resetDevice();
+    StorageModule storage;
+    storage.begin();
+    AlarmConfig loaded = makeAlarm(1, 2, ALARM_ONCE, SOUND_MP3_FILE);
+    CHECK(storage.loadAlarm(2, loaded));
+    checkSameAlarm(loaded, AlarmConfig());
+    CHECK(!storage.loadAlarm(MAX_ALARMS, loaded));
+}
+
+TEST(AlarmRecords, longFileNameIsTruncated) {
+    resetDevice();
+    StorageModule storage;
+    storage.begin();
+    AlarmConfig alarm = makeAlarm(7, 0, ALARM_DAILY, SOUND_MP3_FILE);
+    alarm.mp3File = "a_very_long_alarm_sound_file_name_that_does_not_fit_the_record_field.mp3";
+    storage.saveAlarm(0, alarm);
+
+    AlarmConfig loaded;
+    storage.loadAlarm(0, loaded);
+    CHECK_EQ(loaded.mp3File.length(), 63);
+    CHECK(alarm.mp3File.startsWith(loaded.mp3File.c_str()));
+}
+
+TEST(AlarmRecords, corruptRecordIsRejected) {
+    resetDevice();
+    {
+        StorageModule storage;
+        storage.begin();
+        storage.saveAlarm(0, makeAlarm(5, 15, ALARM_DAILY, SOUND_FM_RADIO));
+    }
+
+    Preferences prefs;
+    prefs.begin("alarmclock");
+    uint8_t blob[96];
+    size_t len = prefs.getBytes("alm_0", blob, sizeof(blob));
+    CHECK(len > 8);
+    blob[3] ^= 0x01;                    // Minute 15 -> 14
+    prefs.putBytes("alm_0", blob, len);
+
+    StorageModule storage;
+    storage.begin();
+    AlarmConfig loaded = makeAlarm(1, 2, ALARM_ONCE, SOUND_MP3_FILE);
+    CHECK(!storage.loadAlarm(0, loaded));
+    checkSameAlarm(loaded, AlarmConfig());
+}
+
+// Keys and types exactly as the per-field firmware wrote them
+static void writeLegacyAlarm(Preferences& prefs, int index) {
+    char key[16];
+    snprintf(key, sizeof(key), "alm_%d_en", index);  prefs.putBool(key, true);
+    snprintf(key, sizeof(key), "alm_%d_h", index);   prefs.putUChar(key, 6);
+    snprintf(key, sizeof(key), "alm_%d_m", index);   prefs.putUChar(key, 10);
+    snprintf(key, sizeof(key), "alm_%d_rep", index); prefs.putUChar(key, ALARM_WEEKDAYS);
+    snprintf(key, sizeof(key), "alm_%d_snd", index); prefs.putUChar(key, SOUND_MP3_FILE);
+    snprintf(key, sizeof(key), "alm_%d_idx", index); prefs.putInt(key, 3);
+    snprintf(key, sizeof(key), "alm_%d_fm", index);  prefs.putFloat(key, 94.9f);
+    snprintf(key, sizeof(key), "alm_%d_mp3", index); prefs.putString(key, "rooster.mp3");
+    snprintf(key, sizeof(key), "alm_%d_yr", index);  prefs.putUShort(key, 2024);
+    snprintf(key, sizeof(key), "alm_%d_mon", index); prefs.putUChar(key, 11);
+    snprintf(key, sizeof(key), "alm_%d_day", index); prefs.putUChar(key, 5);
+}
+
+TEST(AlarmRecords, legacyKeysMigrateToOneRecord) {
+    resetDevice();
+    Preferences prefs;
+    prefs.begin("alarmclock");
+    writeLegacyAlarm(prefs, 1);
+    size_t freeBefore = prefs.freeEntries();
+
+    AlarmConfig expected;
+    expected.enabled = true;
+    expected.hour = 6;
+    expected.minute = 10;
+    expected.repeatMode = ALARM_WEEKDAYS;
+    expected.soundType = SOUND_MP3_FILE;
+    expected.stationIndex = 3;
+    expected.fmFrequency = 94.9f;
+    expected.mp3File = "rooster.mp3";
+    expected.lastYear = 2024;
+    expected.lastMonth = 11;
+    expected.lastDay = 5;
+    {
+        StorageModule storage;
+        storage.begin();
+        AlarmConfig loaded;
+        CHECK(storage.loadAlarm(1, loaded));
+        checkSameAlarm(loaded, expected);
+    }
+
+    CHECK(!prefs.isKey("alm_1_en"));
+    CHECK(!prefs.isKey("alm_1_mp3"));
+    CHECK(!prefs.isKey("alm_1_day"));
+    CHECK(prefs.isKey("alm_1"));
+    CHECK(prefs.freeEntries() > freeBefore);
+
+    // Second boot reads the record
+    Preferences::hostResetCounters();
+    StorageModule storage;
+    storage.begin();
+    AlarmConfig loaded;
+    CHECK(storage.loadAlarm(1, loaded));
+    checkSameAlarm(loaded, expected);
+    CHECK_EQ(Preferences::hostWrites(), 0);
+}
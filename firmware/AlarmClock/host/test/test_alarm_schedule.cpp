@@ -0,0 +1,148 @@
+#include "HostTest.h"
+#include "AlarmSchedule.h"
+#include "PosixTz.h"
+
+// Next-fire times on a simulated clock, through real zone rules: the clock
+// jumps from deadline to deadline the way AlarmController sleeps, and every
+// fire is checked against the local calendar
+
+static time_t utcAt(int year, int month, int day, int hour, int minute) {
+    return (time_t)daysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * 3600 + minute * 60;
+}
+
+static long localDay(PosixTz& tz, time_t utc) {
+    return (long)(tz.toLocal(utc) / SECONDS_PER_DAY);
+}
+
+static int localMinuteOfDay(PosixTz& tz, time_t utc) {
+    return (int)(tz.toLocal(utc) % SECONDS_PER_DAY / 60);
+}
+
+TEST(AlarmSchedule, calendarHelpers) {
+    CHECK_EQ(daysFromCivil(1970, 1, 1), 0);
+    CHECK_EQ(daysFromCivil(2024, 2, 29), 19782);
+    uint16_t y;
+    uint8_t m, d;
+    civilFromDays(19782, y, m, d);
+    CHECK_EQ(y, 2024);
+    CHECK_EQ(m, 2);
+    CHECK_EQ(d, 29);
+    CHECK_EQ(dayOfWeekFromDays(daysFromCivil(2025, 6, 2)), 1);   // Monday
+}
+
+TEST(AlarmSchedule, repeatRulesPickTheRightDays) {
+    PosixTz utc;
+    time_t friday = utcAt(2025, 6, 6, 8, 0);    // After 07:00
+
+    CHECK_EQ(alarmNextFire(7, 0, ALARM_DAILY, -1, friday, utc), utcAt(2025, 6, 7, 7, 0));
+    CHECK_EQ(alarmNextFire(7, 0, ALARM_WEEKDAYS, -1, friday, utc), utcAt(2025, 6, 9, 7, 0));
+    CHECK_EQ(alarmNextFire(7, 0, ALARM_WEEKENDS, -1, friday, utc), utcAt(2025, 6, 7, 7, 0));
+    CHECK_EQ(alarmNextFire(9, 30, ALARM_ONCE, -1, friday, utc), utcAt(2025, 6, 6, 9, 30));
+
+    // Sunday evening: weekends wait for Saturday, weekdays fire Monday
+    time_t sunday = utcAt(2025, 6, 8, 20, 0);
+    CHECK_EQ(alarmNextFire(7, 0, ALARM_WEEKENDS, -1, sunday, utc), utcAt(2025, 6, 14, 7, 0));
+    CHECK_EQ(alarmNextFire(7, 0, ALARM_WEEKDAYS, -1, sunday, utc), utcAt(2025, 6, 9, 7, 0));
+
+    // Exactly at the deadline still counts; the day it last rang doesn't
+    CHECK_EQ(alarmNextFire(8, 0, ALARM_DAILY, -1, friday, utc), friday);
+    long today = daysFromCivil(2025, 6, 6);
+    CHECK_EQ(alarmNextFire(8, 0, ALARM_DAILY, today, friday, utc), utcAt(2025, 6, 7, 8, 0));
+}
+
+TEST(AlarmSchedule, springForwardGapFiresAfterTheJump) {
+    PosixTz london;
+    CHECK(london.set("GMT0BST,M3.5.0/1,M10.5.0"));
+    // 2025-03-30: 01:00 GMT becomes 02:00 BST, so 01:30 never happens
+    time_t before = utcAt(2025, 3, 29, 23, 0);
+    time_t fire = alarmNextFire(1, 30, ALARM_DAILY, -1, before, london);
+    CHECK_EQ(fire, utcAt(2025, 3, 30, 1, 30));              // 02:30 BST
+    CHECK_EQ(localMinuteOfDay(london, fire), 2 * 60 + 30);
+
+    PosixTz newYork;
+    CHECK(newYork.set("EST5EDT,M3.2.0,M11.1.0"));
+    // 2025-03-09: 02:30 doesn't exist; fires at 03:30 EDT
+    fire = alarmNextFire(2, 30, ALARM_DAILY, -1, utcAt(2025, 3, 9, 5, 0), newYork);
+    CHECK_EQ(fire, utcAt(2025, 3, 9, 7, 30));
+    CHECK(newYork.isDstAt(fire));
+}
+
+TEST(AlarmSchedule, fallBackOverlapFiresOnce) {
+    PosixTz newYork;
+    newYork.set("EST5EDT,M3.2.0,M11.1.0");
+    // 2025-11-02: 01:30 happens in EDT and again in EST
+    time_t fire = alarmNextFire(1, 30, ALARM_DAILY, -1, utcAt(2025, 11, 2, 4, 0), newYork);
+    CHECK_EQ(fire, utcAt(2025, 11, 2, 5, 30));              // 01:30 EDT
+    CHECK(newYork.isDstAt(fire));
+
+    // After ringing, the repeat an hour later is the same local day: skipped
+    long rang = localDay(newYork, fire);
+    time_t next = alarmNextFire(1, 30, ALARM_DAILY, rang, fire + 1, newYork);
+    CHECK_EQ(next, utcAt(2025, 11, 3, 6, 30));              // Next day, EST
+}
+
+// Runs an alarm for a year the way AlarmController does: ring, remember the
+// local day, schedule from just after the deadline
+static void simulateYear(const char* posix, uint8_t hour, uint8_t minute, AlarmRepeat mode,
+                         int& fires, int& wrongTime, int& wrongDay, int& sameDayTwice) {
+    PosixTz tz;
+    CHECK(tz.set(posix));
+    time_t start = utcAt(2025, 1, 1, 0, 0);
+    time_t end = utcAt(2026, 1, 1, 0, 0);
+
+    fires = wrongTime = wrongDay = sameDayTwice = 0;
+    long lastDay = -1;
+    time_t now = start;
+    while (true) {
+        time_t fire = alarmNextFire(hour, minute, mode, lastDay, now, tz);
+        CHECK(fire > 0);
+        if (fire <= 0 || fire >= end) break;
+
+        long day = localDay(tz, fire);
+        if (localMinuteOfDay(tz, fire) != hour * 60 + minute) wrongTime++;
+        if (!alarmRunsOnDay(mode, dayOfWeekFromDays(day))) wrongDay++;
+        if (day == lastDay) sameDayTwice++;
+        fires++;
+
+        lastDay = day;
+        now = fire + 1;
+    }
+}
+
+TEST(AlarmSchedule, yearOfDailyAlarmsAcrossDstChanges) {
+    const char* zones[] = {
+        "GMT0BST,M3.5.0/1,M10.5.0",
+        "EST5EDT,M3.2.0,M11.1.0",
+        "AEST-10AEDT,M10.1.0,M4.1.0/3",     // Southern hemisphere
+        "<+0530>-5:30",
+    };
+    for (size_t i = 0; i < sizeof(zones) / sizeof(zones[0]); i++) {
+        int fires, wrongTime, wrongDay, twice;
+        simulateYear(zones[i], 7, 0, ALARM_DAILY, fires, wrongTime, wrongDay, twice);
+        CHECK_EQ(fires, 365);
+        CHECK_EQ(wrongTime, 0);
+        CHECK_EQ(twice, 0);
+
+        // Inside the overlap: still once a day
+        simulateYear(zones[i], 1, 30, ALARM_DAILY, fires, wrongTime, wrongDay, twice);
+        CHECK_EQ(fires, 365);
+        CHECK_EQ(twice, 0);
+    }
+}
+
+TEST(AlarmSchedule, yearOfWeekdayAndWeekendAlarms) {
+    int fires, wrongTime, wrongDay, twice;
+    simulateYear("CET-1CEST,M3.5.0,M10.5.0/3", 6, 30, ALARM_WEEKDAYS, fires, wrongTime, wrongDay, twice);
+    CHECK_EQ(fires, 261);       // 2025 has 261 weekdays
+    CHECK_EQ(wrongTime, 0);
+    CHECK_EQ(wrongDay, 0);
+
+    simulateYear("CET-1CEST,M3.5.0,M10.5.0/3", 9, 0, ALARM_WEEKENDS, fires, wrongTime, wrongDay, twice);
+    CHECK_EQ(fires, 104);
+    CHECK_EQ(wrongDay, 0);
+
+    // 02:30 in the spring gap: every fire but that one is on time
+    simulateYear("CET-1CEST,M3.5.0,M10.5.0/3", 2, 30, ALARM_DAILY, fires, wrongTime, wrongDay, twice);
+    CHECK_EQ(fires, 365);
+    CHECK_EQ(wrongTime, 1);
+}
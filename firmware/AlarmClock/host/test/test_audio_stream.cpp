@@ -0,0 +1,153 @@
+#include "HostTest.h"
+#include "Fixtures.h"
+#include "AudioModule.h"
+#include "StorageModule.h"
+#include <lwip/dns.h>
+
+// Station switches through the resolve/connect/prebuffer pipeline against
+// the stand-in station in the Audio shim, with DNS answered when the test
+// says, the way the audio task runs it: one loop() every few ms
+
+static const uint32_t LOOP_MS = 5;
+
+struct StreamRig {
+    StorageModule storage;
+    AudioModule audio;
+
+    StreamRig() : audio(-1, -1, -1, 21, 10) {
+        resetDevice();
+        hostDnsReset();
+        Audio::hostSetStation(true, 48, 0);
+        storage.begin();
+        storage.saveInternetStation(0, "North", "http://north.example:8000/live");
+        storage.saveInternetStation(1, "East", "http://east.example/stream.mp3");
+        storage.saveInternetStation(2, "West", "http://west.example/icy");
+        storage.publishInternetStations();
+        hostDnsAdd("north.example", 0x0A000001);
+        hostDnsAdd("east.example", 0x0A000002);
+        hostDnsAdd("west.example", 0x0A000003);
+        audio.begin();
+    }
+};
+
+struct SwitchCost {
+    uint32_t firstAudioMs;      // Switch to unmuted audio
+    uint32_t longestLoopMs;     // Longest the audio task was inside loop()
+};
+
+// Runs the audio task until the switch settles; lookups take dnsMs
+static SwitchCost runSwitch(AudioModule& audio, uint32_t dnsMs) {
+    SwitchCost cost = { 0, 0 };
+    uint32_t start = millis();
+    while (millis() - start < 10000) {
+        if (hostDnsPending() > 0 && millis() - start >= dnsMs) hostDnsAnswer();
+
+        uint32_t before = millis();
+        audio.loop();
+        uint32_t spent = millis() - before;
+        if (spent > cost.longestLoopMs) cost.longestLoopMs = spent;
+
+        StreamState state = audio.getStreamState();
+        if (state == STREAM_PLAYING || state == STREAM_FAILED) break;
+        hostClockAdvance(LOOP_MS);
+    }
+    cost.firstAudioMs = millis() - start;
+    return cost;
+}
+
+TEST(AudioStream, switchGoesThroughEachState) {
+    StreamRig rig;
+    rig.audio.playStation(0);
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_RESOLVING);
+    rig.audio.loop();
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_RESOLVING);
+
+    CHECK_EQ(hostDnsAnswer(), 1);
+    rig.audio.loop();
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_CONNECTING);
+    rig.audio.loop();
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_PREBUFFERING);
+
+    runSwitch(rig.audio, 0);
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_PLAYING);
+    CHECK_EQ(rig.audio.getPrebufferPercent(), 100);
+    CHECK(rig.audio.getIsPlaying());
+}
+
+TEST(AudioStream, answerForAnEarlierStationIsIgnored) {
+    StreamRig rig;
+    // The first station's lookup fails, but only after the switch away
+    hostDnsReset();
+    hostDnsAdd("east.example", 0x0A000002);
+    rig.audio.playStation(0);
+    rig.audio.loop();
+    rig.audio.playStation(1);
+    rig.audio.loop();
+    CHECK_EQ(hostDnsPending(), 2);
+
+    CHECK_EQ(hostDnsAnswer(), 2);
+    rig.audio.loop();
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_CONNECTING);
+    CHECK_STR(rig.audio.getStreamError(), "");
+}
+
+TEST(AudioStream, unknownHostFails) {
+    StreamRig rig;
+    rig.audio.playCustom("Nowhere", "http://nowhere.example/live");
+    runSwitch(rig.audio, 0);
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_FAILED);
+    CHECK_STR(rig.audio.getStreamError(), "Host not found");
+}
+
+TEST(AudioStream, refusedConnectFails) {
+    StreamRig rig;
+    Audio::hostSetStation(false, 48, 0);
+    rig.audio.playStation(2);
+    runSwitch(rig.audio, 0);
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_FAILED);
+    CHECK_STR(rig.audio.getStreamError(), "Could not connect");
+    CHECK(!rig.audio.getIsPlaying());
+}
+
+TEST(AudioStream, loopReturnsWhileResolving) {
+    StreamRig rig;
+    Audio::hostSetStation(true, 48, 300);
+    rig.audio.playStation(0);
+    SwitchCost cost = runSwitch(rig.audio, 200);
+    CHECK_EQ(rig.audio.getStreamState(), STREAM_PLAYING);
+    // Only the connect itself blocks the audio task
+    CHECK_EQ(cost.longestLoopMs, 300);
+    CHECK(cost.firstAudioMs >= 200 + 300);
+}
+
+// ===== TIME TO FIRST AUDIO =====
+
+BENCH(timeToFirstAudio) {
+    const uint32_t DNS_MS = 120;
+    const uint32_t CONNECT_MS = 250;
+    StreamRig rig;
+    Audio::hostSetStation(true, 48, CONNECT_MS);
+
+    rig.audio.playStation(0);
+    SwitchCost cold = runSwitch(rig.audio, DNS_MS);
+
+    // Neighbours were pre-resolved once the first station played
+    hostDnsAnswer();
+    rig.audio.nextStation();
+    SwitchCost warm = runSwitch(rig.audio, DNS_MS);
+
+    Audio::hostSetStation(true, 16, CONNECT_MS);
+    rig.audio.nextStation();
+    SwitchCost slow = runSwitch(rig.audio, DNS_MS);
+
+    printf("Virtual ms from switch to audio, %u ms lookups, %u ms connects, %u byte prebuffer:\n",
+           (unsigned)DNS_MS, (unsigned)CONNECT_MS, (unsigned)STREAM_PREBUFFER_BYTES);
+    printf("  cold lookup:          first audio %5u ms, longest loop() %4u ms\n",
+           (unsigned)cold.firstAudioMs, (unsigned)cold.longestLoopMs);
+    printf("  pre-resolved:         first audio %5u ms, longest loop() %4u ms\n",
+           (unsigned)warm.firstAudioMs, (unsigned)warm.longestLoopMs);
+    printf("  real-time station:    first audio %5u ms, longest loop() %4u ms\n",
+           (unsigned)slow.firstAudioMs, (unsigned)slow.longestLoopMs);
+    CHECK(warm.firstAudioMs + DNS_MS <= cold.firstAudioMs + LOOP_MS);
+    CHECK_EQ(cold.longestLoopMs, CONNECT_MS);
+}
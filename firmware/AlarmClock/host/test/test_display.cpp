@@ -0,0 +1,90 @@
+#include "HostTest.h"
+#include "DisplayILI9341.h"
+
+// The display driver against the framebuffer panel, which counts every
+// pixel sent to it
+
+// A menu screen as MenuSystem draws it: clear, then redraw everything
+static void drawMenu(DisplayILI9341& display, const char* title, bool withButton) {
+    display.beginFrame();
+    display.clear();
+    display.drawText(10, 10, title, TFT_WHITE, 2);
+    if (withButton) {
+        display.fillRect(20, 180, 120, 40, TFT_BLUE);
+        display.drawText(40, 190, "Save", TFT_WHITE, 1);
+    }
+    display.endFrame();
+}
+
+TEST(Display, unchangedFramePushesNothing) {
+    DisplayILI9341 display(-1, -1, -1, -1, -1, -1, -1);
+    display.begin();
+    CHECK(display.hasCompositor());
+    TFT_eSPI* panel = display.getTFT();
+
+    // First frame after begin(): the panel is unknown, so all of it is diffed
+    drawMenu(display, "Set Alarm", true);
+    CHECK_EQ(display.getLastFrameScanned(), 320 * 240);
+    CHECK_EQ(panel->readPixel(25, 185), TFT_BLUE);
+
+    // The same screen again: clear() only blanks what was drawn, so the diff
+    // covers the title and button, and nothing reaches the panel
+    panel->hostResetPixelsPushed();
+    drawMenu(display, "Set Alarm", true);
+    CHECK_EQ(display.getLastFramePixels(), 0);
+    CHECK_EQ(panel->hostPixelsPushed(), 0);
+    CHECK(display.getLastFrameScanned() > 0);
+    CHECK(display.getLastFrameScanned() < 320 * 240 / 4);
+}
+
+TEST(Display, changedFramePushesOnlyTheDifference) {
+    DisplayILI9341 display(-1, -1, -1, -1, -1, -1, -1);
+    display.begin();
+    TFT_eSPI* panel = display.getTFT();
+    drawMenu(display, "Set Alarm", true);
+
+    // One title glyph changes: at most its 16x32 cell goes out
+    panel->hostResetPixelsPushed();
+    drawMenu(display, "Set Alarn", true);
+    CHECK(panel->hostPixelsPushed() > 0);
+    CHECK(panel->hostPixelsPushed() <= 16 * 32);
+    CHECK_EQ(display.getLastFramePixels(), panel->hostPixelsPushed());
+
+    // Dropping the button blacks out exactly where it was
+    panel->hostResetPixelsPushed();
+    drawMenu(display, "Set Alarn", false);
+    CHECK_EQ(panel->readPixel(25, 185), TFT_BLACK);
+    CHECK(panel->hostPixelsPushed() <= 120 * 40);
+}
+
+// Clock pixels in the analog clock's bounding box (centre 240,70, radius 55)
+static int clockDifferences(TFT_eSPI* a, TFT_eSPI* b) {
+    int differences = 0;
+    for (int y = 70 - 55; y <= 70 + 55; y++) {
+        for (int x = 240 - 55; x <= 240 + 55; x++) {
+            if (a->readPixel(x, y) != b->readPixel(x, y)) differences++;
+        }
+    }
+    return differences;
+}
+
+TEST(Display, clockWithoutSpriteDrawsOnThePanel) {
+    DisplayILI9341 withSprite(-1, -1, -1, -1, -1, -1, -1);
+    withSprite.begin();
+
+    hostSetPsramFull(true);
+    DisplayILI9341 direct(-1, -1, -1, -1, -1, -1, -1);
+    direct.begin();
+    hostSetPsramFull(false);
+    CHECK(!direct.hasCompositor());
+
+    withSprite.updateTime(10, 8, 30);
+    direct.updateTime(10, 8, 30);
+    CHECK_EQ(direct.getTFT()->readPixel(240, 70), TFT_WHITE);   // Centre dot
+    CHECK_EQ(clockDifferences(withSprite.getTFT(), direct.getTFT()), 0);
+
+    // The next second erases the old hands too
+    withSprite.updateTime(10, 8, 31);
+    direct.updateTime(10, 8, 31);
+    CHECK_EQ(clockDifferences(withSprite.getTFT(), direct.getTFT()), 0);
+}
@@ -0,0 +1,255 @@
+#include "HostTest.h"
+#include "HtmlStream.h"
+#include <string>
+
+// Page responses drained the way AsyncTCP sends them: static sections are
+// read from flash in place, only formatted text is buffered, and every
+// buffer is freed once sent or when the client goes away
+
+// A page template the size of the settings page's static sections
+static std::string makeStatic(char fill, size_t size) {
+    std::string text = "<section>";
+    text.append(size - 20, fill);
+    text += "</section>\n";
+    return text;
+}
+
+static const std::string TOP = makeStatic('t', 6000);
+static const std::string MIDDLE = makeStatic('m', 3000);
+static const std::string BOTTOM = makeStatic('b', 4000);
+static const int ROWS = 150;
+
+enum PageBuild {
+    PAGE_COPIED,      // Static sections written as text
+    PAGE_FLASH,       // Static sections referenced, rows printed
+    PAGE_ROWS         // Static sections referenced, rows written when sent
+};
+
+static void sendSection(HtmlStream& out, const std::string& text, PageBuild build) {
+    if (build == PAGE_COPIED) out.write((const uint8_t*)text.data(), text.size());
+    else out.sendStatic(text.c_str());
+}
+
+static void sendTableRows(HtmlStream& out, int first, int end, PageBuild build) {
+    if (build == PAGE_ROWS) {
+        out.sendRows(end - first, [first](HtmlRowOut& row, int i) {
+            row.printf("<tr><td>%d</td><td>Station %d</td><td>http://stream%d.example/live</td></tr>\n",
+                       first + i, first + i, first + i);
+        });
+        return;
+    }
+    for (int i = first; i < end; i++) {
+        out.printf("<tr><td>%d</td><td>Station %d</td><td>http://stream%d.example/live</td></tr>\n", i, i, i);
+    }
+}
+
+// The page as a handler builds it
+static void buildPage(HtmlStream& out, PageBuild build) {
+    out.begin();
+    sendSection(out, TOP, build);
+    sendTableRows(out, 0, ROWS / 2, build);
+    sendSection(out, MIDDLE, build);
+    sendTableRows(out, ROWS / 2, ROWS, build);
+    sendSection(out, BOTTOM, build);
+    out.end();
+}
+
+static std::string expectedPage() {
+    std::string page = TOP;
+    char row[128];
+    for (int i = 0; i < ROWS; i++) {
+        if (i == ROWS / 2) page += MIDDLE;
+        snprintf(row, sizeof(row), "<tr><td>%d</td><td>Station %d</td><td>http://stream%d.example/live</td></tr>\n", i, i, i);
+        page += row;
+    }
+    return page + BOTTOM;
+}
+
+TEST(HtmlStream, pageReadsBackInOrder) {
+    const size_t windows[] = { 1, 7, 100, HOST_TCP_WINDOW, 70000 };
+    for (size_t i = 0; i < 3 * sizeof(windows) / sizeof(windows[0]); i++) {
+        AsyncWebServerRequest request(HTTP_GET, "/stations");
+        {
+            HtmlStream out(&request);
+            buildPage(out, (PageBuild)(i % 3));
+        }
+        AsyncWebServerResponse* response = request.hostResponse();
+        CHECK(response != nullptr);
+        CHECK_EQ(response->hostCode(), 200);
+        CHECK(response->hostChunked());
+        CHECK(response->hostDrain(windows[i / 3]) == expectedPage());
+        CHECK_EQ(HtmlStream::getHeldBytes(), 0);
+    }
+}
+
+TEST(HtmlStream, staticSectionsAreNotCopied) {
+    AsyncWebServerRequest request(HTTP_GET, "/settings");
+    HtmlStream::resetPeakBytes();
+    {
+        HtmlStream out(&request);
+        out.begin();
+        out.sendStatic(TOP.c_str());
+        out.sendStatic(MIDDLE.c_str());
+        out.sendStatic(BOTTOM.c_str());
+        out.print("<p>");
+        out.end();
+    }
+    // Three flash references and one block for "<p>"
+    CHECK(HtmlStream::getPeakBytes() < HTML_CHUNK_SIZE + 256);
+    CHECK(HtmlStream::getPeakBytes() < TOP.size());
+    CHECK(request.hostResponse()->hostDrain() == TOP + MIDDLE + BOTTOM + "<p>");
+}
+
+TEST(HtmlStream, disconnectFreesTheUnsentPage) {
+    AsyncWebServerRequest request(HTTP_GET, "/stations");
+    {
+        HtmlStream out(&request);
+        buildPage(out, PAGE_COPIED);
+    }
+    CHECK(HtmlStream::getHeldBytes() > TOP.size());
+
+    uint8_t window[HOST_TCP_WINDOW];
+    CHECK_EQ(request.hostResponse()->hostFill(window, sizeof(window)), sizeof(window));
+    request.hostDisconnect();
+    CHECK_EQ(HtmlStream::getHeldBytes(), 0);
+}
+
+TEST(HtmlStream, printfLongerThanTheStackBuffer) {
+    AsyncWebServerRequest request(HTTP_GET, "/");
+    std::string longText(HTML_FORMAT_SIZE * 3, 'x');
+    {
+        HtmlStream out(&request);
+        out.begin();
+        out.printf("<p>%s</p>", longText.c_str());
+        out.end();
+    }
+    CHECK(request.hostResponse()->hostDrain() == "<p>" + longText + "</p>");
+}
+
+TEST(HtmlStream, rowsAreWrittenAsTheyAreSent) {
+    AsyncWebServerRequest request(HTTP_GET, "/stations");
+    const int STATIONS = 250;
+    int written = 0;
+    HtmlStream::resetPeakBytes();
+    {
+        HtmlStream out(&request);
+        out.begin();
+        out.sendStatic(TOP.c_str());
+        out.sendRows(STATIONS, [&written](HtmlRowOut& row, int i) {
+            written++;
+            row.printf("<div class='station-card'><h3>Station %d</h3><p>http://stream%d.example/live</p></div>", i, i);
+        });
+        out.print("<p>end</p>");
+        out.end();
+    }
+    CHECK_EQ(written, 0);
+
+    std::string expected = TOP;
+    char row[128];
+    for (int i = 0; i < STATIONS; i++) {
+        snprintf(row, sizeof(row), "<div class='station-card'><h3>Station %d</h3><p>http://stream%d.example/live</p></div>", i, i);
+        expected += row;
+    }
+    expected += "<p>end</p>";
+    CHECK(expected.size() > 20000);
+
+    CHECK(request.hostResponse()->hostDrain() == expected);
+    CHECK_EQ(written, STATIONS);
+    CHECK(HtmlStream::getPeakBytes() < HTML_CHUNK_SIZE + HTML_ROW_MAX + HTML_CHUNK_SIZE + 512);
+    CHECK_EQ(HtmlStream::getHeldBytes(), 0);
+}
+
+TEST(HtmlStream, longRowIsCutAtTheRowLimit) {
+    AsyncWebServerRequest request(HTTP_GET, "/");
+    std::string longText(HTML_ROW_MAX * 2, 'x');
+    {
+        HtmlStream out(&request);
+        out.begin();
+        out.sendRows(2, [&longText](HtmlRowOut& row, int i) {
+            if (i == 0) row.printf("%s", longText.c_str());
+            else row.print("<p>");
+        });
+        out.end();
+    }
+    CHECK(request.hostResponse()->hostDrain() == std::string(HTML_ROW_MAX - 1, 'x') + "<p>");
+}
+
+TEST(HtmlStream, namesAreEscaped) {
+    uint8_t buffer[128];
+    HtmlRowOut row(buffer, sizeof(buffer));
+    htmlEscape(row, "Rock & Roll <Live> \"Best\" 'Mix'");
+    CHECK(std::string((char*)buffer, row.getLength()) ==
+          "Rock &amp; Roll &lt;Live&gt; &quot;Best&quot; &#39;Mix&#39;");
+
+    HtmlRowOut plain(buffer, sizeof(buffer));
+    CHECK_EQ(htmlEscape(plain, "wake.mp3"), 8);
+    CHECK_EQ(htmlEscape(plain, nullptr), 0);
+}
+
+TEST(HtmlStream, oversizedPageIsA500) {
+    AsyncWebServerRequest request(HTTP_GET, "/alarms");
+    std::string card(1000, 'c');
+    {
+        HtmlStream out(&request);
+        out.begin();
+        for (int i = 0; i < HTML_PAGE_MAX / 1000 + 1; i++) out.print(card.c_str());
+        out.end();
+    }
+    CHECK_EQ(request.hostResponse()->hostCode(), 500);
+    CHECK(!request.hostResponse()->hostChunked());
+    CHECK_EQ(HtmlStream::getHeldBytes(), 0);
+}
+
+// ===== PAGE BUFFERS =====
+
+struct PageCost {
+    size_t peakBytes;
+    double firstByteUs;
+    double totalUs;
+};
+
+// Handler start to the first TCP window filled, and to the last
+static PageCost servePages(PageBuild build, int pages) {
+    PageCost cost = { 0, 0, 0 };
+    uint8_t window[HOST_TCP_WINDOW];
+    for (int i = 0; i < pages; i++) {
+        AsyncWebServerRequest request(HTTP_GET, "/stations");
+        HtmlStream::resetPeakBytes();
+        uint64_t start = hostBenchNanos();
+        {
+            HtmlStream out(&request);
+            buildPage(out, build);
+        }
+        AsyncWebServerResponse* response = request.hostResponse();
+        response->hostFill(window, sizeof(window));
+        uint64_t firstByte = hostBenchNanos();
+        while (response->hostFill(window, sizeof(window)) > 0) {}
+        uint64_t done = hostBenchNanos();
+
+        if (HtmlStream::getPeakBytes() > cost.peakBytes) cost.peakBytes = HtmlStream::getPeakBytes();
+        cost.firstByteUs += (firstByte - start) / 1e3;
+        cost.totalUs += (done - start) / 1e3;
+    }
+    cost.firstByteUs /= pages;
+    cost.totalUs /= pages;
+    return cost;
+}
+
+BENCH(htmlStreamPage) {
+    const int PAGES = 2000;
+    PageCost copied = servePages(PAGE_COPIED, PAGES);
+    PageCost referenced = servePages(PAGE_FLASH, PAGES);
+    PageCost rows = servePages(PAGE_ROWS, PAGES);
+    size_t pageSize = expectedPage().size();
+
+    printf("%u byte page, %u bytes of it static, %u rows; mean of %d:\n", (unsigned)pageSize,
+           (unsigned)(TOP.size() + MIDDLE.size() + BOTTOM.size()), (unsigned)ROWS, PAGES);
+    printf("  static copied:     peak %6u bytes buffered, first byte %6.1f us, last byte %6.1f us\n",
+           (unsigned)copied.peakBytes, copied.firstByteUs, copied.totalUs);
+    printf("  static from flash: peak %6u bytes buffered, first byte %6.1f us, last byte %6.1f us\n",
+           (unsigned)referenced.peakBytes, referenced.firstByteUs, referenced.totalUs);
+    printf("  rows when sent:    peak %6u bytes buffered, first byte %6.1f us, last byte %6.1f us\n",
+           (unsigned)rows.peakBytes, rows.firstByteUs, rows.totalUs);
+    CHECK(referenced.peakBytes + TOP.size() + MIDDLE.size() < copied.peakBytes);
+    CHECK(rows.peakBytes < referenced.peakBytes / 2);
+}
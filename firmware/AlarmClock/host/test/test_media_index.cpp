@@ -0,0 +1,98 @@
+#include "HostTest.h"
+#include "Fixtures.h"
+#include "MediaIndex.h"
+#include "Mp3Files.h"
+
+// The /mp3/ index on the LittleFS directory: a scan probes new and changed
+// files, drops deleted ones and saves the listing for the next boot
+
+static void writeMp3(const char* path, const Bytes& bytes) {
+    LittleFS.mkdir("/mp3");
+    File file = LittleFS.open(path, "w");
+    file.write(bytes.data(), bytes.size());
+    file.close();
+}
+
+static Bytes titledMp3(const char* title, size_t frames) {
+    return concat(id3v2Tag(3, id3Frame(3, "TIT2", 0, latin1(title)), 32), mp3Frames(frames));
+}
+
+// Starts a scan and runs it to the end, one entry per loop() as on the device
+static int scanAll() {
+    MediaIndex::requestRescan();
+    MediaIndex::loop();
+    int steps = 0;
+    while (MediaIndex::isScanning() && steps < 1000) {
+        MediaIndex::loop();
+        steps++;
+    }
+    return steps;
+}
+
+TEST(MediaIndex, scanProbesMp3Files) {
+    resetDevice();
+    writeMp3("/mp3/wake.mp3", titledMp3("Rise & Shine", 100));
+    writeMp3("/mp3/Alpha.MP3", concat(mp3Frames(50), id3v1Tag("First Light")));
+    writeMp3("/mp3/notes.txt", latin1("not audio"));
+    CHECK(MediaIndex::begin());
+
+    // Three files and the end of the listing
+    CHECK_EQ(scanAll(), 4);
+    CHECK_EQ(MediaIndex::count(), 2);
+
+    // Sorted by name, case aside
+    const MediaEntry* first = MediaIndex::get(0);
+    CHECK_STR(first->name, "Alpha.MP3");
+    CHECK_STR(first->title, "First Light");
+    CHECK_EQ(first->durationMs, 50 * MP3_FRAME_BYTES * 8 / 128);
+
+    const MediaEntry* wake = MediaIndex::find("wake.mp3");
+    CHECK(wake != nullptr);
+    CHECK_STR(wake->title, "Rise & Shine");
+    CHECK_EQ(wake->bitrateKbps, 128);
+    CHECK(LittleFS.exists(MEDIA_INDEX_FILE));
+}
+
+TEST(MediaIndex, rescanFollowsChanges) {
+    resetDevice();
+    writeMp3("/mp3/a.mp3", titledMp3("Old A", 10));
+    writeMp3("/mp3/b.mp3", titledMp3("Old B", 10));
+    CHECK(MediaIndex::begin());
+    scanAll();
+    CHECK_EQ(MediaIndex::count(), 2);
+
+    LittleFS.remove("/mp3/a.mp3");
+    writeMp3("/mp3/b.mp3", titledMp3("New B", 20));
+    writeMp3("/mp3/c.mp3", titledMp3("C", 5));
+    scanAll();
+
+    CHECK_EQ(MediaIndex::count(), 2);
+    CHECK(MediaIndex::find("a.mp3") == nullptr);
+    CHECK_STR(MediaIndex::find("b.mp3")->title, "New B");
+    CHECK_EQ(MediaIndex::find("b.mp3")->durationMs, 20 * MP3_FRAME_BYTES * 8 / 128);
+    CHECK_STR(MediaIndex::find("c.mp3")->title, "C");
+
+    // Everything gone with the folder
+    LittleFS.remove("/mp3/b.mp3");
+    LittleFS.remove("/mp3/c.mp3");
+    LittleFS.remove("/mp3");
+    scanAll();
+    CHECK_EQ(MediaIndex::count(), 0);
+}
+
+TEST(MediaIndex, savedIndexIsLoadedAtBoot) {
+    resetDevice();
+    writeMp3("/mp3/wake.mp3", titledMp3("Rise & Shine", 100));
+    CHECK(MediaIndex::begin());
+    scanAll();
+
+    // Listed before any scan has run
+    CHECK(MediaIndex::begin());
+    CHECK(!MediaIndex::isScanning());
+    CHECK_EQ(MediaIndex::count(), 1);
+    CHECK_STR(MediaIndex::get(0)->title, "Rise & Shine");
+
+    // Unchanged files aren't probed again
+    scanAll();
+    CHECK_EQ(MediaIndex::count(), 1);
+}
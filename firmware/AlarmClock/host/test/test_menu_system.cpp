@@ -0,0 +1,81 @@
+#include "HostTest.h"
+#include "Fixtures.h"
+#include "MenuSystem.h"
+#include <ezTime.h>
+
+// The menu on the framebuffer panel, driven by buttons and touch the way
+// the UI task drives it: input first, then updateDisplay()
+
+struct MenuRig {
+    StorageModule storage;
+    DisplayILI9341 display;
+    FMRadioModule fm;
+    AudioModule audio;
+    TimeModule time;
+    TouchScreenModule touch;
+    MenuSystem menu;
+    UIState ui;
+
+    MenuRig()
+        : display(-1, -1, -1, -1, -1, -1, -1), audio(-1, -1, -1),
+          touch(display.getTFT()), menu(&display, &time, &fm, &audio, &storage, &touch) {
+        resetDevice();
+        hostEzTimeReset();
+        storage.begin();
+        display.begin();
+        touch.begin();
+        time.setStorage(&storage);
+        time.begin("", "");
+
+        ui.currentMenu = MENU_MAIN;
+        ui.selectedItem = 0;
+        ui.needsRedraw = true;
+        ui.lastButtonPress = 0;
+        menu.setUIState(&ui);
+    }
+
+    // Pixels sent to the panel by one UI pass
+    uint32_t frame() {
+        display.getTFT()->hostResetPixelsPushed();
+        menu.updateDisplay();
+        return display.getTFT()->hostPixelsPushed();
+    }
+};
+
+TEST(MenuSystem, clockScreenOnlyRedrawsWhatChanged) {
+    MenuRig rig;
+    UTC.setTime(1748845740);
+    rig.time.loop();
+    CHECK(rig.frame() > 0);
+    CHECK_EQ(rig.frame(), 0);
+}
+
+TEST(MenuSystem, setupButtonTogglesTheSetupScreen) {
+    MenuRig rig;
+    rig.frame();
+    rig.menu.handleButtons(false, false, false, false, true);
+    CHECK_EQ(rig.ui.currentMenu, MENU_SETUP);
+    CHECK(rig.frame() > 0);
+
+    rig.menu.handleButtons(false, false, false, false, true);
+    CHECK_EQ(rig.ui.currentMenu, MENU_MAIN);
+}
+
+TEST(MenuSystem, touchOnSetupOpensIt) {
+    MenuRig rig;
+    rig.frame();
+    hostClockAdvance(1000);
+
+    // Raw controller coordinates of the SETUP button, bottom right
+    rig.display.getTFT()->hostTouch(902, 770);
+    rig.menu.handleTouch();
+    rig.display.getTFT()->hostRelease();
+    CHECK_EQ(rig.ui.currentMenu, MENU_SETUP);
+
+    // Elsewhere on the clock face nothing happens
+    MenuRig other;
+    hostClockAdvance(1000);
+    other.display.getTFT()->hostTouch(2000, 2000);
+    other.menu.handleTouch();
+    CHECK_EQ(other.ui.currentMenu, MENU_MAIN);
+}
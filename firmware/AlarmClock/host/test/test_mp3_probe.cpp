@@ -0,0 +1,126 @@
+#include "HostTest.h"
+#include "Mp3Probe.h"
+#include "Mp3Files.h"
+
+// The MP3 header parser on byte buffers as MediaIndex reads them: the
+// first bytes of the file, its last 128, and the bytes after the ID3v2 tag
+
+static const size_t TITLE_MAX = 48;    // As MediaEntry holds it
+
+// ===== ID3 =====
+
+TEST(Mp3Probe, id3v2SizeIsSyncsafe) {
+    // 0x00 0x00 0x02 0x01 is 2 * 128 + 1, not 0x201
+    const uint8_t header[10] = { 'I', 'D', '3', 3, 0, 0, 0x00, 0x00, 0x02, 0x01 };
+    CHECK_EQ(mp3Id3v2Size(header, sizeof(header)), 10 + 257);
+
+    // A v2.4 footer adds another 10
+    const uint8_t footer[10] = { 'I', 'D', '3', 4, 0, 0x10, 0x00, 0x00, 0x01, 0x7F };
+    CHECK_EQ(mp3Id3v2Size(footer, sizeof(footer)), 10 + 255 + 10);
+
+    const uint8_t unknown[10] = { 'I', 'D', '3', 5, 0, 0, 0, 0, 0, 1 };
+    CHECK_EQ(mp3Id3v2Size(unknown, sizeof(unknown)), 0);
+    CHECK_EQ(mp3Id3v2Size((const uint8_t*)"\xFF\xFB\x90\x00", 4), 0);
+    CHECK_EQ(mp3Id3v2Size(header, 9), 0);
+}
+
+TEST(Mp3Probe, titleFromId3v23) {
+    Bytes tag = id3v2Tag(3, id3Frame(3, "TIT2", 0, latin1("Morning Song")), 64);
+    char title[TITLE_MAX];
+    CHECK(mp3Id3v2Title(tag.data(), tag.size(), title, sizeof(title)));
+    CHECK_STR(title, "Morning Song");
+}
+
+TEST(Mp3Probe, titleAfterALongFrameInId3v24) {
+    // 200 bytes: the frame size only reads right as syncsafe
+    Bytes artist(200, 'a');
+    Bytes frames = concat(id3Frame(4, "TPE1", 3, artist),
+                          id3Frame(4, "TIT2", 3, latin1("Caf\xC3\xA9 Radio")));
+    Bytes tag = id3v2Tag(4, frames);
+    char title[TITLE_MAX];
+    CHECK(mp3Id3v2Title(tag.data(), tag.size(), title, sizeof(title)));
+    CHECK_STR(title, "Caf\xC3\xA9 Radio");
+}
+
+TEST(Mp3Probe, titleTextEncodings) {
+    char title[TITLE_MAX];
+
+    // ISO-8859-1 comes out as UTF-8
+    Bytes tag = id3v2Tag(3, id3Frame(3, "TIT2", 0, latin1("Caf\xE9")));
+    CHECK(mp3Id3v2Title(tag.data(), tag.size(), title, sizeof(title)));
+    CHECK_STR(title, "Caf\xC3\xA9");
+
+    // UTF-16 with a little-endian BOM
+    const uint8_t utf16[] = { 0xFF, 0xFE, 'S', 0, 0xE9, 0, 0, 0 };
+    tag = id3v2Tag(3, id3Frame(3, "TIT2", 1, Bytes(utf16, utf16 + sizeof(utf16))));
+    CHECK(mp3Id3v2Title(tag.data(), tag.size(), title, sizeof(title)));
+    CHECK_STR(title, "S\xC3\xA9");
+
+    // Cut to the buffer
+    Bytes longTitle(100, 'x');
+    tag = id3v2Tag(3, id3Frame(3, "TIT2", 0, longTitle));
+    CHECK(mp3Id3v2Title(tag.data(), tag.size(), title, sizeof(title)));
+    CHECK_EQ(strlen(title), sizeof(title) - 1);
+}
+
+TEST(Mp3Probe, titleFromId3v1) {
+    Bytes file = concat(mp3Frames(2), id3v1Tag("Evening Tune"));
+    char title[TITLE_MAX];
+    CHECK(mp3Id3v1Title(file.data(), file.size(), title, sizeof(title)));
+    CHECK_STR(title, "Evening Tune");
+
+    CHECK(!mp3Id3v1Title(file.data(), file.size() - 1, title, sizeof(title)));
+    CHECK(!mp3Id3v1Title(file.data(), 100, title, sizeof(title)));
+}
+
+// ===== MPEG AUDIO =====
+
+TEST(Mp3Probe, cbrDurationFromSize) {
+    Bytes audio = mp3Frames(100);
+    Mp3Info info;
+    CHECK(mp3AudioInfo(audio.data(), audio.size(), audio.size(), info));
+    CHECK_EQ(info.bitrateKbps, 128);
+    CHECK_EQ(info.sampleRate, 44100);
+    CHECK(!info.vbr);
+    CHECK_EQ(info.durationMs, 100 * MP3_FRAME_BYTES * 8 / 128);
+}
+
+TEST(Mp3Probe, vbrDurationFromXing) {
+    Bytes audio = mp3Frames(5, 1000, 480000);
+    Mp3Info info;
+    CHECK(mp3AudioInfo(audio.data(), audio.size(), 480000, info));
+    CHECK(info.vbr);
+    CHECK_EQ(info.durationMs, 1000 * 1152 * 1000 / 44100);
+    CHECK_EQ(info.bitrateKbps, 480000 * 8 / (1000 * 1152 * 1000 / 44100));
+}
+
+TEST(Mp3Probe, junkBeforeTheFirstFrame) {
+    // A stray sync word that isn't followed by another frame
+    Bytes audio = concat(Bytes{ 0x00, 0xFF, 0xFB, 0x90, 0x00, 0x11 }, mp3Frames(3));
+    Mp3Info info;
+    CHECK(mp3AudioInfo(audio.data(), audio.size(), audio.size(), info));
+    CHECK_EQ(info.durationMs, (uint32_t)((audio.size() - 6) * 8 / 128));
+}
+
+TEST(Mp3Probe, truncatedBuffers) {
+    char title[TITLE_MAX];
+    Mp3Info info;
+
+    // Tag declares more than was read: the title is what arrived
+    Bytes tag = id3v2Tag(3, id3Frame(3, "TIT2", 0, latin1("Sunrise Sessions")), 512);
+    CHECK(mp3Id3v2Title(tag.data(), 10 + 10 + 1 + 7, title, sizeof(title)));
+    CHECK_STR(title, "Sunrise");
+    // Cut inside the frame header
+    CHECK(!mp3Id3v2Title(tag.data(), 15, title, sizeof(title)));
+
+    // A frame header with nothing after it
+    Bytes audio = mp3Frames(1, 1000, 480000);
+    CHECK(!mp3AudioInfo(audio.data(), 3, 3, info));
+    // Xing header cut off: treated as constant bitrate
+    CHECK(mp3AudioInfo(audio.data(), 40, 41700, info));
+    CHECK(!info.vbr);
+    CHECK_EQ(info.durationMs, 41700 * 8 / 128);
+
+    const uint8_t noise[64] = { 0 };
+    CHECK(!mp3AudioInfo(noise, sizeof(noise), sizeof(noise), info));
+}
@@ -0,0 +1,272 @@
+#include "HostTest.h"
+#include "NtpSync.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// The SNTP state machine against a scripted stand-in server, first through
+// a fake transport and then over real UDP on the loopback interface
+
+static void putBE32(uint8_t* p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+enum ServerMode {
+    SERVER_ANSWER,
+    SERVER_DROP,
+    SERVER_KISS,        // Stratum 0: kiss-o'-death
+    SERVER_UNSYNCED,    // Leap indicator 3
+    SERVER_STALE        // Answers with an origin that isn't our request's
+};
+
+// A server's reply to request, at unix time serverSeconds + 0.5 s
+static void buildReply(const uint8_t* request, uint8_t* reply, ServerMode mode, uint32_t serverSeconds) {
+    memset(reply, 0, NTP_PACKET_SIZE);
+    reply[0] = ((mode == SERVER_UNSYNCED ? 3 : 0) << 6) | (4 << 3) | 4;
+    reply[1] = mode == SERVER_KISS ? 0 : 2;
+    memcpy(reply + 24, request + 40, 8);            // Origin = client's transmit
+    if (mode == SERVER_STALE) reply[31] ^= 1;
+    putBE32(reply + 40, serverSeconds + NTP_UNIX_OFFSET);
+    putBE32(reply + 44, 0x80000000UL);
+}
+
+// Replies are queued at send() time and delivered on the next receive()
+class FakeTransport : public NtpTransport {
+public:
+    ServerMode mode;
+    bool sendFails;
+    uint32_t serverSeconds;
+    int sent;
+    uint8_t reply[NTP_PACKET_SIZE];
+    bool replyWaiting;
+
+    FakeTransport() : mode(SERVER_ANSWER), sendFails(false), serverSeconds(1750000000),
+                      sent(0), replyWaiting(false) {}
+
+    bool send(const uint8_t* packet, size_t len) override {
+        if (sendFails || len != NTP_PACKET_SIZE) return false;
+        sent++;
+        if (mode != SERVER_DROP) {
+            buildReply(packet, reply, mode, serverSeconds);
+            replyWaiting = true;
+        }
+        return true;
+    }
+
+    size_t receive(uint8_t* packet, size_t size) override {
+        if (!replyWaiting || size < NTP_PACKET_SIZE) return 0;
+        replyWaiting = false;
+        memcpy(packet, reply, NTP_PACKET_SIZE);
+        return NTP_PACKET_SIZE;
+    }
+};
+
+static NtpSync makeClient() {
+    NtpSync ntp;
+    ntp.configure(3600000, 1500, 2000, 600000);
+    return ntp;
+}
+
+TEST(NtpSync, firstReplySetsTheTime) {
+    FakeTransport server;
+    NtpSync ntp = makeClient();
+    NtpResult result;
+    ntp.begin(server, 1000);
+
+    CHECK(!ntp.poll(1000, result));     // Sends
+    CHECK_EQ(ntp.getState(), NTP_WAITING);
+    CHECK_EQ(server.sent, 1);
+    CHECK(ntp.poll(1040, result));      // Reply after 40 ms
+    CHECK_EQ(result.roundTripMs, 40);
+    CHECK_EQ(result.unixSeconds, 1750000000);
+    CHECK_EQ(result.millis, 520);       // 0.5 s plus half the round trip
+    CHECK(ntp.hasSynced());
+    CHECK_EQ(ntp.getState(), NTP_IDLE);
+    CHECK_EQ(ntp.msUntilNextAttempt(1040), 3600000);
+}
+
+TEST(NtpSync, timeoutsBackOffExponentially) {
+    FakeTransport server;
+    server.mode = SERVER_DROP;
+    NtpSync ntp = makeClient();
+    NtpResult result;
+    ntp.begin(server, 0);
+
+    // Send times over half an hour of 10 ms polls
+    uint32_t sendTimes[16];
+    int sends = 0;
+    for (uint32_t now = 0; now < 1800000 && sends < 16; now += 10) {
+        int before = server.sent;
+        CHECK(!ntp.poll(now, result));
+        if (server.sent != before) sendTimes[sends++] = now;
+    }
+    CHECK(sends >= 10);
+    // Timeout, then 2, 4, 8 ... s of backoff, capped at 10 minutes
+    uint32_t backoff = 2000;
+    for (int i = 1; i < sends; i++) {
+        CHECK_EQ(sendTimes[i] - sendTimes[i - 1], 1500 + backoff);
+        backoff = backoff * 2 < 600000 ? backoff * 2 : 600000;
+    }
+    CHECK_EQ(ntp.getState(), NTP_BACKOFF);
+    CHECK(!ntp.hasSynced());
+
+    // The server comes back: the next attempt syncs and clears the failures
+    server.mode = SERVER_ANSWER;
+    uint32_t now = sendTimes[sends - 1] + 1500 + 600000;
+    CHECK(!ntp.poll(now, result));
+    CHECK(ntp.poll(now + 10, result));
+    CHECK_EQ(ntp.getFailures(), 0);
+}
+
+TEST(NtpSync, kissOfDeathBacksOffFully) {
+    FakeTransport server;
+    server.mode = SERVER_KISS;
+    NtpSync ntp = makeClient();
+    NtpResult result;
+    ntp.begin(server, 0);
+    ntp.poll(0, result);
+    CHECK(!ntp.poll(10, result));
+    CHECK_EQ(ntp.getState(), NTP_BACKOFF);
+    CHECK_EQ(ntp.msUntilNextAttempt(10), 600000);
+}
+
+TEST(NtpSync, badRepliesAreNotTrusted) {
+    const ServerMode modes[] = { SERVER_UNSYNCED, SERVER_STALE };
+    for (size_t i = 0; i < 2; i++) {
+        FakeTransport server;
+        server.mode = modes[i];
+        NtpSync ntp = makeClient();
+        NtpResult result;
+        ntp.begin(server, 0);
+        ntp.poll(0, result);
+        CHECK(!ntp.poll(10, result));
+        CHECK_EQ(ntp.getState(), NTP_WAITING);  // Still waiting for a real answer
+        CHECK(!ntp.poll(1500, result));
+        CHECK_EQ(ntp.getFailures(), 1);
+    }
+}
+
+TEST(NtpSync, sendFailureIsRetriedLater) {
+    FakeTransport server;
+    server.sendFails = true;                     // No route, DNS not answered yet...
+    NtpSync ntp = makeClient();
+    NtpResult result;
+    ntp.begin(server, 0);
+    CHECK(!ntp.poll(0, result));
+    CHECK_EQ(ntp.getState(), NTP_BACKOFF);
+    CHECK_EQ(ntp.msUntilNextAttempt(0), 2000);
+
+    server.sendFails = false;
+    CHECK(!ntp.poll(1999, result));
+    CHECK_EQ(server.sent, 0);
+    CHECK(!ntp.poll(2000, result));
+    CHECK(ntp.poll(2010, result));
+}
+
+TEST(NtpSync, requestSyncDoesNotInterruptAWait) {
+    FakeTransport server;
+    server.mode = SERVER_DROP;
+    NtpSync ntp = makeClient();
+    NtpResult result;
+    ntp.begin(server, 0);
+    ntp.poll(0, result);
+    ntp.requestSync(100);
+    CHECK_EQ(ntp.getState(), NTP_WAITING);
+    ntp.poll(1500, result);                      // Times out
+    ntp.requestSync(1600);                       // Skips the backoff
+    ntp.poll(1600, result);
+    CHECK_EQ(server.sent, 2);
+}
+
+// ===== LOOPBACK =====
+
+// Non-blocking UDP socket on 127.0.0.1 with a kernel-chosen port
+static int openLoopback(sockaddr_in& address) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return -1;
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(address);
+    if (bind(fd, (sockaddr*)&address, len) != 0 || getsockname(fd, (sockaddr*)&address, &len) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// The device side: a UDP socket, as WiFiUDP is on the ESP32
+class UdpTransport : public NtpTransport {
+public:
+    int fd;
+    sockaddr_in local;
+    sockaddr_in server;
+
+    UdpTransport(const sockaddr_in& to) : fd(openLoopback(local)), server(to) {}
+    ~UdpTransport() { if (fd >= 0) close(fd); }
+
+    bool send(const uint8_t* packet, size_t len) override {
+        return sendto(fd, packet, len, 0, (const sockaddr*)&server, sizeof(server)) == (ssize_t)len;
+    }
+
+    size_t receive(uint8_t* packet, size_t size) override {
+        ssize_t n = recv(fd, packet, size, 0);
+        return n > 0 ? (size_t)n : 0;
+    }
+};
+
+// Answers waiting requests according to a script, one mode per request
+static void serveRequests(int fd, const ServerMode* script, int scriptLength, int& served) {
+    uint8_t request[NTP_PACKET_SIZE + 16];
+    sockaddr_in from;
+    socklen_t fromLen = sizeof(from);
+    ssize_t n;
+    while ((n = recvfrom(fd, request, sizeof(request), 0, (sockaddr*)&from, &fromLen)) > 0) {
+        ServerMode mode = served < scriptLength ? script[served] : SERVER_ANSWER;
+        served++;
+        if (n != NTP_PACKET_SIZE || (request[0] & 7) != 3 || mode == SERVER_DROP) continue;
+
+        uint8_t reply[NTP_PACKET_SIZE];
+        buildReply(request, reply, mode, 1750000000);
+        sendto(fd, reply, sizeof(reply), 0, (sockaddr*)&from, fromLen);
+    }
+}
+
+TEST(NtpSync, loopbackServerThatDropsThenAnswers) {
+    sockaddr_in serverAddress;
+    int serverFd = openLoopback(serverAddress);
+    CHECK(serverFd >= 0);
+    if (serverFd < 0) return;
+    UdpTransport udp(serverAddress);
+    CHECK(udp.fd >= 0);
+
+    const ServerMode script[] = { SERVER_DROP, SERVER_STALE, SERVER_KISS, SERVER_DROP };
+    int served = 0;
+    NtpSync ntp = makeClient();
+    NtpResult result;
+    ntp.begin(udp, 0);
+
+    // Virtual milliseconds; the datagrams are real
+    bool synced = false;
+    uint32_t now = 0;
+    for (; now < 3600000 && !synced; now += 10) {
+        synced = ntp.poll(now, result);
+        serveRequests(serverFd, script, 4, served);
+    }
+    close(serverFd);
+
+    CHECK(synced);
+    CHECK_EQ(served, 5);                // Four scripted failures, then an answer
+    CHECK_EQ(result.unixSeconds, 1750000000);
+    CHECK_EQ(ntp.getFailures(), 0);
+    CHECK_EQ(ntp.getRequests(), 5);
+    // Two timeouts (2 + 4 s), the kiss-o'-death's 10 minute cap, then a third
+    // timeout whose backoff keeps doubling (16 s): synced at about 626.5 s
+    CHECK(now > 626000 && now < 627000);
+}
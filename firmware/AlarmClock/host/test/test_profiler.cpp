@@ -0,0 +1,111 @@
+#include "HostTest.h"
+#include "Profiler.h"
+#include "DisplayILI9341.h"
+#include "FMRadioModule.h"
+#include "PosixTz.h"
+#include "TimeFormat.h"
+
+// Histograms from known samples, then the main loop's stages timed on the
+// host with the same profiler the firmware uses
+
+static const uint32_t CYCLES_PER_US = 240;
+
+// Print that keeps what is written, for the /metrics text
+class CapturePrint : public Print {
+public:
+    String text;
+    size_t write(uint8_t c) override { text += (char)c; return 1; }
+};
+
+TEST(Profiler, percentilesFromKnownSamples) {
+    Profiler::begin();
+    for (int i = 0; i < 98; i++) Profiler::record(PROF_DISPLAY, 10 * CYCLES_PER_US);
+    Profiler::record(PROF_DISPLAY, 1000 * CYCLES_PER_US);
+    Profiler::record(PROF_DISPLAY, 5000 * CYCLES_PER_US);
+
+    ProfileStats stats;
+    Profiler::getStats(PROF_DISPLAY, stats);
+    CHECK_EQ(stats.count, 100);
+    CHECK_EQ(stats.p50Us, 10);                      // Exact below 16 us
+    CHECK(stats.p99Us >= 896 && stats.p99Us <= 1000);   // Bucket lower bound, within 12.5%
+    CHECK_EQ(stats.maxUs, 5000);
+    CHECK_EQ(stats.totalUs, 98 * 10 + 1000 + 5000);
+
+    Profiler::getStats(PROF_ALARMS, stats);
+    CHECK_EQ(stats.count, 0);
+    CHECK_EQ(stats.p99Us, 0);
+}
+
+TEST(Profiler, metricsListEveryStage) {
+    Profiler::begin();
+    Profiler::record(PROF_TIME, 42 * CYCLES_PER_US);
+
+    CapturePrint out;
+    Profiler::writeMetrics(out);
+    CHECK(out.text.indexOf("loop_stage_latency_us{stage=\"time\",quantile=\"0.5\"} 40\n") >= 0);  // Bucket floor
+    CHECK(out.text.indexOf("loop_stage_latency_us{stage=\"time\",quantile=\"1\"} 42\n") >= 0);
+    CHECK(out.text.indexOf("loop_stage_latency_us_count{stage=\"alarms\"} 0\n") >= 0);
+    for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+        String label = String("stage=\"") + Profiler::stageName((ProfileStage)i) + "\"";
+        CHECK(out.text.indexOf(label.c_str()) >= 0);
+    }
+}
+
+// One simulated second of the main loop per iteration: the stages that do
+// real work on the host, timed with PROFILE_SCOPE as in AlarmClock.ino
+BENCH(loopStages) {
+    DisplayILI9341 display(-1, -1, -1, -1, -1, -1, -1);
+    display.begin();
+    FMRadioModule fm;
+    fm.begin();
+    PosixTz tz;
+    tz.set("CET-1CEST,M3.5.0,M10.5.0/3");
+
+    const int ITERATIONS = 2000;
+    time_t epoch = 1735689600;    // 2025-01-01 00:00 UTC
+    TimeSnapshot now;
+    char text[FULL_DATE_TEXT_SIZE];
+    uint32_t checksum = 0;
+
+    Profiler::begin();
+    uint64_t start = hostBenchNanos();
+    for (int i = 0; i < ITERATIONS; i++, epoch++) {
+        {
+            PROFILE_SCOPE(PROF_TIME);
+            makeTimeSnapshot(epoch, tz, now);
+            formatClockTime(now, text);
+        }
+        {
+            PROFILE_SCOPE(PROF_RDS);
+            checksum += fm.getRSSI() + fm.getRdsReceived();
+        }
+        {
+            PROFILE_SCOPE(PROF_DISPLAY);
+            display.updateTime(now.hour, now.minute, now.second);
+            display.beginFrame();
+            display.clear();
+            display.drawText(10, 10, text, TFT_WHITE, 2);
+            formatFullDate(now, text);
+            display.drawText(10, 50, text, TFT_CYAN, 1);
+            display.endFrame();
+        }
+        {
+            PROFILE_SCOPE(PROF_ALARMS);
+            for (uint8_t a = 0; a < 10; a++) {
+                checksum += (uint32_t)alarmNextFire(6 + a, 15, (AlarmRepeat)(a % 4), -1, epoch, tz);
+            }
+        }
+        hostClockAdvance(1000);
+    }
+    uint64_t elapsed = hostBenchNanos() - start;
+
+    Serial.setEcho(true);
+    Profiler::dump();
+    Serial.setEcho(false);
+    printf("%d iterations, %.1f us each (checksum %u)\n",
+           ITERATIONS, elapsed / 1000.0 / ITERATIONS, checksum);
+
+    ProfileStats stats;
+    Profiler::getStats(PROF_DISPLAY, stats);
+    CHECK_EQ(stats.count, ITERATIONS);
+}
@@ -0,0 +1,136 @@
+#include "HostTest.h"
+#include "Fixtures.h"
+#include <esp_system.h>
+#include "StorageModule.h"
+
+// Flash writes for scripted usage sessions: the settings go through
+// StorageModule as the UI and web handlers use it, with loop() polled the
+// way the storage task does, and the NVS shim counts what reaches flash
+
+static const uint32_t LOOP_MS = 50;
+
+// Let the storage task run for a while with no changes
+static void idle(StorageModule& storage, uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += LOOP_MS) {
+        storage.loop();
+        delay(LOOP_MS);
+    }
+}
+
+static void freshStorage(StorageModule& storage) {
+    resetDevice();
+    CHECK(storage.begin());
+    storage.flushSettings();
+    Preferences::hostResetCounters();
+}
+
+TEST(SettingsJournal, volumePotDragIsOneWrite) {
+    StorageModule storage;
+    freshStorage(storage);
+
+    // Ten seconds of turning the pot, a new reading every loop
+    for (int i = 0; i < 200; i++) {
+        storage.saveVolume(i * 21 / 200);
+        storage.loop();
+        delay(LOOP_MS);
+    }
+    CHECK_EQ(Preferences::hostWrites(), 0);     // Still moving
+    idle(storage, 5000);
+    CHECK_EQ(Preferences::hostWrites(), 1);
+    CHECK_EQ(Preferences::hostBytesWritten(), sizeof(SettingsRecord));
+    CHECK_EQ(storage.loadVolume(), 20);
+}
+
+TEST(SettingsJournal, brightnessPressesAreOneWrite) {
+    StorageModule storage;
+    freshStorage(storage);
+
+    for (int press = 1; press <= 6; press++) {
+        storage.saveBrightness(press * 40);
+        idle(storage, 700);
+    }
+    idle(storage, 60000);
+    CHECK_EQ(Preferences::hostWrites(), 1);
+    CHECK_EQ(storage.loadBrightness(), 240);
+}
+
+TEST(SettingsJournal, steadyEditsAreRateLimited) {
+    StorageModule storage;
+    freshStorage(storage);
+
+    // A change every 4 s for two minutes: quiet long enough each time, so
+    // only the minimum interval holds the writes back
+    for (int i = 0; i < 30; i++) {
+        storage.saveVolume(i % 21);
+        idle(storage, 4000);
+    }
+    CHECK(Preferences::hostWrites() <= 120000 / SETTINGS_MIN_INTERVAL_MS + 1);
+    CHECK(Preferences::hostWrites() >= 3);
+}
+
+TEST(SettingsJournal, webSettingsSaveIsOneWrite) {
+    StorageModule storage;
+    freshStorage(storage);
+
+    // What the settings form's handlers store, then the explicit flush
+    FeatureFlags flags;
+    flags.enableStereo = true;
+    flags.enableLED = false;
+    storage.saveConfig(6, 30, true, 98.5f);
+    storage.saveFeatureFlags(flags);
+    storage.saveTimezone(3600, 3600);
+    storage.saveAudioMode(true);
+    CHECK(storage.flushSettings());
+    idle(storage, 60000);
+    CHECK_EQ(Preferences::hostWrites(), 1);
+
+    FeatureFlags loaded;
+    storage.loadFeatureFlags(loaded);
+    CHECK(loaded.enableStereo);
+    CHECK(!loaded.enableLED);
+    CHECK(storage.loadAudioMode());
+}
+
+TEST(SettingsJournal, restartFlushesPendingSettings) {
+    resetDevice();
+    {
+        StorageModule storage;
+        storage.begin();
+        storage.saveVolume(17);
+        Preferences::hostResetCounters();
+        hostRunShutdownHandlers();      // What esp_restart() runs
+        CHECK_EQ(Preferences::hostWrites(), 1);
+    }
+
+    StorageModule storage;
+    storage.begin();
+    CHECK_EQ(storage.loadVolume(), 17);
+}
+
+TEST(SettingsJournal, tornWriteKeepsThePreviousCommit) {
+    resetDevice();
+    {
+        StorageModule storage;
+        storage.begin();
+        storage.saveVolume(5);
+        storage.flushSettings();
+        storage.saveVolume(12);
+        storage.flushSettings();
+    }
+
+    // Damage whichever slot holds the newer record, as a power cut mid-write would
+    Preferences prefs;
+    prefs.begin("alarmclock");
+    SettingsRecord a, b;
+    CHECK_EQ(prefs.getBytes("cfg_a", &a, sizeof(a)), sizeof(a));
+    CHECK_EQ(prefs.getBytes("cfg_b", &b, sizeof(b)), sizeof(b));
+    const char* newer = a.sequence > b.sequence ? "cfg_a" : "cfg_b";
+    SettingsRecord torn = a.sequence > b.sequence ? a : b;
+    CHECK_EQ(torn.data.volume, 12);
+    torn.data.volume ^= 0x40;
+    prefs.putBytes(newer, &torn, sizeof(torn));
+
+    StorageModule storage;
+    storage.begin();
+    CHECK_EQ(storage.loadVolume(), 5);
+}
@@ -0,0 +1,116 @@
+#include "HostTest.h"
+#include <Arduino.h>
+#include <Preferences.h>
+#include <LittleFS.h>
+#include <TFT_eSPI.h>
+#include "FMRadioModule.h"
+
+// The stand-ins themselves: if these drift from the real libraries, every
+// other suite tests the wrong thing
+
+TEST(Shims, virtualClockOnlyMovesWhenTold) {
+    hostClockSet(0);
+    CHECK_EQ(millis(), 0);
+    delay(1500);
+    CHECK_EQ(millis(), 1500);
+    hostClockAdvanceMicros(250);
+    CHECK_EQ(micros(), 1500250);
+    CHECK_EQ(millis(), 1500);
+}
+
+TEST(Shims, nvsKeepsValuesAcrossInstances) {
+    Preferences::hostErase();
+    {
+        Preferences prefs;
+        CHECK(prefs.begin("shimtest"));
+        CHECK_EQ(prefs.putUChar("volume", 7), 1);
+        CHECK_EQ(prefs.putString("name", "Radio 4"), 7);
+        CHECK_EQ(prefs.putBytes("this_key_is_too_long", "x", 1), 0);
+    }
+    Preferences prefs;
+    prefs.begin("shimtest", true);
+    CHECK_EQ(prefs.getUChar("volume", 3), 7);
+    CHECK_STR(prefs.getString("name", "").c_str(), "Radio 4");
+    CHECK_EQ(prefs.getInt("volume", -1), -1);   // Stored as one byte, not an int
+    CHECK(!prefs.isKey("missing"));
+    CHECK_EQ(prefs.putUChar("volume", 9), 0);   // Read-only
+}
+
+TEST(Shims, nvsCountsOnlyChangedWrites) {
+    Preferences::hostErase();
+    Preferences prefs;
+    prefs.begin("shimtest");
+    prefs.putULong("epoch", 1000);
+    prefs.putULong("epoch", 1000);
+    prefs.putULong("epoch", 1001);
+    CHECK_EQ(Preferences::hostWrites(), 2);
+    CHECK_EQ(Preferences::hostBytesWritten(), 8);
+}
+
+TEST(Shims, littleFsLivesInADirectory) {
+    CHECK(LittleFS.begin(true, HOST_TEST_DATA_DIR "/shimfs"));
+    File file = LittleFS.open("/hello.txt", "w");
+    CHECK((bool)file);
+    file.printf("%.1f,%s\n", 98.5, "Jazz");
+    file.close();
+
+    // The same file through stdio, as the catalog code reads it
+    FILE* fp = fopen(LittleFS.hostPath("/hello.txt").c_str(), "r");
+    CHECK(fp != nullptr);
+    if (fp) fclose(fp);
+
+    file = LittleFS.open("/hello.txt", "r");
+    String line = file.readStringUntil('\n');
+    CHECK_EQ(file.available(), 0);
+    file.close();
+    CHECK_STR(line.c_str(), "98.5,Jazz");
+    CHECK(LittleFS.remove("/hello.txt"));
+    CHECK(!LittleFS.exists("/hello.txt"));
+}
+
+TEST(Shims, framebufferCountsPixelsSentToThePanel) {
+    TFT_eSPI tft;
+    tft.init();
+    tft.setRotation(1);
+    CHECK_EQ(tft.width(), 320);
+    CHECK_EQ(tft.height(), 240);
+
+    tft.fillRect(310, 230, 20, 20, TFT_RED);    // Clipped to 10x10
+    CHECK_EQ(tft.hostPixelsPushed(), 100);
+    CHECK_EQ(tft.readPixel(319, 239), TFT_RED);
+
+    TFT_eSprite sprite(&tft);
+    CHECK(sprite.createSprite(20, 10) != nullptr);
+    sprite.fillSprite(TFT_BLUE);
+    CHECK_EQ(tft.hostPixelsPushed(), 100);      // Drawing into a sprite is free
+    sprite.pushSprite(0, 0, 5, 0, 10, 10);
+    CHECK_EQ(tft.hostPixelsPushed(), 200);
+    CHECK_EQ(tft.readPixel(0, 0), TFT_BLUE);
+    CHECK_EQ(tft.readPixel(10, 0), TFT_BLACK);
+}
+
+TEST(Shims, textDamagesItsCell) {
+    TFT_eSPI tft;
+    tft.setRotation(1);
+    tft.setCursor(10, 20, 2);
+    tft.setTextSize(2);
+    tft.setTextColor(TFT_WHITE, TFT_NAVY);
+    CHECK_EQ(tft.textWidth("12:34"), 80);
+    CHECK_EQ(tft.fontHeight(), 32);
+    tft.print("12:34");
+    CHECK_EQ(tft.getCursorX(), 90);
+    CHECK_EQ(tft.readPixel(89, 51), TFT_NAVY);
+    CHECK_EQ(tft.readPixel(90, 20), TFT_BLACK);
+}
+
+TEST(Shims, fmRadioTunesTheFakeChip) {
+    FMRadioModule fm;
+    CHECK(fm.begin());
+    CHECK(fm.getFrequency() > 97.95 && fm.getFrequency() < 98.05);
+
+    fm.setFrequency(108.0);
+    fm.seekUp();    // Wraps to the bottom of the band
+    CHECK(fm.getFrequency() > 87.45 && fm.getFrequency() < 87.55);
+    fm.seekDown();
+    CHECK(fm.getFrequency() > 107.95);
+}
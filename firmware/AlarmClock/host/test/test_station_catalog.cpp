@@ -0,0 +1,266 @@
+#include "HostTest.h"
+#include "Fixtures.h"
+#include "StationCatalog.h"
+#include "StationTable.h"
+#include "StorageModule.h"
+#include <unistd.h>
+
+// The station catalog file: fixed index, string pool, tombstones and
+// compaction, and StorageModule's use of it
+
+#define CATALOG_TEST_FILE LITTLEFS_BASE_PATH "/test.cat"
+
+static void stationName(int i, char* out, size_t size) {
+    snprintf(out, size, "Station %03d", i);
+}
+
+static void stationUrl(int i, char* out, size_t size) {
+    snprintf(out, size, "http://stream%d.example.com:8000/live.mp3", i);
+}
+
+static void fillCatalog(StationCatalog& catalog, int count) {
+    char name[CATALOG_NAME_MAX], url[CATALOG_URL_MAX];
+    for (int i = 0; i < count; i++) {
+        stationName(i, name, sizeof(name));
+        stationUrl(i, url, sizeof(url));
+        CHECK(catalog.add(name, url));
+    }
+}
+
+// Station i of the catalog is what fillCatalog() added as number expected
+static bool stationIs(StationCatalog& catalog, int i, int expected) {
+    char name[CATALOG_NAME_MAX], url[CATALOG_URL_MAX];
+    char wantName[CATALOG_NAME_MAX], wantUrl[CATALOG_URL_MAX];
+    if (!catalog.get(i, name, sizeof(name), url, sizeof(url))) return false;
+    stationName(expected, wantName, sizeof(wantName));
+    stationUrl(expected, wantUrl, sizeof(wantUrl));
+    return strcmp(name, wantName) == 0 && strcmp(url, wantUrl) == 0;
+}
+
+TEST(StationCatalog, hundredsOfStationsSurviveReopen) {
+    resetDevice();
+    {
+        StationCatalog catalog;
+        CHECK(catalog.open(CATALOG_TEST_FILE));
+        CHECK_EQ(catalog.count(), 0);
+        fillCatalog(catalog, 300);      // Index grows 32 -> 512
+    }
+
+    StationCatalog catalog;
+    CHECK(catalog.open(CATALOG_TEST_FILE));
+    CHECK_EQ(catalog.count(), 300);
+    CHECK(stationIs(catalog, 0, 0));
+    CHECK(stationIs(catalog, 299, 299));
+
+    size_t nameLen, urlLen;
+    CHECK(catalog.getLengths(42, nameLen, urlLen));
+    CHECK_EQ(nameLen, strlen("Station 042"));
+    CHECK_EQ(urlLen, strlen("http://stream42.example.com:8000/live.mp3"));
+    CHECK(!catalog.getLengths(300, nameLen, urlLen));
+}
+
+TEST(StationCatalog, deleteLeavesATombstoneAndShiftsIndices) {
+    resetDevice();
+    StationCatalog catalog;
+    catalog.open(CATALOG_TEST_FILE);
+    fillCatalog(catalog, 10);
+    uint32_t size = catalog.getFileSize();
+
+    CHECK(catalog.remove(2));
+    CHECK_EQ(catalog.count(), 9);
+    CHECK(stationIs(catalog, 1, 1));
+    CHECK(stationIs(catalog, 2, 3));            // Old 3 is the new 2
+    CHECK_EQ(catalog.getFileSize(), size);       // Nothing moved on flash
+    CHECK(catalog.getGarbageBytes() > 0);
+    CHECK(!catalog.remove(9));
+
+    // Still gone after a reboot
+    catalog.close();
+    catalog.open(CATALOG_TEST_FILE);
+    CHECK_EQ(catalog.count(), 9);
+    CHECK(stationIs(catalog, 2, 3));
+}
+
+TEST(StationCatalog, updateAppendsAndCompactReclaims) {
+    resetDevice();
+    StationCatalog catalog;
+    catalog.open(CATALOG_TEST_FILE);
+    fillCatalog(catalog, 4);
+
+    CHECK(catalog.update(1, "Jazz FM", "http://jazz.example.com/stream"));
+    char name[CATALOG_NAME_MAX], url[CATALOG_URL_MAX];
+    CHECK(catalog.get(1, name, sizeof(name), url, sizeof(url)));
+    CHECK_STR(name, "Jazz FM");
+    CHECK_STR(url, "http://jazz.example.com/stream");
+    CHECK(catalog.getGarbageBytes() > 0);
+
+    uint32_t before = catalog.getFileSize();
+    CHECK(catalog.compact());
+    CHECK_EQ(catalog.getGarbageBytes(), 0);
+    CHECK(catalog.getFileSize() < before);
+    CHECK_EQ(catalog.count(), 4);
+    CHECK(stationIs(catalog, 0, 0));
+    CHECK(catalog.get(1, name, sizeof(name), url, sizeof(url)));
+    CHECK_STR(name, "Jazz FM");
+    CHECK(stationIs(catalog, 3, 3));
+}
+
+TEST(StationCatalog, churnStaysCompact) {
+    resetDevice();
+    StationCatalog catalog;
+    catalog.open(CATALOG_TEST_FILE);
+    fillCatalog(catalog, 20);
+
+    // A thousand edits: automatic compaction keeps dead bytes bounded
+    for (int i = 0; i < 1000; i++) {
+        CHECK(catalog.remove(0));
+        char name[CATALOG_NAME_MAX], url[CATALOG_URL_MAX];
+        stationName(20 + i, name, sizeof(name));
+        stationUrl(20 + i, url, sizeof(url));
+        CHECK(catalog.add(name, url));
+    }
+    CHECK_EQ(catalog.count(), 20);
+    CHECK(stationIs(catalog, 0, 1000));
+    CHECK(stationIs(catalog, 19, 1019));
+    CHECK(catalog.getGarbageBytes() <= catalog.getFileSize() / 2);
+    CHECK(catalog.getFileSize() < 20 * 4096);
+}
+
+TEST(StationCatalog, badInputAndBadFiles) {
+    resetDevice();
+    StationCatalog catalog;
+    catalog.open(CATALOG_TEST_FILE);
+    char longName[CATALOG_NAME_MAX + 1];
+    memset(longName, 'x', CATALOG_NAME_MAX);
+    longName[CATALOG_NAME_MAX] = '\0';
+    CHECK(!catalog.add("", "http://a"));
+    CHECK(!catalog.add(longName, "http://a"));
+    CHECK_EQ(catalog.count(), 0);
+
+    // Short buffers are filled and terminated, not overrun
+    CHECK(catalog.add("A long station name", "http://example.com/stream"));
+    char name[8], url[12];
+    CHECK(catalog.get(0, name, sizeof(name), url, sizeof(url)));
+    CHECK_STR(name, "A long ");
+    CHECK_STR(url, "http://exam");
+    catalog.close();
+
+    // A file that isn't a catalog is replaced by an empty one
+    FILE* fp = fopen(CATALOG_TEST_FILE, "wb");
+    fputs("not a catalog at all", fp);
+    fclose(fp);
+    CHECK(catalog.open(CATALOG_TEST_FILE));
+    CHECK_EQ(catalog.count(), 0);
+    CHECK(catalog.add("Radio", "http://radio"));
+}
+
+// Two stations the way firmware before the catalog stored them
+static void writeLegacyStations() {
+    Preferences prefs;
+    prefs.begin("alarmclock");
+    prefs.putInt("inet_count", 2);
+    prefs.putString("inet_n_0", "BBC Radio 4");
+    prefs.putString("inet_u_0", "http://bbc.example/r4");
+    prefs.putString("inet_n_1", "KEXP");
+    prefs.putString("inet_u_1", "http://kexp.example/live");
+}
+
+static bool legacyStationsKept() {
+    Preferences prefs;
+    prefs.begin("alarmclock", true);
+    return prefs.isKey("inet_count") && prefs.isKey("inet_n_1") && prefs.isKey("inet_u_1");
+}
+
+TEST(StationCatalog, storageMigratesNvsStationsAndPublishes) {
+    resetDevice();
+    writeLegacyStations();
+
+    StorageModule storage;
+    CHECK(storage.begin());
+    CHECK_EQ(storage.getInternetStationCount(), 2);
+    Preferences prefs;
+    prefs.begin("alarmclock", true);
+    CHECK(!prefs.isKey("inet_n_0"));
+    CHECK(!prefs.isKey("inet_count"));
+
+    CHECK(storage.publishInternetStations());
+    {
+        StationTableRef stations;
+        CHECK_EQ(stations.count(), 2);
+        CHECK_STR(stations.getName(1), "KEXP");
+        CHECK_STR(stations.get(0)->url.data, "http://bbc.example/r4");
+    }
+
+    // Up to MAX_INTERNET_STATIONS, then refused
+    char name[CATALOG_NAME_MAX], url[CATALOG_URL_MAX];
+    for (int i = 2; i < MAX_INTERNET_STATIONS; i++) {
+        stationName(i, name, sizeof(name));
+        stationUrl(i, url, sizeof(url));
+        CHECK(storage.saveInternetStation(i, name, url));
+    }
+    CHECK(!storage.saveInternetStation(MAX_INTERNET_STATIONS, "One too many", "http://x"));
+    CHECK_EQ(storage.getInternetStationCount(), MAX_INTERNET_STATIONS);
+}
+
+TEST(StationCatalog, nvsStationsStayUntilTheCatalogHasThem) {
+    resetDevice();
+    writeLegacyStations();
+
+    // A directory where the file should be: the catalog can't open
+    CHECK(LittleFS.mkdir("/stations.cat"));
+    {
+        StorageModule storage;
+        CHECK(storage.begin());
+        CHECK_EQ(storage.getInternetStationCount(), 0);
+    }
+    CHECK(legacyStationsKept());
+
+    // A catalog that doesn't match what NVS holds is left alone too
+    CHECK_EQ(rmdir(LittleFS.hostPath("/stations.cat").c_str()), 0);
+    {
+        StationCatalog catalog;
+        CHECK(catalog.open(STATION_CATALOG_FILE));
+        CHECK(catalog.add("Added later", "http://later.example"));
+    }
+    {
+        StorageModule storage;
+        storage.begin();
+        CHECK_EQ(storage.getInternetStationCount(), 1);
+    }
+    CHECK(legacyStationsKept());
+
+    // Once the catalog works, the next boot finishes the move
+    LittleFS.remove("/stations.cat");
+    StorageModule storage;
+    storage.begin();
+    CHECK_EQ(storage.getInternetStationCount(), 2);
+    CHECK(!legacyStationsKept());
+}
+
+// Boot-time cost of a full catalog: StorageModule opens it (index only)
+// and publishes the StationTable every consumer reads
+BENCH(stationCatalogLoad) {
+    resetDevice();
+    {
+        StationCatalog catalog;
+        catalog.open(STATION_CATALOG_FILE);
+        fillCatalog(catalog, MAX_INTERNET_STATIONS);
+    }
+
+    const int ROUNDS = 200;
+    uint64_t openNanos = 0;
+    uint64_t publishNanos = 0;
+    for (int i = 0; i < ROUNDS; i++) {
+        StorageModule storage;
+        uint64_t start = hostBenchNanos();
+        storage.begin();
+        uint64_t opened = hostBenchNanos();
+        storage.publishInternetStations();
+        publishNanos += hostBenchNanos() - opened;
+        openNanos += opened - start;
+        CHECK_EQ(storage.getInternetStationCount(), MAX_INTERNET_STATIONS);
+    }
+
+    printf("%d stations: begin() %.1f us, publishInternetStations() %.1f us\n",
+           MAX_INTERNET_STATIONS, openNanos / 1000.0 / ROUNDS, publishNanos / 1000.0 / ROUNDS);
+}
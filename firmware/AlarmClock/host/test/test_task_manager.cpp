@@ -0,0 +1,134 @@
+#include "HostTest.h"
+#include "TaskManager.h"
+#include "Config.h"
+#include <atomic>
+
+// The task scheduler on host threads: start-up is all or nothing, tasks
+// sharing the app lock never overlap, stop() waits for them, and audio
+// keeps its period however long the app tasks hold the lock
+
+static std::atomic<int> audioTicks(0);
+static std::atomic<int> uiTicks(0);
+static std::atomic<int> netTicks(0);
+static std::atomic<int> inside(0);
+static std::atomic<int> maxInside(0);
+
+static void resetCounters() {
+    audioTicks = 0;
+    uiTicks = 0;
+    netTicks = 0;
+    inside = 0;
+    maxInside = 0;
+}
+
+// Busy for us microseconds, as a redraw or a flash write would be
+static void work(uint32_t us) {
+    uint64_t until = hostBenchNanos() + (uint64_t)us * 1000;
+    while (hostBenchNanos() < until) {}
+}
+
+static void lockedWork(std::atomic<int>& ticks, uint32_t us) {
+    int now = ++inside;
+    if (now > maxInside) maxInside = now;
+    ticks++;
+    work(us);
+    inside--;
+}
+
+static void audioTick() { audioTicks++; }
+static void uiTick() { lockedWork(uiTicks, 2000); }
+static void netTick() { lockedWork(netTicks, 500); }
+
+// The firmware's task layout with stand-in ticks
+static void addTasks(TaskManager& tasks, TaskTick audio, TaskTick net, TaskTick ui, bool audioLocked = false) {
+    tasks.addTask("audio", audio, AUDIO_TASK_PERIOD_MS, AUDIO_TASK_CORE,
+                  AUDIO_TASK_PRIORITY, AUDIO_TASK_STACK, audioLocked);
+    tasks.addTask("network", net, NET_TASK_PERIOD_MS, APP_TASK_CORE,
+                  APP_TASK_PRIORITY, APP_TASK_STACK, true);
+    tasks.addTask("ui", ui, UI_TASK_PERIOD_MS, APP_TASK_CORE,
+                  APP_TASK_PRIORITY, APP_TASK_STACK, true);
+}
+
+TEST(TaskManager, failedStartRunsNoTick) {
+    resetCounters();
+    int before = hostTaskRunning();
+    TaskManager tasks;
+    addTasks(tasks, audioTick, netTick, uiTick);
+
+    hostTaskFailCreateAfter(2);         // "ui" can't be created
+    CHECK(!tasks.start());
+    hostTaskFailCreateAfter(-1);
+    CHECK(!tasks.isStarted());
+
+    vTaskDelay(50);
+    CHECK_EQ(audioTicks, 0);
+    CHECK_EQ(netTicks, 0);
+    CHECK_EQ(hostTaskRunning(), before);
+}
+
+TEST(TaskManager, lockedTasksTakeTurnsAndStopWaits) {
+    resetCounters();
+    int before = hostTaskRunning();
+    TaskManager tasks;
+    addTasks(tasks, audioTick, netTick, uiTick);
+    CHECK(tasks.start());
+    CHECK(!tasks.addTask("late", audioTick, 1, 0, 1, 4096, false));
+
+    vTaskDelay(200);
+    CHECK(uiTicks > 0);
+    CHECK(netTicks > 0);
+    CHECK_EQ(maxInside, 1);
+
+    // Holding the app lock stops the app tasks but not audio
+    CHECK(tasks.lockApp(100));
+    int audio = audioTicks;
+    int ui = uiTicks;
+    vTaskDelay(60);
+    CHECK(audioTicks > audio + 20);
+    CHECK_EQ(uiTicks, ui);
+    tasks.unlockApp();
+
+    tasks.stop();
+    CHECK(!tasks.isStarted());
+    CHECK_EQ(hostTaskRunning(), before);
+    audio = audioTicks;
+    vTaskDelay(20);
+    CHECK_EQ(audioTicks, audio);
+}
+
+// ===== AUDIO LATENCY =====
+
+static const uint32_t UI_REDRAW_US = 15000;     // A full-screen redraw
+static const uint32_t NET_FLUSH_US = 3000;      // A storage flush
+static std::atomic<uint64_t> lastAudioNanos(0);
+static std::atomic<uint64_t> worstAudioGapNanos(0);
+
+static void timedAudioTick() {
+    uint64_t now = hostBenchNanos();
+    uint64_t last = lastAudioNanos.exchange(now);
+    if (last && now - last > worstAudioGapNanos) worstAudioGapNanos = now - last;
+}
+
+static void redrawTick() { work(UI_REDRAW_US); }
+static void flushTick() { work(NET_FLUSH_US); }
+
+// Worst gap between audio ticks over a second of app tasks hogging the lock
+static double worstAudioGapMs(bool audioTakesAppLock) {
+    lastAudioNanos = 0;
+    worstAudioGapNanos = 0;
+    TaskManager tasks;
+    addTasks(tasks, timedAudioTick, flushTick, redrawTick, audioTakesAppLock);
+    CHECK(tasks.start());
+    vTaskDelay(1000);
+    tasks.stop();
+    return worstAudioGapNanos / 1e6;
+}
+
+BENCH(audioLatency) {
+    double own = worstAudioGapMs(false);
+    double shared = worstAudioGapMs(true);
+    printf("Worst gap between 1 ms audio ticks, UI redraws %u ms and flushes %u ms on the app lock:\n",
+           (unsigned)(UI_REDRAW_US / 1000), (unsigned)(NET_FLUSH_US / 1000));
+    printf("  audio without the lock %.2f ms, audio on the lock %.2f ms\n", own, shared);
+    CHECK(own < shared);
+}
@@ -0,0 +1,110 @@
+#include "HostTest.h"
+#include <new>
+#include "TimeFormat.h"
+#include "PosixTz.h"
+#include "DisplayILI9341.h"
+
+// Clock and date text, and proof that the steady-state clock screen never
+// touches the heap. The host String wraps std::string, so every String the
+// firmware would build goes through the operator new counted here.
+
+static volatile unsigned long allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+static TimeSnapshot at(PosixTz& tz, time_t epoch) {
+    TimeSnapshot t;
+    makeTimeSnapshot(epoch, tz, t);
+    return t;
+}
+
+TEST(TimeFormat, formatsEveryField) {
+    PosixTz utc;
+    TimeSnapshot t = at(utc, 1726920022);      // Sat 2024-09-21 12:00:22 UTC
+    char time[TIME_TEXT_SIZE], hm[HOUR_MINUTE_SIZE], date[DATE_TEXT_SIZE], full[FULL_DATE_TEXT_SIZE];
+    CHECK_EQ(formatClockTime(t, time), 8);
+    CHECK_STR(time, "12:00:22");
+    CHECK_EQ(formatHourMinute(t, hm), 5);
+    CHECK_STR(hm, "12:00");
+    formatShortDate(t, date);
+    CHECK_STR(date, "Sat, 21 Sep 2024");
+    formatFullDate(t, full);
+    CHECK_STR(full, "Saturday, 21 September 2024");
+
+    // Single digits are zero-padded; the widest full date still fits
+    t = at(utc, 1727139607);                    // Tue 2024-09-24 01:00:07
+    formatClockTime(t, time);
+    CHECK_STR(time, "01:00:07");
+    t = at(utc, 1726656000);                    // Wed 2024-09-18
+    CHECK_EQ(formatFullDate(t, full), strlen("Wednesday, 18 September 2024"));
+}
+
+TEST(TimeFormat, shortBuffersGetEmptyText) {
+    PosixTz utc;
+    TimeSnapshot t = at(utc, 1726920022);
+    char small[8];
+    memset(small, 'x', sizeof(small));
+    CHECK_EQ(formatClockTime(t, small, sizeof(small)), 0);
+    CHECK_STR(small, "");
+    CHECK_EQ(formatShortDate(t, small, sizeof(small)), 0);
+    CHECK_EQ(formatClockTime(t, small, 0), 0);
+}
+
+TEST(TimeFormat, counterSeesStringAllocations) {
+    unsigned long before = allocations;
+    String text("14:35:22 on a date long enough to leave the small buffer");
+    text += "!";
+    CHECK(allocations - before >= 1);
+}
+
+TEST(TimeFormat, threeDaysOfFormattingAllocateNothing) {
+    PosixTz tz;
+    tz.set("CET-1CEST,M3.5.0,M10.5.0/3");
+    char time[TIME_TEXT_SIZE], hm[HOUR_MINUTE_SIZE], date[DATE_TEXT_SIZE], full[FULL_DATE_TEXT_SIZE];
+
+    unsigned long before = allocations;
+    for (time_t epoch = 1711756800; epoch < 1711756800 + 3 * 86400; epoch++) {   // Over a DST change
+        TimeSnapshot t;
+        makeTimeSnapshot(epoch, tz, t);
+        formatClockTime(t, time);
+        formatHourMinute(t, hm);
+        formatShortDate(t, date);
+        formatFullDate(t, full);
+    }
+    CHECK_EQ(allocations - before, 0);
+}
+
+TEST(TimeFormat, clockScreenAllocatesNothingPerSecond) {
+    DisplayILI9341 display(-1, -1, -1, -1, -1, -1, -1);
+    display.begin();
+    PosixTz tz;
+    tz.set("GMT0BST,M3.5.0/1,M10.5.0");
+
+    // The main screen's per-second work: digital time and date, the analog
+    // clock and the status lines, for two hours across midnight
+    time_t start = 1735686000;                  // 2024-12-31 23:00 UTC
+    display.updateClockText(at(tz, start));     // First draw
+    unsigned long before = allocations;
+    for (time_t epoch = start + 1; epoch < start + 2 * 3600; epoch++) {
+        TimeSnapshot t = at(tz, epoch);
+        display.updateClockText(t);
+        display.updateTime(t.hour, t.minute, t.second);
+        display.updateAlarmStatus(true, 7, 30);
+        display.updateWiFiStatus(true);
+    }
+    CHECK_EQ(allocations - before, 0);
+}
@@ -0,0 +1,141 @@
+#include "HostTest.h"
+#include "TimeSnapshot.h"
+#include "PosixTz.h"
+
+// The once-per-second local time snapshot: fields against glibc's civil
+// calendar, tick detection across minute, day and DST boundaries, and the
+// per-loop cost of reading it versus converting on every getter call
+
+// Local time = UTC + a fixed offset
+class FixedOffset : public LocalTimeMapping {
+private:
+    long offset;
+
+public:
+    FixedOffset(long seconds) : offset(seconds) {}
+    time_t toLocal(time_t utc) override { return utc + offset; }
+    time_t localToEpoch(time_t local) override { return local - offset; }
+};
+
+TEST(TimeSnapshot, fieldsMatchGmtime) {
+    FixedOffset utc(0);
+    // Every 97 minutes and a few seconds from 1970 to 2100, hitting all
+    // fields including leap days and century years
+    for (time_t epoch = 0; epoch < 4102444800; epoch += 5821 + 13) {
+        TimeSnapshot s;
+        makeTimeSnapshot(epoch, utc, s);
+        struct tm expected;
+        gmtime_r(&epoch, &expected);
+        if (s.year != expected.tm_year + 1900 || s.month != expected.tm_mon + 1 ||
+            s.day != expected.tm_mday || s.hour != expected.tm_hour ||
+            s.minute != expected.tm_min || s.second != expected.tm_sec ||
+            s.dayOfWeek != expected.tm_wday) {
+            CHECK_EQ(epoch, -1);    // Report the first mismatch only
+            break;
+        }
+    }
+}
+
+TEST(TimeSnapshot, localTimeBeforeTheEpoch) {
+    FixedOffset newYork(-5 * 3600);
+    TimeSnapshot s;
+    makeTimeSnapshot(0, newYork, s);
+    CHECK(s.valid);
+    CHECK_EQ(s.days, -1);
+    CHECK_EQ(s.year, 1969);
+    CHECK_EQ(s.month, 12);
+    CHECK_EQ(s.day, 31);
+    CHECK_EQ(s.hour, 19);
+    CHECK_EQ(s.dayOfWeek, 3);    // Wednesday
+}
+
+TEST(TimeSnapshot, ticksOnSecondMinuteAndDay) {
+    FixedOffset paris(3600);
+    TimeSnapshot none = {};
+    TimeSnapshot prev, now;
+    makeTimeSnapshot(1735689599, paris, prev);    // 2025-01-01 00:59:59 local
+    CHECK_EQ(timeSnapshotTicks(none, prev), TIME_TICK_SECOND | TIME_TICK_MINUTE | TIME_TICK_DAY);
+    CHECK_EQ(timeSnapshotTicks(prev, prev), 0);
+    CHECK_EQ(timeSnapshotTicks(prev, none), 0);
+
+    makeTimeSnapshot(1735689600, paris, now);
+    CHECK_EQ(timeSnapshotTicks(prev, now), TIME_TICK_SECOND | TIME_TICK_MINUTE);
+    makeTimeSnapshot(1735689601, paris, prev);
+    CHECK_EQ(timeSnapshotTicks(now, prev), TIME_TICK_SECOND);
+
+    // Local midnight, and a clock step that skips whole minutes
+    makeTimeSnapshot(1735772399, paris, prev);    // 23:59:59
+    makeTimeSnapshot(1735772400, paris, now);
+    CHECK_EQ(timeSnapshotTicks(prev, now), TIME_TICK_SECOND | TIME_TICK_MINUTE | TIME_TICK_DAY);
+    makeTimeSnapshot(1735772400 + 3600 * 5 + 7, paris, prev);
+    CHECK_EQ(timeSnapshotTicks(now, prev), TIME_TICK_SECOND | TIME_TICK_MINUTE);
+}
+
+TEST(TimeSnapshot, ticksAcrossDstChanges) {
+    PosixTz newYork;
+    CHECK(newYork.set("EST5EDT,M3.2.0,M11.1.0"));
+
+    // 2025-11-02 01:59:59 EDT -> 01:00:00 EST: wall clock goes back an hour
+    TimeSnapshot prev, now;
+    makeTimeSnapshot(1762063199, newYork, prev);
+    makeTimeSnapshot(1762063200, newYork, now);
+    CHECK_EQ(prev.hour, 1);
+    CHECK_EQ(prev.minute, 59);
+    CHECK_EQ(now.hour, 1);
+    CHECK_EQ(now.minute, 0);
+    CHECK_EQ(timeSnapshotTicks(prev, now), TIME_TICK_SECOND | TIME_TICK_MINUTE);
+
+    // 2025-03-09 01:59:59 EST -> 03:00:00 EDT
+    makeTimeSnapshot(1741503599, newYork, prev);
+    makeTimeSnapshot(1741503600, newYork, now);
+    CHECK_EQ(now.hour, 3);
+    CHECK_EQ(now.day, prev.day);
+    CHECK_EQ(timeSnapshotTicks(prev, now), TIME_TICK_SECOND | TIME_TICK_MINUTE);
+}
+
+// One main-loop iteration's time reads: the alarm check and the main screen
+// ask for hour, minute, second, day, month, year and weekday several times
+static const int CONSUMERS = 4;
+static const int LOOPS_PER_SECOND = 100;
+
+BENCH(timeSnapshotPerLoop) {
+    PosixTz tz;
+    tz.set("CET-1CEST,M3.5.0,M10.5.0/3");
+    const int SECONDS = 2000;
+    time_t epoch = 1735689600;
+    volatile uint32_t sink = 0;
+
+    // Before: every getter converted the current time on its own
+    uint64_t start = hostBenchNanos();
+    for (int s = 0; s < SECONDS; s++) {
+        for (int loop = 0; loop < LOOPS_PER_SECOND; loop++) {
+            for (int c = 0; c < CONSUMERS; c++) {
+                for (int field = 0; field < 7; field++) {
+                    TimeSnapshot each;
+                    makeTimeSnapshot(epoch + s, tz, each);
+                    sink = sink + each.hour + field;
+                }
+            }
+        }
+    }
+    uint64_t perGetter = hostBenchNanos() - start;
+
+    // After: one conversion per second, then plain field reads
+    start = hostBenchNanos();
+    TimeSnapshot snapshot;
+    for (int s = 0; s < SECONDS; s++) {
+        makeTimeSnapshot(epoch + s, tz, snapshot);
+        for (int loop = 0; loop < LOOPS_PER_SECOND; loop++) {
+            for (int c = 0; c < CONSUMERS; c++) {
+                sink = sink + snapshot.hour + snapshot.minute + snapshot.second + snapshot.day +
+                       snapshot.month + snapshot.year + snapshot.dayOfWeek;
+            }
+        }
+    }
+    uint64_t perSecond = hostBenchNanos() - start;
+
+    int loops = SECONDS * LOOPS_PER_SECOND;
+    printf("Time reads per loop (%d consumers x 7 fields): converting each call %.1f ns, snapshot %.1f ns\n",
+           CONSUMERS, (double)perGetter / loops, (double)perSecond / loops);
+    CHECK(perSecond < perGetter);
+}
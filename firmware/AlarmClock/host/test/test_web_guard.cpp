@@ -0,0 +1,150 @@
+#include "HostTest.h"
+#include "WebGuard.h"
+#include "AppLock.h"
+#include <freertos/task.h>
+#include <atomic>
+#include <thread>
+
+// Web handlers against the app lock with no TaskManager at all, as during
+// setup() or when ENABLE_TASKS is off and loop() does the work, and pages
+// riding out a busy lock
+
+// Holds the app lock on another thread, as loop() or a task would: for
+// holdMs, or until destroyed when holdMs is 0
+class LockHolder {
+private:
+    std::atomic<bool> holding;
+    std::atomic<bool> release;
+    std::thread thread;
+
+public:
+    explicit LockHolder(uint32_t holdMs = 0) : holding(false), release(false) {
+        thread = std::thread([this, holdMs]() {
+            AppLock::take();
+            holding = true;
+            TickType_t start = xTaskGetTickCount();
+            while (!release && (holdMs == 0 || xTaskGetTickCount() - start < holdMs)) vTaskDelay(1);
+            AppLock::give();
+        });
+        while (!holding) vTaskDelay(1);
+    }
+
+    ~LockHolder() {
+        release = true;
+        thread.join();
+    }
+};
+
+// True if another thread finds the app lock taken
+static bool lockHeldElsewhere() {
+    bool held = false;
+    std::thread([&held]() {
+        held = !AppLock::take(0);
+        if (!held) AppLock::give();
+    }).join();
+    return held;
+}
+
+TEST(WebGuard, handlersHoldTheAppLockWithoutTasks) {
+    CHECK(AppLock::begin());
+    bool heldInHandler = false;
+    ArRequestHandlerFunction handler = WebGuard::wrap([&heldInHandler](AsyncWebServerRequest* request) {
+        heldInHandler = lockHeldElsewhere();
+        request->send(200, "text/plain", "ok");
+    });
+
+    AsyncWebServerRequest request(HTTP_POST, "/save_alarm");
+    handler(&request);
+    CHECK(heldInHandler);
+    CHECK(!lockHeldElsewhere());
+    CHECK_EQ(request.hostResponse()->hostCode(), 200);
+    request.hostDisconnect();
+}
+
+TEST(WebGuard, unlockedHandlersRunWhileTheLockIsHeld) {
+    CHECK(AppLock::begin());
+    LockHolder holder;
+    ArRequestHandlerFunction handler = WebGuard::wrap([](AsyncWebServerRequest* request) {
+        request->send(200, "text/plain", "ok");
+    }, false);
+
+    AsyncWebServerRequest request(HTTP_GET, "/metrics");
+    handler(&request);
+    CHECK_EQ(request.hostResponse()->hostCode(), 200);
+    request.hostDisconnect();
+}
+
+TEST(WebGuard, busyLockAnswers503) {
+    CHECK(AppLock::begin());
+    LockHolder holder;
+    bool ran = false;
+    ArRequestHandlerFunction handler = WebGuard::wrap([&ran](AsyncWebServerRequest* request) {
+        ran = true;
+        request->send(200, "text/plain", "ok");
+    });
+
+    uint32_t rejected = WebGuard::getRejected();
+    AsyncWebServerRequest request(HTTP_POST, "/save_alarm");
+    handler(&request);
+    CHECK(!ran);
+    CHECK_EQ(request.hostResponse()->hostCode(), 503);
+    CHECK(request.hostResponse()->hostHeader("Retry-After") != nullptr);
+    CHECK_EQ(WebGuard::getRejected(), rejected + 1);
+}
+
+TEST(WebGuard, requestCountsUntilTheClientGoes) {
+    CHECK(AppLock::begin());
+    static int done;
+    done = 0;
+    ArRequestHandlerFunction handler = WebGuard::wrap([](AsyncWebServerRequest* request) {
+        request->send(200, "text/plain", "ok");
+    }, true, [](AsyncWebServerRequest* request) { (void)request; done++; });
+
+    int open = WebGuard::getOpenRequests();
+    AsyncWebServerRequest request(HTTP_GET, "/list_mp3");
+    handler(&request);
+    CHECK_EQ(WebGuard::getOpenRequests(), open + 1);
+    CHECK_EQ(done, 0);
+    request.hostDisconnect();
+    CHECK_EQ(WebGuard::getOpenRequests(), open);
+    CHECK_EQ(done, 1);
+}
+
+static void sendPage(AsyncWebServerRequest* request) {
+    request->send(200, "text/html", "<p>page</p>");
+}
+
+TEST(WebGuard, pageWaitsOutABusyTick) {
+    CHECK(AppLock::begin());
+    LockHolder redraw(WEB_PAGE_WAIT_MS / 5);
+    AsyncWebServerRequest request(HTTP_GET, "/alarms");
+    WebGuard::wrapPage(sendPage)(&request);
+    CHECK_EQ(request.hostResponse()->hostCode(), 200);
+    CHECK(request.hostResponse()->hostDrain() == "<p>page</p>");
+    request.hostDisconnect();
+}
+
+TEST(WebGuard, pageNeverGets503) {
+    CHECK(AppLock::begin());
+    LockHolder holder;
+    AsyncWebServerRequest request(HTTP_GET, "/");
+    TickType_t start = xTaskGetTickCount();
+    WebGuard::wrapPage(sendPage)(&request);
+    CHECK(xTaskGetTickCount() - start >= WEB_PAGE_WAIT_MS);
+
+    AsyncWebServerResponse* response = request.hostResponse();
+    CHECK_EQ(response->hostCode(), 200);
+    CHECK_STR(response->hostContentType(), "text/html");
+    CHECK(response->hostHeader("Cache-Control") != nullptr);
+    CHECK(response->hostDrain().find("http-equiv=\"refresh\"") != std::string::npos);
+}
+
+TEST(WebGuard, postToAPageUrlIsAnAction) {
+    CHECK(AppLock::begin());
+    LockHolder holder;
+    AsyncWebServerRequest request(HTTP_POST, "/settings");
+    TickType_t start = xTaskGetTickCount();
+    WebGuard::wrapPage(sendPage)(&request);
+    CHECK(xTaskGetTickCount() - start < WEB_PAGE_WAIT_MS);
+    CHECK_EQ(request.hostResponse()->hostCode(), 503);
+}
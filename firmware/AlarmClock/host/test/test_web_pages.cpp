@@ -0,0 +1,186 @@
+#include "HostTest.h"
+#include "Fixtures.h"
+#include "WebServerModule.h"
+#include "AlarmController.h"
+#include "AudioModule.h"
+#include "FMRadioModule.h"
+#include "DisplayILI9341.h"
+#include "StorageModule.h"
+#include "TimeModule.h"
+#include "HtmlStream.h"
+#include "AppLock.h"
+#include "MediaIndex.h"
+#include "Mp3Files.h"
+#include <string>
+
+// The web server as HardwareSetup wires it, answering requests through
+// the routes it registers: every page comes back whole, forms change what
+// the pages show, and /events opens with a snapshot
+
+struct WebClock {
+    StorageModule storage;
+    DisplayILI9341 display;
+    FMRadioModule fm;
+    AudioModule audio;
+    TimeModule time;
+    AlarmController alarms;
+    WebServerModule web;
+    AsyncWebServer* server;
+
+    WebClock()
+        : display(-1, -1, -1, -1, -1, -1, -1), audio(-1, -1, -1),
+          alarms(&audio, &fm, &display, &storage), server(nullptr) {
+        resetDevice();
+        AppLock::begin();
+        storage.begin();
+        display.begin();
+        audio.begin();
+        time.setStorage(&storage);
+        time.begin("", "");
+        alarms.begin();
+
+        web.setStorageModule(&storage);
+        web.setTimeModule(&time);
+        web.setAudioModule(&audio);
+        web.setFMRadioModule(&fm);
+        web.setDisplayModule(&display);
+        web.setAlarmController(&alarms);
+        web.begin("alarmclock");
+        server = AsyncWebServer::hostListening(80);
+    }
+
+    // Sends the request and reads the whole response
+    int fetch(AsyncWebServerRequest& request, std::string& body) {
+        body.clear();
+        if (!server || !server->hostHandle(&request) || !request.hostResponse()) return 0;
+        body = request.hostResponse()->hostDrain();
+        return request.hostResponse()->hostCode();
+    }
+
+    int get(const char* url, std::string& body) {
+        AsyncWebServerRequest request(HTTP_GET, url);
+        return fetch(request, body);
+    }
+};
+
+static bool contains(const std::string& text, const char* part) {
+    return text.find(part) != std::string::npos;
+}
+
+TEST(WebPages, pagesAreWhole) {
+    WebClock clock;
+    CHECK(clock.server != nullptr);
+
+    // Each with a heading from its last static section
+    const char* pages[][2] = {
+        { "/", "Quick Play" },
+        { "/stations", "Saved Stations" },
+        { "/settings", "System Information" },
+        { "/control", "Current Status" },
+        { "/alarms", "Alarm Management" },
+    };
+    for (size_t i = 0; i < sizeof(pages) / sizeof(pages[0]); i++) {
+        std::string body;
+        CHECK_EQ(clock.get(pages[i][0], body), 200);
+        CHECK(contains(body, pages[i][1]));
+        CHECK(contains(body, "</html>"));
+        CHECK_EQ(HtmlStream::getHeldBytes(), 0);
+    }
+}
+
+TEST(WebPages, unknownUrlIs404) {
+    WebClock clock;
+    std::string body;
+    CHECK_EQ(clock.get("/no-such-page", body), 404);
+}
+
+TEST(WebPages, addedStationIsListed) {
+    WebClock clock;
+    AsyncWebServerRequest add(HTTP_POST, "/add_station");
+    add.hostAddArg("name", "Test FM Northern");
+    add.hostAddArg("url", "http://stream.example/northern");
+    std::string body;
+    CHECK_EQ(clock.fetch(add, body), 200);
+
+    CHECK_EQ(clock.get("/stations", body), 200);
+    CHECK(contains(body, "Test FM Northern"));
+    CHECK(contains(body, "http://stream.example/northern"));
+}
+
+TEST(WebPages, alarmSavedThroughTheApiIsShown) {
+    WebClock clock;
+    AsyncWebServerRequest put(HTTP_PUT, "/api/v1/alarms/1");
+    put.hostSetBody("{\"enabled\":true,\"hour\":6,\"minute\":45,\"repeat\":1,\"soundType\":1,\"fmFreq\":101.7}");
+    std::string body;
+    CHECK_EQ(clock.fetch(put, body), 200);
+
+    AlarmConfig saved;
+    CHECK(clock.storage.loadAlarm(1, saved));
+    CHECK(saved.enabled);
+    CHECK_EQ(saved.hour, 6);
+    CHECK_EQ(saved.minute, 45);
+
+    CHECK_EQ(clock.get("/api/v1/alarms", body), 200);
+    CHECK(contains(body, "\"hour\":6"));
+}
+
+TEST(WebPages, mp3TitlesAreEscaped) {
+    WebClock clock;
+    LittleFS.mkdir("/mp3");
+    Bytes bytes = concat(id3v2Tag(3, id3Frame(3, "TIT2", 0, latin1("<b>Rise & Shine</b>"))),
+                         mp3Frames(10));
+    File file = LittleFS.open("/mp3/it's.mp3", "w");
+    file.write(bytes.data(), bytes.size());
+    file.close();
+    CHECK(MediaIndex::begin());
+    MediaIndex::loop();
+    while (MediaIndex::isScanning()) MediaIndex::loop();
+
+    std::string body;
+    CHECK_EQ(clock.get("/alarms", body), 200);
+    CHECK(contains(body, "<option value='it&#39;s.mp3'>&lt;b&gt;Rise &amp; Shine&lt;/b&gt;"));
+    CHECK(!contains(body, "<b>Rise"));
+}
+
+TEST(WebPages, metricsAreText) {
+    WebClock clock;
+    std::string body;
+    CHECK_EQ(clock.get("/metrics", body), 200);
+    CHECK(contains(body, "web_page_buffer_bytes"));
+    CHECK(contains(body, "wifi_connected 0"));
+}
+
+TEST(WebPages, eventsOpenWithASnapshot) {
+    WebClock clock;
+    clock.web.handleClient();
+    AsyncEventSourceClient* client = clock.server->hostOpenEvents("/events");
+    CHECK(client != nullptr);
+    if (!client) return;
+    CHECK(client->connected());
+    CHECK_EQ(client->hostReceived().size(), 1);
+    if (!client->hostReceived().empty()) {
+        CHECK(contains(client->hostReceived()[0].data.c_str(), "\"volume\""));
+    }
+}
+
+TEST(WebPages, eventsSnapshotIsTheLastSample) {
+    WebClock clock;
+    clock.audio.setVolume(5);
+    clock.web.handleClient();
+
+    // Connecting reads what loop() sampled, not the modules
+    clock.audio.setVolume(9);
+    AsyncEventSourceClient* client = clock.server->hostOpenEvents("/events");
+    CHECK(client != nullptr);
+    if (!client) return;
+    CHECK_EQ(client->hostReceived().size(), 1);
+    CHECK(contains(client->hostReceived()[0].data.c_str(), "\"volume\":5"));
+
+    // The next poll brings it up to date
+    hostClockAdvance(EVENTS_POLL_MS);
+    clock.web.handleClient();
+    CHECK_EQ(client->hostReceived().size(), 2);
+    if (client->hostReceived().size() == 2) {
+        CHECK_STR(client->hostReceived()[1].data.c_str(), "{\"volume\":9}");
+    }
+}
@@ -0,0 +1,284 @@
+#include "HostTest.h"
+#include "WiFiLink.h"
+#include <Arduino.h>
+#include <vector>
+
+// The connection policy against a simulated radio on the virtual clock:
+// links drop, access points move channel or go away, and every recovery is
+// timed the way the clock would see it
+
+#define SIM_FAST_JOIN_MS      350     // Straight to a known BSSID
+#define SIM_SCAN_JOIN_MS      2600    // Scan, auth and DHCP
+#define SIM_WRONG_CHANNEL_MS  800     // Cached channel no longer has the AP
+#define SIM_NOT_FOUND_MS      3000    // Scan found no such SSID
+#define SIM_STEP_MS           10
+
+struct SimAp {
+    const char* ssid;
+    uint8_t bssid[6];
+    uint8_t channel;
+    bool up;
+};
+
+struct SimEvent {
+    uint32_t at;
+    bool connected;
+    int ap;
+    int generation;     // Join it answers; -1 for a link drop
+};
+
+// Join results arrive after a delay; a newer join or leave() cancels them
+class SimRadio : public WiFiRadio {
+public:
+    SimAp aps[2];
+    std::vector<SimEvent> events;
+    int generation;
+    int joins;
+    int fastJoins;
+
+    SimRadio() : generation(0), joins(0), fastJoins(0) {
+        SimAp home = { "home", { 0x02, 0x11, 0x22, 0x33, 0x44, 0x55 }, 6, true };
+        SimAp phone = { "phone", { 0x02, 0x66, 0x77, 0x88, 0x99, 0xAA }, 11, true };
+        aps[0] = home;
+        aps[1] = phone;
+    }
+
+    void join(const char* ssid, const char* password, const uint8_t* bssid, uint8_t channel) override {
+        (void)password;
+        generation++;
+        joins++;
+        if (bssid) fastJoins++;
+
+        uint32_t now = millis();
+        for (int i = 0; i < 2; i++) {
+            if (strcmp(aps[i].ssid, ssid) != 0) continue;
+            if (!aps[i].up) {
+                events.push_back({ now + SIM_NOT_FOUND_MS, false, i, generation });
+            } else if (bssid && channel != aps[i].channel) {
+                events.push_back({ now + SIM_WRONG_CHANNEL_MS, false, i, generation });
+            } else {
+                events.push_back({ now + (bssid ? SIM_FAST_JOIN_MS : SIM_SCAN_JOIN_MS), true, i, generation });
+            }
+        }
+    }
+
+    void leave() override {
+        generation++;
+    }
+
+    void dropLink() {
+        events.push_back({ (uint32_t)millis(), false, -1, -1 });
+    }
+
+    void deliver(WiFiLink& link) {
+        uint32_t now = millis();
+        for (size_t i = 0; i < events.size();) {
+            if ((int32_t)(now - events[i].at) < 0) {
+                i++;
+                continue;
+            }
+            SimEvent event = events[i];
+            events.erase(events.begin() + i);
+            if (event.generation >= 0 && event.generation != generation) continue;
+            if (event.connected) link.onConnected(now, aps[event.ap].bssid, aps[event.ap].channel);
+            else link.onDisconnected(now);
+        }
+    }
+};
+
+static void setUp(WiFiLink& link, SimRadio& radio) {
+    hostClockSet(0);
+    link.configure(10000, 3000, 2000, 120000);
+    link.addAp("home", "secret");
+    link.addAp("phone", "hotspot");
+    link.begin(radio, millis());
+}
+
+static void run(WiFiLink& link, SimRadio& radio, uint32_t ms) {
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += SIM_STEP_MS) {
+        delay(SIM_STEP_MS);
+        radio.deliver(link);
+        link.poll(millis());
+    }
+}
+
+// Milliseconds until the link is up, or 0 if it isn't within limitMs
+static uint32_t runUntilConnected(WiFiLink& link, SimRadio& radio, uint32_t limitMs) {
+    uint32_t start = millis();
+    while (!link.isConnected()) {
+        if (millis() - start >= limitMs) return 0;
+        run(link, radio, SIM_STEP_MS);
+    }
+    return millis() - start;
+}
+
+TEST(WiFiLink, firstJoinScansAndCachesTheAp) {
+    WiFiLink link;
+    SimRadio radio;
+    setUp(link, radio);
+
+    CHECK_EQ(link.getState(), WIFI_LINK_CONNECTING);
+    CHECK_EQ(runUntilConnected(link, radio, 5000), SIM_SCAN_JOIN_MS);
+    CHECK_EQ(radio.fastJoins, 0);
+    CHECK(link.takeCacheChanged());
+    CHECK(!link.takeCacheChanged());
+    CHECK_EQ(link.getCache().channel, 6);
+    CHECK_EQ(link.getCache().apIndex, 0);
+}
+
+TEST(WiFiLink, dropRejoinsTheCachedBssid) {
+    WiFiLink link;
+    SimRadio radio;
+    setUp(link, radio);
+    runUntilConnected(link, radio, 5000);
+    link.takeCacheChanged();
+    run(link, radio, 60000);
+
+    radio.dropLink();
+    run(link, radio, SIM_STEP_MS);
+    CHECK_EQ(link.getState(), WIFI_LINK_CONNECTING);
+    CHECK_EQ(runUntilConnected(link, radio, 5000), SIM_FAST_JOIN_MS);
+    CHECK_EQ(link.getDrops(), 1);
+    CHECK_EQ(radio.fastJoins, 1);
+    CHECK(!link.takeCacheChanged());                    // Same AP: nothing to save
+    CHECK_EQ(link.getApIndex(), 0);
+}
+
+TEST(WiFiLink, movedChannelFallsBackToAScan) {
+    WiFiLink link;
+    SimRadio radio;
+    setUp(link, radio);
+    runUntilConnected(link, radio, 5000);
+    link.takeCacheChanged();
+
+    radio.aps[0].channel = 1;
+    radio.dropLink();
+    run(link, radio, SIM_STEP_MS);
+    uint32_t outage = runUntilConnected(link, radio, 10000);
+    CHECK_EQ(outage, SIM_WRONG_CHANNEL_MS + SIM_SCAN_JOIN_MS);
+    CHECK_EQ(link.getApIndex(), 0);
+    CHECK(link.takeCacheChanged());
+    CHECK_EQ(link.getCache().channel, 1);
+}
+
+TEST(WiFiLink, missingApFallsBackToTheNextNetwork) {
+    WiFiLink link;
+    SimRadio radio;
+    setUp(link, radio);
+    runUntilConnected(link, radio, 5000);
+
+    radio.aps[0].up = false;
+    radio.dropLink();
+    run(link, radio, SIM_STEP_MS);
+    // Fast join to the gone AP times out, the scan finds nothing, then phone
+    CHECK(runUntilConnected(link, radio, 20000) > 0);
+    CHECK_STR(link.getApSsid(link.getApIndex()), "phone");
+    CHECK_EQ(link.getCache().apIndex, 1);
+    CHECK_EQ(link.getFailedRounds(), 0);
+
+    // The next round starts from the network that worked
+    radio.aps[0].up = true;
+    radio.dropLink();
+    run(link, radio, SIM_STEP_MS);
+    CHECK_EQ(runUntilConnected(link, radio, 5000), SIM_FAST_JOIN_MS);
+    CHECK_STR(link.getApSsid(link.getApIndex()), "phone");
+}
+
+TEST(WiFiLink, backoffDoublesUntilTheCapAndResetsOnConnect) {
+    WiFiLink link;
+    SimRadio radio;
+    setUp(link, radio);
+    runUntilConnected(link, radio, 5000);
+
+    radio.aps[0].up = false;
+    radio.aps[1].up = false;
+    radio.dropLink();
+
+    // Record each backoff as it starts
+    std::vector<uint32_t> waits;
+    bool backingOff = false;
+    for (uint32_t elapsed = 0; elapsed < 15 * 60 * 1000; elapsed += SIM_STEP_MS) {
+        run(link, radio, SIM_STEP_MS);
+        bool waiting = link.getState() == WIFI_LINK_BACKOFF;
+        if (waiting && !backingOff) waits.push_back(link.msUntilRetry(millis()));
+        backingOff = waiting;
+        CHECK(!link.isConnected());
+    }
+
+    const uint32_t expected[] = { 2000, 4000, 8000, 16000, 32000, 64000, 120000, 120000 };
+    CHECK(waits.size() >= sizeof(expected) / sizeof(expected[0]));
+    for (size_t i = 0; i < waits.size() && i < sizeof(expected) / sizeof(expected[0]); i++) {
+        CHECK_EQ(waits[i], expected[i]);
+    }
+    for (size_t i = sizeof(expected) / sizeof(expected[0]); i < waits.size(); i++) {
+        CHECK_EQ(waits[i], 120000);
+    }
+    CHECK_EQ(link.getFailedRounds(), waits.size());
+
+    // Back within one capped backoff plus a round of joins
+    radio.aps[0].up = true;
+    radio.aps[1].up = true;
+    uint32_t outage = runUntilConnected(link, radio, 120000 + 20000);
+    CHECK(outage > 0);
+    CHECK_EQ(link.getFailedRounds(), 0);
+    CHECK_EQ(link.msUntilRetry(millis()), 0);
+}
+
+TEST(WiFiLink, rapidFlappingNeverBacksOff) {
+    WiFiLink link;
+    SimRadio radio;
+    setUp(link, radio);
+    runUntilConnected(link, radio, 5000);
+    int joinsBefore = radio.joins;
+
+    uint32_t worstOutage = 0;
+    for (int i = 0; i < 20; i++) {
+        run(link, radio, 30000);
+        radio.dropLink();
+        run(link, radio, SIM_STEP_MS);
+        uint32_t outage = runUntilConnected(link, radio, 10000);
+        CHECK(outage > 0);
+        if (outage > worstOutage) worstOutage = outage;
+        CHECK_EQ(link.getFailedRounds(), 0);
+    }
+    CHECK_EQ(link.getDrops(), 20);
+    CHECK_EQ(radio.joins - joinsBefore, 20);            // One fast join each
+    CHECK_EQ(worstOutage, SIM_FAST_JOIN_MS);
+}
+
+TEST(WiFiLink, dropWhileJoiningWithinTheSettleTimeIsIgnored) {
+    WiFiLink link;
+    SimRadio radio;
+    setUp(link, radio);
+    runUntilConnected(link, radio, 5000);
+
+    // The driver reports the old link's end just after the rejoin started
+    radio.dropLink();
+    run(link, radio, SIM_STEP_MS);
+    radio.dropLink();
+    run(link, radio, SIM_STEP_MS);
+    CHECK_EQ(link.getState(), WIFI_LINK_CONNECTING);
+    CHECK_EQ(radio.joins, 2);
+
+    // Past the settle time a drop fails the join: the fast join becomes a scan
+    run(link, radio, WIFI_EVENT_SETTLE_MS);
+    radio.dropLink();
+    run(link, radio, SIM_STEP_MS);
+    CHECK_EQ(radio.joins, 3);
+    CHECK_EQ(radio.fastJoins, 1);
+    CHECK(runUntilConnected(link, radio, 5000) > 0);
+}
+
+TEST(WiFiLink, stopCancelsEverything) {
+    WiFiLink link;
+    SimRadio radio;
+    setUp(link, radio);
+    run(link, radio, 100);
+    link.stop();
+
+    run(link, radio, 60000);
+    CHECK_EQ(link.getState(), WIFI_LINK_IDLE);
+    CHECK_EQ(radio.joins, 1);
+    link.onConnected(millis(), radio.aps[0].bssid, 6);
+    CHECK(!link.isConnected());
+}
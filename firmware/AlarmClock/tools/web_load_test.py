@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Web server load test for the AlarmClock.
+
+Runs N concurrent clients against a device on the network for a fixed time,
+then reports requests per second, response latency and how the audio loop
+held up (per-stage latency from /metrics, underruns, loop rate, 503s).
+
+The profiler is reset before the run (POST /metrics/reset), so the audio
+stage p99/max afterwards reflect only the loaded period.
+
+Usage:
+    python3 tools/web_load_test.py alarmclock.local --clients 4 --seconds 30
+"""
+
+import argparse
+import re
+import threading
+import time
+import urllib.error
+import urllib.request
+
+DEFAULT_PATHS = ["/", "/control", "/stations", "/settings", "/alarms"]
+
+METRIC_LINE = re.compile(r'^([a-z_]+)(\{[^}]*\})?\s+(\S+)$')
+
+
+def fetch(url, timeout, data=None):
+    request = urllib.request.Request(url, data=data)
+    with urllib.request.urlopen(request, timeout=timeout) as response:
+        response.read()
+        return response.status
+
+
+def scrape(base, timeout):
+    """Return {(name, labels): value} from /metrics."""
+    with urllib.request.urlopen(base + "/metrics", timeout=timeout) as response:
+        text = response.read().decode("utf-8", "replace")
+
+    metrics = {}
+    for line in text.splitlines():
+        match = METRIC_LINE.match(line.strip())
+        if match:
+            metrics[(match.group(1), match.group(2) or "")] = float(match.group(3))
+    return metrics
+
+
+def percentile(values, fraction):
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, int(round(fraction * (len(ordered) - 1))))
+    return ordered[index]
+
+
+def client(base, paths, deadline, timeout, results, lock):
+    latencies, errors, busy = [], 0, 0
+    i = 0
+    while time.monotonic() < deadline:
+        path = paths[i % len(paths)]
+        i += 1
+        start = time.monotonic()
+        try:
+            fetch(base + path, timeout)
+            latencies.append(time.monotonic() - start)
+        except urllib.error.HTTPError as error:
+            if error.code == 503:
+                busy += 1
+            else:
+                errors += 1
+        except (urllib.error.URLError, OSError):
+            errors += 1
+
+    with lock:
+        results["latencies"].extend(latencies)
+        results["errors"] += errors
+        results["busy"] += busy
+
+
+def stage(metrics, name, quantile):
+    return metrics.get(("loop_stage_latency_us",
+                        '{stage="%s",quantile="%s"}' % (name, quantile)), 0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host", help="device hostname or IP, e.g. alarmclock.local")
+    parser.add_argument("--clients", type=int, default=4, help="concurrent clients")
+    parser.add_argument("--seconds", type=float, default=30, help="test duration")
+    parser.add_argument("--timeout", type=float, default=10, help="per-request timeout")
+    parser.add_argument("--path", action="append", dest="paths",
+                        help="page to request (repeatable, default: all pages)")
+    args = parser.parse_args()
+
+    base = "http://" + args.host
+    paths = args.paths or DEFAULT_PATHS
+
+    fetch(base + "/metrics/reset", args.timeout, data=b"")
+    before = scrape(base, args.timeout)
+
+    results = {"latencies": [], "errors": 0, "busy": 0}
+    lock = threading.Lock()
+    deadline = time.monotonic() + args.seconds
+    threads = [threading.Thread(target=client,
+                                args=(base, paths, deadline, args.timeout, results, lock))
+               for _ in range(args.clients)]
+    started = time.monotonic()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.monotonic() - started
+
+    after = scrape(base, args.timeout)
+    latencies = results["latencies"]
+
+    print("Clients:          %d for %.0f s" % (args.clients, elapsed))
+    print("Requests:         %d ok, %d busy (503), %d failed"
+          % (len(latencies), results["busy"], results["errors"]))
+    print("Throughput:       %.1f req/s" % (len(latencies) / elapsed))
+    print("Latency:          p50 %.0f ms, p99 %.0f ms, max %.0f ms"
+          % (percentile(latencies, 0.5) * 1000, percentile(latencies, 0.99) * 1000,
+             max(latencies, default=0) * 1000))
+    print("Audio loop:       p50 %.0f us, p99 %.0f us, max %.0f us"
+          % (stage(after, "audio", "0.5"), stage(after, "audio", "0.99"),
+             stage(after, "audio", "1")))
+    underruns = (after.get(("audio_underruns_total", ""), 0) -
+                 before.get(("audio_underruns_total", ""), 0))
+    print("Audio underruns:  %d" % underruns)
+    print("UI loop rate:     %.0f Hz" % after.get(("loop_rate_hz", ""), 0))
+    print("Min free heap:    %.0f bytes" % after.get(("heap_min_free_bytes", ""), 0))
+
+
+if __name__ == "__main__":
+    main()
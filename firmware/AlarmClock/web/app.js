@@ -0,0 +1,338 @@
+// ===== Shared =====
+
+function showAlert(message, isError = false) {
+    const alert = document.getElementById('alert');
+    alert.textContent = message;
+    alert.className = 'alert ' + (isError ? 'error' : 'success');
+    alert.style.display = 'block';
+    setTimeout(() => {
+        alert.style.display = 'none';
+    }, 4000);
+}
+
+// fetch() that retries when the clock answers 503 (busy): the request was
+// turned away before it ran, so sending it again is safe
+function fetchRetry(url, options = {}, attempts = 3) {
+    return fetch(url, options).then(response => {
+        if (response.status !== 503 || attempts <= 1) return response;
+        const seconds = parseInt(response.headers.get('Retry-After'), 10) || 1;
+        return new Promise(resolve => setTimeout(resolve, seconds * 1000))
+            .then(() => fetchRetry(url, options, attempts - 1));
+    });
+}
+
+// ===== Live status (/events) =====
+// Elements marked data-live="<field>" are updated from the server's JSON
+// deltas, so pages no longer need reloading to show the current state.
+
+function applyLiveStatus(update) {
+    for (const field in update) {
+        document.querySelectorAll('[data-live="' + field + '"]').forEach(el => {
+            el.textContent = update[field] === '' ? '-' : update[field];
+        });
+    }
+
+    const slider = document.getElementById('volumeSlider');
+    if ('volume' in update && slider && document.activeElement !== slider) {
+        slider.value = update.volume;
+        updateVolumeDisplay(update.volume);
+    }
+}
+
+function startLiveStatus() {
+    if (!window.EventSource || !document.querySelector('[data-live]')) return;
+
+    const source = new EventSource('/events');
+    source.onmessage = event => applyLiveStatus(JSON.parse(event.data));
+}
+
+document.addEventListener('DOMContentLoaded', startLiveStatus);
+
+// ===== Play page =====
+
+function playCustom() {
+    const name = document.getElementById('playName').value;
+    const url = document.getElementById('playUrl').value;
+
+    if (!name || !url) {
+        showAlert('Please enter both name and URL', true);
+        return;
+    }
+
+    playStation(name, url);
+}
+
+function playStation(name, url) {
+    fetchRetry('/play', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: 'name=' + encodeURIComponent(name) + '&url=' + encodeURIComponent(url)
+    })
+    .then(response => response.text())
+    .then(data => {
+        showAlert(data);
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+function stopAudio() {
+    fetchRetry('/stop', {
+        method: 'POST'
+    })
+    .then(response => response.text())
+    .then(data => {
+        showAlert(data);
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+// ===== Stations page =====
+
+function addStation() {
+    const name = document.getElementById('newName').value;
+    const url = document.getElementById('newUrl').value;
+
+    if (!name || !url) {
+        showAlert('Please enter both name and URL', true);
+        return;
+    }
+
+    fetchRetry('/add_station', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: 'name=' + encodeURIComponent(name) + '&url=' + encodeURIComponent(url)
+    })
+    .then(response => response.text())
+    .then(data => {
+        if (data.includes('success')) {
+            showAlert(data);
+            document.getElementById('newName').value = '';
+            document.getElementById('newUrl').value = '';
+            setTimeout(() => location.reload(), 1500);
+        } else {
+            showAlert(data, true);
+        }
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+function deleteStation(index) {
+    if (!confirm('Are you sure you want to delete this station?')) {
+        return;
+    }
+
+    fetchRetry('/delete_station', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: 'index=' + index
+    })
+    .then(response => response.text())
+    .then(data => {
+        showAlert(data);
+        setTimeout(() => location.reload(), 1000);
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+function playFromList(name, url) {
+    fetchRetry('/play', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: 'name=' + encodeURIComponent(name) + '&url=' + encodeURIComponent(url)
+    })
+    .then(response => response.text())
+    .then(data => {
+        showAlert(data);
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+// ===== Control page =====
+
+function updateVolumeDisplay(value) {
+    document.getElementById('volumeValue').textContent = value;
+}
+
+function updateBrightnessDisplay(value) {
+    document.getElementById('brightnessValue').textContent = value;
+}
+
+function saveVolume() {
+    const volume = document.getElementById('volumeSlider').value;
+
+    fetchRetry('/set_volume', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: 'volume=' + volume
+    })
+    .then(response => response.text())
+    .then(data => {
+        showAlert('Volume saved: ' + volume);
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+function saveBrightness() {
+    const brightness = document.getElementById('brightnessSlider').value;
+
+    fetchRetry('/set_brightness', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: 'brightness=' + brightness
+    })
+    .then(response => response.text())
+    .then(data => {
+        showAlert('Brightness saved: ' + brightness);
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+// ===== Settings page =====
+
+function saveFeatures() {
+    const form = document.getElementById('featuresForm');
+    const formData = new FormData(form);
+    const params = new URLSearchParams(formData).toString();
+
+    fetchRetry('/save_features', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: params
+    })
+    .then(response => response.text())
+    .then(data => {
+        showAlert(data);
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+function saveAudioMode() {
+    const audioMode = document.getElementById('audioMode').value;
+
+    fetchRetry('/save_audio_mode', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: 'audioMode=' + audioMode
+    })
+    .then(response => response.text())
+    .then(data => {
+        showAlert(data);
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+function saveTimezone() {
+    const gmtOffset = document.getElementById('gmtOffset').value;
+    const dstOffset = document.getElementById('dstOffset').value;
+
+    fetchRetry('/save_timezone', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: 'gmtOffset=' + gmtOffset + '&dstOffset=' + dstOffset
+    })
+    .then(response => response.text())
+    .then(data => {
+        showAlert(data);
+    })
+    .catch(error => {
+        showAlert('Error: ' + error, true);
+    });
+}
+
+// ===== Alarms page =====
+
+function updateSoundOptions(index) {
+    const soundType = document.getElementById('soundType_' + index).value;
+    document.getElementById('radioOptions_' + index).style.display = soundType == '0' ? 'block' : 'none';
+    document.getElementById('fmOptions_' + index).style.display = soundType == '1' ? 'block' : 'none';
+    document.getElementById('mp3Options_' + index).style.display = soundType == '2' ? 'block' : 'none';
+}
+
+function toggleAlarm(index) {
+    saveAlarm(index);
+}
+
+function saveAlarm(index) {
+    const time = document.getElementById('time_' + index).value.split(':');
+    const enabled = document.getElementById('enabled_' + index).checked ? '1' : '0';
+    const repeat = document.getElementById('repeat_' + index).value;
+    const soundType = document.getElementById('soundType_' + index).value;
+
+    let params = 'index=' + index + '&enabled=' + enabled + '&hour=' + time[0] + '&minute=' + time[1];
+    params += '&repeat=' + repeat + '&soundType=' + soundType;
+
+    if (soundType == '0') {
+        params += '&stationIndex=' + document.getElementById('station_' + index).value;
+        params += '&stationIndex=0&fmFreq=98.0&mp3File=';
+    } else if (soundType == '1') {
+        params += '&fmFreq=' + document.getElementById('fmFreq_' + index).value;
+        params += '&stationIndex=0&mp3File=';
+    } else if (soundType == '2') {
+        const mp3Select = document.getElementById('mp3File_' + index);
+        if (mp3Select.value) {
+            params += '&mp3File=' + encodeURIComponent(mp3Select.value);
+        } else {
+            alert('Please select an MP3 file or upload one to /mp3/ directory');
+            return;
+        }
+        params += '&stationIndex=0&fmFreq=98.0';
+    }
+
+    fetchRetry('/save_alarm', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: params
+    })
+    .then(response => response.text())
+    .then(data => {
+        alert(data);
+        location.reload();
+    })
+    .catch(error => alert('Error: ' + error));
+}
+
+function testAlarm(index) {
+    const soundType = document.getElementById('soundType_' + index).value;
+    let params = 'soundType=' + soundType;
+
+    if (soundType == '0') {
+        params += '&stationIndex=' + document.getElementById('station_' + index).value;
+    } else if (soundType == '1') {
+        params += '&fmFreq=' + document.getElementById('fmFreq_' + index).value;
+    } else if (soundType == '2') {
+        const mp3Select = document.getElementById('mp3File_' + index);
+        if (mp3Select.value) {
+            params += '&mp3File=' + encodeURIComponent(mp3Select.value);
+        } else {
+            alert('Please select an MP3 file');
+            return;
+        }
+    }
+
+    fetchRetry('/test_alarm', {
+        method: 'POST',
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+        body: params
+    })
+    .then(response => response.text())
+    .then(data => alert(data))
+    .catch(error => alert('Error: ' + error));
+}
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Build the static web assets for the AlarmClock web interface.
+
+Compresses the CSS/JS sources in this directory into content-hashed .gz
+files under ../data/www (uploaded to the LittleFS 'spiffs' partition with
+the rest of the data folder) and regenerates ../WebAssets.h, which holds
+the hashed URLs, plus ../WebAssets.cpp with the ETags and a flash copy of
+each file used when LittleFS has no upload.
+
+Run after editing any file in web/:
+    python3 web/build_assets.py
+"""
+
+import gzip
+import hashlib
+import os
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SKETCH = os.path.dirname(HERE)
+OUT_DIR = os.path.join(SKETCH, "data", "www")
+HEADER = os.path.join(SKETCH, "WebAssets.h")
+SOURCE = os.path.join(SKETCH, "WebAssets.cpp")
+
+# (source file, macro prefix, content type)
+ASSETS = [
+    ("app.css", "APP_CSS", "text/css"),
+    ("alarms.css", "ALARMS_CSS", "text/css"),
+    ("app.js", "APP_JS", "application/javascript"),
+]
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    os.makedirs(OUT_DIR, exist_ok=True)
+    for name in os.listdir(OUT_DIR):
+        if name.endswith(".gz"):
+            os.remove(os.path.join(OUT_DIR, name))
+
+    macros = []
+    arrays = []
+    table = []
+    for source, macro, content_type in ASSETS:
+        with open(os.path.join(HERE, source), "rb") as f:
+            raw = f.read()
+        digest = hashlib.sha256(raw).hexdigest()[:8]
+        stem, ext = os.path.splitext(source)
+        url = "/www/%s.%s%s" % (stem, digest, ext)
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+
+        with open(os.path.join(OUT_DIR, os.path.basename(url) + ".gz"), "wb") as f:
+            f.write(packed)
+
+        var = "WEB_ASSET_%s_GZ" % macro
+        macros.append('#define WEB_ASSET_%s "%s"' % (macro, url))
+        arrays.append("static const uint8_t %s[] PROGMEM = {\n%s\n};" % (var, c_array(packed)))
+        table.append('    { WEB_ASSET_%s, "%s", "\\"%s\\"", %s, sizeof(%s) },'
+                     % (macro, content_type, digest, var, var))
+        print("%-12s %6d -> %5d bytes  %s" % (source, len(raw), len(packed), url))
+
+    with open(HEADER, "w") as f:
+        f.write("// Generated by web/build_assets.py - do not edit by hand\n")
+        f.write("#ifndef WEB_ASSETS_H\n#define WEB_ASSETS_H\n\n")
+        f.write("#include <Arduino.h>\n\n")
+        f.write("\n".join(macros) + "\n\n")
+        f.write("struct WebAsset {\n")
+        f.write("    const char* path;         // Hashed URL; the LittleFS file is path + \".gz\"\n")
+        f.write("    const char* contentType;\n")
+        f.write("    const char* etag;\n")
+        f.write("    const uint8_t* gzData;    // Flash copy when LittleFS has no upload\n")
+        f.write("    size_t gzSize;\n")
+        f.write("};\n\n")
+        f.write("#define WEB_ASSET_COUNT %d\n\n" % len(ASSETS))
+        f.write("extern const WebAsset WEB_ASSETS[WEB_ASSET_COUNT];\n\n")
+        f.write("#endif\n")
+
+    with open(SOURCE, "w") as f:
+        f.write("// Generated by web/build_assets.py - do not edit by hand\n")
+        f.write('#include "WebAssets.h"\n\n')
+        f.write("\n\n".join(arrays) + "\n\n")
+        f.write("const WebAsset WEB_ASSETS[WEB_ASSET_COUNT] = {\n%s\n};\n" % "\n".join(table))
+
+if __name__ == "__main__":
+    main()